@@ -1,4 +1,8 @@
 #include "Assessment.hpp"
+#include "Student.hpp"
+#include "AssessmentColumns.hpp"
+#include "GradeKernel.hpp"
+#include "GradingPolicy.hpp"
 
 namespace PokenoSouth {
 
@@ -11,9 +15,7 @@ namespace PokenoSouth {
                           const string& assessmentDate)
         : assessmentId(assessmentId),
           studentRollNumber(studentRollNumber),
-          courseId(courseId),
-          calculatedGrade(0.0),
-          gradeNeedsRecalculation(true) {
+          courseKey(internCourseId(courseId)) {
         
         // Validate assessment ID
         if (!isValidAssessmentId(assessmentId)) {
@@ -25,11 +27,6 @@ namespace PokenoSouth {
             throw invalid_argument("Invalid student roll number: must be between 1 and 99999");
         }
         
-        // Validate course ID
-        if (!isValidCourseId(courseId)) {
-            throw invalid_argument("Invalid course ID format");
-        }
-        
         // Validate and set internal marks
         if (!isValidMarks(internalMarks)) {
             throw invalid_argument("Invalid internal marks: must be between " +
@@ -47,16 +44,15 @@ namespace PokenoSouth {
         this->finalMarks = finalMarks;
         
         // Validate and set assessment date
-        if (!Common::isValidDate(assessmentDate)) {
-            throw invalid_argument("Invalid assessment date format: must be YYYY-MM-DD");
+        if (!Date::tryParse(assessmentDate, this->assessmentDate)) {
+            throw invalid_argument("Invalid assessment date format: must be a real date in YYYY-MM-DD format");
         }
-        this->assessmentDate = assessmentDate;
         
         // Initialize defaults
-        this->assessmentType = "Assignment";
+        this->typeKey = SymbolTable::assessmentTypes().intern(DEFAULT_ASSESSMENT_TYPE);
         this->remarks = "";
         this->isSubmitted = false;
-        this->submissionDate = "";
+        this->submissionDate = Date();
     }
     
     // Constructor with full metadata
@@ -70,76 +66,101 @@ namespace PokenoSouth {
                           const string& remarks)
         : Assessment(assessmentId, studentRollNumber, courseId, internalMarks, finalMarks, assessmentDate) {
         
-        this->assessmentType = assessmentType.empty() ? "Assignment" : assessmentType;
+        setAssessmentType(assessmentType);
         this->remarks = remarks;
     }
     
+    Assessment::Assessment(TrustedInput,
+                          const string& assessmentId,
+                          int studentRollNumber,
+                          const string& courseId,
+                          double internalMarks,
+                          double finalMarks,
+                          Date assessmentDate,
+                          const string& assessmentType,
+                          bool isSubmitted,
+                          Date submissionDate,
+                          const string& remarks)
+        : assessmentId(assessmentId),
+          studentRollNumber(studentRollNumber),
+          courseKey(SymbolTable::courseIds().intern(courseId)),
+          internalMarks(internalMarks),
+          finalMarks(finalMarks),
+          assessmentDate(assessmentDate),
+          typeKey(SymbolTable::assessmentTypes().intern(assessmentType.empty() ? DEFAULT_ASSESSMENT_TYPE : assessmentType)),
+          remarks(remarks),
+          isSubmitted(isSubmitted || !submissionDate.empty()),   // As setIsSubmitted + setSubmissionDate would leave it
+          submissionDate(submissionDate.empty() && isSubmitted ? Date::today() : submissionDate) {
+    }
+    
     // Copy constructor
     Assessment::Assessment(const Assessment& other)
         : assessmentId(other.assessmentId),
           studentRollNumber(other.studentRollNumber),
-          courseId(other.courseId),
+          courseKey(other.courseKey),
           internalMarks(other.internalMarks),
           finalMarks(other.finalMarks),
           assessmentDate(other.assessmentDate),
-          calculatedGrade(other.calculatedGrade),
-          gradeNeedsRecalculation(other.gradeNeedsRecalculation),
-          assessmentType(other.assessmentType),
+          cachedGradeBits(other.cachedGradeBits.load(memory_order_relaxed)),
+          typeKey(other.typeKey),
           remarks(other.remarks),
           isSubmitted(other.isSubmitted),
           submissionDate(other.submissionDate) {
     }
     
+    // Destructor
+    Assessment::~Assessment() {
+        if (columns) {
+            columns->untrack(this);
+        }
+    }
+    
     // Assignment operator
     Assessment& Assessment::operator=(const Assessment& other) {
         if (this != &other) {
             // Note: assessmentId, studentRollNumber, courseId are const and cannot be changed
+            // The owner link stays with this object; it is told about the new grade below
+            const double oldGrade = getCalculatedGrade();
             internalMarks = other.internalMarks;
             finalMarks = other.finalMarks;
             assessmentDate = other.assessmentDate;
-            calculatedGrade = other.calculatedGrade;
-            gradeNeedsRecalculation = other.gradeNeedsRecalculation;
-            assessmentType = other.assessmentType;
+            cachedGradeBits.store(other.cachedGradeBits.load(memory_order_relaxed), memory_order_relaxed);
+            typeKey = other.typeKey;
             remarks = other.remarks;
             isSubmitted = other.isSubmitted;
             submissionDate = other.submissionDate;
+            notifyGradeChanged(oldGrade);
         }
         return *this;
     }
     
     // === CALCULATED GETTERS ===
     double Assessment::getCalculatedGrade() const {
-        // Memory optimization: Use lazy evaluation with thread-safe double-checked locking pattern
-        if (gradeNeedsRecalculation) {
-            // Calculate weighted grade: internal*0.3 + final*0.7
-            const double newCalculatedGrade = calculateWeightedGrade();
-            
-            // Atomic update of cached values
-            calculatedGrade = newCalculatedGrade;
-            gradeNeedsRecalculation = false;
+        // Lazy, lock-free: see cachedGradeBits for why a racing fill is benign
+        uint64_t bits = cachedGradeBits.load(memory_order_relaxed);
+        if (bits == STALE_GRADE) {
+            // Calculate weighted grade under the course's policy
+            const double grade = calculateWeightedGrade();
+            memcpy(&bits, &grade, sizeof bits);
+            cachedGradeBits.store(bits, memory_order_relaxed);
+            return grade;
         }
-        return calculatedGrade;
+        double grade;
+        memcpy(&grade, &bits, sizeof grade);
+        return grade;
     }
     
     double Assessment::getInternalContribution() const {
-        return internalMarks * INTERNAL_WEIGHT;
+        return internalMarks * GradingPolicyRegistry::shared().forCourse(courseKey).internalWeight();
     }
     
     double Assessment::getFinalContribution() const {
-        return finalMarks * FINAL_WEIGHT;
+        return finalMarks * GradingPolicyRegistry::shared().forCourse(courseKey).finalWeight();
     }
     
     string Assessment::getLetterGrade() const {
-        double grade = getCalculatedGrade();
-        
-        if (grade >= A_PLUS_THRESHOLD) return "A+";
-        if (grade >= A_THRESHOLD) return "A";
-        if (grade >= B_PLUS_THRESHOLD) return "B+";
-        if (grade >= B_THRESHOLD) return "B";
-        if (grade >= C_PLUS_THRESHOLD) return "C+";
-        if (grade >= C_THRESHOLD) return "C";
-        if (grade >= D_THRESHOLD) return "D";
-        return "F";
+        // Bands are defined once, in GradeKernel, so batch classification agrees with this
+        return GradeKernel::letterName(GradeKernel::letterCode(getCalculatedGrade()));
     }
     
     string Assessment::getGradeStatus() const {
@@ -160,8 +181,10 @@ namespace PokenoSouth {
         
         // Memory optimization: Only update if value actually changed
         if (abs(this->internalMarks - marks) > 1e-9) {  // Use epsilon comparison for doubles
+            const double oldGrade = getCalculatedGrade();
             this->internalMarks = marks;
-            gradeNeedsRecalculation = true;
+            invalidateGrade();
+            notifyGradeChanged(oldGrade);
         }
     }
     
@@ -174,51 +197,67 @@ namespace PokenoSouth {
         
         // Memory optimization: Only update if value actually changed
         if (abs(this->finalMarks - marks) > 1e-9) {  // Use epsilon comparison for doubles
+            const double oldGrade = getCalculatedGrade();
             this->finalMarks = marks;
-            gradeNeedsRecalculation = true;
+            invalidateGrade();
+            notifyGradeChanged(oldGrade);
         }
     }
     
     void Assessment::setAssessmentDate(const string& date) {
-        if (!Common::isValidDate(date)) {
-            throw invalid_argument("Invalid assessment date format: must be YYYY-MM-DD");
+        if (!Date::tryParse(date, this->assessmentDate)) {
+            throw invalid_argument("Invalid assessment date format: must be a real date in YYYY-MM-DD format");
         }
-        this->assessmentDate = date;
+        markModified();
     }
     
     void Assessment::setAssessmentType(const string& type) {
-        this->assessmentType = type.empty() ? "Assignment" : type;
+        this->typeKey = SymbolTable::assessmentTypes().intern(type.empty() ? DEFAULT_ASSESSMENT_TYPE : type);
+        markModified();
     }
     
     void Assessment::setRemarks(const string& remarks) {
         this->remarks = remarks;
+        markModified();
     }
     
     void Assessment::setIsSubmitted(bool submitted) {
         this->isSubmitted = submitted;
         if (submitted && submissionDate.empty()) {
-            submissionDate = Common::getCurrentDate();
+            submissionDate = Date::today();
         }
+        markModified();
     }
     
     void Assessment::setSubmissionDate(const string& date) {
-        if (!date.empty() && !Common::isValidDate(date)) {
-            throw invalid_argument("Invalid submission date format: must be YYYY-MM-DD");
+        Date submitted;
+        if (!date.empty() && !Date::tryParse(date, submitted)) {
+            throw invalid_argument("Invalid submission date format: must be a real date in YYYY-MM-DD format");
         }
-        this->submissionDate = date;
+        this->submissionDate = submitted;
         if (!date.empty()) {
             this->isSubmitted = true;
         }
+        markModified();
     }
     
     // === GRADE CALCULATION METHODS ===
     void Assessment::recalculateGrade() {
-        gradeNeedsRecalculation = true;
+        invalidateGrade();
         getCalculatedGrade(); // Force recalculation
     }
     
+    void Assessment::applyRegrade(double oldGrade, double grade) {
+        uint64_t bits;
+        memcpy(&bits, &grade, sizeof bits);
+        cachedGradeBits.store(bits, memory_order_relaxed);
+        if (grade != oldGrade) {
+            notifyGradeChanged(oldGrade);
+        }
+    }
+    
     double Assessment::calculateWeightedGrade() const {
-        return (internalMarks * INTERNAL_WEIGHT) + (finalMarks * FINAL_WEIGHT);
+        return GradingPolicyRegistry::shared().forCourse(courseKey).assessmentGrade(internalMarks, finalMarks);
     }
     
     void Assessment::updateMarks(double internal, double final) {
@@ -234,9 +273,30 @@ namespace PokenoSouth {
                                       to_string(MAX_MARKS));
         }
         
+        const double oldGrade = getCalculatedGrade();
         this->internalMarks = internal;
         this->finalMarks = final;
-        gradeNeedsRecalculation = true;
+        invalidateGrade();
+        notifyGradeChanged(oldGrade);
+    }
+    
+    void Assessment::notifyGradeChanged(double oldGrade) {
+        // Keeps the owner's running totals (and through it the course's) in step
+        if (owner) {
+            owner->onAssessmentGradeChanged(this, oldGrade, getCalculatedGrade());
+        }
+        markModified();
+    }
+    
+    // === VERSIONING ===
+    void Assessment::markModified() {
+        version = VersionClock::stamp(VersionDomain::Assessments);
+        if (columns) {
+            columns->refresh(*this);
+        }
+        if (owner) {
+            owner->markModified();
+        }
     }
     
     // === COMPARISON AND ANALYSIS ===
@@ -267,9 +327,7 @@ namespace PokenoSouth {
     
     int Assessment::getDaysLate() const {
         if (!isLateSubmission()) return 0;
-        // Simple calculation - for now return placeholder
-        // In a real implementation, would parse dates and calculate difference
-        return 1; // Placeholder for days late
+        return submissionDate.daysSince(assessmentDate);
     }
     
     bool Assessment::requiresResubmission() const {
@@ -286,8 +344,8 @@ namespace PokenoSouth {
         cout << "\n=== Assessment Information ===" << endl;
         cout << "Assessment ID: " << assessmentId << endl;
         cout << "Student Roll: " << studentRollNumber << endl;
-        cout << "Course: " << courseId << endl;
-        cout << "Type: " << assessmentType << endl;
+        cout << "Course: " << getCourseId() << endl;
+        cout << "Type: " << getAssessmentType() << endl;
         cout << "Assessment Date: " << assessmentDate << endl;
         cout << "Internal Marks: " << fixed << setprecision(1) << internalMarks << "/100" << endl;
         cout << "Final Marks: " << fixed << setprecision(1) << finalMarks << "/100" << endl;
@@ -308,11 +366,13 @@ namespace PokenoSouth {
     
     void Assessment::displayGradeBreakdown() const {
         cout << "\n=== Grade Breakdown ===" << endl;
-        cout << "Assessment: " << assessmentId << " (" << courseId << ")" << endl;
-        cout << "Internal Assessment (" << static_cast<int>(INTERNAL_WEIGHT * 100) << "%): "
+        cout << "Assessment: " << assessmentId << " (" << getCourseId() << ")" << endl;
+        const CourseGradingPolicy& policy = GradingPolicyRegistry::shared().forCourse(courseKey);
+        cout << "Grading Policy: " << policy.getName() << endl;
+        cout << "Internal Assessment (" << static_cast<int>(policy.internalWeight() * 100 + 0.5) << "%): "
                   << fixed << setprecision(1) << internalMarks
                   << " → " << getInternalContribution() << " points" << endl;
-        cout << "Final Assessment (" << static_cast<int>(FINAL_WEIGHT * 100) << "%): "
+        cout << "Final Assessment (" << static_cast<int>(policy.finalWeight() * 100 + 0.5) << "%): "
                   << fixed << setprecision(1) << finalMarks
                   << " → " << getFinalContribution() << " points" << endl;
         cout << "Total Grade: " << fixed << setprecision(1) << getCalculatedGrade() << "%" << endl;
@@ -359,13 +419,13 @@ namespace PokenoSouth {
         ostringstream oss;
         oss << assessmentId << ","
             << studentRollNumber << ","
-            << courseId << ","
+            << getCourseId() << ","
             << fixed << setprecision(1) << internalMarks << ","
             << fixed << setprecision(1) << finalMarks << ","
             << fixed << setprecision(1) << getCalculatedGrade() << ","
             << getLetterGrade() << ","
             << assessmentDate << ","
-            << assessmentType << ","
+            << getAssessmentType() << ","
             << (isSubmitted ? "Yes" : "No") << ","
             << submissionDate << ","
             << remarks;
@@ -389,6 +449,14 @@ namespace PokenoSouth {
         return !courseId.empty() && courseId.length() >= 3;
     }
     
+    SymbolKey Assessment::internCourseId(const string& courseId) {
+        // Validate before interning so rejected IDs never enter the shared table
+        if (!isValidCourseId(courseId)) {
+            throw invalid_argument("Invalid course ID format");
+        }
+        return SymbolTable::courseIds().intern(courseId);
+    }
+    
     string Assessment::generateAssessmentId(int studentRoll, const string& courseId) {
         return "ASS" + to_string(studentRoll) + "_" + courseId;
     }
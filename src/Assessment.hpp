@@ -1,9 +1,12 @@
 #pragma once
 
 #include "common.hpp"
-#include "Student.hpp"
-#include "Course.hpp"
 #include "Grade.hpp"
+#include "SymbolTable.hpp"
+#include "EntityArena.hpp"
+#include "VersionClock.hpp"
+#include "Date.hpp"
+#include "TrustedInput.hpp"
 
 USING_STD_ASSESSMENT
 
@@ -11,13 +14,14 @@ namespace PokenoSouth {
     // Forward declarations
     class Student;
     class Course;
+    class AssessmentColumns;
     
     /**
      * Assessment Entity for Pokeno South Primary School
      * Represents a weighted assessment with automatic grade calculation following TalentHub Wellington patterns
      * 
      * Key Features:
-     * - Weighted grade calculation (Internal 30%, Final 70%)
+     * - Weighted grade calculation under the course's grading policy (standard: Internal 30%, Final 70%)
      * - Immutable assessment ID and relationships
      * - Comprehensive validation for marks (0-100 range)
      * - Grade classification and pass/fail determination
@@ -28,22 +32,36 @@ namespace PokenoSouth {
         // Core assessment data (immutable after construction)
         const string assessmentId;    // Immutable identifier
         const int studentRollNumber;       // Reference to student (immutable)
-        const string courseId;        // Reference to course (immutable)
+        const SymbolKey courseKey;         // Interned reference to course (immutable)
         
         // Marks data (mutable for corrections)
-        double internalMarks;              // 0-100, weighted 30%
-        double finalMarks;                 // 0-100, weighted 70%
-        string assessmentDate;        // YYYY-MM-DD format
+        double internalMarks;              // 0-100, weighted by the course's policy (standard 30%)
+        double finalMarks;                 // 0-100, weighted by the course's policy (standard 70%)
+        Date assessmentDate;
         
         // Calculated fields (auto-computed)
-        mutable double calculatedGrade;    // Cache for weighted calculation
-        mutable bool gradeNeedsRecalculation;  // Flag for lazy evaluation
+        // The weighted grade's raw bits, or STALE_GRADE when it must be recomputed. The grade is a pure
+        // function of the marks and the course's policy weights (which only change through
+        // applyRegrade()), so concurrent readers that race to fill it store identical bits and
+        // relaxed atomics suffice: plain loads and stores on mainstream targets, no lock, no contention.
+        // Mutating an assessment still requires that nobody is reading it.
+        static constexpr uint64_t STALE_GRADE = 0x7FF8DEADBEEF0000ULL;   // A NaN no calculation produces
+        mutable atomic<uint64_t> cachedGradeBits{STALE_GRADE};
+        
+        void invalidateGrade() { cachedGradeBits.store(STALE_GRADE, memory_order_relaxed); }
         
         // Assessment metadata
-        string assessmentType;        // e.g., "Assignment", "Test", "Exam"
+        SymbolKey typeKey;                 // Interned type, e.g., "Assignment", "Test", "Exam"
         string remarks;               // Optional teacher comments
         bool isSubmitted;                  // Submission status
-        string submissionDate;        // When student submitted
+        Date submissionDate;          // When student submitted; empty if not yet
+        
+        EntityHandle handle = INVALID_HANDLE;   // Slot in the owning EntityArena
+        Student* owner = nullptr;               // Linked student, told about mark changes; not copied
+        AssessmentColumns* columns = nullptr;   // Columnar mirror holding this row, if tracked; not copied
+        Version version = VersionClock::stamp(VersionDomain::Assessments);   // See markModified()
+        
+        void notifyGradeChanged(double oldGrade);
         
     public:
     // Constructor with core data
@@ -66,33 +84,55 @@ namespace PokenoSouth {
                    const string& assessmentType,
                    const string& remarks);
         
-        // Destructor
-        ~Assessment() = default;
+        // Unchecked constructor for verified saved data (see TrustedInput); courseId is already formatted
+        Assessment(TrustedInput,
+                   const string& assessmentId,
+                   int studentRollNumber,
+                   const string& courseId,
+                   double internalMarks,
+                   double finalMarks,
+                   Date assessmentDate,
+                   const string& assessmentType,
+                   bool isSubmitted,
+                   Date submissionDate,
+                   const string& remarks);
+        
+        // Destructor (drops this row from the columnar mirror)
+        ~Assessment();
         
         // Copy constructor and assignment
         Assessment(const Assessment& other);
         Assessment& operator=(const Assessment& other);
         
-        // Move constructor and assignment
-        Assessment(Assessment&& other) noexcept = default;
+        // Move constructor and assignment: const members and the atomic grade cache leave nothing
+        // to steal, so moves fall back to the copy constructor
         Assessment& operator=(Assessment&& other) noexcept = delete;  // Cannot move due to const members
         
         // === GETTER METHODS (const correctness) ===
         const string& getAssessmentId() const { return assessmentId; }
         int getStudentRollNumber() const { return studentRollNumber; }
-        const string& getCourseId() const { return courseId; }
+        const string& getCourseId() const { return SymbolTable::courseIds().name(courseKey); }
+        SymbolKey getCourseKey() const { return courseKey; }
         double getInternalMarks() const { return internalMarks; }
         double getFinalMarks() const { return finalMarks; }
-        const string& getAssessmentDate() const { return assessmentDate; }
-        const string& getAssessmentType() const { return assessmentType; }
+        Date getAssessmentDate() const { return assessmentDate; }
+        const string& getAssessmentType() const { return SymbolTable::assessmentTypes().name(typeKey); }
+        SymbolKey getAssessmentTypeKey() const { return typeKey; }
+        EntityHandle getHandle() const { return handle; }
+        void setHandle(EntityHandle h) { handle = h; }
+        Student* getOwner() const { return owner; }
+        void setOwner(Student* student) { owner = student; }   // Set by Student::addAssessment
+        void setColumns(AssessmentColumns* mirror) { columns = mirror; }   // Set by AssessmentColumns::track
+        Version getVersion() const { return version; }
+        void markModified();   // New stamp and column refresh; also stamps the owner (and its courses)
         const string& getRemarks() const { return remarks; }
         bool getIsSubmitted() const { return isSubmitted; }
-        const string& getSubmissionDate() const { return submissionDate; }
+        Date getSubmissionDate() const { return submissionDate; }
         
         // === CALCULATED GETTERS ===
-        double getCalculatedGrade() const;     // Weighted: internal*0.3 + final*0.7
-        double getInternalContribution() const; // Internal marks * 0.3
-        double getFinalContribution() const;    // Final marks * 0.7
+        double getCalculatedGrade() const;     // Weighted by the course's policy (standard: internal*0.3 + final*0.7)
+        double getInternalContribution() const; // Internal marks * the policy's internal weight
+        double getFinalContribution() const;    // Final marks * the policy's final weight
         string getLetterGrade() const;     // A+, A, B+, B, C+, C, D, F
         string getGradeStatus() const;     // "Pass" or "Fail"
         bool isPassing() const;                 // Grade >= 50%
@@ -109,6 +149,9 @@ namespace PokenoSouth {
         
         // === GRADE CALCULATION METHODS ===
         void recalculateGrade();               // Force recalculation
+        // The grade under the course's new policy, computed in bulk by AssessmentColumns::regrade
+        // (oldGrade is its row's last grade): replaces the cached grade and tells the owner
+        void applyRegrade(double oldGrade, double grade);
         double calculateWeightedGrade() const; // Pure calculation method
         void updateMarks(double internal, double final); // Update both marks atomically
         
@@ -136,12 +179,14 @@ namespace PokenoSouth {
         static bool isValidRollNumber(int rollNumber);
         static bool isValidCourseId(const string& courseId);
         static string generateAssessmentId(int studentRoll, const string& courseId);
+        static SymbolKey internCourseId(const string& courseId);  // Validate, then intern
         
         // === BUSINESS RULES AND CONSTANTS ===
+        static constexpr const char* DEFAULT_ASSESSMENT_TYPE = "Assignment";
         static constexpr double MIN_MARKS = 0.0;
         static constexpr double MAX_MARKS = 100.0;
-        static constexpr double INTERNAL_WEIGHT = 0.3;   // 30% weighting
-        static constexpr double FINAL_WEIGHT = 0.7;      // 70% weighting
+        static constexpr double INTERNAL_WEIGHT = 0.3;   // 30% weighting under the "standard" policy
+        static constexpr double FINAL_WEIGHT = 0.7;      // 70% weighting under the "standard" policy
         static constexpr double PASS_THRESHOLD = 50.0;   // 50% to pass
         static constexpr double SUPPLEMENTAL_MIN = 40.0; // Minimum for supplemental
         static constexpr double SUPPLEMENTAL_MAX = 49.9; // Maximum for supplemental
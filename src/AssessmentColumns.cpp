@@ -0,0 +1,246 @@
+#include "AssessmentColumns.hpp"
+#include "Assessment.hpp"
+
+namespace PokenoSouth {
+
+    // === ROW ACCESS ===
+    void AssessmentColumns::writeRow(size_t row, const Assessment& assessment) {
+        rollNumberColumn[row] = assessment.getStudentRollNumber();
+        courseKeyColumn[row] = assessment.getCourseKey();
+        internalMarksColumn[row] = assessment.getInternalMarks();
+        finalMarksColumn[row] = assessment.getFinalMarks();
+        gradeColumn[row] = assessment.getCalculatedGrade();
+        dateColumn[row] = assessment.getAssessmentDate();
+        submittedColumn[row] = assessment.getIsSubmitted() ? 1 : 0;
+    }
+
+    uint32_t AssessmentColumns::rowOf(const Assessment* assessment) const {
+        const EntityHandle handle = assessment->getHandle();
+        if (handle >= rowOfHandle.size()) return NO_ROW;
+        const uint32_t row = rowOfHandle[handle];
+        // A moved-from or copied Assessment can carry the same handle; only the bound object owns the row
+        return (row != NO_ROW && sourceColumn[row] == assessment) ? row : NO_ROW;
+    }
+
+    // === SYNCHRONISATION ===
+    void AssessmentColumns::track(Assessment* assessment) {
+        const EntityHandle handle = assessment->getHandle();
+        if (handle == INVALID_HANDLE) {
+            return;   // Not arena-owned; nothing would keep the row alive
+        }
+
+        uint32_t row = rowOf(assessment);
+        if (row == NO_ROW) {
+            row = static_cast<uint32_t>(size());
+            rollNumberColumn.push_back(0);
+            courseKeyColumn.push_back(SymbolTable::INVALID_KEY);
+            internalMarksColumn.push_back(0.0);
+            finalMarksColumn.push_back(0.0);
+            gradeColumn.push_back(0.0);
+            dateColumn.push_back(Date());
+            submittedColumn.push_back(0);
+            sourceColumn.push_back(assessment);
+            if (handle >= rowOfHandle.size()) {
+                rowOfHandle.resize(handle + 1, NO_ROW);
+            }
+            rowOfHandle[handle] = row;
+        }
+
+        writeRow(row, *assessment);
+        assessment->setColumns(this);
+    }
+
+    void AssessmentColumns::refresh(const Assessment& assessment) {
+        const uint32_t row = rowOf(&assessment);
+        if (row != NO_ROW) {
+            writeRow(row, assessment);
+        }
+    }
+
+    void AssessmentColumns::untrack(const Assessment* assessment) {
+        const uint32_t row = rowOf(assessment);
+        if (row == NO_ROW) {
+            return;
+        }
+
+        // Move the last row into the hole so the columns stay packed
+        const size_t last = size() - 1;
+        if (row != last) {
+            rollNumberColumn[row] = rollNumberColumn[last];
+            courseKeyColumn[row] = courseKeyColumn[last];
+            internalMarksColumn[row] = internalMarksColumn[last];
+            finalMarksColumn[row] = finalMarksColumn[last];
+            gradeColumn[row] = gradeColumn[last];
+            dateColumn[row] = dateColumn[last];
+            submittedColumn[row] = submittedColumn[last];
+            sourceColumn[row] = sourceColumn[last];
+            rowOfHandle[sourceColumn[row]->getHandle()] = row;
+        }
+
+        rollNumberColumn.pop_back();
+        courseKeyColumn.pop_back();
+        internalMarksColumn.pop_back();
+        finalMarksColumn.pop_back();
+        gradeColumn.pop_back();
+        dateColumn.pop_back();
+        submittedColumn.pop_back();
+        sourceColumn.pop_back();
+        rowOfHandle[assessment->getHandle()] = NO_ROW;
+    }
+
+    void AssessmentColumns::rebuild(const EntityArena<Assessment>& assessments) {
+        clear();
+        const size_t rows = assessments.size();
+        rollNumberColumn.reserve(rows);
+        courseKeyColumn.reserve(rows);
+        internalMarksColumn.reserve(rows);
+        finalMarksColumn.reserve(rows);
+        gradeColumn.reserve(rows);
+        dateColumn.reserve(rows);
+        submittedColumn.reserve(rows);
+        sourceColumn.reserve(rows);
+        rowOfHandle.assign(assessments.capacity(), NO_ROW);
+
+        for (Assessment* assessment : assessments) {
+            track(assessment);
+        }
+    }
+
+    void AssessmentColumns::clear() {
+        // Unbind first so later edits or destruction don't reach back into the emptied columns
+        for (Assessment* assessment : sourceColumn) {
+            assessment->setColumns(nullptr);
+        }
+        rollNumberColumn.clear();
+        courseKeyColumn.clear();
+        internalMarksColumn.clear();
+        finalMarksColumn.clear();
+        gradeColumn.clear();
+        dateColumn.clear();
+        submittedColumn.clear();
+        sourceColumn.clear();
+        rowOfHandle.clear();
+    }
+
+    // === SCANS ===
+    size_t AssessmentColumns::countForStudent(int rollNumber) const {
+        size_t matches = 0;
+        for (int32_t roll : rollNumberColumn) {
+            matches += (roll == rollNumber);
+        }
+        return matches;
+    }
+
+    size_t AssessmentColumns::countForCourse(SymbolKey courseKey) const {
+        size_t matches = 0;
+        for (SymbolKey key : courseKeyColumn) {
+            matches += (key == courseKey);
+        }
+        return matches;
+    }
+
+    size_t AssessmentColumns::countFor(int rollNumber, SymbolKey courseKey) const {
+        size_t matches = 0;
+        const size_t rows = size();
+        for (size_t row = 0; row < rows; ++row) {
+            matches += (rollNumberColumn[row] == rollNumber) & (courseKeyColumn[row] == courseKey);
+        }
+        return matches;
+    }
+
+    vector<Assessment*> AssessmentColumns::selectForStudent(int rollNumber) const {
+        vector<Assessment*> result;
+        forEachRowWhere([&](size_t row) { return rollNumberColumn[row] == rollNumber; },
+                        [&](size_t row) { result.push_back(sourceColumn[row]); });
+        return result;
+    }
+
+    vector<Assessment*> AssessmentColumns::selectForCourse(SymbolKey courseKey) const {
+        vector<Assessment*> result;
+        forEachRowWhere([&](size_t row) { return courseKeyColumn[row] == courseKey; },
+                        [&](size_t row) { result.push_back(sourceColumn[row]); });
+        return result;
+    }
+
+    GradeAggregate AssessmentColumns::summarize() const {
+        GradeAggregate summary;
+        for (double grade : gradeColumn) {
+            summary.add(grade);
+        }
+        return summary;
+    }
+
+    size_t AssessmentColumns::countSubmitted() const {
+        size_t matches = 0;
+        for (uint8_t flag : submittedColumn) {
+            matches += flag;
+        }
+        return matches;
+    }
+
+    void AssessmentColumns::countLetterGrades(size_t (&counts)[GradeKernel::LETTER_COUNT]) const {
+        std::fill(std::begin(counts), std::end(counts), size_t{0});
+        
+        // Classify in fixed-size blocks so the codes stay in a small stack buffer
+        constexpr size_t BLOCK = 256;
+        uint8_t codes[BLOCK];
+        for (size_t start = 0; start < size(); start += BLOCK) {
+            const size_t rows = std::min(BLOCK, size() - start);
+            GradeKernel::classify(gradeColumn.data() + start, nullptr, codes, rows);
+            for (size_t i = 0; i < rows; ++i) {
+                counts[codes[i]]++;
+            }
+        }
+    }
+
+    StudentScoreGroups AssessmentColumns::groupGradesByStudent() const {
+        vector<uint32_t> order(size());
+        for (uint32_t row = 0; row < order.size(); ++row) order[row] = row;
+        std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+            if (rollNumberColumn[a] != rollNumberColumn[b]) return rollNumberColumn[a] < rollNumberColumn[b];
+            return courseKeyColumn[a] < courseKeyColumn[b];
+        });
+
+        StudentScoreGroups groups;
+        groups.grades.reserve(size());
+        groups.offsets.push_back(0);
+        for (uint32_t row : order) {
+            if (groups.rollNumbers.empty() || groups.rollNumbers.back() != rollNumberColumn[row] ||
+                groups.courseKeys.back() != courseKeyColumn[row]) {
+                if (!groups.rollNumbers.empty()) {
+                    groups.offsets.push_back(static_cast<uint32_t>(groups.grades.size()));
+                }
+                groups.rollNumbers.push_back(rollNumberColumn[row]);
+                groups.courseKeys.push_back(courseKeyColumn[row]);
+            }
+            groups.grades.push_back(gradeColumn[row]);
+        }
+        if (!groups.rollNumbers.empty()) {
+            groups.offsets.push_back(static_cast<uint32_t>(groups.grades.size()));
+        }
+        return groups;
+    }
+
+    // === RE-GRADING ===
+    size_t AssessmentColumns::regrade(SymbolKey courseKey, double internalWeight, double finalWeight) {
+        // The kernel runs over whole blocks, other courses' rows included: a multiply-add per row
+        // costs less than gathering the course's rows into scratch first
+        constexpr size_t BLOCK = 256;
+        double grades[BLOCK];
+        size_t moved = 0;
+        for (size_t start = 0; start < size(); start += BLOCK) {
+            const size_t rows = std::min(BLOCK, size() - start);
+            GradeKernel::weightedGrades(internalMarksColumn.data() + start, finalMarksColumn.data() + start,
+                                        grades, rows, internalWeight, finalWeight);
+            for (size_t i = 0; i < rows; ++i) {
+                const size_t row = start + i;
+                if (courseKeyColumn[row] != courseKey || gradeColumn[row] == grades[i]) continue;
+                const double oldGrade = gradeColumn[row];
+                gradeColumn[row] = grades[i];
+                sourceColumn[row]->applyRegrade(oldGrade, grades[i]);   // Refreshes this row too; no rows move
+                moved++;
+            }
+        }
+        return moved;
+    }
+}
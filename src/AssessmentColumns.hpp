@@ -0,0 +1,121 @@
+#pragma once
+
+#include "common.hpp"
+#include "SymbolTable.hpp"
+#include "EntityArena.hpp"
+#include "GradeAggregate.hpp"
+#include "GradeKernel.hpp"
+#include "GradeCalculator.hpp"
+#include "Date.hpp"
+
+USING_STD_COLUMNS
+
+namespace PokenoSouth {
+    class Assessment;
+
+    // Grades grouped per (student, course), ready for GradeCalculator::calculateGrades()
+    struct StudentScoreGroups {
+        vector<int32_t> rollNumbers;   // One per group; groups ascend by roll number, then course key
+        vector<SymbolKey> courseKeys;  // One per group
+        vector<uint32_t> offsets;      // rollNumbers.size() + 1 entries into 'grades'
+        vector<double> grades;
+
+        size_t size() const { return rollNumbers.size(); }
+        ScoreBatch batch() const { return {grades.data(), nullptr, offsets.data(), rollNumbers.size()}; }
+    };
+
+    /**
+     * AssessmentColumns for Pokeno South Primary School
+     * Column-wise (struct-of-arrays) mirror of the assessment arena for scans and aggregations
+     *
+     * Key Features:
+     * - One contiguous array per field: roll number, course key, internal marks, final marks,
+     *   weighted grade, date (day number) and submitted flag, so a filter or sum streams
+     *   through dense memory instead of chasing Assessment pointers and their string members
+     * - Rows are packed: untrack() moves the last row into the hole, so [0, size()) is always live
+     *   and scans need no liveness test; row order is therefore unspecified
+     * - Kept in step by the assessments themselves: track() binds an Assessment to its row,
+     *   Assessment::markModified() rewrites the row, and ~Assessment() removes it
+     * - source(row) maps a row back to its Assessment for the few results that need the object
+     * - Whole-column grade work (regrade, letter histogram) goes through GradeKernel; what-if
+     *   re-grading is GradeSimulation's job, on its own snapshot of these columns
+     *
+     * Either may be destroyed first: each side unbinds the other (System still declares it before the arena).
+     */
+    class AssessmentColumns {
+    private:
+        static constexpr uint32_t NO_ROW = UINT32_MAX;
+
+        vector<int32_t> rollNumberColumn;
+        vector<SymbolKey> courseKeyColumn;
+        vector<double> internalMarksColumn;
+        vector<double> finalMarksColumn;
+        vector<double> gradeColumn;
+        vector<Date> dateColumn;                 // 4-byte day numbers; compare and subtract as integers
+        vector<uint8_t> submittedColumn;         // 1 if submitted
+        vector<Assessment*> sourceColumn;
+
+        vector<uint32_t> rowOfHandle;            // Indexed by EntityHandle; NO_ROW if untracked
+
+        void writeRow(size_t row, const Assessment& assessment);
+        uint32_t rowOf(const Assessment* assessment) const;   // NO_ROW unless this row is that object
+
+    public:
+        AssessmentColumns() = default;
+        ~AssessmentColumns() { clear(); }   // Unbinds survivors so their destructors don't call back
+        AssessmentColumns(const AssessmentColumns&) = delete;             // Assessments point back at us
+        AssessmentColumns& operator=(const AssessmentColumns&) = delete;
+
+        // === SYNCHRONISATION ===
+        void track(Assessment* assessment);                 // Append (or refresh) a row and bind it
+        void refresh(const Assessment& assessment);         // Re-read a tracked assessment's fields
+        void untrack(const Assessment* assessment);         // No-op if not tracked
+        void rebuild(const EntityArena<Assessment>& assessments);
+        void clear();
+
+        size_t size() const { return sourceColumn.size(); }
+        bool empty() const { return sourceColumn.empty(); }
+
+        // === COLUMNS (row-aligned, size() entries each) ===
+        const vector<int32_t>& rollNumbers() const { return rollNumberColumn; }
+        const vector<SymbolKey>& courseKeys() const { return courseKeyColumn; }
+        const vector<double>& internalMarks() const { return internalMarksColumn; }
+        const vector<double>& finalMarks() const { return finalMarksColumn; }
+        const vector<double>& grades() const { return gradeColumn; }
+        const vector<Date>& dates() const { return dateColumn; }
+        const vector<uint8_t>& submitted() const { return submittedColumn; }
+        Assessment* source(size_t row) const { return sourceColumn[row]; }
+
+        // === SCANS ===
+        size_t countForStudent(int rollNumber) const;
+        size_t countForCourse(SymbolKey courseKey) const;
+        size_t countFor(int rollNumber, SymbolKey courseKey) const;
+        vector<Assessment*> selectForStudent(int rollNumber) const;
+        vector<Assessment*> selectForCourse(SymbolKey courseKey) const;
+
+        GradeAggregate summarize() const;                          // All rows
+        size_t countSubmitted() const;
+        
+        // Letter-grade histogram, indexed by GradeKernel letter code (A+ first)
+        void countLetterGrades(size_t (&counts)[GradeKernel::LETTER_COUNT]) const;
+
+        // Gathers the grade column into one contiguous run per (student, course) (CSR layout),
+        // keyed by the roll-number and course-key columns, so no ids are copied or compared as strings
+        StudentScoreGroups groupGradesByStudent() const;
+
+        // === RE-GRADING ===
+        // Re-weights one course's rows after its grading policy changed: GradeKernel sweeps the mark
+        // columns, and each grade that moved is written to the grade column and to its Assessment's
+        // cache, whose owner is told as for a mark edit. Returns how many grades moved
+        size_t regrade(SymbolKey courseKey, double internalWeight, double finalWeight);
+
+        // Calls visitor(row) for every row whose index satisfies predicate(row)
+        template <typename Predicate, typename Visitor>
+        void forEachRowWhere(Predicate&& predicate, Visitor&& visitor) const {
+            const size_t rows = size();
+            for (size_t row = 0; row < rows; ++row) {
+                if (predicate(row)) visitor(row);
+            }
+        }
+    };
+}
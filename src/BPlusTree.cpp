@@ -0,0 +1,725 @@
+#include "BPlusTree.hpp"
+#include "Crc32c.hpp"
+
+// Durable commits need fsync, which iostreams do not expose; other platforms get flush() only
+#if defined(__unix__) || defined(__APPLE__)
+#define POKENO_FSYNC 1
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace PokenoSouth {
+
+    namespace {
+        using PageId = BPlusTree::PageId;
+        constexpr size_t PAGE_SIZE = BPlusTree::PAGE_SIZE;
+
+        // Every page: CRC32C of bytes [4, PAGE_SIZE) | type (u8) | reserved (u8) | entry count (u16)
+        //   leaf:     (key length u16, cell length u16, key, cell) x count
+        //   branch:   first child u32, then (key length u16, key, child u32) x count
+        //   overflow: count = bytes used, then next page u32 (NO_PAGE at the end), then data
+        //   meta:     MAGIC, page size u32, txn u64, root u32, page count u32, live pages u32, entries u64
+        // Pages 0 and 1 hold the meta pages of alternate commits; the higher valid txn wins.
+        constexpr size_t HEADER_SIZE = 8;
+        constexpr size_t OVERFLOW_HEADER_SIZE = HEADER_SIZE + 4;
+        constexpr size_t OVERFLOW_CAPACITY = PAGE_SIZE - OVERFLOW_HEADER_SIZE;
+        constexpr uint8_t PAGE_LEAF = 1;
+        constexpr uint8_t PAGE_BRANCH = 2;
+        constexpr uint8_t PAGE_OVERFLOW = 3;
+        constexpr uint8_t PAGE_META = 4;
+        constexpr PageId META_PAGES = 2;
+        constexpr PageId NO_PAGE = 0;                 // Page 0 is a meta page, so never a chain link
+        constexpr string_view MAGIC = "PSBTREE1";
+
+        // Leaf cells: CELL_INLINE + value, or CELL_OVERFLOW + first page (u32) + value length (u32)
+        constexpr char CELL_INLINE = 0;
+        constexpr char CELL_OVERFLOW = 1;
+
+        constexpr PageId COMPACT_MIN_PAGES = 64;      // Small files are not worth rewriting
+        constexpr double BULK_FILL = 0.9;             // Leaves some room so the next inserts do not split at once
+
+        template <typename T>
+        T loadAt(const char* at) {
+            T value;
+            memcpy(&value, at, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void storeAt(char* at, T value) {
+            memcpy(at, &value, sizeof(T));
+        }
+
+        uint32_t pageChecksum(const char* page) {
+            return Crc32c::compute(string_view(page + 4, PAGE_SIZE - 4));
+        }
+
+        PageId chainLength(size_t valueLength) {
+            return static_cast<PageId>((valueLength + OVERFLOW_CAPACITY - 1) / OVERFLOW_CAPACITY);
+        }
+
+        void writeRawPage(fstream& stream, PageId id, char* page) {
+            storeAt<uint32_t>(page, pageChecksum(page));
+            stream.seekp(static_cast<std::streamoff>(id) * static_cast<std::streamoff>(PAGE_SIZE));
+            stream.write(page, PAGE_SIZE);
+            if (!stream) throw runtime_error("cannot write page " + to_string(id));
+        }
+
+        // Writes 'value' to a chain of overflow pages starting at 'next' and returns the cell pointing at it
+        string makeCellIn(fstream& stream, PageId& next, string_view value) {
+            string cell;
+            if (value.size() <= BPlusTree::MAX_INLINE_VALUE) {
+                cell.reserve(1 + value.size());
+                cell.push_back(CELL_INLINE);
+                cell.append(value.data(), value.size());
+                return cell;
+            }
+
+            const PageId first = next;
+            char page[PAGE_SIZE];
+            for (size_t offset = 0; offset < value.size();) {
+                const size_t chunk = std::min(OVERFLOW_CAPACITY, value.size() - offset);
+                memset(page, 0, PAGE_SIZE);
+                page[4] = static_cast<char>(PAGE_OVERFLOW);
+                storeAt<uint16_t>(page + 6, static_cast<uint16_t>(chunk));
+                const PageId id = next++;
+                storeAt<uint32_t>(page + HEADER_SIZE, offset + chunk < value.size() ? next : NO_PAGE);
+                memcpy(page + OVERFLOW_HEADER_SIZE, value.data() + offset, chunk);
+                writeRawPage(stream, id, page);
+                offset += chunk;
+            }
+
+            cell.push_back(CELL_OVERFLOW);
+            char reference[8];
+            storeAt<uint32_t>(reference, first);
+            storeAt<uint32_t>(reference + 4, static_cast<uint32_t>(value.size()));
+            cell.append(reference, sizeof(reference));
+            return cell;
+        }
+
+        // Forces the file's written data to the device. fsync covers every descriptor of the
+        // file, so a separate one works alongside the fstream (which must be flushed first)
+        void syncFile(const string& path) {
+#ifdef POKENO_FSYNC
+            const int descriptor = ::open(path.c_str(), O_RDONLY);
+            if (descriptor < 0) throw runtime_error("cannot open " + path + " to sync it");
+            const bool synced = ::fsync(descriptor) == 0;
+            ::close(descriptor);
+            if (!synced) throw runtime_error("cannot sync " + path);
+#else
+            (void)path;
+#endif
+        }
+
+        // Makes a rename in the directory holding 'path' durable
+        void syncDirectory(const string& path) {
+#ifdef POKENO_FSYNC
+            const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+            const string directory = parent.empty() ? "." : parent.string();
+            const int descriptor = ::open(directory.c_str(), O_RDONLY);
+            if (descriptor < 0) throw runtime_error("cannot open directory " + directory + " to sync it");
+            const bool synced = ::fsync(descriptor) == 0;
+            ::close(descriptor);
+            if (!synced) throw runtime_error("cannot sync directory " + directory);
+#else
+            (void)path;
+#endif
+        }
+
+        bool keyLess(const string& entry, string_view key) { return string_view(entry) < key; }
+        bool keyGreater(string_view key, const string& entry) { return key < string_view(entry); }
+    }
+
+    BPlusTree::BPlusTree(string path, size_t cachePages)
+        : path(std::move(path)), cacheCapacity(std::max<size_t>(cachePages, 16)) {
+        open();
+    }
+
+    // === PAGES ===
+    void BPlusTree::open() {
+        file.open(path, ios::in | ios::out | ios::binary);
+        if (!file.is_open()) {
+            ofstream create(path, ios::binary);
+            if (!create) throw runtime_error("cannot create " + path);
+            create.close();
+            file.open(path, ios::in | ios::out | ios::binary);
+            if (!file.is_open()) throw runtime_error("cannot open " + path);
+        }
+
+        file.seekg(0, ios::end);
+        const std::streamoff size = file.tellg();
+        Meta first;
+        Meta second;
+        const bool firstValid = readMeta(0, first);
+        const bool secondValid = readMeta(1, second);
+        if (!firstValid && !secondValid) {
+            // Every commit leaves a root page after the two meta pages, so a file no longer than
+            // those holds nothing: it is new, or its creation stopped before the first commit
+            if (size > static_cast<std::streamoff>(META_PAGES * PAGE_SIZE)) {
+                throw runtime_error(path + " is not a B+tree file, or both of its meta pages are damaged");
+            }
+            // Two blank meta slots, then an empty root leaf as commit 1
+            char page[PAGE_SIZE] = {};
+            file.clear();
+            writeRawPage(file, 0, page);
+            writeRawPage(file, 1, page);
+            committed = Meta{0, NO_PAGE, META_PAGES, 0, 0};
+            rollback();
+            root = allocate(Node{});
+            commit();
+            return;
+        }
+        committed = (firstValid && (!secondValid || first.txn > second.txn)) ? first : second;
+        rollback();
+    }
+
+    void BPlusTree::readPage(PageId id, char* page) const {
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(id) * static_cast<std::streamoff>(PAGE_SIZE));
+        file.read(page, PAGE_SIZE);
+        if (!file || loadAt<uint32_t>(page) != pageChecksum(page)) {
+            file.clear();
+            throw runtime_error("damaged page " + to_string(id) + " in " + path);
+        }
+    }
+
+    void BPlusTree::writePage(PageId id, char* page) {
+        file.clear();
+        writeRawPage(file, id, page);
+        stats.pagesWritten++;
+    }
+
+    void BPlusTree::encodeMeta(const Meta& meta, char* page) {
+        memset(page, 0, PAGE_SIZE);
+        page[4] = static_cast<char>(PAGE_META);
+        char* at = page + HEADER_SIZE;
+        memcpy(at, MAGIC.data(), MAGIC.size());
+        at += MAGIC.size();
+        storeAt<uint32_t>(at, static_cast<uint32_t>(PAGE_SIZE));
+        storeAt<uint64_t>(at + 4, meta.txn);
+        storeAt<uint32_t>(at + 12, meta.root);
+        storeAt<uint32_t>(at + 16, meta.pageCount);
+        storeAt<uint32_t>(at + 20, meta.livePages);
+        storeAt<uint64_t>(at + 24, meta.entries);
+    }
+
+    bool BPlusTree::readMeta(PageId slot, Meta& meta) const {
+        char page[PAGE_SIZE];
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(slot) * static_cast<std::streamoff>(PAGE_SIZE));
+        file.read(page, PAGE_SIZE);
+        if (!file) {
+            file.clear();
+            return false;
+        }
+        const char* at = page + HEADER_SIZE;
+        if (loadAt<uint32_t>(page) != pageChecksum(page) || static_cast<uint8_t>(page[4]) != PAGE_META ||
+            string_view(at, MAGIC.size()) != MAGIC || loadAt<uint32_t>(at + MAGIC.size()) != PAGE_SIZE) {
+            return false;
+        }
+        at += MAGIC.size();
+        meta.txn = loadAt<uint64_t>(at + 4);
+        meta.root = loadAt<uint32_t>(at + 12);
+        meta.pageCount = loadAt<uint32_t>(at + 16);
+        meta.livePages = loadAt<uint32_t>(at + 20);
+        meta.entries = loadAt<uint64_t>(at + 24);
+        return true;
+    }
+
+    void BPlusTree::writeMeta(const Meta& meta) {
+        char page[PAGE_SIZE];
+        encodeMeta(meta, page);
+        writePage(static_cast<PageId>(meta.txn % META_PAGES), page);
+    }
+
+    BPlusTree::NodePtr BPlusTree::load(PageId id) const {
+        auto pending = dirty.find(id);
+        if (pending != dirty.end()) {
+            return NodePtr(NodePtr(), &pending->second);   // Non-owning: dirty nodes live until commit/rollback
+        }
+
+        auto cached = cacheIndex.find(id);
+        if (cached != cacheIndex.end()) {
+            stats.cacheHits++;
+            cache.splice(cache.begin(), cache, cached->second);
+            return cached->second->second;
+        }
+
+        stats.cacheMisses++;
+        char page[PAGE_SIZE];
+        readPage(id, page);
+        NodePtr node = make_shared<const Node>(decodeNode(page));
+        remember(id, node);
+        return node;
+    }
+
+    void BPlusTree::remember(PageId id, NodePtr node) const {
+        cache.emplace_front(id, std::move(node));
+        cacheIndex[id] = cache.begin();
+        if (cache.size() > cacheCapacity) {
+            cacheIndex.erase(cache.back().first);
+            cache.pop_back();
+        }
+    }
+
+    BPlusTree::Node* BPlusTree::mutableNode(PageId& id) {
+        auto pending = dirty.find(id);
+        if (pending != dirty.end()) return &pending->second;
+
+        Node copy = *load(id);
+        release(id);
+        id = allocate(std::move(copy));
+        return &dirty.at(id);
+    }
+
+    PageId BPlusTree::allocate(Node node) {
+        const PageId id = nextPage++;
+        livePages++;
+        dirty.emplace(id, std::move(node));
+        return id;
+    }
+
+    void BPlusTree::release(PageId id) {
+        livePages--;
+        dirty.erase(id);   // An uncommitted page is simply never written
+    }
+
+    // === VALUES ===
+    string BPlusTree::makeCell(string_view value) {
+        const PageId before = nextPage;
+        string cell = makeCellIn(file, nextPage, value);
+        livePages += nextPage - before;
+        stats.pagesWritten += nextPage - before;
+        return cell;
+    }
+
+    void BPlusTree::readCell(const string& cell, string& value) const {
+        if (cell.empty() || cell[0] == CELL_INLINE) {
+            value.assign(cell.data() + (cell.empty() ? 0 : 1), cell.empty() ? 0 : cell.size() - 1);
+            return;
+        }
+
+        PageId next = loadAt<uint32_t>(cell.data() + 1);
+        const uint32_t length = loadAt<uint32_t>(cell.data() + 5);
+        value.clear();
+        value.reserve(length);
+        char page[PAGE_SIZE];
+        while (value.size() < length) {
+            if (next == NO_PAGE) throw runtime_error("broken overflow chain in " + path);
+            readPage(next, page);
+            const size_t used = loadAt<uint16_t>(page + 6);
+            if (static_cast<uint8_t>(page[4]) != PAGE_OVERFLOW || used > OVERFLOW_CAPACITY) {
+                throw runtime_error("damaged overflow page " + to_string(next) + " in " + path);
+            }
+            value.append(page + OVERFLOW_HEADER_SIZE, used);
+            next = loadAt<uint32_t>(page + HEADER_SIZE);
+        }
+    }
+
+    void BPlusTree::releaseCell(const string& cell) {
+        if (!cell.empty() && cell[0] == CELL_OVERFLOW) {
+            livePages -= chainLength(loadAt<uint32_t>(cell.data() + 5));
+        }
+    }
+
+    // === NODES ===
+    size_t BPlusTree::encodedSize(const Node& node) {
+        size_t size = HEADER_SIZE;
+        if (node.leaf) {
+            for (size_t i = 0; i < node.keys.size(); ++i) size += 4 + node.keys[i].size() + node.cells[i].size();
+        } else {
+            size += 4;
+            for (const string& key : node.keys) size += 2 + key.size() + 4;
+        }
+        return size;
+    }
+
+    void BPlusTree::encodeNode(const Node& node, char* page) {
+        memset(page, 0, PAGE_SIZE);
+        page[4] = static_cast<char>(node.leaf ? PAGE_LEAF : PAGE_BRANCH);
+        storeAt<uint16_t>(page + 6, static_cast<uint16_t>(node.keys.size()));
+        char* at = page + HEADER_SIZE;
+        if (node.leaf) {
+            for (size_t i = 0; i < node.keys.size(); ++i) {
+                storeAt<uint16_t>(at, static_cast<uint16_t>(node.keys[i].size()));
+                storeAt<uint16_t>(at + 2, static_cast<uint16_t>(node.cells[i].size()));
+                at += 4;
+                memcpy(at, node.keys[i].data(), node.keys[i].size());
+                at += node.keys[i].size();
+                memcpy(at, node.cells[i].data(), node.cells[i].size());
+                at += node.cells[i].size();
+            }
+        } else {
+            storeAt<uint32_t>(at, node.children[0]);
+            at += 4;
+            for (size_t i = 0; i < node.keys.size(); ++i) {
+                storeAt<uint16_t>(at, static_cast<uint16_t>(node.keys[i].size()));
+                at += 2;
+                memcpy(at, node.keys[i].data(), node.keys[i].size());
+                at += node.keys[i].size();
+                storeAt<uint32_t>(at, node.children[i + 1]);
+                at += 4;
+            }
+        }
+    }
+
+    BPlusTree::Node BPlusTree::decodeNode(const char* page) {
+        const uint8_t type = static_cast<uint8_t>(page[4]);
+        if (type != PAGE_LEAF && type != PAGE_BRANCH) throw runtime_error("B+tree page is not a tree node");
+
+        Node node;
+        node.leaf = (type == PAGE_LEAF);
+        const size_t count = loadAt<uint16_t>(page + 6);
+        const char* at = page + HEADER_SIZE;
+        const char* end = page + PAGE_SIZE;
+        auto need = [&](size_t length) {
+            if (static_cast<size_t>(end - at) < length) throw runtime_error("B+tree node overruns its page");
+        };
+
+        node.keys.reserve(count);
+        if (node.leaf) {
+            node.cells.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                need(4);
+                const size_t keyLength = loadAt<uint16_t>(at);
+                const size_t cellLength = loadAt<uint16_t>(at + 2);
+                at += 4;
+                need(keyLength + cellLength);
+                node.keys.emplace_back(at, keyLength);
+                at += keyLength;
+                node.cells.emplace_back(at, cellLength);
+                at += cellLength;
+            }
+        } else {
+            node.children.reserve(count + 1);
+            need(4);
+            node.children.push_back(loadAt<uint32_t>(at));
+            at += 4;
+            for (size_t i = 0; i < count; ++i) {
+                need(2);
+                const size_t keyLength = loadAt<uint16_t>(at);
+                at += 2;
+                need(keyLength + 4);
+                node.keys.emplace_back(at, keyLength);
+                at += keyLength;
+                node.children.push_back(loadAt<uint32_t>(at));
+                at += 4;
+            }
+        }
+        return node;
+    }
+
+    size_t BPlusTree::childIndex(const Node& node, string_view key) {
+        return static_cast<size_t>(upper_bound(node.keys.begin(), node.keys.end(), key, keyGreater) - node.keys.begin());
+    }
+
+    // === TREE OPERATIONS ===
+    bool BPlusTree::findCell(string_view key, string* cell) const {
+        NodePtr node = load(root);
+        while (!node->leaf) node = load(node->children[childIndex(*node, key)]);
+        auto it = lower_bound(node->keys.begin(), node->keys.end(), key, keyLess);
+        if (it == node->keys.end() || *it != key) return false;
+        if (cell) *cell = node->cells[static_cast<size_t>(it - node->keys.begin())];
+        return true;
+    }
+
+    BPlusTree::Split BPlusTree::splitNode(Node& node) {
+        // Split by bytes, not by count: keys and values vary in length
+        const size_t half = (encodedSize(node) - HEADER_SIZE) / 2;
+        Node right;
+        right.leaf = node.leaf;
+        string separator;
+
+        if (node.leaf) {
+            size_t middle = 0;
+            for (size_t used = 0; middle + 1 < node.keys.size() && used < half; ++middle) {
+                used += 4 + node.keys[middle].size() + node.cells[middle].size();
+            }
+            middle = std::max<size_t>(middle, 1);
+            right.keys.assign(std::make_move_iterator(node.keys.begin() + middle), std::make_move_iterator(node.keys.end()));
+            right.cells.assign(std::make_move_iterator(node.cells.begin() + middle), std::make_move_iterator(node.cells.end()));
+            node.keys.resize(middle);
+            node.cells.resize(middle);
+            separator = right.keys.front();
+        } else {
+            // The middle key moves up; each side keeps at least one key
+            size_t middle = 0;
+            for (size_t used = 0; middle + 2 < node.keys.size() && used < half; ++middle) {
+                used += 2 + node.keys[middle].size() + 4;
+            }
+            middle = std::max<size_t>(middle, 1);
+            separator = std::move(node.keys[middle]);
+            right.keys.assign(std::make_move_iterator(node.keys.begin() + middle + 1), std::make_move_iterator(node.keys.end()));
+            right.children.assign(node.children.begin() + middle + 1, node.children.end());
+            node.keys.resize(middle);
+            node.children.resize(middle + 1);
+        }
+
+        return Split{std::move(separator), allocate(std::move(right))};
+    }
+
+    bool BPlusTree::insertInto(PageId& id, string_view key, string& cell, Split& split) {
+        Node* node = mutableNode(id);
+
+        if (node->leaf) {
+            auto it = lower_bound(node->keys.begin(), node->keys.end(), key, keyLess);
+            const size_t position = static_cast<size_t>(it - node->keys.begin());
+            if (it != node->keys.end() && *it == key) {
+                releaseCell(node->cells[position]);
+                node->cells[position] = std::move(cell);
+            } else {
+                node->keys.insert(it, string(key));
+                node->cells.insert(node->cells.begin() + static_cast<std::ptrdiff_t>(position), std::move(cell));
+                entries++;
+            }
+        } else {
+            const size_t index = childIndex(*node, key);
+            PageId child = node->children[index];
+            Split childSplit;
+            const bool childSplitHappened = insertInto(child, key, cell, childSplit);
+            node->children[index] = child;
+            if (childSplitHappened) {
+                node->keys.insert(node->keys.begin() + static_cast<std::ptrdiff_t>(index), std::move(childSplit.key));
+                node->children.insert(node->children.begin() + static_cast<std::ptrdiff_t>(index) + 1, childSplit.right);
+            }
+        }
+
+        if (encodedSize(*node) <= PAGE_SIZE) return false;
+        split = splitNode(*node);
+        return true;
+    }
+
+    bool BPlusTree::eraseFrom(PageId& id, string_view key) {
+        Node* node = mutableNode(id);
+
+        if (node->leaf) {
+            auto it = lower_bound(node->keys.begin(), node->keys.end(), key, keyLess);
+            const size_t position = static_cast<size_t>(it - node->keys.begin());
+            releaseCell(node->cells[position]);
+            node->keys.erase(it);
+            node->cells.erase(node->cells.begin() + static_cast<std::ptrdiff_t>(position));
+            return node->keys.empty();
+        }
+
+        const size_t index = childIndex(*node, key);
+        PageId child = node->children[index];
+        if (eraseFrom(child, key)) {
+            release(child);
+            node->children.erase(node->children.begin() + static_cast<std::ptrdiff_t>(index));
+            if (!node->keys.empty()) {
+                node->keys.erase(node->keys.begin() + static_cast<std::ptrdiff_t>(index == 0 ? 0 : index - 1));
+            }
+            return node->children.empty();
+        }
+        node->children[index] = child;
+        return false;
+    }
+
+    bool BPlusTree::scanFrom(PageId id, string_view prefix,
+                             const function<bool(string_view, string_view)>& visit, string& value) const {
+        const NodePtr node = load(id);
+
+        if (node->leaf) {
+            for (auto it = lower_bound(node->keys.begin(), node->keys.end(), prefix, keyLess);
+                 it != node->keys.end(); ++it) {
+                if (it->compare(0, prefix.size(), prefix.data(), prefix.size()) != 0) return false;   // Past the range
+                readCell(node->cells[static_cast<size_t>(it - node->keys.begin())], value);
+                if (!visit(*it, value)) return false;
+            }
+            return true;
+        }
+
+        for (size_t index = childIndex(*node, prefix); index < node->children.size(); ++index) {
+            if (index > 0) {
+                const string& first = node->keys[index - 1];
+                if (first.compare(0, prefix.size(), prefix.data(), prefix.size()) != 0 && string_view(first) > prefix) {
+                    return false;
+                }
+            }
+            if (!scanFrom(node->children[index], prefix, visit, value)) return false;
+        }
+        return true;
+    }
+
+    // === READS ===
+    bool BPlusTree::get(string_view key, string& value) const {
+        string cell;
+        if (!findCell(key, &cell)) return false;
+        readCell(cell, value);
+        return true;
+    }
+
+    void BPlusTree::scan(string_view prefix, const function<bool(string_view key, string_view value)>& visit) const {
+        string value;
+        scanFrom(root, prefix, visit, value);
+    }
+
+    // === WRITES ===
+    void BPlusTree::put(string_view key, string_view value) {
+        if (key.size() > MAX_KEY_SIZE) {
+            throw length_error("B+tree key longer than " + to_string(MAX_KEY_SIZE) + " bytes");
+        }
+        string existing;
+        if (get(key, existing) && existing == value) return;   // Unchanged records cost no pages
+
+        string cell = makeCell(value);
+        Split split;
+        if (insertInto(root, key, cell, split)) {
+            Node parent;
+            parent.leaf = false;
+            parent.keys.push_back(std::move(split.key));
+            parent.children = {root, split.right};
+            root = allocate(std::move(parent));
+        }
+    }
+
+    bool BPlusTree::erase(string_view key) {
+        if (!contains(key)) return false;   // Nothing to copy
+        eraseFrom(root, key);
+        entries--;
+
+        // A branch root with a single child hands the root to it; one with none becomes an empty leaf
+        for (;;) {
+            const NodePtr top = load(root);
+            if (top->leaf || top->children.size() > 1) break;
+            const PageId onlyChild = top->children.empty() ? NO_PAGE : top->children[0];
+            release(root);
+            root = onlyChild != NO_PAGE ? onlyChild : allocate(Node{});
+        }
+        return true;
+    }
+
+    // === TRANSACTIONS ===
+    bool BPlusTree::hasUncommittedChanges() const {
+        return !dirty.empty() || root != committed.root || nextPage != committed.pageCount;
+    }
+
+    void BPlusTree::commit() {
+        if (!hasUncommittedChanges()) return;
+
+        // New pages first, in file order; nothing reachable from the current meta page changes
+        vector<PageId> ids;
+        ids.reserve(dirty.size());
+        for (const auto& entry : dirty) ids.push_back(entry.first);
+        sort(ids.begin(), ids.end());
+        char page[PAGE_SIZE];
+        for (PageId id : ids) {
+            encodeNode(dirty.at(id), page);
+            writePage(id, page);
+        }
+        file.flush();
+        if (!file) throw runtime_error("cannot flush " + path);
+        syncFile(path);   // The new pages must be on disk before any meta page names them
+
+        // Then the switch-over: the older meta slot now names the new root
+        const Meta meta{committed.txn + 1, root, nextPage, livePages, entries};
+        writeMeta(meta);
+        file.flush();
+        if (!file) throw runtime_error("cannot flush " + path);
+        syncFile(path);
+        committed = meta;
+
+        for (PageId id : ids) remember(id, make_shared<const Node>(std::move(dirty.at(id))));
+        dirty.clear();
+
+        if (committed.pageCount >= COMPACT_MIN_PAGES && committed.pageCount - META_PAGES > 2 * committed.livePages) {
+            compact();
+        }
+    }
+
+    void BPlusTree::rollback() {
+        dirty.clear();
+        root = committed.root;
+        nextPage = committed.pageCount;
+        livePages = committed.livePages;
+        entries = committed.entries;
+    }
+
+    void BPlusTree::compact() {
+        commit();
+        const string tempPath = path + ".compact";
+        Meta meta;
+        {
+            fstream out(tempPath, ios::in | ios::out | ios::binary | ios::trunc);
+            if (!out.is_open()) throw runtime_error("cannot create " + tempPath);
+            char page[PAGE_SIZE] = {};
+            writeRawPage(out, 0, page);
+            writeRawPage(out, 1, page);
+            PageId next = META_PAGES;
+            const size_t fillLimit = static_cast<size_t>(PAGE_SIZE * BULK_FILL);
+
+            // Leaves, packed in key order; each level records (first key, page) for the one above
+            vector<pair<string, PageId>> level;
+            Node leaf;
+            size_t used = HEADER_SIZE;
+            auto flushLeaf = [&]() {
+                encodeNode(leaf, page);
+                writeRawPage(out, next, page);
+                level.emplace_back(leaf.keys.empty() ? string() : leaf.keys.front(), next++);
+                leaf = Node{};
+                used = HEADER_SIZE;
+            };
+            scan("", [&](string_view key, string_view value) {
+                string cell = makeCellIn(out, next, value);
+                const size_t entrySize = 4 + key.size() + cell.size();
+                if (!leaf.keys.empty() && used + entrySize > fillLimit) flushLeaf();
+                leaf.keys.emplace_back(key);
+                leaf.cells.push_back(std::move(cell));
+                used += entrySize;
+                return true;
+            });
+            if (!leaf.keys.empty() || level.empty()) flushLeaf();
+
+            while (level.size() > 1) {
+                vector<pair<string, PageId>> parents;
+                Node branch;
+                string firstKey;
+                auto flushBranch = [&]() {
+                    encodeNode(branch, page);
+                    writeRawPage(out, next, page);
+                    parents.emplace_back(std::move(firstKey), next++);
+                    branch = Node{};
+                };
+                for (auto& [key, id] : level) {
+                    const size_t entrySize = 2 + key.size() + 4;
+                    if (!branch.children.empty() && used + entrySize > fillLimit) flushBranch();
+                    if (branch.children.empty()) {
+                        branch.leaf = false;
+                        firstKey = std::move(key);
+                        branch.children.push_back(id);
+                        used = HEADER_SIZE + 4;
+                        continue;
+                    }
+                    branch.keys.push_back(std::move(key));
+                    branch.children.push_back(id);
+                    used += entrySize;
+                }
+                flushBranch();
+                level = std::move(parents);
+            }
+
+            meta = Meta{committed.txn + 1, level.front().second, next, next - META_PAGES, entries};
+            encodeMeta(meta, page);
+            writeRawPage(out, static_cast<PageId>(meta.txn % META_PAGES), page);
+            out.flush();
+            if (!out) throw runtime_error("cannot write " + tempPath);
+        }
+        syncFile(tempPath);   // Complete on disk before it can replace the old file
+
+        file.close();
+        std::filesystem::rename(tempPath, path);
+        syncDirectory(path);
+        cache.clear();
+        cacheIndex.clear();
+        open();
+    }
+
+    BPlusTree::Stats BPlusTree::getStats() const {
+        Stats current = stats;
+        current.entries = entries;
+        current.filePages = nextPage;
+        current.livePages = livePages;
+        current.lastCommit = committed.txn;
+        return current;
+    }
+}
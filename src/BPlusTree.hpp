@@ -0,0 +1,147 @@
+#pragma once
+
+#include "common.hpp"
+#include "Usings.hpp"
+
+USING_STD_BPLUSTREE
+
+namespace PokenoSouth {
+    /**
+     * BPlusTree for Pokeno South Primary School
+     * Embedded, single-file, page-based ordered key-value store
+     *
+     * Key Features:
+     * - 4 KiB pages, each carrying a CRC32C. Keys compare as raw bytes, so big-endian
+     *   numbers sort numerically and a shared prefix groups related keys for scan()
+     * - Copy-on-write: committed pages are never overwritten. put()/erase() copy the
+     *   root-to-leaf path into fresh pages; commit() appends those and then writes the new
+     *   root into the older of two meta pages. A crash at any point leaves the previous
+     *   commit readable, and rollback() just forgets the copies
+     * - commit() fsyncs the new pages before writing the meta page and fsyncs again after it;
+     *   compact() syncs the rewritten file before renaming it into place, then the directory
+     * - A file that stopped before its first commit (no valid meta page, no page past them)
+     *   is treated as new rather than damaged
+     * - Decoded pages are kept in a bounded LRU cache. Committed pages are immutable, so
+     *   cached pages never go stale
+     * - Values longer than MAX_INLINE_VALUE live in chains of overflow pages
+     * - Superseded pages are not reused in place: once they outnumber the live ones,
+     *   commit() rewrites the live tree into a fresh, densely packed file (compact())
+     * - Nodes left underfull by erase() are not merged (empty ones are removed); compaction
+     *   repacks them
+     * - Throws runtime_error for I/O failures and damaged files, length_error for keys
+     *   longer than MAX_KEY_SIZE
+     */
+    class BPlusTree {
+    public:
+        using PageId = uint32_t;
+
+        static constexpr size_t PAGE_SIZE = 4096;
+        static constexpr size_t MAX_KEY_SIZE = 512;
+        static constexpr size_t MAX_INLINE_VALUE = 1024;
+        static constexpr size_t DEFAULT_CACHE_PAGES = 1024;   // 4 MiB of page data
+
+        struct Stats {
+            uint64_t entries = 0;
+            PageId filePages = 0;       // Including superseded pages awaiting compaction
+            PageId livePages = 0;
+            uint64_t lastCommit = 0;    // Transaction number; survives reopening and compaction
+            uint64_t pagesWritten = 0;  // By this instance
+            uint64_t cacheHits = 0;
+            uint64_t cacheMisses = 0;
+        };
+
+    private:
+        struct Node {
+            bool leaf = true;
+            vector<string> keys;
+            vector<string> cells;      // Leaf values: tag byte, then the value or its overflow chain
+            vector<PageId> children;   // Branch: keys.size() + 1 entries; keys[i] is the first key under children[i + 1]
+        };
+        using NodePtr = shared_ptr<const Node>;
+
+        struct Meta {
+            uint64_t txn = 0;
+            PageId root = 0;
+            PageId pageCount = 0;
+            PageId livePages = 0;
+            uint64_t entries = 0;
+        };
+
+        struct Split {
+            string key;
+            PageId right;
+        };
+
+        string path;
+        mutable fstream file;
+        Meta committed;
+
+        // Working state; equals 'committed' when there is nothing to commit
+        PageId root = 0;
+        PageId nextPage = 0;
+        PageId livePages = 0;
+        uint64_t entries = 0;
+        unordered_map<PageId, Node> dirty;   // Pages copied or created since the last commit
+
+        // Page cache (most recently used first)
+        size_t cacheCapacity;
+        mutable list<pair<PageId, NodePtr>> cache;
+        mutable unordered_map<PageId, list<pair<PageId, NodePtr>>::iterator> cacheIndex;
+        mutable Stats stats;
+
+        // Pages
+        void open();
+        void readPage(PageId id, char* page) const;
+        void writePage(PageId id, char* page);
+        bool readMeta(PageId slot, Meta& meta) const;
+        void writeMeta(const Meta& meta);
+        NodePtr load(PageId id) const;
+        void remember(PageId id, NodePtr node) const;
+        Node* mutableNode(PageId& id);
+        PageId allocate(Node node);
+        void release(PageId id);
+
+        // Values
+        string makeCell(string_view value);
+        void readCell(const string& cell, string& value) const;
+        void releaseCell(const string& cell);
+
+        // Tree operations
+        static size_t encodedSize(const Node& node);
+        static void encodeNode(const Node& node, char* page);
+        static Node decodeNode(const char* page);
+        static void encodeMeta(const Meta& meta, char* page);
+        static size_t childIndex(const Node& node, string_view key);
+        bool findCell(string_view key, string* cell) const;
+        Split splitNode(Node& node);
+        bool insertInto(PageId& id, string_view key, string& cell, Split& split);
+        bool eraseFrom(PageId& id, string_view key);
+        bool scanFrom(PageId id, string_view prefix,
+                      const function<bool(string_view, string_view)>& visit, string& value) const;
+
+    public:
+        explicit BPlusTree(string path, size_t cachePages = DEFAULT_CACHE_PAGES);
+        BPlusTree(const BPlusTree&) = delete;
+        BPlusTree& operator=(const BPlusTree&) = delete;
+
+        // === READS (see uncommitted changes) ===
+        bool get(string_view key, string& value) const;
+        bool contains(string_view key) const { return findCell(key, nullptr); }
+        // Entries whose key starts with 'prefix', in key order, until 'visit' returns false
+        void scan(string_view prefix, const function<bool(string_view key, string_view value)>& visit) const;
+
+        // === WRITES ===
+        void put(string_view key, string_view value);   // No-op if the key already holds 'value'
+        bool erase(string_view key);                    // False if the key was absent
+
+        // === TRANSACTIONS ===
+        bool hasUncommittedChanges() const;
+        void commit();
+        void rollback();
+        void compact();   // Commits first
+
+        uint64_t size() const { return entries; }
+        Stats getStats() const;
+        const string& getPath() const { return path; }
+    };
+}
@@ -0,0 +1,411 @@
+#include "BTreeStorage.hpp"
+#include "ByteCodec.hpp"
+
+namespace PokenoSouth {
+
+    namespace {
+        // Primary keys: 'S' + roll number (big-endian u32, so students sort numerically),
+        // 'C' + course ID, 'A' + assessment slot. Assessment IDs are not unique in saved data,
+        // so a slot is ID + '\0' + occurrence (big-endian u32, 0 for the first with that ID).
+        // Secondary keys carry empty values: 's' + roll + slot and 'c' + course ID + '\0' + slot.
+        // Values are ByteWriter records of every field except the key. A course record ends with its
+        // grading policy name; records written before that field existed end one field earlier.
+        constexpr char STUDENT = 'S';
+        constexpr char COURSE = 'C';
+        constexpr char ASSESSMENT = 'A';
+        constexpr char STUDENT_ASSESSMENT = 's';
+        constexpr char COURSE_ASSESSMENT = 'c';
+
+        string bigEndian(uint32_t value) {
+            const char bytes[4] = {static_cast<char>(value >> 24), static_cast<char>(value >> 16),
+                                   static_cast<char>(value >> 8), static_cast<char>(value)};
+            return string(bytes, sizeof(bytes));
+        }
+
+        uint32_t fromBigEndian(string_view bytes) {
+            if (bytes.size() != 4) throw runtime_error("malformed record key");
+            uint32_t value = 0;
+            for (char byte : bytes) value = value << 8 | static_cast<uint8_t>(byte);
+            return value;
+        }
+
+        string rollBytes(int rollNumber) { return bigEndian(static_cast<uint32_t>(rollNumber)); }
+
+        string assessmentSlot(string_view assessmentId, uint32_t occurrence) {
+            return string(assessmentId) + '\0' + bigEndian(occurrence);
+        }
+
+        string_view idOfSlot(string_view slot) { return slot.substr(0, slot.find('\0')); }
+
+        uint32_t occurrenceOfSlot(string_view slot) {
+            return fromBigEndian(slot.substr(slot.find('\0') + 1));
+        }
+
+        string studentKey(int rollNumber) { return STUDENT + rollBytes(rollNumber); }
+        string courseKey(string_view courseId) { return COURSE + string(courseId); }
+        string assessmentKey(string_view slot) { return ASSESSMENT + string(slot); }
+        string assessmentSlotsPrefix(string_view assessmentId) { return ASSESSMENT + string(assessmentId) + '\0'; }
+        string studentAssessmentPrefix(int rollNumber) { return STUDENT_ASSESSMENT + rollBytes(rollNumber); }
+        string courseAssessmentPrefix(string_view courseId) { return COURSE_ASSESSMENT + string(courseId) + '\0'; }
+
+        string encodeStudent(const Student& student) {
+            string record;
+            ByteWriter out(record);
+            out.putString(student.getFirstName());
+            out.putString(student.getLastName());
+            out.putDate(student.getDateOfBirth());
+            out.putString(student.getAddress());
+            out.putString(student.getContactEmail());
+            out.putString(student.getEmergencyContact());
+            out.putDate(student.getEnrollmentDate());
+            const auto enrolled = student.getEnrolledCourses();
+            out.put<uint32_t>(static_cast<uint32_t>(enrolled.size()));
+            for (const Course* course : enrolled) out.putString(course->getCourseId());
+            return record;
+        }
+
+        string encodeCourse(const Course& course) {
+            string record;
+            ByteWriter out(record);
+            out.putString(course.getCourseName());
+            out.put<int32_t>(course.getCredits());
+            out.putString(course.getDescription());
+            out.put<int32_t>(course.getDuration());
+            out.putString(course.getTeacher());
+            out.putDate(course.getStartDate());
+            out.putDate(course.getEndDate());
+            out.put<int32_t>(course.getMaxEnrollment());
+            out.put<uint8_t>(course.getIsActive() ? 1 : 0);
+            out.putString(course.getGradingPolicyName());
+            return record;
+        }
+
+        string encodeAssessment(const Assessment& assessment) {
+            string record;
+            ByteWriter out(record);
+            out.put<int32_t>(assessment.getStudentRollNumber());
+            out.putString(assessment.getCourseId());
+            out.put<double>(assessment.getInternalMarks());
+            out.put<double>(assessment.getFinalMarks());
+            out.putDate(assessment.getAssessmentDate());
+            out.putString(assessment.getAssessmentType());
+            out.put<uint8_t>(assessment.getIsSubmitted() ? 1 : 0);
+            out.putDate(assessment.getSubmissionDate());
+            out.putString(assessment.getRemarks());
+            out.put<uint8_t>(assessment.getOwner() ? 1 : 0);   // Linked to the student with its roll number
+            return record;
+        }
+    }
+
+    BTreeStorage::BTreeStorage(string path, string backupDirectory)
+        : path(std::move(path)), backupDirectory(std::move(backupDirectory)) {}
+
+    BPlusTree& BTreeStorage::open() {
+        if (!tree) {
+            const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+            if (!parent.empty()) std::filesystem::create_directories(parent);
+            tree = make_unique<BPlusTree>(path);
+        }
+        return *tree;
+    }
+
+    // Applies 'change' as one commit; a failure rolls the tree back to the previous commit
+    bool BTreeStorage::transact(const string& action, const function<void(BPlusTree&)>& change) {
+        clearError();
+        try {
+            BPlusTree& records = open();
+            try {
+                change(records);
+                records.commit();
+            } catch (...) {
+                records.rollback();
+                throw;
+            }
+            return true;
+        } catch (const exception& e) {
+            setError("Cannot " + action + " in " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    // === RECORDS ===
+    void BTreeStorage::putStudent(BPlusTree& tree, const Student& student) {
+        tree.put(studentKey(student.getRollNumber()), encodeStudent(student));
+    }
+
+    void BTreeStorage::putCourse(BPlusTree& tree, const Course& course) {
+        tree.put(courseKey(course.getCourseId()), encodeCourse(course));
+    }
+
+    void BTreeStorage::putAssessment(BPlusTree& tree, const string& slot, const string& record) {
+        const string key = assessmentKey(slot);
+        ByteReader fields(record);
+        const int rollNumber = fields.get<int32_t>();
+        const string courseId = fields.getString();
+
+        // A changed roll number or course moves the secondary keys
+        string previous;
+        if (tree.get(key, previous)) {
+            ByteReader in(previous);
+            const int previousRollNumber = in.get<int32_t>();
+            const string previousCourseId = in.getString();
+            if (previousRollNumber != rollNumber) tree.erase(studentAssessmentPrefix(previousRollNumber) + slot);
+            if (previousCourseId != courseId) tree.erase(courseAssessmentPrefix(previousCourseId) + slot);
+        }
+
+        tree.put(key, record);
+        tree.put(studentAssessmentPrefix(rollNumber) + slot, {});
+        tree.put(courseAssessmentPrefix(courseId) + slot, {});
+    }
+
+    void BTreeStorage::eraseAssessment(BPlusTree& tree, const string& slot) {
+        const string key = assessmentKey(slot);
+        string record;
+        if (!tree.get(key, record)) return;
+        ByteReader in(record);
+        const int rollNumber = in.get<int32_t>();
+        const string courseId = in.getString();
+        tree.erase(key);
+        tree.erase(studentAssessmentPrefix(rollNumber) + slot);
+        tree.erase(courseAssessmentPrefix(courseId) + slot);
+    }
+
+    // What follows 'prefix' in each matching key: the assessment slots a secondary key indexes
+    vector<string> BTreeStorage::scanSlots(const BPlusTree& tree, const string& prefix) {
+        vector<string> slots;
+        tree.scan(prefix, [&](string_view key, string_view) {
+            slots.emplace_back(key.substr(prefix.size()));
+            return true;
+        });
+        return slots;
+    }
+
+    // === STORAGE OPERATIONS ===
+    bool BTreeStorage::initialize() {
+        clearError();
+        try {
+            open();
+            return true;
+        } catch (const exception& e) {
+            setError("Cannot open " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    bool BTreeStorage::load(EntityArena<Student>& students,
+                            EntityArena<Course>& courses,
+                            EntityArena<Assessment>& assessments) {
+        clearError();
+        students.clear();
+        courses.clear();
+        assessments.clear();
+        if (!tree && !std::filesystem::exists(path)) return false;   // Nothing saved yet
+
+        try {
+            const BPlusTree& records = open();
+            if (records.size() == 0) return false;
+
+            unordered_map<string, Course*> courseById;
+            records.scan(string(1, COURSE), [&](string_view key, string_view value) {
+                ByteReader in(value);
+                const string courseId(key.substr(1));
+                string courseName = in.getString();
+                const int credits = in.get<int32_t>();
+                string description = in.getString();
+                const int duration = in.get<int32_t>();
+                string teacher = in.getString();
+                const Date startDate = in.getDate();
+                const Date endDate = in.getDate();
+                const int maxEnrollment = in.get<int32_t>();
+                const bool isActive = in.get<uint8_t>() != 0;
+                const string policyName = in.atEnd() ? GradingPolicyRegistry::DEFAULT_POLICY : in.getString();
+                if (!in.atEnd()) throw runtime_error("course record " + courseId + " has trailing data");
+                Course* course = courses.emplace(TRUSTED_INPUT, courseId, courseName, credits, description, duration,
+                                                 teacher, startDate, endDate, maxEnrollment, isActive);
+                course->setGradingPolicy(policyName);   // Before the assessments below are graded
+                courseById.emplace(courseId, course);
+                return true;
+            });
+
+            unordered_map<int, Student*> studentByRoll;
+            records.scan(string(1, STUDENT), [&](string_view key, string_view value) {
+                ByteReader in(value);
+                const int rollNumber = static_cast<int>(fromBigEndian(key.substr(1)));
+                string firstName = in.getString();
+                string lastName = in.getString();
+                const Date dateOfBirth = in.getDate();
+                string address = in.getString();
+                string contactEmail = in.getString();
+                string emergencyContact = in.getString();
+                const Date enrollmentDate = in.getDate();
+                Student* student = students.emplace(TRUSTED_INPUT, rollNumber, firstName, lastName, dateOfBirth,
+                                                    address, contactEmail, emergencyContact, enrollmentDate);
+                studentByRoll.emplace(rollNumber, student);
+
+                // Same restore rule as the CSV loader: saved enrollments are linked as-is
+                const uint32_t enrolledCount = in.get<uint32_t>();
+                for (uint32_t i = 0; i < enrolledCount; ++i) {
+                    auto course = courseById.find(in.getString());
+                    if (course != courseById.end() && student->attachCourse(course->second)) {
+                        course->second->attachStudent(student);
+                    }
+                }
+                if (!in.atEnd()) throw runtime_error("student record " + to_string(rollNumber) + " has trailing data");
+                return true;
+            });
+
+            records.scan(string(1, ASSESSMENT), [&](string_view key, string_view value) {
+                ByteReader in(value);
+                const string assessmentId(idOfSlot(key.substr(1)));
+                const int rollNumber = in.get<int32_t>();
+                string courseId = in.getString();
+                const double internalMarks = in.get<double>();
+                const double finalMarks = in.get<double>();
+                const Date assessmentDate = in.getDate();
+                string assessmentType = in.getString();
+                const bool isSubmitted = in.get<uint8_t>() != 0;
+                const Date submissionDate = in.getDate();
+                string remarks = in.getString();
+                const bool linked = in.get<uint8_t>() != 0;
+                if (!in.atEnd()) throw runtime_error("assessment record " + assessmentId + " has trailing data");
+                Assessment* assessment = assessments.emplace(TRUSTED_INPUT, assessmentId, rollNumber, courseId,
+                                                             internalMarks, finalMarks, assessmentDate,
+                                                             assessmentType, isSubmitted, submissionDate, remarks);
+                auto owner = studentByRoll.find(rollNumber);
+                if (linked && owner != studentByRoll.end()) owner->second->addAssessment(assessment);
+                return true;
+            });
+            return true;
+        } catch (const exception& e) {
+            students.clear();
+            courses.clear();
+            assessments.clear();
+            setError("Cannot load " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    bool BTreeStorage::save(const EntityArena<Student>& students,
+                            const EntityArena<Course>& courses,
+                            const EntityArena<Assessment>& assessments) {
+        return transact("save records", [&](BPlusTree& records) {
+            unordered_set<string> live;
+            live.reserve(courses.size() + students.size() + 3 * assessments.size());
+
+            for (const Course* course : courses) {
+                putCourse(records, *course);
+                live.insert(courseKey(course->getCourseId()));
+            }
+            for (const Student* student : students) {
+                putStudent(records, *student);
+                live.insert(studentKey(student->getRollNumber()));
+            }
+            unordered_map<string, uint32_t> occurrences;
+            for (const Assessment* assessment : assessments) {
+                const string slot = assessmentSlot(assessment->getAssessmentId(),
+                                                   occurrences[assessment->getAssessmentId()]++);
+                putAssessment(records, slot, encodeAssessment(*assessment));
+                live.insert(assessmentKey(slot));
+                live.insert(studentAssessmentPrefix(assessment->getStudentRollNumber()) + slot);
+                live.insert(courseAssessmentPrefix(assessment->getCourseId()) + slot);
+            }
+
+            // Whatever was not written above belongs to entities that no longer exist
+            vector<string> stale;
+            records.scan("", [&](string_view key, string_view) {
+                if (live.find(string(key)) == live.end()) stale.emplace_back(key);
+                return true;
+            });
+            for (const string& key : stale) records.erase(key);
+        });
+    }
+
+    bool BTreeStorage::backup() {
+        clearError();
+        if (!tree && !std::filesystem::exists(path)) return true;   // Nothing to keep yet
+        try {
+            open();   // Every change is committed, so the file on disk is complete
+            auto now = time(nullptr);
+            ostringstream timestamp;
+            timestamp << put_time(localtime(&now), "%Y%m%d_%H%M%S");
+            std::filesystem::create_directories(backupDirectory);
+            const string stem = std::filesystem::path(path).stem().string();
+            std::filesystem::copy_file(path, backupDirectory + stem + "_" + timestamp.str() + ".btree",
+                                       std::filesystem::copy_options::overwrite_existing);
+            return true;
+        } catch (const exception& e) {
+            setError("Cannot back up " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    // === RECORD-LEVEL API ===
+    bool BTreeStorage::saveStudent(const Student& student) {
+        return transact("save student " + to_string(student.getRollNumber()),
+                        [&](BPlusTree& records) { putStudent(records, student); });
+    }
+
+    bool BTreeStorage::saveCourse(const Course& course) {
+        return transact("save course " + course.getCourseId(),
+                        [&](BPlusTree& records) { putCourse(records, course); });
+    }
+
+    bool BTreeStorage::saveAssessment(const Assessment& assessment) {
+        return transact("save assessment " + assessment.getAssessmentId(), [&](BPlusTree& records) {
+            putAssessment(records, assessmentSlot(assessment.getAssessmentId(), 0), encodeAssessment(assessment));
+        });
+    }
+
+    bool BTreeStorage::removeStudent(int rollNumber) {
+        return transact("remove student " + to_string(rollNumber), [&](BPlusTree& records) {
+            for (const string& slot : scanSlots(records, studentAssessmentPrefix(rollNumber))) {
+                eraseAssessment(records, slot);
+            }
+            records.erase(studentKey(rollNumber));
+        });
+    }
+
+    bool BTreeStorage::removeCourse(const string& courseId) {
+        return transact("remove course " + courseId, [&](BPlusTree& records) {
+            for (const string& slot : scanSlots(records, courseAssessmentPrefix(courseId))) {
+                eraseAssessment(records, slot);
+            }
+            records.erase(courseKey(courseId));
+        });
+    }
+
+    bool BTreeStorage::removeAssessment(const string& assessmentId) {
+        return transact("remove assessment " + assessmentId, [&](BPlusTree& records) {
+            eraseAssessment(records, assessmentSlot(assessmentId, 0));
+
+            // Later duplicates move up a slot, so the first one left is again occurrence 0
+            const string prefix = assessmentSlotsPrefix(assessmentId);
+            vector<pair<string, string>> remaining;
+            records.scan(prefix, [&](string_view key, string_view record) {
+                remaining.emplace_back(key.substr(1), record);
+                return true;
+            });
+            for (size_t i = 0; i < remaining.size(); ++i) {
+                if (occurrenceOfSlot(remaining[i].first) == i) continue;
+                eraseAssessment(records, remaining[i].first);
+                putAssessment(records, assessmentSlot(assessmentId, static_cast<uint32_t>(i)), remaining[i].second);
+            }
+        });
+    }
+
+    vector<string> BTreeStorage::findAssessmentIds(int rollNumber) {
+        clearError();
+        try {
+            vector<string> ids = scanSlots(open(), studentAssessmentPrefix(rollNumber));
+            for (string& id : ids) id.resize(idOfSlot(id).size());
+            return ids;
+        } catch (const exception& e) {
+            setError("Cannot read " + path + ": " + e.what());
+            return {};
+        }
+    }
+
+    BPlusTree::Stats BTreeStorage::getStats() {
+        return open().getStats();
+    }
+}
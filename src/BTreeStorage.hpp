@@ -0,0 +1,72 @@
+#pragma once
+
+#include "StorageBackend.hpp"
+#include "BPlusTree.hpp"
+
+namespace PokenoSouth {
+    /**
+     * BTreeStorage for Pokeno South Primary School
+     * Entities as individual records in an embedded B+tree file (see BPlusTree)
+     *
+     * Key Features:
+     * - One record per entity, keyed by roll number, course ID or assessment ID, plus
+     *   secondary keys (student -> assessments, course -> assessments) whose prefix scans
+     *   find dependent records without reading everything
+     * - save() rewrites only the records that changed: unchanged ones cost no pages, so a
+     *   point update touches a few pages instead of the whole dataset
+     * - The record-level API (saveStudent(), removeCourse(), ...) commits one change at a
+     *   time; removals take the dependent assessments with them, as System's do. System
+     *   routes every single-entity edit through it, so save() is left with nothing to write
+     * - Assessment IDs may repeat in saved data, so each is stored with its occurrence; the
+     *   record-level calls address the first one, the one System's lookups find
+     * - Every change is a copy-on-write commit: a crash leaves the previous commit intact,
+     *   and records from checksummed pages load through the TrustedInput constructors
+     * - Enrollments are stored on the student record as course IDs; IDs of courses that no
+     *   longer exist are skipped on load, like the CSV loader does
+     */
+    class BTreeStorage : public StorageBackend {
+    private:
+        string path;
+        string backupDirectory;
+        unique_ptr<BPlusTree> tree;   // Opened on first use
+
+        BPlusTree& open();
+        bool transact(const string& action, const function<void(BPlusTree&)>& change);
+
+        static void putStudent(BPlusTree& tree, const Student& student);
+        static void putCourse(BPlusTree& tree, const Course& course);
+        static void putAssessment(BPlusTree& tree, const string& slot, const string& record);
+        static void eraseAssessment(BPlusTree& tree, const string& slot);
+        static vector<string> scanSlots(const BPlusTree& tree, const string& prefix);
+
+    public:
+        static constexpr const char* DEFAULT_PATH = "data/records.btree";
+        static constexpr const char* DEFAULT_BACKUP_DIRECTORY = "data/backups/";
+
+        explicit BTreeStorage(string path = DEFAULT_PATH,
+                              string backupDirectory = DEFAULT_BACKUP_DIRECTORY);
+
+        string name() const override { return "B+tree store"; }
+        bool initialize() override;
+        bool load(EntityArena<Student>& students,
+                  EntityArena<Course>& courses,
+                  EntityArena<Assessment>& assessments) override;
+        bool save(const EntityArena<Student>& students,
+                  const EntityArena<Course>& courses,
+                  const EntityArena<Assessment>& assessments) override;
+        bool backup() override;
+
+        // === RECORD-LEVEL API (one commit each; false with getLastError() on failure) ===
+        bool storesRecords() const override { return true; }
+        bool saveStudent(const Student& student) override;
+        bool saveCourse(const Course& course) override;
+        bool saveAssessment(const Assessment& assessment) override;
+        bool removeStudent(int rollNumber) override;               // With the student's assessments
+        bool removeCourse(const string& courseId) override;        // With the course's assessments
+        bool removeAssessment(const string& assessmentId) override;
+        vector<string> findAssessmentIds(int rollNumber);
+
+        BPlusTree::Stats getStats();
+        const string& getPath() const { return path; }
+    };
+}
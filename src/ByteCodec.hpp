@@ -0,0 +1,73 @@
+#pragma once
+
+#include "common.hpp"
+#include "Date.hpp"
+#include "Usings.hpp"
+
+USING_STD_BYTECODEC
+
+namespace PokenoSouth {
+    /**
+     * ByteWriter / ByteReader for Pokeno South Primary School
+     * Fixed-width binary encoding shared by the binary storage backends
+     *
+     * Key Features:
+     * - Numbers in native byte order, strings length-prefixed (u32), dates as their int32 day number
+     * - ByteReader never reads past its input: a short buffer throws runtime_error
+     *   instead of producing garbage
+     * - Header-only; both classes work on caller-owned buffers and allocate nothing themselves
+     *   beyond the strings they return
+     */
+    class ByteWriter {
+    private:
+        string& out;
+
+    public:
+        explicit ByteWriter(string& out) : out(out) {}
+
+        template <typename T>
+        void put(T value) {
+            static_assert(std::is_trivially_copyable<T>::value, "ByteWriter::put needs a plain value");
+            char bytes[sizeof(T)];
+            memcpy(bytes, &value, sizeof(T));
+            out.append(bytes, sizeof(T));
+        }
+        void putString(string_view text) {
+            put<uint32_t>(static_cast<uint32_t>(text.size()));
+            out.append(text.data(), text.size());
+        }
+        void putDate(Date date) { put<int32_t>(date.dayNumber()); }
+    };
+
+    class ByteReader {
+    private:
+        string_view in;
+        size_t position = 0;
+
+        void need(size_t length) const {
+            if (in.size() - position < length) throw runtime_error("binary data is truncated");
+        }
+
+    public:
+        explicit ByteReader(string_view in) : in(in) {}
+
+        template <typename T>
+        T get() {
+            static_assert(std::is_trivially_copyable<T>::value, "ByteReader::get needs a plain value");
+            need(sizeof(T));
+            T value;
+            memcpy(&value, in.data() + position, sizeof(T));
+            position += sizeof(T);
+            return value;
+        }
+        string getString() {
+            const uint32_t length = get<uint32_t>();
+            need(length);
+            string text(in.substr(position, length));
+            position += length;
+            return text;
+        }
+        Date getDate() { return Date::fromDayNumber(get<int32_t>()); }
+        bool atEnd() const { return position == in.size(); }
+    };
+}
@@ -0,0 +1,128 @@
+#include "CharClass.hpp"
+
+// Vector paths need per-function target attributes and __builtin_cpu_supports for runtime dispatch
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define POKENO_CHARCLASS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace PokenoSouth {
+
+    namespace {
+        using FindFn = size_t (*)(const uint8_t* table, const char* text, size_t length);
+
+        size_t findScalar(const uint8_t* table, const char* text, size_t length) {
+            for (size_t i = 0; i < length; ++i) {
+                const unsigned char c = static_cast<unsigned char>(text[i]);
+                if ((table[(c >> 7) * 16 + (c & 0x0F)] & (1u << ((c >> 4) & 7))) == 0) return i;
+            }
+            return string_view::npos;
+        }
+
+#ifdef POKENO_CHARCLASS_X86
+        // 0xFF in each byte of 'chunk' that is NOT a member. lowTable/highTable are the two 16-byte
+        // halves of the class table (bytes below/above 0x80); bitTable maps (high nibble & 7) -> bit.
+        __attribute__((target("ssse3")))
+        inline __m128i nonMembers(__m128i chunk, __m128i lowTable, __m128i highTable, __m128i bitTable) {
+            const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+            const __m128i lowNibbles = _mm_and_si128(chunk, nibbleMask);
+            const __m128i bitIndex = _mm_and_si128(_mm_srli_epi16(chunk, 4), _mm_set1_epi8(0x07));
+            const __m128i upperHalf = _mm_cmplt_epi8(chunk, _mm_setzero_si128());   // Bytes >= 0x80
+            const __m128i bits = _mm_or_si128(_mm_and_si128(upperHalf, _mm_shuffle_epi8(highTable, lowNibbles)),
+                                              _mm_andnot_si128(upperHalf, _mm_shuffle_epi8(lowTable, lowNibbles)));
+            const __m128i hit = _mm_and_si128(bits, _mm_shuffle_epi8(bitTable, bitIndex));
+            return _mm_cmpeq_epi8(hit, _mm_setzero_si128());
+        }
+
+        __attribute__((target("ssse3")))
+        size_t findSsse3(const uint8_t* table, const char* text, size_t length) {
+            if (length < 16) return findScalar(table, text, length);
+            const __m128i lowTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+            const __m128i highTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16));
+            const __m128i bitTable = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+            size_t i = 0;
+            for (;; i += 16) {
+                if (i + 16 > length) i = length - 16;   // Final chunk overlaps bytes already known good
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+                const int mask = _mm_movemask_epi8(nonMembers(chunk, lowTable, highTable, bitTable));
+                if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+                if (i + 16 == length) return string_view::npos;
+            }
+        }
+
+        __attribute__((target("avx2")))
+        size_t findAvx2(const uint8_t* table, const char* text, size_t length) {
+            if (length < 32) return findSsse3(table, text, length);
+            // vpshufb looks up within each 128-bit lane, so both lanes carry a copy of each table
+            const __m256i lowTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+            const __m256i highTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16)));
+            const __m256i bitTable = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                                      1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+            const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+            const __m256i bitIndexMask = _mm256_set1_epi8(0x07);
+            const __m256i zero = _mm256_setzero_si256();
+
+            size_t i = 0;
+            for (;; i += 32) {
+                if (i + 32 > length) i = length - 32;
+                const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+                const __m256i lowNibbles = _mm256_and_si256(chunk, nibbleMask);
+                const __m256i bitIndex = _mm256_and_si256(_mm256_srli_epi16(chunk, 4), bitIndexMask);
+                const __m256i upperHalf = _mm256_cmpgt_epi8(zero, chunk);
+                const __m256i bits = _mm256_blendv_epi8(_mm256_shuffle_epi8(lowTable, lowNibbles),
+                                                        _mm256_shuffle_epi8(highTable, lowNibbles), upperHalf);
+                const __m256i hit = _mm256_and_si256(bits, _mm256_shuffle_epi8(bitTable, bitIndex));
+                const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hit, zero)));
+                if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+                if (i + 32 == length) return string_view::npos;
+            }
+        }
+#endif
+
+        struct Dispatch {
+            FindFn find;
+            const char* name;
+        };
+
+        Dispatch pathNamed(string_view name) {
+#ifdef POKENO_CHARCLASS_X86
+            __builtin_cpu_init();
+            if (name == "avx2" && __builtin_cpu_supports("avx2")) return {findAvx2, "avx2"};
+            if (name == "ssse3" && __builtin_cpu_supports("ssse3")) return {findSsse3, "ssse3"};
+#endif
+            if (name == "scalar") return {findScalar, "scalar"};
+            return {nullptr, nullptr};
+        }
+
+        Dispatch choose() {
+#ifdef POKENO_CHARCLASS_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) return {findAvx2, "avx2"};
+            if (__builtin_cpu_supports("ssse3")) return {findSsse3, "ssse3"};
+#endif
+            return {findScalar, "scalar"};
+        }
+
+        const Dispatch& dispatch() {
+            static const Dispatch chosen = choose();
+            return chosen;
+        }
+    }
+
+    // === QUERIES ===
+    size_t CharClass::findFirstNotIn(string_view text) const {
+        return dispatch().find(table.data(), text.data(), text.size());
+    }
+
+    const char* CharClass::simdPath() {
+        return dispatch().name;
+    }
+
+    bool CharClass::findFirstNotInOn(string_view path, string_view text, size_t& position) const {
+        const Dispatch forced = pathNamed(path);
+        if (!forced.find) return false;
+        position = forced.find(table.data(), text.data(), text.size());
+        return true;
+    }
+}
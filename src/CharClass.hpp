@@ -0,0 +1,72 @@
+#pragma once
+
+#include "common.hpp"
+
+USING_STD_CHARCLASS
+
+namespace PokenoSouth {
+    /**
+     * CharClass for Pokeno South Primary School
+     * A set of byte values, checked against whole strings 16 or 32 bytes at a time
+     *
+     * Key Features:
+     * - The 256-bit membership mask is stored directly in nibble-lookup layout: table[half * 16 + low]
+     *   bit (high & 7) is set when byte (half << 7) | (high << 4) | low is a member. One shuffle per
+     *   table then classifies a full vector of bytes (pshufb), with no per-byte branches
+     * - findFirstNotIn()/containsAll() pick AVX2, SSSE3 or a scalar loop once, from what the CPU
+     *   supports at runtime (GCC/Clang on x86); other compilers and targets use the scalar loop.
+     *   All paths give identical answers
+     * - Classes are 32-byte values built at compile time or cheaply at runtime, and combine with |
+     */
+    class CharClass {
+    private:
+        array<uint8_t, 32> table{};
+
+        static constexpr size_t slot(unsigned char c) { return (c >> 7) * 16 + (c & 0x0F); }
+        static constexpr uint8_t bit(unsigned char c) { return static_cast<uint8_t>(1u << ((c >> 4) & 7)); }
+
+    public:
+        constexpr CharClass() = default;
+
+        // === CONSTRUCTION ===
+        constexpr CharClass& add(unsigned char c) {
+            table[slot(c)] |= bit(c);
+            return *this;
+        }
+        constexpr CharClass& addRange(unsigned char first, unsigned char last) {
+            for (unsigned c = first; c <= last; ++c) add(static_cast<unsigned char>(c));
+            return *this;
+        }
+        static constexpr CharClass of(string_view chars) {
+            CharClass result;
+            for (char c : chars) result.add(static_cast<unsigned char>(c));
+            return result;
+        }
+        constexpr CharClass operator|(const CharClass& other) const {
+            CharClass result = *this;
+            for (size_t i = 0; i < table.size(); ++i) result.table[i] |= other.table[i];
+            return result;
+        }
+
+        // Same sets as isalnum()/isdigit()/isalpha() in the C locale
+        static constexpr CharClass digits() { return CharClass().addRange('0', '9'); }
+        static constexpr CharClass letters() { return CharClass().addRange('a', 'z').addRange('A', 'Z'); }
+        static constexpr CharClass alnum() { return digits() | letters(); }
+        static constexpr CharClass printableASCII() { return CharClass().addRange(32, 126); }
+
+        // === QUERIES ===
+        constexpr bool contains(char c) const {
+            const unsigned char byte = static_cast<unsigned char>(c);
+            return (table[slot(byte)] & bit(byte)) != 0;
+        }
+
+        size_t findFirstNotIn(string_view text) const;   // string_view::npos if every byte is a member
+        bool containsAll(string_view text) const { return findFirstNotIn(text) == string_view::npos; }
+
+        static const char* simdPath();   // "avx2", "ssse3" or "scalar": what findFirstNotIn() uses here
+
+        // findFirstNotIn() forced onto one named path, so tests and benchmarks can compare them.
+        // Returns false, leaving 'position' alone, if this build or CPU cannot run that path
+        bool findFirstNotInOn(string_view path, string_view text, size_t& position) const;
+    };
+}
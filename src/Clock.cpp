@@ -0,0 +1,48 @@
+#include "Clock.hpp"
+
+namespace PokenoSouth {
+
+    // === CLOCK ===
+    const Clock& Clock::current() {
+        const Clock* clock = active.load(memory_order_acquire);
+        return clock ? *clock : SystemClock::shared();
+    }
+
+    // === SYSTEM CLOCK ===
+    Date SystemClock::currentDate() const {
+        const int64_t now = static_cast<int64_t>(system_clock::to_time_t(system_clock::now()));
+        // dayEnd is published last, so seeing a current window implies the matching day number
+        if (now < dayEnd.load(memory_order_acquire) && now >= dayStart.load(memory_order_relaxed)) {
+            return Date::fromDayNumber(dayNumber.load(memory_order_relaxed));
+        }
+        return refresh(now);
+    }
+
+    Date SystemClock::refresh(int64_t now) const {
+        const time_t nowTime = static_cast<time_t>(now);
+        tm local = *localtime(&nowTime);
+        const Date date = Date::fromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+
+        // Local midnight to the next local midnight; mktime normalises tm_mday overflow and DST
+        local.tm_hour = 0;
+        local.tm_min = 0;
+        local.tm_sec = 0;
+        local.tm_isdst = -1;
+        const int64_t start = static_cast<int64_t>(mktime(&local));
+        local.tm_mday += 1;
+        local.tm_isdst = -1;
+        const int64_t end = static_cast<int64_t>(mktime(&local));
+
+        // Concurrent refreshes compute identical values; a reader racing one sees the day either side
+        // of the rollover, which is as right as the wall clock it read
+        dayNumber.store(date.dayNumber(), memory_order_relaxed);
+        dayStart.store(start, memory_order_relaxed);
+        dayEnd.store(end, memory_order_release);
+        return date;
+    }
+
+    const SystemClock& SystemClock::shared() {
+        static const SystemClock clock;
+        return clock;
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "common.hpp"
+#include "Date.hpp"
+
+USING_STD_CLOCK
+
+namespace PokenoSouth {
+    /**
+     * Clock for Pokeno South Primary School
+     * Source of "today" for every date-dependent rule (enrollment windows, ages, late submissions)
+     *
+     * Key Features:
+     * - Clock::today() is what Date::today() returns; entities never read the wall clock directly
+     * - The default SystemClock caches the local day number and the [start, end) of that day, so a
+     *   call is one system_clock::now() and two compares; localtime() runs only on day rollover
+     *   (or if the wall clock is set back)
+     * - use() swaps in another clock process-wide, e.g. a FakeClock pinned to a date for tests and
+     *   simulations; ScopedClock restores the previous clock on scope exit
+     */
+    class Clock {
+    private:
+        static inline atomic<const Clock*> active{nullptr};   // nullptr = SystemClock::shared()
+
+    public:
+        virtual ~Clock() = default;
+        virtual Date currentDate() const = 0;
+
+        static Date today() { return current().currentDate(); }
+        static const Clock& current();
+
+        // Installs 'clock' (nullptr = system clock) and returns the one it replaces.
+        // The caller keeps 'clock' alive for as long as it is installed.
+        static const Clock* use(const Clock* clock) { return active.exchange(clock); }
+    };
+
+    // Local wall-clock date, cached per day
+    class SystemClock final : public Clock {
+    private:
+        // Seconds since the epoch bounding the cached day; refreshed together by refresh()
+        mutable atomic<int64_t> dayStart{0};
+        mutable atomic<int64_t> dayEnd{0};
+        mutable atomic<int32_t> dayNumber{0};
+
+        Date refresh(int64_t now) const;
+
+    public:
+        Date currentDate() const override;
+
+        static const SystemClock& shared();
+    };
+
+    // Stands still at a chosen date until moved
+    class FakeClock final : public Clock {
+    private:
+        atomic<int32_t> dayNumber;
+
+    public:
+        explicit FakeClock(Date date) : dayNumber(date.dayNumber()) {}
+
+        Date currentDate() const override { return Date::fromDayNumber(dayNumber.load(memory_order_relaxed)); }
+        void set(Date date) { dayNumber.store(date.dayNumber(), memory_order_relaxed); }
+        void advanceDays(int32_t days) { dayNumber.fetch_add(days, memory_order_relaxed); }
+    };
+
+    // Installs a clock for the lifetime of the guard
+    class ScopedClock {
+    private:
+        const Clock* previous;
+
+    public:
+        explicit ScopedClock(const Clock& clock) : previous(Clock::use(&clock)) {}
+        ~ScopedClock() { Clock::use(previous); }
+        ScopedClock(const ScopedClock&) = delete;
+        ScopedClock& operator=(const ScopedClock&) = delete;
+    };
+}
@@ -2,18 +2,23 @@
 
 namespace PokenoSouth {
 
+    // Course dates are optional: "" leaves the date unset
+    static Date parseCourseDate(const string& text, const char* which) {
+        Date date;
+        if (!text.empty() && !Date::tryParse(text, date)) {
+            throw invalid_argument(string("Invalid ") + which + " date format: must be a real date in YYYY-MM-DD format");
+        }
+        return date;
+    }
+
     // Constructor with core data
     Course::Course(const string& courseId,
                    const string& courseName,
                    int credits,
                    const string& description,
                    int duration)
-        : courseId(formatCourseId(courseId)) {
-        
-        // Validate course ID
-        if (!isValidCourseId(this->courseId)) {
-            throw invalid_argument("Invalid course ID format: must follow pattern like MATH101");
-        }
+        : courseKey(internCourseId(courseId)),
+          teacherKey(SymbolTable::teachers().intern("")) {
         
         // Validate and set course name
         if (!isValidCourseName(courseName)) {
@@ -41,8 +46,8 @@ namespace PokenoSouth {
         this->duration = duration;
         
         // Initialize defaults
-        this->startDate = "";
-        this->endDate = "";
+        this->startDate = Date();
+        this->endDate = Date();
         this->maxEnrollment = DEFAULT_MAX_ENROLLMENT;
         this->isActive = true;
         
@@ -57,11 +62,7 @@ namespace PokenoSouth {
                        const string& description,
                        int duration,
                        const string& teacher)
-            : courseId(formatCourseId(courseId)), teacher(teacher) {
-            // Validate course ID
-            if (!isValidCourseId(this->courseId)) {
-                throw invalid_argument("Invalid course ID format: must follow pattern like MATH101");
-            }
+            : courseKey(internCourseId(courseId)) {
             // Validate and set course name
             if (!isValidCourseName(courseName)) {
                 throw invalid_argument("Invalid course name: cannot be empty");
@@ -87,9 +88,10 @@ namespace PokenoSouth {
             if (teacher.empty()) {
                 throw invalid_argument("Teacher name cannot be empty");
             }
+            this->teacherKey = SymbolTable::teachers().intern(teacher);
             // Initialize defaults
-            this->startDate = "";
-            this->endDate = "";
+            this->startDate = Date();
+            this->endDate = Date();
             this->maxEnrollment = DEFAULT_MAX_ENROLLMENT;
             this->isActive = true;
             // Initialize empty enrollment with optimized capacity
@@ -108,21 +110,13 @@ namespace PokenoSouth {
                    int maxEnrollment)
         : Course(courseId, courseName, credits, description, duration) {
         
-        // Validate and set start date
-        if (!startDate.empty() && !Common::isValidDate(startDate)) {
-            throw invalid_argument("Invalid start date format: must be YYYY-MM-DD");
-        }
-        this->startDate = startDate;
-        
-        // Validate and set end date
-        if (!endDate.empty() && !Common::isValidDate(endDate)) {
-            throw invalid_argument("Invalid end date format: must be YYYY-MM-DD");
-        }
-        this->endDate = endDate;
+        // Validate and set start and end dates
+        this->startDate = parseCourseDate(startDate, "start");
+        this->endDate = parseCourseDate(endDate, "end");
         
         // Validate date sequence
-        if (!startDate.empty() && !endDate.empty()) {
-            if (startDate >= endDate) {  // Simple string comparison for dates in YYYY-MM-DD format
+        if (!this->startDate.empty() && !this->endDate.empty()) {
+            if (this->startDate >= this->endDate) {
                 throw invalid_argument("End date must be after start date");
             }
         }
@@ -146,19 +140,12 @@ namespace PokenoSouth {
                        int maxEnrollment,
                        bool isActive)
             : Course(courseId, courseName, credits, description, duration, teacher) {
-            // Validate and set start date
-            if (!startDate.empty() && !Common::isValidDate(startDate)) {
-                throw invalid_argument("Invalid start date format: must be YYYY-MM-DD");
-            }
-            this->startDate = startDate;
-            // Validate and set end date
-            if (!endDate.empty() && !Common::isValidDate(endDate)) {
-                throw invalid_argument("Invalid end date format: must be YYYY-MM-DD");
-            }
-            this->endDate = endDate;
+            // Validate and set start and end dates
+            this->startDate = parseCourseDate(startDate, "start");
+            this->endDate = parseCourseDate(endDate, "end");
             // Validate date sequence
-            if (!startDate.empty() && !endDate.empty()) {
-                if (startDate >= endDate) {
+            if (!this->startDate.empty() && !this->endDate.empty()) {
+                if (this->startDate >= this->endDate) {
                     throw invalid_argument("End date must be after start date");
                 }
             }
@@ -170,14 +157,42 @@ namespace PokenoSouth {
             this->isActive = isActive;
         }
     
+    Course::Course(TrustedInput,
+                   const string& courseId,
+                   const string& courseName,
+                   int credits,
+                   const string& description,
+                   int duration,
+                   const string& teacher,
+                   Date startDate,
+                   Date endDate,
+                   int maxEnrollment,
+                   bool isActive)
+        : courseKey(SymbolTable::courseIds().intern(courseId)),
+          courseName(courseName),
+          credits(credits),
+          description(description),
+          teacherKey(SymbolTable::teachers().intern(teacher)),
+          duration(duration),
+          startDate(startDate),
+          endDate(endDate),
+          maxEnrollment(maxEnrollment),
+          isActive(isActive) {
+        enrolledStudents.reserve(DEFAULT_MAX_ENROLLMENT);
+    }
+    
     // Copy constructor
     Course::Course(const Course& other)
-        : courseId(other.courseId),
+        : courseKey(other.courseKey),
           courseName(other.courseName),
           credits(other.credits),
           description(other.description),
+          teacherKey(other.teacherKey),
           duration(other.duration),
           enrolledStudents(other.enrolledStudents),
+          enrolledRollNumbers(other.enrolledRollNumbers),
+          studentGrades(other.studentGrades),
+          ungradedStudents(other.ungradedStudents),
           startDate(other.startDate),
           endDate(other.endDate),
           maxEnrollment(other.maxEnrollment),
@@ -187,16 +202,21 @@ namespace PokenoSouth {
     // Assignment operator
     Course& Course::operator=(const Course& other) {
         if (this != &other) {
-            // Note: courseId is const and cannot be changed
+            // Note: the course key is const and cannot be changed
             courseName = other.courseName;
             credits = other.credits;
             description = other.description;
+            teacherKey = other.teacherKey;
             duration = other.duration;
             enrolledStudents = other.enrolledStudents;
+            enrolledRollNumbers = other.enrolledRollNumbers;
+            studentGrades = other.studentGrades;
+            ungradedStudents = other.ungradedStudents;
             startDate = other.startDate;
             endDate = other.endDate;
             maxEnrollment = other.maxEnrollment;
             isActive = other.isActive;
+            markModified();
         }
         return *this;
     }
@@ -225,6 +245,7 @@ namespace PokenoSouth {
             throw invalid_argument("Invalid course name: cannot be empty");
         }
         this->courseName = name;
+        markModified();
     }
     
     void Course::setCredits(int credits) {
@@ -234,10 +255,12 @@ namespace PokenoSouth {
                                       to_string(MAX_CREDITS));
         }
         this->credits = credits;
+        markModified();
     }
     
     void Course::setDescription(const string& description) {
         this->description = description;
+        markModified();
     }
     
     void Course::setDuration(int duration) {
@@ -247,36 +270,35 @@ namespace PokenoSouth {
                                       to_string(MAX_DURATION) + " weeks");
         }
         this->duration = duration;
+        markModified();
     }
     
     void Course::setStartDate(const string& startDate) {
-        if (!startDate.empty() && !Common::isValidDate(startDate)) {
-            throw invalid_argument("Invalid start date format: must be YYYY-MM-DD");
-        }
+        const Date date = parseCourseDate(startDate, "start");
         
         // Validate with existing end date
-        if (!endDate.empty() && !startDate.empty()) {
-            if (startDate >= endDate) {  // Simple string comparison for dates in YYYY-MM-DD format
+        if (!endDate.empty() && !date.empty()) {
+            if (date >= endDate) {
                 throw invalid_argument("Start date must be before end date");
             }
         }
         
-        this->startDate = startDate;
+        this->startDate = date;
+        markModified();
     }
     
     void Course::setEndDate(const string& endDate) {
-        if (!endDate.empty() && !Common::isValidDate(endDate)) {
-            throw invalid_argument("Invalid end date format: must be YYYY-MM-DD");
-        }
+        const Date date = parseCourseDate(endDate, "end");
         
         // Validate with existing start date
-        if (!startDate.empty() && !endDate.empty()) {
-            if (startDate >= endDate) {  // Simple string comparison for dates in YYYY-MM-DD format
+        if (!startDate.empty() && !date.empty()) {
+            if (startDate >= date) {
                 throw invalid_argument("End date must be after start date");
             }
         }
         
-        this->endDate = endDate;
+        this->endDate = date;
+        markModified();
     }
     
     void Course::setMaxEnrollment(int maxEnrollment) {
@@ -292,6 +314,7 @@ namespace PokenoSouth {
         }
         
         this->maxEnrollment = maxEnrollment;
+        markModified();
         
         // Memory management: Adjust vector capacity if needed
         if (maxEnrollment > enrolledStudents.capacity()) {
@@ -299,7 +322,7 @@ namespace PokenoSouth {
         } else if (maxEnrollment < enrolledStudents.capacity() / 2 && 
                    enrolledStudents.capacity() > DEFAULT_MAX_ENROLLMENT) {
             // Only shrink if the new capacity is significantly smaller and we're above default
-            vector<shared_ptr<Student>> temp(enrolledStudents);
+            vector<Student*> temp(enrolledStudents);
             enrolledStudents = move(temp);
             enrolledStudents.reserve(maxEnrollment);
         }
@@ -307,34 +330,44 @@ namespace PokenoSouth {
     
     void Course::setIsActive(bool active) {
         this->isActive = active;
+        markModified();
+    }
+    
+    const CourseGradingPolicy& Course::getGradingPolicy() const {
+        return GradingPolicyRegistry::shared().forCourse(courseKey);
+    }
+    
+    void Course::setGradingPolicy(const string& policyName) {
+        GradingPolicyRegistry::shared().assign(courseKey, policyName);
+        markModified();
     }
     
     // === STUDENT ENROLLMENT MANAGEMENT (bidirectional) ===
-    bool Course::enrollStudent(shared_ptr<Student> student) {
+    bool Course::enrollStudent(Student* student) {
         if (!student) {
             throw invalid_argument("Cannot enroll null student");
         }
         
         // Check if course is active
         if (!isActive) {
-            throw runtime_error("Cannot enroll in inactive course: " + courseId);
+            throw runtime_error("Cannot enroll in inactive course: " + getCourseId());
         }
         
         // Check if already enrolled
         if (isStudentEnrolled(student->getRollNumber())) {
             throw runtime_error("Student " + to_string(student->getRollNumber()) +
-                                   " is already enrolled in course: " + courseId);
+                                   " is already enrolled in course: " + getCourseId());
         }
         
         // Check enrollment capacity
         if (isFull()) {
-            throw runtime_error("Course " + courseId + " is at maximum capacity (" +
+            throw runtime_error("Course " + getCourseId() + " is at maximum capacity (" +
                                    to_string(maxEnrollment) + ")");
         }
         
         // Check enrollment period
         if (!isEnrollmentPeriodActive()) {
-            throw runtime_error("Enrollment period is not active for course: " + courseId);
+            throw runtime_error("Enrollment period is not active for course: " + getCourseId());
         }
         
         // Memory management: Reserve space if needed to avoid frequent reallocations
@@ -343,21 +376,27 @@ namespace PokenoSouth {
         }
         
         enrolledStudents.push_back(student);
+        enrolledRollNumbers.insert(static_cast<uint32_t>(student->getRollNumber()));
+        addStudentGrade(student->getCourseGrade(courseKey));
+        markModified();
         return true;
     }
     
     bool Course::withdrawStudent(int rollNumber) {
         auto it = find_if(enrolledStudents.begin(), enrolledStudents.end(),
-            [rollNumber](const shared_ptr<Student>& student) {
+            [rollNumber](const Student* student) {
                 return student && student->getRollNumber() == rollNumber;
             });
             
         if (it == enrolledStudents.end()) {
             throw runtime_error("Student " + to_string(rollNumber) +
-                                   " is not enrolled in course: " + courseId);
+                                   " is not enrolled in course: " + getCourseId());
         }
         
+        removeStudentGrade((*it)->getCourseGrade(courseKey));
         enrolledStudents.erase(it);
+        enrolledRollNumbers.erase(static_cast<uint32_t>(rollNumber));
+        markModified();
         
         // Memory management: Shrink vector if significantly smaller than capacity
         if (enrolledStudents.size() < enrolledStudents.capacity() / 2 && enrolledStudents.capacity() > DEFAULT_MAX_ENROLLMENT) {
@@ -367,26 +406,42 @@ namespace PokenoSouth {
         return true;
     }
     
+    bool Course::attachStudent(Student* student) {
+        if (!student || !enrolledRollNumbers.insert(static_cast<uint32_t>(student->getRollNumber()))) {
+            return false;
+        }
+        enrolledStudents.push_back(student);
+        addStudentGrade(student->getCourseGrade(courseKey));
+        markModified();
+        return true;
+    }
+    
+    void Course::detachStudent(const Student* student) {
+        auto it = find(enrolledStudents.begin(), enrolledStudents.end(), student);
+        if (it != enrolledStudents.end()) {
+            removeStudentGrade(student->getCourseGrade(courseKey));
+            enrolledStudents.erase(it);
+            enrolledRollNumbers.erase(static_cast<uint32_t>(student->getRollNumber()));
+            markModified();
+        }
+    }
+    
     bool Course::isStudentEnrolled(int rollNumber) const {
-        return any_of(enrolledStudents.begin(), enrolledStudents.end(),
-            [rollNumber](const shared_ptr<Student>& student) {
-                return student && student->getRollNumber() == rollNumber;
-            });
+        return rollNumber >= 0 && enrolledRollNumbers.contains(static_cast<uint32_t>(rollNumber));
     }
     
-    shared_ptr<Student> Course::getStudent(int rollNumber) const {
+    Student* Course::getStudent(int rollNumber) const {
+        if (!isStudentEnrolled(rollNumber)) {
+            return nullptr;   // Skip the scan for the common miss
+        }
         auto it = find_if(enrolledStudents.begin(), enrolledStudents.end(),
-            [rollNumber](const shared_ptr<Student>& student) {
+            [rollNumber](const Student* student) {
                 return student && student->getRollNumber() == rollNumber;
             });
             
         return (it != enrolledStudents.end()) ? *it : nullptr;
     }
     
-    vector<shared_ptr<Student>> Course::getEnrolledStudents() const {
-        return enrolledStudents;
-    }
-    
     // === ENROLLMENT QUERIES ===
     vector<int> Course::getEnrolledRollNumbers() const {
         vector<int> rollNumbers;
@@ -420,48 +475,31 @@ namespace PokenoSouth {
     bool Course::isEnrollmentPeriodActive() const {
         if (startDate.empty()) return true; // No date restrictions
         
-        string currentDate = Common::getCurrentDate();
-        
         // Can enroll before start date and during course
         if (!endDate.empty()) {
-            return currentDate <= endDate;
+            return Date::today() <= endDate;
         }
         
         return true; // No end date restriction
     }
     
-    bool Course::meetsPrerequisites(shared_ptr<Student> student) const {
+    bool Course::meetsPrerequisites(const Student* student) const {
         // For primary school, no prerequisites
         return student != nullptr;
     }
     
     // === GRADE AND ASSESSMENT SUPPORT ===
     double Course::getCourseAverageGrade() const {
-        if (enrolledStudents.empty()) {
-            return 0.0;
-        }
-        
-        double totalGrade = 0.0;
-        int validGrades = 0;
-        
-        for (const auto& student : enrolledStudents) {
-            if (student) {
-                double courseGrade = student->getCourseGrade(courseId);
-                if (courseGrade > 0.0) {
-                    totalGrade += courseGrade;
-                    validGrades++;
-                }
-            }
-        }
-        
-        return validGrades > 0 ? totalGrade / validGrades : 0.0;
+        // Students with no marks yet (grade 0) don't pull the average down
+        const int gradedStudents = studentGrades.count - ungradedStudents;
+        return gradedStudents > 0 ? studentGrades.total() / gradedStudents : 0.0;
     }
     
-    vector<shared_ptr<Student>> Course::getPassingStudents() const {
-        vector<shared_ptr<Student>> passingStudents;
+    vector<Student*> Course::getPassingStudents() const {
+        vector<Student*> passingStudents;
         
         for (const auto& student : enrolledStudents) {
-            if (student && student->getCourseGrade(courseId) >= 50.0) {
+            if (student && student->getCourseGrade(courseKey) >= 50.0) {
                 passingStudents.push_back(student);
             }
         }
@@ -469,11 +507,11 @@ namespace PokenoSouth {
         return passingStudents;
     }
     
-    vector<shared_ptr<Student>> Course::getFailingStudents() const {
-        vector<shared_ptr<Student>> failingStudents;
+    vector<Student*> Course::getFailingStudents() const {
+        vector<Student*> failingStudents;
         
         for (const auto& student : enrolledStudents) {
-            if (student && student->getCourseGrade(courseId) < 50.0) {
+            if (student && student->getCourseGrade(courseKey) < 50.0) {
                 failingStudents.push_back(student);
             }
         }
@@ -482,11 +520,41 @@ namespace PokenoSouth {
     }
     
     int Course::getPassCount() const {
-        return static_cast<int>(getPassingStudents().size());
+        return studentGrades.passCount;
     }
     
     int Course::getFailCount() const {
-        return static_cast<int>(getFailingStudents().size());
+        return studentGrades.failCount;
+    }
+    
+    GradeAggregate Course::getGradeSummary() const {
+        studentGrades.refreshExtremes([this](auto&& visit) {
+            forEachStudent([&](const Student* student) { visit(student->getCourseGrade(courseKey)); });
+        });
+        return studentGrades;
+    }
+    
+    // === INCREMENTAL GRADE TOTALS ===
+    void Course::addStudentGrade(double courseGrade) {
+        studentGrades.add(courseGrade);
+        if (courseGrade <= 0.0) ungradedStudents++;
+    }
+    
+    void Course::removeStudentGrade(double courseGrade) {
+        studentGrades.remove(courseGrade);
+        if (courseGrade <= 0.0) ungradedStudents--;
+    }
+    
+    void Course::onStudentGradeChanged(double oldCourseGrade, double newCourseGrade) {
+        removeStudentGrade(oldCourseGrade);
+        addStudentGrade(newCourseGrade);
+    }
+    
+    void Course::recalculateGradeTotals() {
+        studentGrades = GradeAggregate();
+        ungradedStudents = 0;
+        forEachStudent([this](const Student* student) { addStudentGrade(student->getCourseGrade(courseKey)); });
+        markModified();
     }
     
     double Course::getPassRate() const {
@@ -499,22 +567,23 @@ namespace PokenoSouth {
     // === DISPLAY AND FORMATTING ===
     void Course::displayCourseInfo() const {
         cout << "\n=== Course Information ===" << endl;
-        cout << "Course ID: " << courseId << endl;
+        cout << "Course ID: " << getCourseId() << endl;
         cout << "Course Name: " << courseName << endl;
         cout << "Credits: " << credits << endl;
         cout << "Duration: " << duration << " weeks" << endl;
         cout << "Description: " << description << endl;
-        cout << "Start Date: " << (startDate.empty() ? "Not set" : startDate) << endl;
-        cout << "End Date: " << (endDate.empty() ? "Not set" : endDate) << endl;
+        cout << "Start Date: " << (startDate.empty() ? "Not set" : startDate.toString()) << endl;
+        cout << "End Date: " << (endDate.empty() ? "Not set" : endDate.toString()) << endl;
         cout << "Enrollment: " << getCurrentEnrollment() << "/" << maxEnrollment
                   << " (" << fixed << setprecision(1) << getEnrollmentPercentage() << "%)" << endl;
         cout << "Status: " << (isActive ? "Active" : "Inactive") << endl;
+        cout << "Grading Policy: " << getGradingPolicyName() << endl;
         cout << "Average Grade: " << fixed << setprecision(1) << getCourseAverageGrade() << "%" << endl;
     }
     
     void Course::displayEnrollmentList() const {
         cout << "\n=== Enrollment List ===" << endl;
-        cout << "Course: " << courseId << " - " << courseName << endl;
+        cout << "Course: " << getCourseId() << " - " << courseName << endl;
         cout << "Enrolled Students: " << getCurrentEnrollment() << "/" << maxEnrollment << endl;
         
         if (!enrolledStudents.empty()) {
@@ -523,7 +592,7 @@ namespace PokenoSouth {
                 if (student) {
                     cout << "  " << student->getRollNumber() << ": " << student->getFullName()
                               << " (Grade: " << fixed << setprecision(1)
-                              << student->getCourseGrade(courseId) << "%)" << endl;
+                              << student->getCourseGrade(courseKey) << "%)" << endl;
                 }
             }
         }
@@ -531,10 +600,11 @@ namespace PokenoSouth {
     
     void Course::displayCourseStatistics() const {
         cout << "\n=== Course Statistics ===" << endl;
-        cout << "Course: " << courseId << " - " << courseName << endl;
+        cout << "Course: " << getCourseId() << " - " << courseName << endl;
         cout << "Total Enrolled: " << getCurrentEnrollment() << endl;
         cout << "Passing Students: " << getPassCount() << endl;
         cout << "Failing Students: " << getFailCount() << endl;
+        cout << "Grading Policy: " << getGradingPolicyName() << endl;
         cout << "Pass Rate: " << fixed << setprecision(1) << getPassRate() << "%" << endl;
         cout << "Average Grade: " << fixed << setprecision(1) << getCourseAverageGrade() << "%" << endl;
         cout << "Enrollment Rate: " << fixed << setprecision(1) << getEnrollmentPercentage() << "%" << endl;
@@ -542,7 +612,7 @@ namespace PokenoSouth {
     
     string Course::toCSVString() const {
         ostringstream oss;
-        oss << courseId << ","
+        oss << getCourseId() << ","
             << courseName << ","
             << credits << ","
             << description << ","
@@ -593,6 +663,15 @@ namespace PokenoSouth {
         return duration >= MIN_DURATION && duration <= MAX_DURATION;
     }
     
+    SymbolKey Course::internCourseId(const string& courseId) {
+        // Validate before interning so rejected IDs never enter the shared table
+        string formatted = formatCourseId(courseId);
+        if (!isValidCourseId(formatted)) {
+            throw invalid_argument("Invalid course ID format: must follow pattern like MATH101");
+        }
+        return SymbolTable::courseIds().intern(formatted);
+    }
+    
     string Course::formatCourseId(const string& courseId) {
         string formatted = courseId;
         transform(formatted.begin(), formatted.end(), formatted.begin(), ::toupper);
@@ -601,7 +680,7 @@ namespace PokenoSouth {
     
     // === COMPARISON OPERATORS ===
     bool Course::operator==(const Course& other) const {
-        return courseId == other.courseId;
+        return courseKey == other.courseKey;
     }
     
     bool Course::operator!=(const Course& other) const {
@@ -609,7 +688,7 @@ namespace PokenoSouth {
     }
     
     bool Course::operator<(const Course& other) const {
-        return courseId < other.courseId;
+        return getCourseId() < other.getCourseId();
     }
     
     // Stream operator
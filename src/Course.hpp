@@ -2,6 +2,15 @@
 
 #include "common.hpp"
 #include "Student.hpp"
+#include "SymbolTable.hpp"
+#include "EntityArena.hpp"
+#include "View.hpp"
+#include "EnrollmentBitmap.hpp"
+#include "GradeAggregate.hpp"
+#include "GradingPolicy.hpp"
+#include "VersionClock.hpp"
+#include "Date.hpp"
+#include "TrustedInput.hpp"
 
 USING_STD_COURSE
 
@@ -15,8 +24,9 @@ namespace PokenoSouth {
      * 
      * Key Features:
      * - Immutable course ID with uppercase enforcement
-     * - Bidirectional relationships with students
+     * - Bidirectional relationships with students (non-owning; entities live in EntityArenas)
      * - Enrollment capacity management
+     * - Grading policy by name, held in GradingPolicyRegistry under the course key
      * - Business rule validation
      * - Comprehensive CRUD operations
      */
@@ -30,19 +40,30 @@ namespace PokenoSouth {
     // (Removed duplicate getCourseId and getCourseName from private section)
     private:
     // Core course data (immutable after construction)
-    const string courseId;     // Immutable identifier, uppercase format
+    const SymbolKey courseKey; // Interned immutable identifier, uppercase format
     string courseName;         // Required, descriptive name
     int credits;                    // 1-6 credits allowed
     string description;        // Course description
-    string teacher;            // Teacher assigned to course
+    SymbolKey teacherKey;      // Interned teacher assigned to course
     int duration;                   // Duration in weeks (1-52)
         
-        // Relationship management (bidirectional with Student)
-        vector<shared_ptr<Student>> enrolledStudents;
+        // Relationship management (bidirectional with Student, non-owning)
+        vector<Student*> enrolledStudents;
+        EnrollmentBitmap enrolledRollNumbers;   // Same students as enrolledStudents, by roll number
+        
+        // Running totals over the enrolled students' course grades (kept current by Student)
+        mutable GradeAggregate studentGrades;
+        int ungradedStudents = 0;               // Enrolled with a course grade of 0, left out of the average
+        
+        void addStudentGrade(double courseGrade);
+        void removeStudentGrade(double courseGrade);
+        
+        EntityHandle handle = INVALID_HANDLE;   // Slot in the owning EntityArena
+        Version version = VersionClock::stamp(VersionDomain::Courses);   // See markModified()
         
         // Course metadata
-        string startDate;          // YYYY-MM-DD format
-        string endDate;            // YYYY-MM-DD format, must be after startDate
+        Date startDate;            // Empty if not set
+        Date endDate;              // Empty if not set; must be after startDate
         int maxEnrollment;              // Maximum students allowed
         bool isActive;                  // Course active status
         
@@ -85,29 +106,50 @@ namespace PokenoSouth {
            int maxEnrollment,
            bool isActive);
 
+    // Unchecked constructor for verified saved data (see TrustedInput); courseId is already formatted
+    Course(TrustedInput,
+           const string& courseId,
+           const string& courseName,
+           int credits,
+           const string& description,
+           int duration,
+           const string& teacher,
+           Date startDate,
+           Date endDate,
+           int maxEnrollment,
+           bool isActive);
+
     // Teacher accessor/mutator
-    const string& getTeacher() const { return teacher; }
-    void setTeacher(const string& t) { teacher = t; }
-    // CourseId and CourseName getters
-    const string& getCourseId() const { return courseId; }
+    const string& getTeacher() const { return SymbolTable::teachers().name(teacherKey); }
+    void setTeacher(const string& t) { teacherKey = SymbolTable::teachers().intern(t); markModified(); }
+    SymbolKey getTeacherKey() const { return teacherKey; }
+    // CourseId and CourseName getters (the string is kept in the shared table for display)
+    const string& getCourseId() const { return SymbolTable::courseIds().name(courseKey); }
+    SymbolKey getCourseKey() const { return courseKey; }
+    EntityHandle getHandle() const { return handle; }
+    void setHandle(EntityHandle h) { handle = h; }
+    Version getVersion() const { return version; }
+    void markModified() { version = VersionClock::stamp(VersionDomain::Courses); }   // Also called by enrolled students
     const string& getCourseName() const { return courseName; }
     // Additional getters
     int getCredits() const { return credits; }
     const string& getDescription() const { return description; }
     int getDuration() const { return duration; }
-    const string& getStartDate() const { return startDate; }
-    const string& getEndDate() const { return endDate; }
+    Date getStartDate() const { return startDate; }
+    Date getEndDate() const { return endDate; }
         
         // Destructor
         ~Course() = default;
         
-        // Copy constructor and assignment (careful with shared_ptr)
+        // Copy constructor and assignment (copies share the non-owning relationship links)
         Course(const Course& other);
         Course& operator=(const Course& other);
         
     // 
         int getMaxEnrollment() const { return maxEnrollment; }
         bool getIsActive() const { return isActive; }
+        const CourseGradingPolicy& getGradingPolicy() const;   // "standard" unless assigned
+        const string& getGradingPolicyName() const { return getGradingPolicy().getName(); }
         
         // Derived getters
         int getCurrentEnrollment() const;
@@ -124,14 +166,27 @@ namespace PokenoSouth {
         void setEndDate(const string& endDate);
         void setMaxEnrollment(int maxEnrollment);
         void setIsActive(bool active);
+        // Unknown names throw invalid_argument. Grades already computed are left as they are;
+        // System::applyGradingPolicy re-grades the course's assessments afterwards
+        void setGradingPolicy(const string& policyName);
         // Note: courseId is immutable
         
         // === STUDENT ENROLLMENT MANAGEMENT (bidirectional) ===
-        bool enrollStudent(shared_ptr<Student> student);
+        bool enrollStudent(Student* student);
         bool withdrawStudent(int rollNumber);
+        bool attachStudent(Student* student);         // Link without enrollment rules (load); false if present
+        void detachStudent(const Student* student);   // Unlink without checks; no-op if absent
         bool isStudentEnrolled(int rollNumber) const;
-        shared_ptr<Student> getStudent(int rollNumber) const;
-        vector<shared_ptr<Student>> getEnrolledStudents() const;
+        Student* getStudent(int rollNumber) const;
+        View<Student> getEnrolledStudents() const { return enrolledStudents; }
+        const EnrollmentBitmap& getEnrolledRollNumberSet() const { return enrolledRollNumbers; }
+        
+        template <typename Visitor>
+        void forEachStudent(Visitor&& visitor) const {
+            for (Student* student : enrolledStudents) {
+                if (student) visitor(student);
+            }
+        }
         
         // === ENROLLMENT QUERIES ===
         vector<int> getEnrolledRollNumbers() const;
@@ -141,15 +196,21 @@ namespace PokenoSouth {
         // === BUSINESS RULE VALIDATION ===
         bool canEnrollMoreStudents() const;
         bool isEnrollmentPeriodActive() const;  // Based on start/end dates
-        bool meetsPrerequisites(shared_ptr<Student> student) const;
+        bool meetsPrerequisites(const Student* student) const;
         
         // === GRADE AND ASSESSMENT SUPPORT ===
         double getCourseAverageGrade() const;
-        vector<shared_ptr<Student>> getPassingStudents() const;
-        vector<shared_ptr<Student>> getFailingStudents() const;
+        vector<Student*> getPassingStudents() const;
+        vector<Student*> getFailingStudents() const;
         int getPassCount() const;
         int getFailCount() const;
         double getPassRate() const;
+        GradeAggregate getGradeSummary() const;   // Over enrolled students' course grades
+        
+        // Called by an enrolled Student when its grade for this course changes
+        void onStudentGradeChanged(double oldCourseGrade, double newCourseGrade);
+        // Re-reads every enrolled student's course grade, e.g. after the grading policy changed
+        void recalculateGradeTotals();
         
         // === DISPLAY AND FORMATTING ===
         void displayCourseInfo() const;
@@ -163,6 +224,7 @@ namespace PokenoSouth {
         static bool isValidCredits(int credits);
         static bool isValidDuration(int duration);
         static string formatCourseId(const string& courseId);  // Convert to uppercase
+        static SymbolKey internCourseId(const string& courseId); // Format, validate, intern
         
         // === BUSINESS RULES ===
         static constexpr int MIN_CREDITS = 1;
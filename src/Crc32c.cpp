@@ -0,0 +1,93 @@
+#include "Crc32c.hpp"
+
+// The hardware path needs a per-function target attribute, __builtin_cpu_supports and the 64-bit crc32 form
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define POKENO_CRC32C_X86 1
+#include <nmmintrin.h>
+#endif
+
+namespace PokenoSouth {
+
+    namespace {
+        using UpdateFn = uint32_t (*)(uint32_t state, const unsigned char* data, size_t length);
+
+        constexpr uint32_t POLYNOMIAL = 0x82F63B78u;   // CRC-32C, reflected
+
+        // tables[k][b]: the CRC of byte b followed by k zero bytes, for slicing-by-8
+        constexpr array<array<uint32_t, 256>, 8> buildTables() {
+            array<array<uint32_t, 256>, 8> tables{};
+            for (uint32_t b = 0; b < 256; ++b) {
+                uint32_t crc = b;
+                for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ ((crc & 1u) ? POLYNOMIAL : 0u);
+                tables[0][b] = crc;
+            }
+            for (size_t k = 1; k < tables.size(); ++k) {
+                for (size_t b = 0; b < 256; ++b) {
+                    const uint32_t previous = tables[k - 1][b];
+                    tables[k][b] = (previous >> 8) ^ tables[0][previous & 0xFFu];
+                }
+            }
+            return tables;
+        }
+
+        constexpr array<array<uint32_t, 256>, 8> TABLES = buildTables();
+
+        uint32_t updateTable(uint32_t state, const unsigned char* data, size_t length) {
+            while (length >= 8) {
+                const uint32_t low = state ^ (uint32_t(data[0]) | uint32_t(data[1]) << 8 |
+                                              uint32_t(data[2]) << 16 | uint32_t(data[3]) << 24);
+                state = TABLES[7][low & 0xFFu] ^ TABLES[6][(low >> 8) & 0xFFu] ^
+                        TABLES[5][(low >> 16) & 0xFFu] ^ TABLES[4][low >> 24] ^
+                        TABLES[3][data[4]] ^ TABLES[2][data[5]] ^ TABLES[1][data[6]] ^ TABLES[0][data[7]];
+                data += 8;
+                length -= 8;
+            }
+            while (length-- > 0) state = (state >> 8) ^ TABLES[0][(state ^ *data++) & 0xFFu];
+            return state;
+        }
+
+#ifdef POKENO_CRC32C_X86
+        __attribute__((target("sse4.2")))
+        uint32_t updateSse42(uint32_t state, const unsigned char* data, size_t length) {
+            uint64_t wide = state;
+            while (length >= 8) {
+                uint64_t word;
+                memcpy(&word, data, sizeof(word));
+                wide = _mm_crc32_u64(wide, word);
+                data += 8;
+                length -= 8;
+            }
+            state = static_cast<uint32_t>(wide);
+            while (length-- > 0) state = _mm_crc32_u8(state, *data++);
+            return state;
+        }
+#endif
+
+        struct Dispatch {
+            UpdateFn update;
+            const char* name;
+        };
+
+        Dispatch choose() {
+#ifdef POKENO_CRC32C_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("sse4.2")) return {updateSse42, "sse4.2"};
+#endif
+            return {updateTable, "table"};
+        }
+
+        const Dispatch& dispatch() {
+            static const Dispatch chosen = choose();
+            return chosen;
+        }
+    }
+
+    // === CHECKSUM ===
+    void Crc32c::update(const char* data, size_t length) {
+        state = dispatch().update(state, reinterpret_cast<const unsigned char*>(data), length);
+    }
+
+    const char* Crc32c::implementation() {
+        return dispatch().name;
+    }
+}
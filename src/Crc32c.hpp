@@ -0,0 +1,39 @@
+#pragma once
+
+#include "common.hpp"
+
+USING_STD_CRC32C
+
+namespace PokenoSouth {
+    /**
+     * Crc32c for Pokeno South Primary School
+     * Streaming CRC-32C (Castagnoli) checksum for data and backup files
+     *
+     * Key Features:
+     * - Incremental: feed the bytes in whatever chunks they are written or read, then take value();
+     *   the result is the same as checksumming the whole buffer at once
+     * - Uses the SSE4.2 crc32 instruction, 8 bytes per step, when the CPU has it (picked once at
+     *   runtime on GCC/Clang x86); otherwise a slicing-by-8 table loop. Both give identical results
+     * - Standard parameters (reflected polynomial 0x82F63B78, initial and final XOR 0xFFFFFFFF),
+     *   so compute("123456789") == 0xE3069283 and sidecars can be checked with common tools
+     */
+    class Crc32c {
+    private:
+        uint32_t state = 0xFFFFFFFFu;
+
+    public:
+        Crc32c() = default;
+
+        void update(const char* data, size_t length);
+        void update(string_view data) { update(data.data(), data.size()); }
+        uint32_t value() const { return state ^ 0xFFFFFFFFu; }
+
+        static uint32_t compute(string_view data) {
+            Crc32c crc;
+            crc.update(data);
+            return crc.value();
+        }
+
+        static const char* implementation();   // "sse4.2" or "table": what update() uses here
+    };
+}
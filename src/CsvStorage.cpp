@@ -0,0 +1,43 @@
+#include "CsvStorage.hpp"
+#include "FileHandler.hpp"
+
+namespace PokenoSouth {
+
+    bool CsvStorage::initialize() {
+        clearError();
+        if (FileHandler::initializeDataFiles()) return true;
+        setError(FileHandler::getLastError());
+        return false;
+    }
+
+    bool CsvStorage::load(EntityArena<Student>& students,
+                          EntityArena<Course>& courses,
+                          EntityArena<Assessment>& assessments) {
+        clearError();
+        if (FileHandler::loadAllData(students, courses, assessments)) return true;
+        setError(FileHandler::getLastError());
+        return false;
+    }
+
+    bool CsvStorage::save(const EntityArena<Student>& students,
+                          const EntityArena<Course>& courses,
+                          const EntityArena<Assessment>& assessments) {
+        clearError();
+        if (FileHandler::saveAllData(students, courses, assessments)) return true;
+        setError(FileHandler::getLastError());
+        return false;
+    }
+
+    bool CsvStorage::backup() {
+        clearError();
+        if (FileHandler::backupDataFiles()) return true;
+        setError(FileHandler::getLastError());
+        return false;
+    }
+
+    bool CsvStorage::hasFiles() {
+        return std::filesystem::exists(FileHandler::STUDENTS_FILE) ||
+               std::filesystem::exists(FileHandler::COURSES_FILE) ||
+               std::filesystem::exists(FileHandler::ASSESSMENTS_FILE);
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "StorageBackend.hpp"
+
+namespace PokenoSouth {
+    /**
+     * CsvStorage for Pokeno South Primary School
+     * The original CSV files under data/, as a StorageBackend
+     *
+     * Key Features:
+     * - Thin adapter over FileHandler's static load/save/backup operations, so checksums,
+     *   temp-file swaps and backups behave exactly as they always have
+     * - Paths are FileHandler's fixed data/ locations
+     * - hasFiles() lets another backend find CSV data to import when it has nothing stored
+     */
+    class CsvStorage : public StorageBackend {
+    public:
+        string name() const override { return "CSV files"; }
+        bool initialize() override;
+        bool load(EntityArena<Student>& students,
+                  EntityArena<Course>& courses,
+                  EntityArena<Assessment>& assessments) override;
+        bool save(const EntityArena<Student>& students,
+                  const EntityArena<Course>& courses,
+                  const EntityArena<Assessment>& assessments) override;
+        bool backup() override;
+
+        // True if any students, courses or assessments CSV file exists
+        static bool hasFiles();
+    };
+}
@@ -0,0 +1,136 @@
+#include "Date.hpp"
+#include "Clock.hpp"
+
+namespace PokenoSouth {
+
+    namespace {
+        struct Civil {
+            int year;
+            int month;
+            int day;
+        };
+
+        // Days since 1970-01-01 for a proleptic Gregorian date (March-based years put
+        // the leap day last, so no month table is needed)
+        int32_t daysFromCivil(int year, int month, int day) {
+            year -= month <= 2;
+            const int era = (year >= 0 ? year : year - 399) / 400;
+            const int yearOfEra = year - era * 400;                                        // [0, 399]
+            const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1; // [0, 365]
+            const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return era * 146097 + dayOfEra - 719468;
+        }
+
+        Civil civilFromDays(int32_t days) {
+            days += 719468;
+            const int era = (days >= 0 ? days : days - 146096) / 146097;
+            const int dayOfEra = days - era * 146097;                                                // [0, 146096]
+            const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+            const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);   // [0, 365]
+            const int monthIndex = (5 * dayOfYear + 2) / 153;                                        // [0, 11], March = 0
+            const int day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+            const int month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+            return {yearOfEra + era * 400 + (month <= 2), month, day};
+        }
+
+        int digitAt(string_view text, size_t i) {
+            const unsigned digit = static_cast<unsigned char>(text[i]) - static_cast<unsigned>('0');
+            return digit <= 9 ? static_cast<int>(digit) : -1;
+        }
+    }
+
+    // === CONSTRUCTION ===
+    Date Date::fromCivil(int year, int month, int day) {
+        if (!isValidCivil(year, month, day)) {
+            throw invalid_argument("Invalid date: no such calendar day");
+        }
+        return Date(daysFromCivil(year, month, day));
+    }
+
+    bool Date::tryParse(string_view text, Date& out) {
+        if (text.size() != TEXT_LENGTH || text[4] != '-' || text[7] != '-') {
+            return false;
+        }
+        int fields[8];
+        static constexpr size_t DIGIT_POSITIONS[8] = {0, 1, 2, 3, 5, 6, 8, 9};
+        for (size_t i = 0; i < 8; ++i) {
+            fields[i] = digitAt(text, DIGIT_POSITIONS[i]);
+            if (fields[i] < 0) return false;
+        }
+        const int year = fields[0] * 1000 + fields[1] * 100 + fields[2] * 10 + fields[3];
+        const int month = fields[4] * 10 + fields[5];
+        const int day = fields[6] * 10 + fields[7];
+        if (!isValidCivil(year, month, day)) {
+            return false;
+        }
+        out = Date(daysFromCivil(year, month, day));
+        return true;
+    }
+
+    Date Date::parse(string_view text) {
+        Date date;
+        if (!tryParse(text, date)) {
+            throw invalid_argument("Invalid date: must be a real calendar date in YYYY-MM-DD format");
+        }
+        return date;
+    }
+
+    Date Date::today() {
+        return Clock::today();
+    }
+
+    // === QUERIES ===
+    int Date::year() const { return civilFromDays(days).year; }
+    int Date::month() const { return civilFromDays(days).month; }
+    int Date::day() const { return civilFromDays(days).day; }
+
+    int Date::yearsUntil(Date on) const {
+        if (empty() || on.empty()) return 0;
+        const Civil from = civilFromDays(days);
+        const Civil to = civilFromDays(on.days);
+        int years = to.year - from.year;
+        if (to.month < from.month || (to.month == from.month && to.day < from.day)) {
+            years--;
+        }
+        return years;
+    }
+
+    bool Date::isValidCivil(int year, int month, int day) {
+        static constexpr int DAYS_IN_MONTH[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        if (year < 0 || year > 9999 || month < 1 || month > 12 || day < 1) {
+            return false;
+        }
+        const int monthDays = DAYS_IN_MONTH[month - 1] + (month == 2 && isLeapYear(year) ? 1 : 0);
+        return day <= monthDays;
+    }
+
+    // === FORMATTING ===
+    void Date::format(char* out) const {
+        const Civil civil = civilFromDays(days);
+        int year = civil.year;
+        for (int i = 3; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + year % 10);
+            year /= 10;
+        }
+        out[4] = '-';
+        out[5] = static_cast<char>('0' + civil.month / 10);
+        out[6] = static_cast<char>('0' + civil.month % 10);
+        out[7] = '-';
+        out[8] = static_cast<char>('0' + civil.day / 10);
+        out[9] = static_cast<char>('0' + civil.day % 10);
+    }
+
+    string Date::toString() const {
+        if (empty()) return string();
+        string text(TEXT_LENGTH, '0');
+        format(&text[0]);
+        return text;
+    }
+
+    ostream& operator<<(ostream& os, Date date) {
+        if (date.empty()) return os;
+        char text[Date::TEXT_LENGTH];
+        date.format(text);
+        return os.write(text, Date::TEXT_LENGTH);
+    }
+}
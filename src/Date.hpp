@@ -0,0 +1,71 @@
+#pragma once
+
+#include "common.hpp"
+
+USING_STD_DATE
+
+namespace PokenoSouth {
+    /**
+     * Date for Pokeno South Primary School
+     * Calendar date stored as a single day number (days since 1970-01-01)
+     *
+     * Key Features:
+     * - 4 bytes; comparison and day arithmetic are plain integer operations
+     * - parse() accepts strict "YYYY-MM-DD" only and checks the day against the month
+     *   (leap years included), so "2024-02-30" is rejected instead of sorting between real dates
+     * - A default-constructed Date is empty, for optional fields such as a submission date;
+     *   empty formats as "" and sorts before every real date
+     * - Civil <-> day-number conversion is branch-light integer math (Howard Hinnant's algorithm),
+     *   valid for every year the four-digit format can express
+     */
+    class Date {
+    private:
+        static constexpr int32_t EMPTY_DAYS = INT32_MIN;
+        int32_t days = EMPTY_DAYS;
+
+        constexpr explicit Date(int32_t days) : days(days) {}
+
+    public:
+        constexpr Date() = default;
+
+        // === CONSTRUCTION ===
+        static constexpr Date fromDayNumber(int32_t dayNumber) { return Date(dayNumber); }
+        static Date fromCivil(int year, int month, int day);    // Throws invalid_argument if not a real date
+        static Date parse(string_view text);                     // Throws invalid_argument unless strict YYYY-MM-DD
+        static bool tryParse(string_view text, Date& out);       // Leaves 'out' untouched on failure
+        static Date today();                                     // Clock::today(): cached, and fakeable
+
+        // === QUERIES ===
+        constexpr bool empty() const { return days == EMPTY_DAYS; }
+        constexpr int32_t dayNumber() const { return days; }
+        int year() const;
+        int month() const;
+        int day() const;
+
+        // Whole years from this date to 'on', counting a year only once its anniversary is reached
+        int yearsUntil(Date on) const;
+
+        static bool isValidCivil(int year, int month, int day);
+        static constexpr bool isLeapYear(int year) { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
+
+        // === FORMATTING ===
+        static constexpr size_t TEXT_LENGTH = 10;   // "YYYY-MM-DD"
+        void format(char* out) const;               // Writes TEXT_LENGTH chars; caller ensures room. Not for empty dates
+        string toString() const;                    // "" when empty
+
+        // === ARITHMETIC AND ORDERING ===
+        constexpr Date addDays(int32_t count) const { return empty() ? *this : Date(days + count); }
+        constexpr int32_t daysSince(Date earlier) const { return days - earlier.days; }
+
+        constexpr bool operator==(Date other) const { return days == other.days; }
+        constexpr bool operator!=(Date other) const { return days != other.days; }
+        constexpr bool operator<(Date other) const { return days < other.days; }
+        constexpr bool operator<=(Date other) const { return days <= other.days; }
+        constexpr bool operator>(Date other) const { return days > other.days; }
+        constexpr bool operator>=(Date other) const { return days >= other.days; }
+    };
+
+    static_assert(sizeof(Date) == 4, "Date must stay a single 32-bit day number");
+
+    ostream& operator<<(ostream& os, Date date);
+}
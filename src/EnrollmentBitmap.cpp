@@ -0,0 +1,218 @@
+#include "EnrollmentBitmap.hpp"
+
+namespace PokenoSouth {
+
+    // === BIT HELPERS ===
+    size_t EnrollmentBitmap::popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<size_t>((word * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    uint32_t EnrollmentBitmap::lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<uint32_t>(__builtin_ctzll(word));
+#else
+        return static_cast<uint32_t>(popcount((word & (~word + 1)) - 1));
+#endif
+    }
+
+    // === REPRESENTATION ===
+    void EnrollmentBitmap::convertToDense() {
+        denseWords.assign(sparseKeys.empty() ? 0 : sparseKeys.back() / 64 + 1, 0);
+        for (uint32_t key : sparseKeys) {
+            denseWords[key / 64] |= uint64_t{1} << (key % 64);
+        }
+        vector<uint32_t>().swap(sparseKeys);
+        dense = true;
+    }
+
+    void EnrollmentBitmap::convertToSparse() {
+        vector<uint32_t> keys;
+        keys.reserve(count);
+        forEach([&keys](uint32_t key) { keys.push_back(key); });
+        sparseKeys.swap(keys);
+        vector<uint64_t>().swap(denseWords);
+        dense = false;
+    }
+
+    void EnrollmentBitmap::rebalance() {
+        // A sorted key costs 32 bits; a dense key range costs 1 bit per possible key.
+        // Switch back to sparse only at half the break-even density so that a row
+        // hovering around the threshold doesn't convert on every insert/erase.
+        if (!dense) {
+            if (count >= MIN_DENSE_COUNT && count * 32 >= static_cast<size_t>(sparseKeys.back()) + 1) {
+                convertToDense();
+            }
+        } else if (count < MIN_DENSE_COUNT / 2 || count * 32 * 2 < denseWords.size() * 64) {
+            convertToSparse();
+        }
+    }
+
+    // === MEMBERSHIP ===
+    bool EnrollmentBitmap::insert(uint32_t key) {
+        if (dense) {
+            const size_t word = key / 64;
+            const uint64_t mask = uint64_t{1} << (key % 64);
+            if (word >= denseWords.size()) {
+                denseWords.resize(word + 1, 0);
+            } else if (denseWords[word] & mask) {
+                return false;
+            }
+            denseWords[word] |= mask;
+        } else {
+            auto it = lower_bound(sparseKeys.begin(), sparseKeys.end(), key);
+            if (it != sparseKeys.end() && *it == key) {
+                return false;
+            }
+            sparseKeys.insert(it, key);
+        }
+        ++count;
+        rebalance();
+        return true;
+    }
+
+    bool EnrollmentBitmap::erase(uint32_t key) {
+        if (!contains(key)) {
+            return false;
+        }
+        if (dense) {
+            denseWords[key / 64] &= ~(uint64_t{1} << (key % 64));
+            while (!denseWords.empty() && denseWords.back() == 0) {
+                denseWords.pop_back();   // Keep the word count tied to the largest key
+            }
+        } else {
+            sparseKeys.erase(lower_bound(sparseKeys.begin(), sparseKeys.end(), key));
+        }
+        --count;
+        rebalance();
+        return true;
+    }
+
+    bool EnrollmentBitmap::contains(uint32_t key) const {
+        if (dense) {
+            const size_t word = key / 64;
+            return word < denseWords.size() && (denseWords[word] >> (key % 64)) & 1;
+        }
+        auto it = lower_bound(sparseKeys.begin(), sparseKeys.end(), key);
+        return it != sparseKeys.end() && *it == key;
+    }
+
+    void EnrollmentBitmap::clear() {
+        vector<uint32_t>().swap(sparseKeys);
+        vector<uint64_t>().swap(denseWords);
+        count = 0;
+        dense = false;
+    }
+
+    vector<uint32_t> EnrollmentBitmap::toVector() const {
+        if (!dense) {
+            return sparseKeys;
+        }
+        vector<uint32_t> keys;
+        keys.reserve(count);
+        forEach([&keys](uint32_t key) { keys.push_back(key); });
+        return keys;
+    }
+
+    // === SET QUERIES ===
+    EnrollmentBitmap EnrollmentBitmap::intersect(const EnrollmentBitmap& a, const EnrollmentBitmap& b) {
+        EnrollmentBitmap result;
+
+        if (a.dense && b.dense) {
+            // Word-parallel AND over the common key range
+            result.dense = true;
+            result.denseWords.resize(min(a.denseWords.size(), b.denseWords.size()));
+            for (size_t w = 0; w < result.denseWords.size(); ++w) {
+                result.denseWords[w] = a.denseWords[w] & b.denseWords[w];
+                result.count += popcount(result.denseWords[w]);
+            }
+            while (!result.denseWords.empty() && result.denseWords.back() == 0) {
+                result.denseWords.pop_back();
+            }
+        } else if (a.dense || b.dense) {
+            // Probe the dense side once per sparse key; output stays sorted
+            const EnrollmentBitmap& sparse = a.dense ? b : a;
+            const EnrollmentBitmap& bits = a.dense ? a : b;
+            for (uint32_t key : sparse.sparseKeys) {
+                if (bits.contains(key)) result.sparseKeys.push_back(key);
+            }
+            result.count = result.sparseKeys.size();
+        } else {
+            set_intersection(a.sparseKeys.begin(), a.sparseKeys.end(),
+                             b.sparseKeys.begin(), b.sparseKeys.end(),
+                             back_inserter(result.sparseKeys));
+            result.count = result.sparseKeys.size();
+        }
+
+        if (result.count > 0) result.rebalance();
+        else result.clear();
+        return result;
+    }
+
+    EnrollmentBitmap EnrollmentBitmap::unite(const EnrollmentBitmap& a, const EnrollmentBitmap& b) {
+        EnrollmentBitmap result;
+
+        if (a.dense && b.dense) {
+            // Word-parallel OR over the wider key range
+            const EnrollmentBitmap& wide = a.denseWords.size() >= b.denseWords.size() ? a : b;
+            const EnrollmentBitmap& narrow = &wide == &a ? b : a;
+            result.dense = true;
+            result.denseWords = wide.denseWords;
+            for (size_t w = 0; w < narrow.denseWords.size(); ++w) {
+                result.denseWords[w] |= narrow.denseWords[w];
+            }
+            for (uint64_t word : result.denseWords) {
+                result.count += popcount(word);
+            }
+        } else if (a.dense || b.dense) {
+            result = a.dense ? a : b;
+            for (uint32_t key : (a.dense ? b : a).sparseKeys) {
+                result.insert(key);
+            }
+            return result;
+        } else {
+            result.sparseKeys.reserve(a.sparseKeys.size() + b.sparseKeys.size());
+            set_union(a.sparseKeys.begin(), a.sparseKeys.end(),
+                      b.sparseKeys.begin(), b.sparseKeys.end(),
+                      back_inserter(result.sparseKeys));
+            result.count = result.sparseKeys.size();
+        }
+
+        if (result.count > 0) result.rebalance();
+        return result;
+    }
+
+    size_t EnrollmentBitmap::intersectionCount(const EnrollmentBitmap& a, const EnrollmentBitmap& b) {
+        size_t shared = 0;
+
+        if (a.dense && b.dense) {
+            const size_t words = min(a.denseWords.size(), b.denseWords.size());
+            for (size_t w = 0; w < words; ++w) {
+                shared += popcount(a.denseWords[w] & b.denseWords[w]);
+            }
+        } else if (a.dense || b.dense) {
+            const EnrollmentBitmap& sparse = a.dense ? b : a;
+            const EnrollmentBitmap& bits = a.dense ? a : b;
+            for (uint32_t key : sparse.sparseKeys) {
+                if (bits.contains(key)) ++shared;
+            }
+        } else {
+            // Merge walk; no allocation
+            auto left = a.sparseKeys.begin();
+            auto right = b.sparseKeys.begin();
+            while (left != a.sparseKeys.end() && right != b.sparseKeys.end()) {
+                if (*left < *right) ++left;
+                else if (*right < *left) ++right;
+                else { ++shared; ++left; ++right; }
+            }
+        }
+
+        return shared;
+    }
+}
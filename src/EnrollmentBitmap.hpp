@@ -0,0 +1,77 @@
+#pragma once
+
+#include "common.hpp"
+
+USING_STD_BITMAP
+
+namespace PokenoSouth {
+    /**
+     * EnrollmentBitmap for Pokeno South Primary School
+     * One row or column of the student x course enrollment matrix, as a set of integer keys
+     *
+     * Key Features:
+     * - Hybrid container (roaring-style): a sorted key array while sparse, a dense bitset once
+     *   the array would cost more memory than the bits covering the same key range
+     * - contains() is one word test when dense and a binary search over a few keys when sparse
+     * - intersect()/unite() AND/OR whole 64-bit words when both sides are dense,
+     *   and fall back to merges or probes otherwise
+     * - Keys are small dense integers: course SymbolKeys for a student's row,
+     *   roll numbers for a course's column
+     *
+     * Student and Course keep one of these next to their relationship vectors and update
+     * both together; the vectors still own order and pointers, the bitmap answers set questions.
+     */
+    class EnrollmentBitmap {
+    private:
+        vector<uint32_t> sparseKeys;   // Sorted ascending; used while !dense
+        vector<uint64_t> denseWords;   // Bit k of word k/64; used while dense
+        size_t count = 0;
+        bool dense = false;
+
+        // Below this many keys the sorted array always wins, whatever the key range
+        static constexpr size_t MIN_DENSE_COUNT = 32;
+
+        void convertToDense();
+        void convertToSparse();
+        void rebalance();
+
+        static size_t popcount(uint64_t word);
+        static uint32_t lowestBit(uint64_t word);   // word != 0
+
+    public:
+        EnrollmentBitmap() = default;
+
+        // === MEMBERSHIP ===
+        bool insert(uint32_t key);      // false if already present
+        bool erase(uint32_t key);       // false if absent
+        bool contains(uint32_t key) const;
+        void clear();
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        bool isDense() const { return dense; }
+
+        // === SET QUERIES ===
+        static EnrollmentBitmap intersect(const EnrollmentBitmap& a, const EnrollmentBitmap& b);
+        static EnrollmentBitmap unite(const EnrollmentBitmap& a, const EnrollmentBitmap& b);
+        static size_t intersectionCount(const EnrollmentBitmap& a, const EnrollmentBitmap& b);
+
+        vector<uint32_t> toVector() const;   // Ascending
+
+        // Visits every key in ascending order
+        template <typename Visitor>
+        void forEach(Visitor&& visitor) const {
+            if (!dense) {
+                for (uint32_t key : sparseKeys) visitor(key);
+                return;
+            }
+            for (size_t w = 0; w < denseWords.size(); ++w) {
+                uint64_t word = denseWords[w];
+                while (word) {
+                    visitor(static_cast<uint32_t>(w * 64 + lowestBit(word)));
+                    word &= word - 1;   // Clear lowest set bit
+                }
+            }
+        }
+    };
+}
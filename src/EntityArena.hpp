@@ -0,0 +1,154 @@
+#pragma once
+
+#include "common.hpp"
+
+USING_STD_ARENA
+
+namespace PokenoSouth {
+    // Stable index of an entity inside its EntityArena
+    using EntityHandle = uint32_t;
+    constexpr EntityHandle INVALID_HANDLE = UINT32_MAX;
+
+    /**
+     * EntityArena for Pokeno South Primary School
+     * Owning, chunked storage for one entity type, addressed by integer handles
+     *
+     * Key Features:
+     * - Entities live in deque chunks, so addresses and handles stay valid as the arena grows
+     * - Erased slots go on a free list and are reused by later emplace() calls
+     * - clear() destroys every entity and releases the chunks (nothing outlives a reload)
+     * - Iteration yields non-owning T* for live entities only, in handle order
+     * - membershipVersion() changes on every emplace/erase/clear, for caches keyed on the set of entities
+     * - Shallow constness, like vector<shared_ptr<T>>: a const arena still hands out mutable entities
+     *
+     * T must provide setHandle(EntityHandle); the arena stamps each entity with its slot.
+     * erase() destroys the entity at once: raw pointers to it dangle immediately, so owners
+     * must unlink relationships before calling erase(). Its handle fails contains() until a
+     * later emplace() reuses the slot, after which it names the new entity.
+     */
+    template <typename T>
+    class EntityArena {
+    private:
+        mutable deque<optional<T>> slots;       // See "shallow constness" above
+        vector<EntityHandle> freeHandles;
+        size_t liveCount = 0;
+        uint64_t membership = 0;
+
+    public:
+        // Forward iterator over live entities, yielding T* by value
+        class iterator {
+        private:
+            deque<optional<T>>* slots;
+            size_t index;
+
+            void skipEmpty() {
+                while (index < slots->size() && !(*slots)[index]) ++index;
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T*;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T**;
+            using reference = T*;
+
+            iterator(deque<optional<T>>* slots, size_t index) : slots(slots), index(index) { skipEmpty(); }
+
+            T* operator*() const { return &*(*slots)[index]; }
+            iterator& operator++() { ++index; skipEmpty(); return *this; }
+            iterator operator++(int) { iterator previous = *this; ++*this; return previous; }
+            bool operator==(const iterator& other) const { return index == other.index; }
+            bool operator!=(const iterator& other) const { return index != other.index; }
+        };
+
+        EntityArena() = default;
+        EntityArena(const EntityArena&) = delete;              // Entities are referenced by address
+        EntityArena& operator=(const EntityArena&) = delete;
+
+        // === CREATION AND REMOVAL ===
+
+        /**
+         * Constructs an entity in a free slot. If T's constructor throws (validation),
+         * the slot is returned to the free list and the exception propagates.
+         */
+        template <typename... Args>
+        T* emplace(Args&&... args) {
+            EntityHandle handle;
+            if (!freeHandles.empty()) {
+                handle = freeHandles.back();
+                freeHandles.pop_back();
+            } else {
+                handle = static_cast<EntityHandle>(slots.size());
+                slots.emplace_back();
+            }
+
+            try {
+                slots[handle].emplace(std::forward<Args>(args)...);
+            } catch (...) {
+                freeHandles.push_back(handle);
+                throw;
+            }
+
+            T* entity = &*slots[handle];
+            entity->setHandle(handle);
+            ++liveCount;
+            ++membership;
+            return entity;
+        }
+
+        bool erase(EntityHandle handle) {
+            if (!contains(handle)) return false;
+            slots[handle].reset();
+            freeHandles.push_back(handle);
+            --liveCount;
+            ++membership;
+            return true;
+        }
+
+        bool erase(const T* entity) {
+            return entity && erase(entity->getHandle());
+        }
+
+        // Erases every live entity matching the predicate; returns how many were erased
+        template <typename Predicate>
+        size_t eraseIf(Predicate predicate) {
+            size_t erased = 0;
+            for (size_t handle = 0; handle < slots.size(); ++handle) {
+                if (slots[handle] && predicate(&*slots[handle])) {
+                    erase(static_cast<EntityHandle>(handle));
+                    ++erased;
+                }
+            }
+            return erased;
+        }
+
+        void clear() {
+            deque<optional<T>>().swap(slots);  // Destroy entities and release chunks
+            freeHandles.clear();
+            freeHandles.shrink_to_fit();
+            liveCount = 0;
+            ++membership;
+        }
+
+        // === ACCESS ===
+        bool contains(EntityHandle handle) const { return handle < slots.size() && slots[handle].has_value(); }
+        T* get(EntityHandle handle) const { return contains(handle) ? &*slots[handle] : nullptr; }
+
+        template <typename Predicate>
+        T* findIf(Predicate predicate) const {
+            for (T* entity : *this) {
+                if (predicate(entity)) return entity;
+            }
+            return nullptr;
+        }
+
+        size_t size() const { return liveCount; }
+        bool empty() const { return liveCount == 0; }
+        size_t capacity() const { return slots.size(); }   // Highest handle + 1; sizes handle-indexed tables
+        uint64_t membershipVersion() const { return membership; }
+
+        // === ITERATION ===
+        iterator begin() const { return iterator(&slots, 0); }
+        iterator end() const { return iterator(&slots, slots.size()); }
+    };
+}
@@ -16,7 +16,7 @@ namespace PokenoSouth {
     
     const vector<string> FileHandler::COURSE_HEADERS = {
         "CourseId", "CourseName", "Credits", "Description", "Teacher", "Duration",
-        "StartDate", "EndDate", "MaxEnrollment", "IsActive"
+        "StartDate", "EndDate", "MaxEnrollment", "IsActive", "GradingPolicy"
     };
     
     const vector<string> FileHandler::ASSESSMENT_HEADERS = {
@@ -38,17 +38,24 @@ namespace PokenoSouth {
         bool inQuotes = false;
         string current = "";
         
-        for (char c : line) {
+        for (size_t i = 0; i < line.size(); ++i) {
+            const char c = line[i];
             if (c == '"') {
-                inQuotes = !inQuotes;
+                // A doubled quote inside a quoted field is one literal quote (see escapeCSVField)
+                if (inQuotes && i + 1 < line.size() && line[i + 1] == '"') {
+                    current += c;
+                    ++i;
+                } else {
+                    inQuotes = !inQuotes;
+                }
             } else if (c == CSV_DELIMITER && !inQuotes) {
-                fields.push_back(Common::trimString(current));
-                current = "";
+                fields.emplace_back(Common::trimView(current));
+                current.clear();
             } else {
                 current += c;
             }
         }
-        fields.push_back(Common::trimString(current));
+        fields.emplace_back(Common::trimView(current));
         
         return fields;
     }
@@ -100,7 +107,13 @@ namespace PokenoSouth {
         string filename = (lastSlash != string::npos) ?
                               originalPath.substr(lastSlash + 1) : originalPath;
         
-        return string(BACKUP_DIRECTORY) + filename + "_" + oss.str() + ".bak";
+        // Two saves within one second each keep their own backup
+        const string stem = string(BACKUP_DIRECTORY) + filename + "_" + oss.str();
+        string backupPath = stem + ".bak";
+        for (int copy = 2; fileExists(backupPath); ++copy) {
+            backupPath = stem + "-" + to_string(copy) + ".bak";
+        }
+        return backupPath;
     }
     
     void FileHandler::setError(const string& error) {
@@ -108,6 +121,142 @@ namespace PokenoSouth {
         errorFlag = true;
     }
     
+    // === CHECKSUM SIDECARS ===
+    // "<file>.sum" holds "crc32c <checksum> <size> <origin>" for the exact bytes of <file>. The CRC is
+    // taken block by block as the file is written, copied or read, so checking it never costs a pass
+    // of its own. Origin "save" means a save wrote the file from live entities: if it still matches,
+    // its rows need no re-validation on load. Copies (backups, restores) keep the origin of a source
+    // that verified and get "copy" otherwise. Hand edits, old files and interrupted writes fail to match.
+    
+    namespace {
+        constexpr size_t CHECKSUM_BLOCK_SIZE = 64 * 1024;
+        
+        // Reads 'file' to the end, adding each block to 'crc' before handing it to 'sink'; returns the byte count
+        template <typename Sink>
+        uint64_t streamBlocks(ifstream& file, Crc32c& crc, Sink&& sink) {
+            vector<char> buffer(CHECKSUM_BLOCK_SIZE);
+            uint64_t total = 0;
+            while (file) {
+                file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                const size_t length = static_cast<size_t>(file.gcount());
+                if (length == 0) break;
+                crc.update(buffer.data(), length);
+                sink(buffer.data(), length);
+                total += length;
+            }
+            return total;
+        }
+    }
+    
+    bool FileHandler::readChecksumRecord(const string& filePath, ChecksumRecord& record) {
+        ifstream sidecar(filePath + CHECKSUM_EXTENSION);
+        string algorithm;
+        string origin;
+        if (!(sidecar >> algorithm >> std::hex >> record.checksum >> std::dec >> record.size >> origin) ||
+            algorithm != CHECKSUM_ALGORITHM) {
+            return false;
+        }
+        record.fromSave = (origin == "save");
+        return true;
+    }
+    
+    bool FileHandler::writeChecksumRecord(const string& filePath, const ChecksumRecord& record) {
+        ofstream sidecar(filePath + CHECKSUM_EXTENSION, ios::trunc);
+        sidecar << CHECKSUM_ALGORITHM << ' ' << std::hex << std::setw(8) << std::setfill('0') << record.checksum
+                << std::dec << ' ' << record.size << ' ' << (record.fromSave ? "save" : "copy") << "\n";
+        sidecar.close();
+        return static_cast<bool>(sidecar);
+    }
+    
+    FileHandler::FileIntegrity FileHandler::checkIntegrity(const string& filePath, uint32_t checksum, uint64_t size) {
+        ChecksumRecord record;
+        if (!readChecksumRecord(filePath, record)) return FileIntegrity::UNVERIFIED;
+        if (record.checksum != checksum || record.size != size) return FileIntegrity::MODIFIED;
+        return record.fromSave ? FileIntegrity::SAVED : FileIntegrity::INTACT;
+    }
+    
+    const char* FileHandler::integrityNote(FileIntegrity integrity) {
+        switch (integrity) {
+            case FileIntegrity::SAVED:
+            case FileIntegrity::INTACT:   return " (checksum verified)";
+            case FileIntegrity::MODIFIED: return " (checksum mismatch, fully validated)";
+            default:                      return "";
+        }
+    }
+    
+    bool FileHandler::writeFileWithChecksum(const string& filePath, const string& content) {
+        ofstream file(filePath, ios::binary | ios::trunc);
+        if (!file.good()) return false;
+        Crc32c crc;
+        for (size_t offset = 0; offset < content.size(); offset += CHECKSUM_BLOCK_SIZE) {
+            const size_t length = std::min(CHECKSUM_BLOCK_SIZE, content.size() - offset);
+            crc.update(content.data() + offset, length);
+            file.write(content.data() + offset, static_cast<std::streamsize>(length));
+        }
+        file.close();
+        if (!file) return false;
+        return writeChecksumRecord(filePath, {crc.value(), content.size(), true});
+    }
+    
+    bool FileHandler::readFileWithChecksum(const string& filePath, string& content, FileIntegrity& integrity) {
+        integrity = FileIntegrity::UNVERIFIED;
+        ifstream file(filePath, ios::binary);
+        if (!file.good()) return false;
+        content.clear();
+        Crc32c crc;
+        const uint64_t size = streamBlocks(file, crc, [&content](const char* data, size_t length) {
+            content.append(data, length);
+        });
+        integrity = checkIntegrity(filePath, crc.value(), size);
+        return true;
+    }
+    
+    FileHandler::FileIntegrity FileHandler::verifyFileChecksum(const string& filePath) {
+        ifstream file(filePath, ios::binary);
+        if (!file.good()) return FileIntegrity::UNVERIFIED;
+        Crc32c crc;
+        const uint64_t size = streamBlocks(file, crc, [](const char*, size_t) {});
+        return checkIntegrity(filePath, crc.value(), size);
+    }
+    
+    FileHandler::FileIntegrity FileHandler::copyWithChecksum(const string& from, const string& to, bool requireIntact) {
+        ifstream source(from, ios::binary);
+        if (!source.good()) throw runtime_error("cannot read " + from);
+        const string partial = to + ".part";
+        ofstream target(partial, ios::binary | ios::trunc);
+        if (!target.good()) throw runtime_error("cannot write " + partial);
+        
+        Crc32c crc;
+        const uint64_t size = streamBlocks(source, crc, [&target](const char* data, size_t length) {
+            target.write(data, static_cast<std::streamsize>(length));
+        });
+        target.close();
+        if (!target) {
+            std::filesystem::remove(partial);
+            throw runtime_error("failed writing " + partial);
+        }
+        
+        const FileIntegrity integrity = checkIntegrity(from, crc.value(), size);
+        if (requireIntact && integrity == FileIntegrity::MODIFIED) {
+            std::filesystem::remove(partial);   // Leave 'to' as it was
+            return integrity;
+        }
+        std::filesystem::remove(to + CHECKSUM_EXTENSION);   // Never leave 'to' paired with a stale record
+        std::filesystem::rename(partial, to);
+        writeChecksumRecord(to, {crc.value(), size, integrity == FileIntegrity::SAVED});
+        return integrity;
+    }
+    
+    void FileHandler::moveWithChecksum(const string& from, const string& to) {
+        std::filesystem::rename(from, to);
+        const string sidecar = from + CHECKSUM_EXTENSION;
+        if (fileExists(sidecar)) {
+            std::filesystem::rename(sidecar, to + CHECKSUM_EXTENSION);   // After the data, so a crash can only orphan it
+        } else if (fileExists(to + CHECKSUM_EXTENSION)) {
+            std::filesystem::remove(to + CHECKSUM_EXTENSION);
+        }
+    }
+    
     // === T035: ENHANCED ERROR HANDLING ===
     
     bool FileHandler::validateFilePermissions(const string& filePath) {
@@ -251,13 +400,19 @@ namespace PokenoSouth {
                 return false;
             }
             
+            // A checksum sidecar settles it exactly
+            const FileIntegrity integrity = verifyFileChecksum(filePath);
+            if (integrity != FileIntegrity::UNVERIFIED) {
+                return integrity != FileIntegrity::MODIFIED;
+            }
+            
             // Check if file is readable
             ifstream file(filePath);
             if (!file.good()) {
                 return false;
             }
             
-            // Try to read first few lines to check basic structure
+            // Without one, try to read first few lines to check basic structure
             string line;
             int validLines = 0;
             while (getline(file, line) && validLines < 5) {
@@ -326,18 +481,14 @@ namespace PokenoSouth {
                 return false;
             }
             
-            ofstream file(filePath);
-            if (!file.good()) {
-                return false;
-            }
-            
+            ostringstream file;
             for (size_t i = 0; i < headers.size(); ++i) {
                 if (i > 0) file << ",";
                 file << headers[i];
             }
             file << "\n";
             
-            return true;
+            return writeFileWithChecksum(filePath, file.str());
         } catch (const exception&) {
             return false;
         }
@@ -426,7 +577,8 @@ namespace PokenoSouth {
         try {
             if (std::filesystem::exists(DATA_DIRECTORY)) {
                 for (const auto& entry : std::filesystem::directory_iterator(DATA_DIRECTORY)) {
-                    if (entry.is_regular_file() && entry.path().extension() == ".csv") {
+                    if (entry.is_regular_file() && (entry.path().extension() == ".csv" ||
+                                                    entry.path().extension() == CHECKSUM_EXTENSION)) {
                         std::filesystem::remove(entry.path());
                     }
                 }
@@ -486,7 +638,11 @@ namespace PokenoSouth {
             }
             
             string backupPath = generateBackupFilename(filePath);
-            std::filesystem::copy_file(filePath, backupPath);
+            if (fileExists(backupPath)) {
+                setError("Failed to backup file: " + filePath + " - backup already exists: " + backupPath);
+                return false;
+            }
+            copyWithChecksum(filePath, backupPath, false);
             
             logOperation("Backup", true, filePath + " -> " + backupPath);
             return true;
@@ -515,8 +671,10 @@ namespace PokenoSouth {
             }
             
             string originalPath = string(DATA_DIRECTORY) + filename;
-            std::filesystem::copy_file(backupPath, originalPath,
-                                     std::filesystem::copy_options::overwrite_existing);
+            if (copyWithChecksum(backupPath, originalPath, true) == FileIntegrity::MODIFIED) {
+                setError("Backup failed checksum verification: " + backupPath);
+                return false;
+            }
             
             logOperation("Restore", true, backupPath + " -> " + originalPath);
             return true;
@@ -544,11 +702,11 @@ namespace PokenoSouth {
     
     // === STUDENT OPERATIONS ===
     
-    bool FileHandler::loadStudentsFromFile(vector<shared_ptr<Student>>& students) {
+    bool FileHandler::loadStudentsFromFile(EntityArena<Student>& students) {
         return loadStudentsFromFile(students, STUDENTS_FILE);
     }
     
-    bool FileHandler::loadStudentsFromFile(vector<shared_ptr<Student>>& students,
+    bool FileHandler::loadStudentsFromFile(EntityArena<Student>& students,
                                          const string& filePath) {
         try {
             clearLastError();
@@ -563,7 +721,13 @@ namespace PokenoSouth {
                 return false;
             }
             
-            ifstream file(filePath);
+            string content;
+            FileIntegrity integrity;
+            if (!readFileWithChecksum(filePath, content, integrity)) {
+                setError("Cannot read students file: " + filePath);
+                return false;
+            }
+            istringstream file(content);
             string line;
             bool firstLine = true;
             int lineNumber = 0;
@@ -594,7 +758,12 @@ namespace PokenoSouth {
                 
                 try {
                     int rollNumber = stoi(fields[0]);
-                    auto student = make_shared<Student>(
+                    if (integrity == FileIntegrity::SAVED) {
+                        students.emplace(TRUSTED_INPUT, rollNumber, fields[1], fields[2], Date::parse(fields[4]),
+                                         fields[3], fields[5], fields[6], Date::parse(fields[7]));
+                        continue;
+                    }
+                    students.emplace(
                         rollNumber,
                         fields[1], // firstName
                         fields[2], // lastName
@@ -604,15 +773,16 @@ namespace PokenoSouth {
                         fields[6], // emergencyContact
                         fields[7]  // enrollmentDate
                     );
-                    
-                    students.push_back(student);
                 } catch (const exception& e) {
+                    // Shown, not just kept as the last error: stricter date rules can reject rows older saves accepted
                     setError("Failed to create student from line " + to_string(lineNumber) + ": " + e.what());
+                    logOperation("Skip Student Record", false, getLastError());
                     continue; // Skip this record but continue processing
                 }
             }
             
-            logOperation("Load Students", true, "Loaded " + to_string(students.size()) + " students from " + filePath);
+            logOperation("Load Students", true, "Loaded " + to_string(students.size()) + " students from " + filePath +
+                         integrityNote(integrity));
             return true;
             
         } catch (const exception& e) {
@@ -621,21 +791,17 @@ namespace PokenoSouth {
         }
     }
     
-    bool FileHandler::saveStudentsToFile(const vector<shared_ptr<Student>>& students) {
+    bool FileHandler::saveStudentsToFile(const EntityArena<Student>& students) {
         return saveStudentsToFile(students, STUDENTS_FILE);
     }
     
-    bool FileHandler::saveStudentsToFile(const vector<shared_ptr<Student>>& students,
+    bool FileHandler::saveStudentsToFile(const EntityArena<Student>& students,
                                        const string& filePath) {
         try {
             clearLastError();
             createDataDirectories();
             
-            ofstream file(filePath);
-            if (!file.good()) {
-                setError("Cannot write to students file: " + filePath);
-                return false;
-            }
+            ostringstream file;   // Written out in one go, with its checksum sidecar
             
             // Write headers
             for (size_t i = 0; i < STUDENT_HEADERS.size(); ++i) {
@@ -658,6 +824,11 @@ namespace PokenoSouth {
                      << student->getEnrollmentDate() << "\n";
             }
             
+            if (!writeFileWithChecksum(filePath, file.str())) {
+                setError("Cannot write to students file: " + filePath);
+                return false;
+            }
+            
             logOperation("Save Students", true, "Saved " + to_string(students.size()) + " students to " + filePath);
             return true;
             
@@ -669,11 +840,11 @@ namespace PokenoSouth {
     
     // === COURSE OPERATIONS ===
     
-    bool FileHandler::loadCoursesFromFile(vector<shared_ptr<Course>>& courses) {
+    bool FileHandler::loadCoursesFromFile(EntityArena<Course>& courses) {
         return loadCoursesFromFile(courses, COURSES_FILE);
     }
     
-    bool FileHandler::loadCoursesFromFile(vector<shared_ptr<Course>>& courses,
+    bool FileHandler::loadCoursesFromFile(EntityArena<Course>& courses,
                                         const string& filePath) {
         try {
             clearLastError();
@@ -683,10 +854,17 @@ namespace PokenoSouth {
                 return false;
             }
             
-            ifstream file(filePath);
+            string content;
+            FileIntegrity integrity;
+            if (!readFileWithChecksum(filePath, content, integrity)) {
+                setError("Cannot read courses file: " + filePath);
+                return false;
+            }
+            istringstream file(content);
             string line;
             bool firstLine = true;
             int lineNumber = 0;
+            size_t fieldCount = COURSE_HEADERS.size();   // One less in files from before GradingPolicy
             
             courses.clear();
             
@@ -699,14 +877,17 @@ namespace PokenoSouth {
                 
                 if (firstLine) {
                     firstLine = false;
-                    if (!validateCSVHeaders(fields, COURSE_HEADERS)) {
+                    const vector<string> legacyHeaders(COURSE_HEADERS.begin(), COURSE_HEADERS.end() - 1);
+                    if (validateCSVHeaders(fields, legacyHeaders)) {
+                        fieldCount = legacyHeaders.size();   // Every course keeps the default policy
+                    } else if (!validateCSVHeaders(fields, COURSE_HEADERS)) {
                         setError("Invalid CSV headers in courses file at line " + to_string(lineNumber));
                         return false;
                     }
                     continue;
                 }
                 
-                if (fields.size() != COURSE_HEADERS.size()) {
+                if (fields.size() != fieldCount) {
                     setError("Invalid field count in courses file at line " + to_string(lineNumber));
                     continue;
                 }
@@ -720,20 +901,36 @@ namespace PokenoSouth {
                     transform(isActiveStr.begin(), isActiveStr.end(), isActiveStr.begin(), [](char c) {return tolower(c);});
                     bool isActive = (isActiveStr == "yes" || isActiveStr == "active" || isActiveStr == "true");
                     
-                    auto course = make_shared<Course>(
-                        fields[0], // courseId
-                        fields[1], // courseName
-                        credits,
-                        fields[3], // description
-                        duration,
-                        fields[4], // teacher
-                        fields[6], // startDate
-                        fields[7], // endDate
-                        maxEnrollment,
-                        isActive
-                    );
+                    Course* course = nullptr;
+                    if (integrity == FileIntegrity::SAVED) {
+                        course = courses.emplace(TRUSTED_INPUT, fields[0], fields[1], credits, fields[3], duration,
+                                                 fields[4], parseOptionalDate(fields[6]), parseOptionalDate(fields[7]),
+                                                 maxEnrollment, isActive);
+                    } else {
+                        course = courses.emplace(
+                            fields[0], // courseId
+                            fields[1], // courseName
+                            credits,
+                            fields[3], // description
+                            duration,
+                            fields[4], // teacher
+                            fields[6], // startDate
+                            fields[7], // endDate
+                            maxEnrollment,
+                            isActive
+                        );
+                    }
                     
-                    courses.push_back(course);
+                    // Assigned before any assessment is graded; an unknown name keeps the default
+                    const string policyName = fields.size() > 10 && !fields[10].empty()
+                        ? fields[10] : string(GradingPolicyRegistry::DEFAULT_POLICY);
+                    try {
+                        course->setGradingPolicy(policyName);
+                    } catch (const invalid_argument& e) {
+                        course->setGradingPolicy(GradingPolicyRegistry::DEFAULT_POLICY);
+                        setError("Course at line " + to_string(lineNumber) + ": " + e.what() + "; using " +
+                                 GradingPolicyRegistry::DEFAULT_POLICY);
+                    }
                     
                 } catch (const exception& e) {
                     setError("Failed to create course from line " + to_string(lineNumber) + ": " + e.what());
@@ -741,7 +938,8 @@ namespace PokenoSouth {
                 }
             }
             
-            logOperation("Load Courses", true, "Loaded " + to_string(courses.size()) + " courses from " + filePath);
+            logOperation("Load Courses", true, "Loaded " + to_string(courses.size()) + " courses from " + filePath +
+                         integrityNote(integrity));
             return true;
             
         } catch (const exception& e) {
@@ -750,21 +948,17 @@ namespace PokenoSouth {
         }
     }
     
-    bool FileHandler::saveCoursesToFile(const vector<shared_ptr<Course>>& courses) {
+    bool FileHandler::saveCoursesToFile(const EntityArena<Course>& courses) {
         return saveCoursesToFile(courses, COURSES_FILE);
     }
     
-    bool FileHandler::saveCoursesToFile(const vector<shared_ptr<Course>>& courses,
+    bool FileHandler::saveCoursesToFile(const EntityArena<Course>& courses,
                                       const string& filePath) {
         try {
             clearLastError();
             createDataDirectories();
             
-            ofstream file(filePath);
-            if (!file.good()) {
-                setError("Cannot write to courses file: " + filePath);
-                return false;
-            }
+            ostringstream file;   // Written out in one go, with its checksum sidecar
             
             // Write headers
             for (size_t i = 0; i < COURSE_HEADERS.size(); ++i) {
@@ -786,7 +980,13 @@ namespace PokenoSouth {
                      << course->getStartDate() << CSV_DELIMITER
                      << course->getEndDate() << CSV_DELIMITER
                      << course->getMaxEnrollment() << CSV_DELIMITER
-                     << (course->getIsActive() ? "Yes" : "No") << "\n";
+                     << (course->getIsActive() ? "Yes" : "No") << CSV_DELIMITER
+                     << escapeCSVField(course->getGradingPolicyName()) << "\n";
+            }
+            
+            if (!writeFileWithChecksum(filePath, file.str())) {
+                setError("Cannot write to courses file: " + filePath);
+                return false;
             }
             
             logOperation("Save Courses", true, "Saved " + to_string(courses.size()) + " courses to " + filePath);
@@ -800,11 +1000,11 @@ namespace PokenoSouth {
     
     // === ASSESSMENT OPERATIONS ===
     
-    bool FileHandler::loadAssessmentsFromFile(vector<shared_ptr<Assessment>>& assessments) {
+    bool FileHandler::loadAssessmentsFromFile(EntityArena<Assessment>& assessments) {
         return loadAssessmentsFromFile(assessments, ASSESSMENTS_FILE);
     }
     
-    bool FileHandler::loadAssessmentsFromFile(vector<shared_ptr<Assessment>>& assessments,
+    bool FileHandler::loadAssessmentsFromFile(EntityArena<Assessment>& assessments,
                                             const string& filePath) {
         try {
             clearLastError();
@@ -814,7 +1014,13 @@ namespace PokenoSouth {
                 return false;
             }
             
-            ifstream file(filePath);
+            string content;
+            FileIntegrity integrity;
+            if (!readFileWithChecksum(filePath, content, integrity)) {
+                setError("Cannot read assessments file: " + filePath);
+                return false;
+            }
+            istringstream file(content);
             string line;
             bool firstLine = true;
             int lineNumber = 0;
@@ -848,7 +1054,13 @@ namespace PokenoSouth {
                     double finalMarks = stod(fields[4]);
                     bool isSubmitted = (fields[8] == "Yes" || fields[8] == "true");
                     
-                    auto assessment = make_shared<Assessment>(
+                    if (integrity == FileIntegrity::SAVED) {
+                        assessments.emplace(TRUSTED_INPUT, fields[0], studentRollNumber, fields[2],
+                                            internalMarks, finalMarks, Date::parse(fields[6]), fields[7],
+                                            isSubmitted, parseOptionalDate(fields[9]), fields[10]);
+                        continue;
+                    }
+                    Assessment* assessment = assessments.emplace(
                         fields[0], // assessmentId
                         studentRollNumber,
                         fields[2], // courseId
@@ -863,8 +1075,7 @@ namespace PokenoSouth {
                     if (!fields[9].empty()) {
                         assessment->setSubmissionDate(fields[9]);
                     }
-                    
-                    assessments.push_back(assessment);
+
                     
                 } catch (const exception& e) {
                     setError("Failed to create assessment from line " + to_string(lineNumber) + ": " + e.what());
@@ -872,7 +1083,8 @@ namespace PokenoSouth {
                 }
             }
             
-            logOperation("Load Assessments", true, "Loaded " + to_string(assessments.size()) + " assessments from " + filePath);
+            logOperation("Load Assessments", true, "Loaded " + to_string(assessments.size()) + " assessments from " + filePath +
+                         integrityNote(integrity));
             return true;
             
         } catch (const exception& e) {
@@ -881,21 +1093,17 @@ namespace PokenoSouth {
         }
     }
     
-    bool FileHandler::saveAssessmentsToFile(const vector<shared_ptr<Assessment>>& assessments) {
+    bool FileHandler::saveAssessmentsToFile(const EntityArena<Assessment>& assessments) {
         return saveAssessmentsToFile(assessments, ASSESSMENTS_FILE);
     }
     
-    bool FileHandler::saveAssessmentsToFile(const vector<shared_ptr<Assessment>>& assessments,
+    bool FileHandler::saveAssessmentsToFile(const EntityArena<Assessment>& assessments,
                                           const string& filePath) {
         try {
             clearLastError();
             createDataDirectories();
             
-            ofstream file(filePath);
-            if (!file.good()) {
-                setError("Cannot write to assessments file: " + filePath);
-                return false;
-            }
+            ostringstream file;   // Written out in one go, with its checksum sidecar
             
             // Write headers
             for (size_t i = 0; i < ASSESSMENT_HEADERS.size(); ++i) {
@@ -921,6 +1129,11 @@ namespace PokenoSouth {
                      << escapeCSVField(assessment->getRemarks()) << "\n";
             }
             
+            if (!writeFileWithChecksum(filePath, file.str())) {
+                setError("Cannot write to assessments file: " + filePath);
+                return false;
+            }
+            
             logOperation("Save Assessments", true, "Saved " + to_string(assessments.size()) + " assessments to " + filePath);
             return true;
             
@@ -930,19 +1143,32 @@ namespace PokenoSouth {
         }
     }
     
-    bool FileHandler::loadAllData(vector<shared_ptr<Student>>& students,
-                                vector<shared_ptr<Course>>& courses,
-                                vector<shared_ptr<Assessment>>& assessments) {
+    bool FileHandler::loadAllData(EntityArena<Student>& students,
+                                EntityArena<Course>& courses,
+                                EntityArena<Assessment>& assessments) {
         bool success = true;
         
+        // Drop the old graph as a whole: entities link to each other by pointer across arenas
+        students.clear();
+        courses.clear();
+        assessments.clear();
+        
         success &= loadStudentsFromFile(students);
         success &= loadCoursesFromFile(courses);
         success &= loadAssessmentsFromFile(assessments);
         
-        // Load enrollments to establish relationships
-        if (success) {
-            success &= loadEnrollments(students, courses);
-        }
+        // Link phase: index students and courses once, then attach every enrollment
+        // and assessment in a single pass over each
+        vector<EnrollmentRecord> enrollmentRecords;
+        success &= readEnrollmentRecords(enrollmentRecords);
+        
+        const unordered_map<int, Student*> studentsByRollNumber = indexStudentsByRollNumber(students);
+        const vector<Course*> coursesByKey = indexCoursesByKey(courses);
+        const int enrollmentsLinked = linkEnrollments(enrollmentRecords, studentsByRollNumber, coursesByKey);
+        const int assessmentsLinked = linkAssessments(assessments, studentsByRollNumber, coursesByKey);
+        logOperation("Link Relationships", true,
+                     "Linked " + to_string(enrollmentsLinked) + " enrollments and " +
+                     to_string(assessmentsLinked) + " assessments");
         
         if (success) {
             logOperation("Load All Data", true, "Successfully loaded all system data with relationships");
@@ -953,9 +1179,9 @@ namespace PokenoSouth {
         return success;
     }
     
-    bool FileHandler::saveAllData(const vector<shared_ptr<Student>>& students,
-                                const vector<shared_ptr<Course>>& courses,
-                                const vector<shared_ptr<Assessment>>& assessments) {
+    bool FileHandler::saveAllData(const EntityArena<Student>& students,
+                                const EntityArena<Course>& courses,
+                                const EntityArena<Assessment>& assessments) {
         
         // T041: Enhanced data consistency with atomic operations
         
@@ -1012,10 +1238,10 @@ namespace PokenoSouth {
             
             if (success) {
                 // Atomic replacement: move temp files to final locations
-                std::filesystem::rename(tempStudents, STUDENTS_FILE);
-                std::filesystem::rename(tempCourses, COURSES_FILE);
-                std::filesystem::rename(tempAssessments, ASSESSMENTS_FILE);
-                std::filesystem::rename(tempEnrollments, ENROLLMENTS_FILE);
+                moveWithChecksum(tempStudents, STUDENTS_FILE);
+                moveWithChecksum(tempCourses, COURSES_FILE);
+                moveWithChecksum(tempAssessments, ASSESSMENTS_FILE);
+                moveWithChecksum(tempEnrollments, ENROLLMENTS_FILE);
                 
                 logOperation("Save All Data", true, 
                     "Successfully saved all system data with atomic operations");
@@ -1042,12 +1268,12 @@ namespace PokenoSouth {
             
             // Create empty files with headers if they don't exist
             if (!fileExists(STUDENTS_FILE)) {
-                vector<shared_ptr<Student>> emptyStudents;
+                EntityArena<Student> emptyStudents;
                 saveStudentsToFile(emptyStudents);
             }
             
             if (!fileExists(COURSES_FILE)) {
-                vector<shared_ptr<Course>> emptyCourses;
+                EntityArena<Course> emptyCourses;
                 saveCoursesToFile(emptyCourses);
             }
             
@@ -1062,21 +1288,46 @@ namespace PokenoSouth {
     
     // === ENROLLMENT RELATIONSHIP OPERATIONS ===
     
-    bool FileHandler::loadEnrollments(vector<shared_ptr<Student>>& students,
-                                    vector<shared_ptr<Course>>& courses) {
+    bool FileHandler::loadEnrollments(EntityArena<Student>& students,
+                                    EntityArena<Course>& courses) {
+        vector<EnrollmentRecord> records;
+        if (!readEnrollmentRecords(records)) {
+            return false;
+        }
+        
+        int enrollmentsProcessed = linkEnrollments(records, indexStudentsByRollNumber(students),
+                                                   indexCoursesByKey(courses));
+        logOperation("Load Enrollments", true, "Processed " + to_string(enrollmentsProcessed) + " enrollments");
+        return true;
+    }
+    
+    bool FileHandler::readEnrollmentRecords(vector<EnrollmentRecord>& records) {
         try {
             clearLastError();
+            records.clear();
             
             if (!fileExists(ENROLLMENTS_FILE)) {
                 logOperation("Load Enrollments", true, "No enrollments file found - starting with empty enrollments");
                 return true; // No enrollments file is valid for new system
             }
             
-            ifstream file(ENROLLMENTS_FILE);
+            // Enrollment rows are only checked for shape, so unlike the entity files a checksum
+            // mismatch cannot fall back to full validation: the file is rejected instead
+            string content;
+            FileIntegrity integrity;
+            if (!readFileWithChecksum(ENROLLMENTS_FILE, content, integrity)) {
+                setError("Cannot read enrollments file: " + string(ENROLLMENTS_FILE));
+                return false;
+            }
+            if (integrity == FileIntegrity::MODIFIED) {
+                setError("Enrollments file failed its checksum and was not loaded: " + string(ENROLLMENTS_FILE));
+                logOperation("Read Enrollments", false, getLastError());
+                return false;
+            }
+            istringstream file(content);
             string line;
             bool firstLine = true;
             int lineNumber = 0;
-            int enrollmentsProcessed = 0;
             
             while (getline(file, line)) {
                 lineNumber++;
@@ -1099,45 +1350,21 @@ namespace PokenoSouth {
                     continue;
                 }
                 
+                // Only process active enrollments (older saves wrote "ACTIVE")
+                string status = fields[4];
+                transform(status.begin(), status.end(), status.begin(), [](char c) {return tolower(c);});
+                if (status != "active") continue;
+                
                 try {
-                    int studentRollNumber = stoi(fields[1]);
-                    string courseId = fields[2];
-                    string status = fields[4];
-                    
-                    // Only process active enrollments
-                    if (status != "Active") continue;
-                    
-                    // Find student and course
-                    auto student = findStudentByRollNumber(studentRollNumber, students);
-                    auto course = findCourseById(courseId, courses);
-                    
-                    if (!student) {
-                        setError("Student not found for enrollment: " + to_string(studentRollNumber));
-                        continue;
-                    }
-                    
-                    if (!course) {
-                        setError("Course not found for enrollment: " + courseId);
-                        continue;
-                    }
-                    
-                    // Establish bidirectional relationship
-                    try {
-                        student->enrollInCourse(course);
-                        course->enrollStudent(student);
-                        enrollmentsProcessed++;
-                    } catch (const exception& e) {
-                        setError("Failed to establish enrollment relationship: " + string(e.what()));
-                        continue;
-                    }
-                    
+                    records.push_back({stoi(fields[1]), fields[2]});
                 } catch (const exception& e) {
                     setError("Failed to process enrollment at line " + to_string(lineNumber) + ": " + e.what());
                     continue;
                 }
             }
             
-            logOperation("Load Enrollments", true, "Processed " + to_string(enrollmentsProcessed) + " enrollments");
+            logOperation("Read Enrollments", true, "Read " + to_string(records.size()) + " active enrollments from " +
+                         string(ENROLLMENTS_FILE) + integrityNote(integrity));
             return true;
             
         } catch (const exception& e) {
@@ -1146,17 +1373,74 @@ namespace PokenoSouth {
         }
     }
     
-    bool FileHandler::saveEnrollments(const vector<shared_ptr<Student>>& students,
-                                    const vector<shared_ptr<Course>>& courses) {
+    int FileHandler::linkEnrollments(const vector<EnrollmentRecord>& records,
+                                     const unordered_map<int, Student*>& studentsByRollNumber,
+                                     const vector<Course*>& coursesByKey) {
+        int linked = 0;
+        
+        for (const auto& record : records) {
+            auto studentIt = studentsByRollNumber.find(record.rollNumber);
+            if (studentIt == studentsByRollNumber.end()) {
+                setError("Student not found for enrollment: " + to_string(record.rollNumber));
+                continue;
+            }
+            
+            SymbolKey courseKey = SymbolTable::courseIds().find(record.courseId);
+            Course* course = courseKey < coursesByKey.size() ? coursesByKey[courseKey] : nullptr;
+            if (!course) {
+                setError("Course not found for enrollment: " + record.courseId);
+                continue;
+            }
+            
+            // Restore the saved relationship as-is: enrollment rules (capacity, enrollment
+            // period) applied when it was created, and a past end date must not drop it.
+            // Both sides move together, so a duplicate row is skipped on both.
+            if (studentIt->second->attachCourse(course)) {
+                course->attachStudent(studentIt->second);
+                linked++;
+            }
+        }
+        
+        return linked;
+    }
+    
+    int FileHandler::linkAssessments(const EntityArena<Assessment>& assessments,
+                                     const unordered_map<int, Student*>& studentsByRollNumber,
+                                     const vector<Course*>& coursesByKey) {
+        int linked = 0;
+        
+        for (Assessment* assessment : assessments) {
+            auto studentIt = studentsByRollNumber.find(assessment->getStudentRollNumber());
+            if (studentIt == studentsByRollNumber.end()) {
+                setError("Student not found for assessment: " + assessment->getAssessmentId());
+                continue;
+            }
+            
+            // Grades are read through the student, so link even if the course is missing;
+            // validateReferentialIntegrity() reports those
+            SymbolKey courseKey = assessment->getCourseKey();
+            if (courseKey >= coursesByKey.size() || !coursesByKey[courseKey]) {
+                setError("Course not found for assessment: " + assessment->getAssessmentId());
+            }
+            
+            try {
+                studentIt->second->addAssessment(assessment);
+                linked++;
+            } catch (const exception& e) {
+                setError("Failed to link assessment " + assessment->getAssessmentId() + ": " + e.what());
+            }
+        }
+        
+        return linked;
+    }
+    
+    bool FileHandler::saveEnrollments(const EntityArena<Student>& students,
+                                    const EntityArena<Course>& courses) {
         try {
             clearLastError();
             createDataDirectories();
             
-            ofstream file(ENROLLMENTS_FILE);
-            if (!file.good()) {
-                setError("Cannot write to enrollments file: " + string(ENROLLMENTS_FILE));
-                return false;
-            }
+            ostringstream file;
             
             // Write headers
             for (size_t i = 0; i < ENROLLMENT_HEADERS.size(); ++i) {
@@ -1189,6 +1473,11 @@ namespace PokenoSouth {
                 }
             }
             
+            if (!writeFileWithChecksum(ENROLLMENTS_FILE, file.str())) {
+                setError("Cannot write to enrollments file: " + string(ENROLLMENTS_FILE));
+                return false;
+            }
+            
             logOperation("Save Enrollments", true, "Saved " + to_string(enrollmentsSaved) + " enrollments to " + string(ENROLLMENTS_FILE));
             return true;
             
@@ -1203,8 +1492,8 @@ namespace PokenoSouth {
             clearLastError();
             
             // Load current data
-            vector<shared_ptr<Student>> students;
-            vector<shared_ptr<Course>> courses;
+            EntityArena<Student> students;
+            EntityArena<Course> courses;
             
             if (!loadStudentsFromFile(students) || !loadCoursesFromFile(courses)) {
                 return false;
@@ -1235,9 +1524,14 @@ namespace PokenoSouth {
                 return false;
             }
             
-            // Perform enrollment
+            // Perform enrollment (undo the student side if the course refuses)
             student->enrollInCourse(course);
-            course->enrollStudent(student);
+            try {
+                course->enrollStudent(student);
+            } catch (const exception&) {
+                student->detachCourse(course);
+                throw;
+            }
             
             // Save updated enrollments
             if (!saveEnrollments(students, courses)) {
@@ -1258,8 +1552,8 @@ namespace PokenoSouth {
             clearLastError();
             
             // Load current data
-            vector<shared_ptr<Student>> students;
-            vector<shared_ptr<Course>> courses;
+            EntityArena<Student> students;
+            EntityArena<Course> courses;
             
             if (!loadStudentsFromFile(students) || !loadCoursesFromFile(courses)) {
                 return false;
@@ -1313,8 +1607,8 @@ namespace PokenoSouth {
             clearLastError();
             
             // Load current data
-            vector<shared_ptr<Student>> students;
-            vector<shared_ptr<Course>> courses;
+            EntityArena<Student> students;
+            EntityArena<Course> courses;
             
             if (!loadStudentsFromFile(students) || !loadCoursesFromFile(courses)) {
                 return false;
@@ -1341,9 +1635,9 @@ namespace PokenoSouth {
     
     // === T041-T043: ENHANCED FILE OPERATIONS AND INTEGRITY VALIDATION ===
     
-    bool FileHandler::validateDataConsistency(const vector<shared_ptr<Student>>& students,
-                                             const vector<shared_ptr<Course>>& courses,
-                                             const vector<shared_ptr<Assessment>>& assessments) {
+    bool FileHandler::validateDataConsistency(const EntityArena<Student>& students,
+                                             const EntityArena<Course>& courses,
+                                             const EntityArena<Assessment>& assessments) {
         try {
             // Validate students
             for (const auto& student : students) {
@@ -1367,24 +1661,23 @@ namespace PokenoSouth {
             }
             
             // Validate courses
+            vector<bool> seenCourseKeys(SymbolTable::courseIds().size(), false);
             for (const auto& course : courses) {
                 if (!course) {
                     setError("Found null course pointer");
                     return false;
                 }
                 
-                // Check for duplicate course IDs
-                string courseId = course->getCourseId();
-                int count = 0;
-                for (const auto& c : courses) {
-                    if (c && c->getCourseId() == courseId) {
-                        count++;
-                    }
+                // Check for duplicate course IDs (keys are dense, so a flag per key suffices)
+                SymbolKey courseKey = course->getCourseKey();
+                if (courseKey >= seenCourseKeys.size()) {
+                    seenCourseKeys.resize(SymbolTable::courseIds().size(), false);
                 }
-                if (count > 1) {
-                    setError("Duplicate course ID found: " + courseId);
+                if (seenCourseKeys[courseKey]) {
+                    setError("Duplicate course ID found: " + course->getCourseId());
                     return false;
                 }
+                seenCourseKeys[courseKey] = true;
             }
             
             // Validate assessments
@@ -1425,26 +1718,17 @@ namespace PokenoSouth {
                     return false;
                 }
                 
-                if (!isFileReadable(filePath)) {
-                    setError("Temporary file is not readable: " + filePath);
+                // Each save recorded the checksum and size of what it streamed out, so a short or
+                // failed write shows up as a size mismatch without reading the file back
+                ChecksumRecord record;
+                if (!readChecksumRecord(filePath, record)) {
+                    setError("Temporary file has no checksum record: " + filePath);
                     return false;
                 }
                 
-                // Check if file has reasonable size (not empty, not too large)
                 long fileSize = getFileSize(filePath);
-                if (fileSize < 0) {
-                    setError("Cannot determine size of temporary file: " + filePath);
-                    return false;
-                }
-                
-                if (fileSize == 0) {
-                    setError("Temporary file is empty: " + filePath);
-                    return false;
-                }
-                
-                // Basic CSV format validation
-                if (!isValidCSVFile(filePath)) {
-                    setError("Temporary file has invalid CSV format: " + filePath);
+                if (fileSize <= 0 || static_cast<uint64_t>(fileSize) != record.size) {
+                    setError("Temporary file size does not match its checksum record: " + filePath);
                     return false;
                 }
             }
@@ -1463,6 +1747,9 @@ namespace PokenoSouth {
                 if (fileExists(filePath)) {
                     std::filesystem::remove(filePath);
                 }
+                if (fileExists(filePath + CHECKSUM_EXTENSION)) {
+                    std::filesystem::remove(filePath + CHECKSUM_EXTENSION);
+                }
             } catch (const exception& e) {
                 // Log but don't fail - cleanup is best effort
                 logOperation("Cleanup Temp File", false, 
@@ -1471,15 +1758,11 @@ namespace PokenoSouth {
         }
     }
     
-    bool FileHandler::saveEnrollments(const vector<shared_ptr<Student>>& students,
-                                     const vector<shared_ptr<Course>>& courses,
+    bool FileHandler::saveEnrollments(const EntityArena<Student>& students,
+                                     const EntityArena<Course>& courses,
                                      const string& filePath) {
         try {
-            ofstream file(filePath);
-            if (!file.is_open()) {
-                setError("Failed to open enrollments file for writing: " + filePath);
-                return false;
-            }
+            ostringstream file;
             
             // Write headers
             for (size_t i = 0; i < ENROLLMENT_HEADERS.size(); ++i) {
@@ -1500,12 +1783,12 @@ namespace PokenoSouth {
                     file << enrollmentId++ << CSV_DELIMITER
                          << student->getRollNumber() << CSV_DELIMITER
                          << escapeCSVField(course->getCourseId()) << CSV_DELIMITER
-                         << escapeCSVField(student->getEnrollmentDate()) << CSV_DELIMITER
-                         << "ACTIVE\n";
+                         << escapeCSVField(student->getEnrollmentDate().toString()) << CSV_DELIMITER
+                         << "Active" << "\n";   // Same status spelling as the other saveEnrollments()
                 }
             }
             
-            if (file.good()) {
+            if (writeFileWithChecksum(filePath, file.str())) {
                 logOperation("Save Enrollments", true, 
                     "Enrollment relationships saved to " + filePath);
                 return true;
@@ -1522,19 +1805,21 @@ namespace PokenoSouth {
     
     // === T042: REFERENTIAL INTEGRITY VALIDATION ===
     
-    bool FileHandler::validateReferentialIntegrity(const vector<shared_ptr<Student>>& students,
-                                                  const vector<shared_ptr<Course>>& courses,
-                                                  const vector<shared_ptr<Assessment>>& assessments) {
+    bool FileHandler::validateReferentialIntegrity(const EntityArena<Student>& students,
+                                                  const EntityArena<Course>& courses,
+                                                  const EntityArena<Assessment>& assessments) {
         try {
             bool isValid = true;
             vector<string> integrityErrors;
             
+            const vector<bool> knownCourses = courseKeyMask(courses);
+            
             // Check assessments reference valid students and courses
             for (const auto& assessment : assessments) {
                 if (!assessment) continue;
                 
                 int studentRollNumber = assessment->getStudentRollNumber();
-                string courseId = assessment->getCourseId();
+                SymbolKey courseKey = assessment->getCourseKey();
                 
                 // Verify student exists
                 bool studentFound = false;
@@ -1552,18 +1837,12 @@ namespace PokenoSouth {
                 }
                 
                 // Verify course exists
-                bool courseFound = false;
-                for (const auto& course : courses) {
-                    if (course && course->getCourseId() == courseId) {
-                        courseFound = true;
-                        break;
-                    }
-                }
+                bool courseFound = courseKey < knownCourses.size() && knownCourses[courseKey];
                 
                 if (!courseFound) {
                     isValid = false;
                     integrityErrors.push_back("Assessment " + assessment->getAssessmentId() + 
-                        " references non-existent course: " + courseId);
+                        " references non-existent course: " + assessment->getCourseId());
                 }
             }
             
@@ -1581,13 +1860,8 @@ namespace PokenoSouth {
                     }
                     
                     // Verify the course exists in the courses list
-                    bool courseFound = false;
-                    for (const auto& course : courses) {
-                        if (course && course->getCourseId() == enrolledCourse->getCourseId()) {
-                            courseFound = true;
-                            break;
-                        }
-                    }
+                    SymbolKey courseKey = enrolledCourse->getCourseKey();
+                    bool courseFound = courseKey < knownCourses.size() && knownCourses[courseKey];
                     
                     if (!courseFound) {
                         isValid = false;
@@ -1644,23 +1918,17 @@ namespace PokenoSouth {
         }
     }
     
-    bool FileHandler::repairReferentialIntegrity(vector<shared_ptr<Student>>& students,
-                                                vector<shared_ptr<Course>>& courses,
-                                                vector<shared_ptr<Assessment>>& assessments) {
+    bool FileHandler::repairReferentialIntegrity(EntityArena<Student>& students,
+                                                EntityArena<Course>& courses,
+                                                EntityArena<Assessment>& assessments) {
         try {
             bool repairsMade = false;
+            const vector<bool> knownCourses = courseKeyMask(courses);
             
             // Remove assessments with invalid student or course references
-            auto assessmentIt = assessments.begin();
-            while (assessmentIt != assessments.end()) {
-                if (!*assessmentIt) {
-                    assessmentIt = assessments.erase(assessmentIt);
-                    repairsMade = true;
-                    continue;
-                }
-                
-                int studentRollNumber = (*assessmentIt)->getStudentRollNumber();
-                string courseId = (*assessmentIt)->getCourseId();
+            size_t removed = assessments.eraseIf([&](const Assessment* assessment) {
+                int studentRollNumber = assessment->getStudentRollNumber();
+                SymbolKey courseKey = assessment->getCourseKey();
                 
                 // Check if student exists
                 bool studentExists = false;
@@ -1672,24 +1940,23 @@ namespace PokenoSouth {
                 }
                 
                 // Check if course exists
-                bool courseExists = false;
-                for (const auto& course : courses) {
-                    if (course && course->getCourseId() == courseId) {
-                        courseExists = true;
-                        break;
-                    }
-                }
+                bool courseExists = courseKey < knownCourses.size() && knownCourses[courseKey];
                 
                 if (!studentExists || !courseExists) {
+                    // Unlink before the slot is freed so no student keeps a dangling pointer
+                    for (const auto& student : students) {
+                        if (student && student->getRollNumber() == studentRollNumber) {
+                            student->detachAssessment(assessment);
+                        }
+                    }
                     logOperation("Repair Integrity", true, 
-                        "Removed assessment " + (*assessmentIt)->getAssessmentId() + 
+                        "Removed assessment " + assessment->getAssessmentId() + 
                         " with invalid references");
-                    assessmentIt = assessments.erase(assessmentIt);
-                    repairsMade = true;
-                } else {
-                    ++assessmentIt;
+                    return true;
                 }
-            }
+                return false;
+            });
+            repairsMade = removed > 0;
             
             // TODO: Fix bidirectional enrollment inconsistencies
             // This would require access to Student/Course internal methods
@@ -1736,7 +2003,10 @@ namespace PokenoSouth {
                     string backupPath = backupSession + filename;
                     
                     try {
-                        std::filesystem::copy_file(file, backupPath);
+                        if (fileExists(backupPath)) {
+                            throw runtime_error("backup already exists: " + backupPath);
+                        }
+                        copyWithChecksum(file, backupPath, false);
                         logOperation("Incremental Backup", true, file + " -> " + backupPath);
                     } catch (const exception& e) {
                         setError("Failed to backup " + file + ": " + e.what());
@@ -1798,8 +2068,9 @@ namespace PokenoSouth {
             for (const auto& [backupFile, targetFile] : filesToRestore) {
                 if (std::filesystem::exists(backupFile)) {
                     try {
-                        std::filesystem::copy_file(backupFile, targetFile, 
-                            std::filesystem::copy_options::overwrite_existing);
+                        if (copyWithChecksum(backupFile, targetFile, true) == FileIntegrity::MODIFIED) {
+                            throw runtime_error("checksum mismatch");
+                        }
                         logOperation("Restore File", true, backupFile + " -> " + targetFile);
                     } catch (const exception& e) {
                         setError("Failed to restore " + backupFile + ": " + e.what());
@@ -1837,7 +2108,8 @@ namespace PokenoSouth {
                     }
                 } else if (entry.is_regular_file()) {
                     string fileName = entry.path().filename().string();
-                    if (fileName.find(".bak") != string::npos) {
+                    if (fileName.find(".bak") != string::npos &&
+                        entry.path().extension() != CHECKSUM_EXTENSION) {
                         backups.push_back(entry.path().string());
                     }
                 }
@@ -1871,6 +2143,7 @@ namespace PokenoSouth {
                         std::filesystem::remove_all(backups[i]);
                     } else {
                         std::filesystem::remove(backups[i]);
+                        std::filesystem::remove(backups[i] + CHECKSUM_EXTENSION);
                     }
                     removedCount++;
                     logOperation("Cleanup Backup", true, "Removed old backup: " + backups[i]);
@@ -1922,30 +2195,83 @@ namespace PokenoSouth {
     
     // === SEARCH AND FILTER OPERATIONS ===
     
-    shared_ptr<Student> FileHandler::findStudentByRollNumber(int rollNumber,
-                                                                 const vector<shared_ptr<Student>>& students) {
+    Student* FileHandler::findStudentByRollNumber(int rollNumber,
+                                                                 const EntityArena<Student>& students) {
         auto it = find_if(students.begin(), students.end(),
-            [rollNumber](const shared_ptr<Student>& student) {
+            [rollNumber](const Student* student) {
                 return student && student->getRollNumber() == rollNumber;
             });
         return (it != students.end()) ? *it : nullptr;
     }
     
-    shared_ptr<Course> FileHandler::findCourseById(const string& courseId,
-                                                       const vector<shared_ptr<Course>>& courses) {
+    Course* FileHandler::findCourseById(const string& courseId,
+                                                       const EntityArena<Course>& courses) {
+        const SymbolKey courseKey = SymbolTable::courseIds().find(courseId);
+        if (courseKey == SymbolTable::INVALID_KEY) return nullptr;  // Never interned: no such course
         auto it = find_if(courses.begin(), courses.end(),
-            [&courseId](const shared_ptr<Course>& course) {
-                return course && course->getCourseId() == courseId;
+            [courseKey](const Course* course) {
+                return course && course->getCourseKey() == courseKey;
             });
         return (it != courses.end()) ? *it : nullptr;
     }
     
-    shared_ptr<Assessment> FileHandler::findAssessmentById(const string& assessmentId,
-                                                              const vector<shared_ptr<Assessment>>& assessments) {
+    vector<bool> FileHandler::courseKeyMask(const EntityArena<Course>& courses) {
+        vector<bool> mask(SymbolTable::courseIds().size(), false);
+        for (const auto& course : courses) {
+            if (course) {
+                mask[course->getCourseKey()] = true;
+            }
+        }
+        return mask;
+    }
+    
+    vector<Course*> FileHandler::indexCoursesByKey(const EntityArena<Course>& courses) {
+        vector<Course*> index(SymbolTable::courseIds().size());
+        for (const auto& course : courses) {
+            if (course) {
+                index[course->getCourseKey()] = course;
+            }
+        }
+        return index;
+    }
+    
+    unordered_map<int, Student*> FileHandler::indexStudentsByRollNumber(const EntityArena<Student>& students) {
+        unordered_map<int, Student*> index;
+        index.reserve(students.size());
+        for (const auto& student : students) {
+            if (student) {
+                index.emplace(student->getRollNumber(), student);
+            }
+        }
+        return index;
+    }
+    
+    Assessment* FileHandler::findAssessmentById(const string& assessmentId,
+                                                              const EntityArena<Assessment>& assessments) {
         auto it = find_if(assessments.begin(), assessments.end(),
-            [&assessmentId](const shared_ptr<Assessment>& assessment) {
+            [&assessmentId](const Assessment* assessment) {
                 return assessment && assessment->getAssessmentId() == assessmentId;
             });
         return (it != assessments.end()) ? *it : nullptr;
     }
+    
+    vector<Student*> FileHandler::findStudentsByName(const string& name,
+                                                                    const EntityArena<Student>& students) {
+        // One-off scan for callers without a StudentNameIndex; System keeps an index for interactive search
+        vector<Student*> matches;
+        string query = Common::normalizeText(name);
+        if (query.empty()) {
+            return matches;
+        }
+        
+        string candidate;   // Reused across students
+        for (const auto& student : students) {
+            if (!student) continue;
+            Common::normalizeTextInto(student->getFullName(), candidate);
+            if (candidate.find(query) != string::npos) {
+                matches.push_back(student);
+            }
+        }
+        return matches;
+    }
 } // namespace PokenoSouth
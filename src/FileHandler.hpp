@@ -4,6 +4,7 @@
 #include "Course.hpp"
 #include "Assessment.hpp"
 #include "common.hpp"
+#include "Crc32c.hpp"
 #include "Usings.hpp"
 
 USING_STD_FILEHANDLER
@@ -41,22 +42,46 @@ namespace PokenoSouth {
         static string generateBackupFilename(const string& originalPath);
         
         // T041-T043: Enhanced file operations and integrity validation
-        static bool validateDataConsistency(const vector<shared_ptr<Student>>& students,
-                                           const vector<shared_ptr<Course>>& courses,
-                                           const vector<shared_ptr<Assessment>>& assessments);
+        static bool validateDataConsistency(const EntityArena<Student>& students,
+                                           const EntityArena<Course>& courses,
+                                           const EntityArena<Assessment>& assessments);
         static bool validateTempFileIntegrity(const vector<string>& tempFiles);
         static void cleanupTempFiles(const vector<string>& tempFiles);
-        static bool validateReferentialIntegrity(const vector<shared_ptr<Student>>& students,
-                                                const vector<shared_ptr<Course>>& courses,
-                                                const vector<shared_ptr<Assessment>>& assessments);
-        static bool repairReferentialIntegrity(vector<shared_ptr<Student>>& students,
-                                              vector<shared_ptr<Course>>& courses,
-                                              vector<shared_ptr<Assessment>>& assessments);
+        static bool validateReferentialIntegrity(const EntityArena<Student>& students,
+                                                const EntityArena<Course>& courses,
+                                                const EntityArena<Assessment>& assessments);
+        static bool repairReferentialIntegrity(EntityArena<Student>& students,
+                                              EntityArena<Course>& courses,
+                                              EntityArena<Assessment>& assessments);
         static bool createIncrementalBackup();
         static bool restoreFromIncrementalBackup(const string& backupPath);
         static vector<string> listAvailableBackups();
         static bool cleanupOldBackups(int keepCount = 10);
         
+        // Checksum sidecars (CRC32C): exact integrity for data and backup files, and no re-validation
+        // when loading a file that a save wrote and nothing has touched since
+        enum class FileIntegrity {
+            UNVERIFIED,   // No sidecar, or one from another algorithm
+            MODIFIED,     // Sidecar does not match the bytes
+            INTACT,       // Matches; bytes of unknown provenance (e.g. a backup of a hand-edited file)
+            SAVED         // Matches, and a save wrote these bytes from live entities
+        };
+        struct ChecksumRecord {
+            uint32_t checksum = 0;
+            uint64_t size = 0;
+            bool fromSave = false;
+        };
+        static bool readChecksumRecord(const string& filePath, ChecksumRecord& record);
+        static bool writeChecksumRecord(const string& filePath, const ChecksumRecord& record);
+        static FileIntegrity checkIntegrity(const string& filePath, uint32_t checksum, uint64_t size);
+        static const char* integrityNote(FileIntegrity integrity);
+        static bool writeFileWithChecksum(const string& filePath, const string& content);
+        static bool readFileWithChecksum(const string& filePath, string& content, FileIntegrity& integrity);
+        static FileIntegrity verifyFileChecksum(const string& filePath);
+        static FileIntegrity copyWithChecksum(const string& from, const string& to, bool requireIntact);
+        static void moveWithChecksum(const string& from, const string& to);
+        static Date parseOptionalDate(const string& text) { return text.empty() ? Date() : Date::parse(text); }
+        
     public:
         // === CONSTANTS AND CONFIGURATION ===
         static constexpr const char* STUDENTS_FILE = "data/students.csv";
@@ -66,6 +91,8 @@ namespace PokenoSouth {
         static constexpr const char* DATA_DIRECTORY = "data/";
         static constexpr const char* BACKUP_DIRECTORY = "data/backups/";
         static constexpr char CSV_DELIMITER = ',';
+        static constexpr const char* CHECKSUM_EXTENSION = ".sum";
+        static constexpr const char* CHECKSUM_ALGORITHM = "crc32c";
         
         // CSV Headers
         static const vector<string> STUDENT_HEADERS;
@@ -93,61 +120,61 @@ namespace PokenoSouth {
         static vector<string> listBackupFiles();
         
         // === STUDENT OPERATIONS ===
-        static bool loadStudentsFromFile(vector<shared_ptr<Student>>& students);
-        static bool loadStudentsFromFile(vector<shared_ptr<Student>>& students,
+        static bool loadStudentsFromFile(EntityArena<Student>& students);
+        static bool loadStudentsFromFile(EntityArena<Student>& students,
                                        const string& filePath);
-        static bool saveStudentsToFile(const vector<shared_ptr<Student>>& students);
-        static bool saveStudentsToFile(const vector<shared_ptr<Student>>& students,
+        static bool saveStudentsToFile(const EntityArena<Student>& students);
+        static bool saveStudentsToFile(const EntityArena<Student>& students,
                                      const string& filePath);
-        static bool appendStudentToFile(const shared_ptr<Student>& student);
-        static bool updateStudentInFile(const shared_ptr<Student>& student);
+        static bool appendStudentToFile(const Student& student);
+        static bool updateStudentInFile(const Student& student);
         static bool removeStudentFromFile(int rollNumber);
         
         // === COURSE OPERATIONS ===
-        static bool loadCoursesFromFile(vector<shared_ptr<Course>>& courses);
-        static bool loadCoursesFromFile(vector<shared_ptr<Course>>& courses,
+        static bool loadCoursesFromFile(EntityArena<Course>& courses);
+        static bool loadCoursesFromFile(EntityArena<Course>& courses,
                                       const string& filePath);
-        static bool saveCoursesToFile(const vector<shared_ptr<Course>>& courses);
-        static bool saveCoursesToFile(const vector<shared_ptr<Course>>& courses,
+        static bool saveCoursesToFile(const EntityArena<Course>& courses);
+        static bool saveCoursesToFile(const EntityArena<Course>& courses,
                                     const string& filePath);
-        static bool appendCourseToFile(const shared_ptr<Course>& course);
-        static bool updateCourseInFile(const shared_ptr<Course>& course);
+        static bool appendCourseToFile(const Course& course);
+        static bool updateCourseInFile(const Course& course);
         static bool removeCourseFromFile(const string& courseId);
         
         // === ASSESSMENT OPERATIONS ===
-        static bool loadAssessmentsFromFile(vector<shared_ptr<Assessment>>& assessments);
-        static bool loadAssessmentsFromFile(vector<shared_ptr<Assessment>>& assessments,
+        static bool loadAssessmentsFromFile(EntityArena<Assessment>& assessments);
+        static bool loadAssessmentsFromFile(EntityArena<Assessment>& assessments,
                                           const string& filePath);
-        static bool saveAssessmentsToFile(const vector<shared_ptr<Assessment>>& assessments);
-        static bool saveAssessmentsToFile(const vector<shared_ptr<Assessment>>& assessments,
+        static bool saveAssessmentsToFile(const EntityArena<Assessment>& assessments);
+        static bool saveAssessmentsToFile(const EntityArena<Assessment>& assessments,
                                         const string& filePath);
-        static bool appendAssessmentToFile(const shared_ptr<Assessment>& assessment);
-        static bool updateAssessmentInFile(const shared_ptr<Assessment>& assessment);
+        static bool appendAssessmentToFile(const Assessment& assessment);
+        static bool updateAssessmentInFile(const Assessment& assessment);
         static bool removeAssessmentFromFile(const string& assessmentId);
         
         // === ENROLLMENT RELATIONSHIP OPERATIONS ===
-        static bool loadEnrollments(vector<shared_ptr<Student>>& students,
-                                  vector<shared_ptr<Course>>& courses);
-        static bool saveEnrollments(const vector<shared_ptr<Student>>& students,
-                                  const vector<shared_ptr<Course>>& courses);
-        static bool saveEnrollments(const vector<shared_ptr<Student>>& students,
-                                  const vector<shared_ptr<Course>>& courses,
+        static bool loadEnrollments(EntityArena<Student>& students,
+                                  EntityArena<Course>& courses);
+        static bool saveEnrollments(const EntityArena<Student>& students,
+                                  const EntityArena<Course>& courses);
+        static bool saveEnrollments(const EntityArena<Student>& students,
+                                  const EntityArena<Course>& courses,
                                   const string& filePath);
         static bool enrollStudentInCourse(int rollNumber, const string& courseId);
         static bool withdrawStudentFromCourse(int rollNumber, const string& courseId);
         static bool isStudentEnrolledInCourse(int rollNumber, const string& courseId);
         
         // === COMPREHENSIVE DATA OPERATIONS ===
-        static bool loadAllData(vector<shared_ptr<Student>>& students,
-                              vector<shared_ptr<Course>>& courses,
-                              vector<shared_ptr<Assessment>>& assessments);
-        static bool saveAllData(const vector<shared_ptr<Student>>& students,
-                              const vector<shared_ptr<Course>>& courses,
-                              const vector<shared_ptr<Assessment>>& assessments);
+        static bool loadAllData(EntityArena<Student>& students,
+                              EntityArena<Course>& courses,
+                              EntityArena<Assessment>& assessments);
+        static bool saveAllData(const EntityArena<Student>& students,
+                              const EntityArena<Course>& courses,
+                              const EntityArena<Assessment>& assessments);
         static bool initializeDataFiles();
-        static bool validateDataIntegrity(const vector<shared_ptr<Student>>& students,
-                                        const vector<shared_ptr<Course>>& courses,
-                                        const vector<shared_ptr<Assessment>>& assessments);
+        static bool validateDataIntegrity(const EntityArena<Student>& students,
+                                        const EntityArena<Course>& courses,
+                                        const EntityArena<Assessment>& assessments);
         
         // === ERROR HANDLING AND LOGGING ===
         static string getLastError();
@@ -183,18 +210,20 @@ namespace PokenoSouth {
                                 vector<string>& headers);
         
         // === SEARCH AND FILTER OPERATIONS ===
-        static shared_ptr<Student> findStudentByRollNumber(int rollNumber,
-                                                               const vector<shared_ptr<Student>>& students);
-        static shared_ptr<Course> findCourseById(const string& courseId,
-                                                     const vector<shared_ptr<Course>>& courses);
-        static shared_ptr<Assessment> findAssessmentById(const string& assessmentId,
-                                                             const vector<shared_ptr<Assessment>>& assessments);
-        static vector<shared_ptr<Student>> findStudentsByName(const string& name,
-                                                                       const vector<shared_ptr<Student>>& students);
-        static vector<shared_ptr<Assessment>> findAssessmentsByStudent(int rollNumber,
-                                                                                const vector<shared_ptr<Assessment>>& assessments);
-        static vector<shared_ptr<Assessment>> findAssessmentsByCourse(const string& courseId,
-                                                                               const vector<shared_ptr<Assessment>>& assessments);
+        static Student* findStudentByRollNumber(int rollNumber,
+                                                               const EntityArena<Student>& students);
+        static Course* findCourseById(const string& courseId,
+                                                     const EntityArena<Course>& courses);
+        static Assessment* findAssessmentById(const string& assessmentId,
+                                                             const EntityArena<Assessment>& assessments);
+        static vector<Student*> findStudentsByName(const string& name,
+                                                                       const EntityArena<Student>& students);
+        static vector<Assessment*> findAssessmentsByStudent(int rollNumber,
+                                                                                const EntityArena<Assessment>& assessments);
+        static vector<Assessment*> findAssessmentsByCourse(const string& courseId,
+                                                                               const EntityArena<Assessment>& assessments);
+        // Roll number -> student; the first of any duplicates wins, as findStudentByRollNumber's scan does
+        static unordered_map<int, Student*> indexStudentsByRollNumber(const EntityArena<Student>& students);
 
     private:
         // Error tracking
@@ -203,5 +232,22 @@ namespace PokenoSouth {
 
         // Operation logging
         static void setError(const string& error);
+        
+        // Course lookups by interned key (SymbolTable::courseIds() keys index these directly)
+        static vector<bool> courseKeyMask(const EntityArena<Course>& courses);
+        static vector<Course*> indexCoursesByKey(const EntityArena<Course>& courses);
+        
+        // === RELATIONSHIP LINKING (hash joins after the entity files load) ===
+        struct EnrollmentRecord {
+            int rollNumber;
+            string courseId;
+        };
+        static bool readEnrollmentRecords(vector<EnrollmentRecord>& records);
+        static int linkEnrollments(const vector<EnrollmentRecord>& records,
+                                   const unordered_map<int, Student*>& studentsByRollNumber,
+                                   const vector<Course*>& coursesByKey);
+        static int linkAssessments(const EntityArena<Assessment>& assessments,
+                                   const unordered_map<int, Student*>& studentsByRollNumber,
+                                   const vector<Course*>& coursesByKey);
     };
 }
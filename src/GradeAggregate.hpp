@@ -0,0 +1,76 @@
+#pragma once
+
+#include "common.hpp"
+
+namespace PokenoSouth {
+    /**
+     * GradeAggregate for Pokeno South Primary School
+     * Running totals over a changing set of percentage grades
+     *
+     * Key Features:
+     * - add()/remove()/replace() are O(1); mean(), pass and fail counts are read directly
+     * - The sum is kept in integer micro-percent, so it depends only on the current set of grades
+     *   and not on the order of edits (a double sum drifts, and 49.999999... would fail a 50.0 pass)
+     * - Min/max are exact after add(); removing the current extreme marks them stale,
+     *   and the owner rescans its own grades (refreshExtremes) the next time they are asked for
+     *
+     * Student keeps one per course it has assessments in (over assessment grades) and one
+     * overall; Course keeps one over its enrolled students' course grades.
+     */
+    struct GradeAggregate {
+        static constexpr double PASS_THRESHOLD = 50.0;
+        static constexpr double MICROS_PER_PERCENT = 1e6;
+
+        int64_t sumMicros = 0;     // Sum of grades, in millionths of a percent
+        int count = 0;
+        int passCount = 0;
+        int failCount = 0;
+        double minGrade = 0.0;
+        double maxGrade = 0.0;
+        bool extremesStale = false;
+
+        void add(double grade) {
+            if (count == 0 || (!extremesStale && grade < minGrade)) minGrade = grade;
+            if (count == 0 || (!extremesStale && grade > maxGrade)) maxGrade = grade;
+            if (count == 0) extremesStale = false;
+            sumMicros += toMicros(grade);
+            ++count;
+            (grade >= PASS_THRESHOLD ? passCount : failCount)++;
+        }
+
+        void remove(double grade) {
+            --count;
+            (grade >= PASS_THRESHOLD ? passCount : failCount)--;
+            sumMicros -= toMicros(grade);
+            if (count == 0) {
+                minGrade = maxGrade = 0.0;
+                extremesStale = false;
+                return;
+            }
+            if (grade <= minGrade || grade >= maxGrade) extremesStale = true;
+        }
+
+        void replace(double oldGrade, double newGrade) {
+            remove(oldGrade);
+            add(newGrade);
+        }
+
+        double total() const { return static_cast<double>(sumMicros) / MICROS_PER_PERCENT; }
+        double mean() const { return count > 0 ? total() / count : 0.0; }
+
+        static int64_t toMicros(double grade) { return std::llround(grade * MICROS_PER_PERCENT); }
+
+        // Rebuilds min/max from the owner's grades; Visit calls back once per current grade
+        template <typename Visit>
+        void refreshExtremes(Visit&& visitGrades) {
+            if (!extremesStale) return;
+            bool first = true;
+            visitGrades([&](double grade) {
+                if (first || grade < minGrade) minGrade = grade;
+                if (first || grade > maxGrade) maxGrade = grade;
+                first = false;
+            });
+            extremesStale = false;
+        }
+    };
+}
@@ -2,6 +2,51 @@
 
 namespace PokenoSouth {
 
+        namespace {
+                // Room for the N best on the stack; covers every policy the school defines
+                constexpr size_t INLINE_HEAP = 16;
+
+                // Mean of the bestN largest of scoreAt(0 .. count-1), selected with a bounded min-heap
+                // built in 'heap', which must have room for min(bestN, count) values
+                template <typename ScoreAt>
+                double bestNMean(size_t count, size_t bestN, ScoreAt scoreAt, double* heap) {
+                        const size_t take = min(bestN, count);
+                        if (take == 0) return 0.0;
+
+                        size_t kept = 0;
+                        for (size_t i = 0; i < count; ++i) {
+                                const double score = scoreAt(i);
+                                if (kept < take) {
+                                        heap[kept++] = score;
+                                        push_heap(heap, heap + kept, greater<double>());
+                                } else if (score > heap[0]) {
+                                        pop_heap(heap, heap + take, greater<double>());
+                                        heap[take - 1] = score;
+                                        push_heap(heap, heap + take, greater<double>());
+                                }
+                        }
+                        return accumulate(heap, heap + take, 0.0) / static_cast<double>(take);
+                }
+
+                // bestNMean with its heap on the stack unless N is unusually large
+                template <typename ScoreAt>
+                double bestNMean(size_t count, size_t bestN, ScoreAt scoreAt) {
+                        const size_t take = min(bestN, count);
+                        if (take <= INLINE_HEAP) {
+                                double heap[INLINE_HEAP];
+                                return bestNMean(count, bestN, scoreAt, heap);
+                        }
+                        vector<double> heap(take);
+                        return bestNMean(count, bestN, scoreAt, heap.data());
+                }
+        }
+
+        void GradeCalculator::calculateGrades(const ScoreBatch& batch, double* grades) const {
+                for (size_t g = 0; g < batch.groupCount; ++g) {
+                        grades[g] = calculateGrade(batch.group(g));
+                }
+        }
+
         double WeightedAverageCalculator::calculateGrade(const vector<AssessmentScore>& scores) const {
                 double wsum = 0.0, sum = 0.0;
                 for (const auto& s : scores) {
@@ -11,17 +56,57 @@ namespace PokenoSouth {
                 return (wsum > 0.0) ? (sum / wsum) : 0.0;
         }
 
+        double WeightedAverageCalculator::calculateGrade(const ScoreSpan& scores) const {
+                if (!scores.weights) {
+                        return scores.count > 0
+                                ? accumulate(scores.scores, scores.scores + scores.count, 0.0) / static_cast<double>(scores.count)
+                                : 0.0;
+                }
+                double wsum = 0.0, sum = 0.0;
+                for (size_t i = 0; i < scores.count; ++i) {
+                    sum  += scores.scores[i] * scores.weights[i];
+                    wsum += scores.weights[i];
+                }
+                return (wsum > 0.0) ? (sum / wsum) : 0.0;
+        }
+
         double BestNOutOfMCalculator::calculateGrade(const vector<AssessmentScore>& scores) const {
-                if (scores.empty()) return 0.0;
-                vector<double> weighted;
-                weighted.reserve(scores.size());
-                for (const auto& s : scores) weighted.push_back(s.score); // simple “best N raw scores”
-                nth_element(weighted.begin(),
-                                 weighted.begin() + min(bestN_, weighted.size()),
-                                 weighted.end(),
-                                 greater<double>());
-                size_t take = min(bestN_, weighted.size());
-                double sum = accumulate(weighted.begin(), weighted.begin() + take, 0.0);
-                return sum / static_cast<double>(take);
-        }
-} // namespace PokenoSouth
\ No newline at end of file
+                // Simple "best N raw scores": weights are ignored
+                return bestNMean(scores.size(), bestN_, [&scores](size_t i) { return scores[i].score; });
+        }
+
+        double BestNOutOfMCalculator::calculateGrade(const ScoreSpan& scores) const {
+                const double* raw = scores.scores;   // Raw scores, as in the vector overload
+                return bestNMean(scores.count, bestN_, [raw](size_t i) { return raw[i]; });
+        }
+
+        void BestNOutOfMCalculator::calculateGrades(const ScoreBatch& batch, double* grades) const {
+                vector<double> heap;   // Grown to the largest group's share, so a batch allocates at most a few times
+                for (size_t g = 0; g < batch.groupCount; ++g) {
+                        const ScoreSpan group = batch.group(g);
+                        const size_t take = min(bestN_, group.count);
+                        if (heap.size() < take) heap.resize(take);
+                        grades[g] = bestNMean(group.count, bestN_, [&group](size_t i) { return group.scores[i]; },
+                                              heap.data());
+                }
+        }
+
+        void BestNAccumulator::add(double score) {
+                if (bestN_ == 0) return;
+                if (heap_.size() < bestN_) {
+                        heap_.push_back(score);
+                        push_heap(heap_.begin(), heap_.end(), greater<double>());
+                        sumMicros_ += GradeAggregate::toMicros(score);
+                } else if (score > heap_.front()) {
+                        sumMicros_ += GradeAggregate::toMicros(score) - GradeAggregate::toMicros(heap_.front());
+                        pop_heap(heap_.begin(), heap_.end(), greater<double>());
+                        heap_.back() = score;
+                        push_heap(heap_.begin(), heap_.end(), greater<double>());
+                }
+        }
+
+        double BestNAccumulator::grade() const {
+                if (heap_.empty()) return 0.0;
+                return static_cast<double>(sumMicros_) / GradeAggregate::MICROS_PER_PERCENT / static_cast<double>(heap_.size());
+        }
+} // namespace PokenoSouth
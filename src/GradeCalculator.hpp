@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common.hpp"
+#include "GradeAggregate.hpp"
 
 USING_STD_GRADECALCULATOR
 
@@ -13,22 +14,68 @@ namespace PokenoSouth {
                 double weight;     // 0..1 (per-course definition)
         };
 
+        // One student's scores as parallel arrays; weights may be null (all equal)
+        struct ScoreSpan {
+                const double* scores = nullptr;
+                const double* weights = nullptr;
+                size_t count = 0;
+        };
+
+        // Many students' scores in compressed-row form: group g owns [offsets[g], offsets[g + 1]).
+        // Non-owning; offsets has groupCount + 1 entries. weights may be null (all equal).
+        struct ScoreBatch {
+                const double* scores = nullptr;
+                const double* weights = nullptr;
+                const uint32_t* offsets = nullptr;
+                size_t groupCount = 0;
+
+                ScoreSpan group(size_t g) const {
+                        const uint32_t begin = offsets[g];
+                        return {scores + begin, weights ? weights + begin : nullptr, offsets[g + 1] - begin};
+                }
+        };
+
         class GradeCalculator {
             public:
                 virtual ~GradeCalculator() = default;
                 virtual double calculateGrade(const vector<AssessmentScore>& scores) const = 0;
+                virtual double calculateGrade(const ScoreSpan& scores) const = 0;
+
+                // grades[g] = calculateGrade(batch.group(g)); strategies may override to share scratch space
+                virtual void calculateGrades(const ScoreBatch& batch, double* grades) const;
         };
 
         class WeightedAverageCalculator final : public GradeCalculator {
             public:
                 double calculateGrade(const vector<AssessmentScore>& scores) const override;
+                double calculateGrade(const ScoreSpan& scores) const override;
         };
 
         class BestNOutOfMCalculator final : public GradeCalculator {
             public:
                 explicit BestNOutOfMCalculator(size_t bestN) : bestN_(bestN) {}
                 double calculateGrade(const vector<AssessmentScore>& scores) const override;
+                double calculateGrade(const ScoreSpan& scores) const override;
+                void calculateGrades(const ScoreBatch& batch, double* grades) const override;
+            private:
+                size_t bestN_;
+        };
+
+        // Running best-N average over scores that arrive one at a time.
+        // Keeps a bounded min-heap of the N best, so add() is O(log N) and grade() is O(1).
+        class BestNAccumulator {
+            public:
+                explicit BestNAccumulator(size_t bestN) : bestN_(bestN) { heap_.reserve(bestN); }
+
+                void add(double score);
+                void clear() { heap_.clear(); sumMicros_ = 0; }
+
+                double grade() const;
+                size_t size() const { return heap_.size(); }          // min(N, scores seen)
+                double lowestKept() const { return heap_.empty() ? 0.0 : heap_.front(); }
             private:
                 size_t bestN_;
+                vector<double> heap_;      // Min-heap: front() is the weakest score still counted
+                int64_t sumMicros_ = 0;    // Integer sum, as in GradeAggregate, so evictions never drift
         };
-} // namespace PokenoSouth
\ No newline at end of file
+} // namespace PokenoSouth
@@ -0,0 +1,98 @@
+#include "GradeKernel.hpp"
+#include "Assessment.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define POKENO_GRADE_KERNEL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace PokenoSouth {
+
+    namespace {
+        // Lower bound of each letter band except F, best first; a grade's code is how many it misses
+        constexpr double LETTER_LOWER_BOUNDS[GradeKernel::LETTER_COUNT - 1] = {
+            Assessment::A_PLUS_THRESHOLD, Assessment::A_THRESHOLD, Assessment::B_PLUS_THRESHOLD,
+            Assessment::B_THRESHOLD, Assessment::C_PLUS_THRESHOLD, Assessment::C_THRESHOLD,
+            Assessment::D_THRESHOLD
+        };
+
+        constexpr const char* LETTER_NAMES[GradeKernel::LETTER_COUNT] = {
+            "A+", "A", "B+", "B", "C+", "C", "D", "F"
+        };
+    }
+
+    // === SCALAR FORMS ===
+    uint8_t GradeKernel::letterCode(double grade) {
+        uint8_t code = 0;
+        for (double bound : LETTER_LOWER_BOUNDS) {
+            code += (grade < bound);
+        }
+        return code;
+    }
+
+    const char* GradeKernel::letterName(uint8_t code) {
+        return code < LETTER_COUNT ? LETTER_NAMES[code] : "F";
+    }
+
+    bool GradeKernel::usesSimd() {
+#ifdef POKENO_GRADE_KERNEL_SSE2
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // === BATCH KERNELS ===
+    void GradeKernel::weightedGrades(const double* internal, const double* final, double* out, size_t count,
+                                     double internalWeight, double finalWeight) {
+        size_t i = 0;
+#ifdef POKENO_GRADE_KERNEL_SSE2
+        // Separate multiply and add (no FMA), so each lane rounds exactly like the scalar expression
+        const __m128d wInternal = _mm_set1_pd(internalWeight);
+        const __m128d wFinal = _mm_set1_pd(finalWeight);
+        for (; i + 2 <= count; i += 2) {
+            const __m128d a = _mm_mul_pd(_mm_loadu_pd(internal + i), wInternal);
+            const __m128d b = _mm_mul_pd(_mm_loadu_pd(final + i), wFinal);
+            _mm_storeu_pd(out + i, _mm_add_pd(a, b));
+        }
+#endif
+        for (; i < count; ++i) {
+            out[i] = internal[i] * internalWeight + final[i] * finalWeight;
+        }
+    }
+
+    void GradeKernel::classify(const double* grades, uint8_t* passFlags, uint8_t* letterCodes, size_t count) {
+        size_t i = 0;
+#ifdef POKENO_GRADE_KERNEL_SSE2
+        const __m128d passThreshold = _mm_set1_pd(Assessment::PASS_THRESHOLD);
+        __m128d bounds[LETTER_COUNT - 1];
+        for (size_t b = 0; b < LETTER_COUNT - 1; ++b) {
+            bounds[b] = _mm_set1_pd(LETTER_LOWER_BOUNDS[b]);
+        }
+
+        for (; i + 2 <= count; i += 2) {
+            const __m128d grade = _mm_loadu_pd(grades + i);
+
+            if (passFlags) {
+                const int passMask = _mm_movemask_pd(_mm_cmpge_pd(grade, passThreshold));
+                passFlags[i] = static_cast<uint8_t>(passMask & 1);
+                passFlags[i + 1] = static_cast<uint8_t>(passMask >> 1);
+            }
+
+            if (letterCodes) {
+                // Each missed bound is an all-ones lane (-1); subtracting it counts the misses
+                __m128i codes = _mm_setzero_si128();
+                for (size_t b = 0; b < LETTER_COUNT - 1; ++b) {
+                    codes = _mm_sub_epi64(codes, _mm_castpd_si128(_mm_cmplt_pd(grade, bounds[b])));
+                }
+                letterCodes[i] = static_cast<uint8_t>(_mm_cvtsi128_si32(codes));
+                letterCodes[i + 1] = static_cast<uint8_t>(_mm_cvtsi128_si32(_mm_srli_si128(codes, 8)));
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            if (passFlags) passFlags[i] = grades[i] >= Assessment::PASS_THRESHOLD;
+            if (letterCodes) letterCodes[i] = letterCode(grades[i]);
+        }
+    }
+}
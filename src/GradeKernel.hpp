@@ -0,0 +1,37 @@
+#pragma once
+
+#include "common.hpp"
+
+namespace PokenoSouth {
+    /**
+     * GradeKernel for Pokeno South Primary School
+     * Batch grade arithmetic over contiguous arrays (e.g. AssessmentColumns)
+     *
+     * Key Features:
+     * - weightedGrades(): internal*wI + final*wF for a whole array in one sweep
+     * - classify(): pass flag and letter-grade code per grade, branch-free
+     * - SSE2 path (two doubles per instruction) where the target guarantees SSE2,
+     *   portable scalar loop everywhere else; both produce identical results
+     * - letterCode() is the single definition of the letter bands; Assessment::getLetterGrade()
+     *   and the batch path both use it, so they can never disagree
+     *
+     * Letter codes run 0..LETTER_COUNT-1 from best (A+) to worst (F); letterName() maps them back.
+     */
+    class GradeKernel {
+    public:
+        static constexpr uint8_t LETTER_COUNT = 8;
+
+        // out[i] = internal[i] * internalWeight + final[i] * finalWeight
+        static void weightedGrades(const double* internal, const double* final, double* out, size_t count,
+                                   double internalWeight, double finalWeight);
+
+        // passFlags[i] = grade >= pass threshold; letterCodes[i] = letterCode(grades[i]).
+        // Either output may be null if not wanted.
+        static void classify(const double* grades, uint8_t* passFlags, uint8_t* letterCodes, size_t count);
+
+        static uint8_t letterCode(double grade);    // Scalar form of classify()
+        static const char* letterName(uint8_t code);
+
+        static bool usesSimd();                     // True when the SSE2 path is compiled in
+    };
+}
@@ -0,0 +1,141 @@
+#include "GradeSimulation.hpp"
+
+namespace PokenoSouth {
+
+    // Below this many groups per thread, spawning costs more than it saves
+    static constexpr size_t MIN_GROUPS_PER_THREAD = 256;
+
+    // === SNAPSHOT ===
+    GradeSimulation::GradeSimulation(const AssessmentColumns& columns) {
+        const vector<int32_t>& rolls = columns.rollNumbers();
+        const vector<SymbolKey>& courseKeys = columns.courseKeys();
+
+        vector<uint32_t> order(columns.size());
+        for (uint32_t row = 0; row < order.size(); ++row) order[row] = row;
+        sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return rolls[a] != rolls[b] ? rolls[a] < rolls[b] : courseKeys[a] < courseKeys[b];
+        });
+
+        internalMarks.reserve(order.size());
+        finalMarks.reserve(order.size());
+        offsets.push_back(0);
+        for (uint32_t row : order) {
+            const bool newGroup = groupRollNumbers.empty() || groupRollNumbers.back() != rolls[row] ||
+                                  groupCourseKeys.back() != courseKeys[row];
+            if (newGroup) {
+                if (!groupRollNumbers.empty()) {
+                    offsets.push_back(static_cast<uint32_t>(internalMarks.size()));
+                }
+                groupRollNumbers.push_back(rolls[row]);
+                groupCourseKeys.push_back(courseKeys[row]);
+            }
+            internalMarks.push_back(columns.internalMarks()[row]);
+            finalMarks.push_back(columns.finalMarks()[row]);
+        }
+        if (!groupRollNumbers.empty()) {
+            offsets.push_back(static_cast<uint32_t>(internalMarks.size()));
+        }
+    }
+
+    // === EVALUATION ===
+    void GradeSimulation::gradeCohort(const CourseGradingPolicy* policy, size_t firstGroup, size_t lastGroup,
+                                      vector<double>& assessmentGrades, vector<double>& courseGrades) const {
+        if (!policy) {
+            // Courses differ from group to group, so this is one policy call per group, not per cohort
+            const GradingPolicyRegistry& registry = GradingPolicyRegistry::shared();
+            for (size_t g = firstGroup; g < lastGroup; ++g) {
+                const CourseGradingPolicy& assigned = registry.forCourse(groupCourseKeys[g]);
+                const size_t begin = offsets[g];
+                const size_t count = offsets[g + 1] - begin;
+                assigned.assessmentGrades(internalMarks.data() + begin, finalMarks.data() + begin,
+                                          assessmentGrades.data() + begin, count);
+                courseGrades[g] = assigned.calculateGrade(ScoreSpan{assessmentGrades.data() + begin, nullptr, count});
+            }
+            return;
+        }
+
+        const size_t firstRow = offsets[firstGroup];
+        const size_t rows = offsets[lastGroup] - firstRow;
+        policy->assessmentGrades(internalMarks.data() + firstRow, finalMarks.data() + firstRow,
+                                assessmentGrades.data() + firstRow, rows);
+
+        // Offsets are absolute row indices, so a cohort is just a window onto the full batch
+        const ScoreBatch cohort{assessmentGrades.data(), nullptr, offsets.data() + firstGroup, lastGroup - firstGroup};
+        policy->calculateGrades(cohort, courseGrades.data() + firstGroup);
+    }
+
+    vector<double> GradeSimulation::gradeAll(const CourseGradingPolicy* policy, size_t threads) const {
+        const size_t groups = studentCourseCount();
+        vector<double> assessmentGrades(assessmentCount());
+        vector<double> courseGrades(groups);
+        if (groups == 0) {
+            return courseGrades;
+        }
+
+        if (threads == 0) {
+            threads = std::max<size_t>(1, thread::hardware_concurrency());
+        }
+        threads = std::max<size_t>(1, std::min(threads, groups / MIN_GROUPS_PER_THREAD));
+
+        if (threads == 1) {
+            gradeCohort(policy, 0, groups, assessmentGrades, courseGrades);
+            return courseGrades;
+        }
+
+        vector<thread> workers;
+        vector<exception_ptr> failures(threads);
+        workers.reserve(threads - 1);
+        const size_t perThread = (groups + threads - 1) / threads;
+        for (size_t first = perThread, cohort = 1; first < groups; first += perThread, ++cohort) {
+            const size_t last = std::min(groups, first + perThread);
+            workers.emplace_back([&, first, last, cohort]() {
+                try {
+                    gradeCohort(policy, first, last, assessmentGrades, courseGrades);
+                } catch (...) {
+                    failures[cohort] = current_exception();   // Rethrown on the calling thread below
+                }
+            });
+        }
+        try {
+            gradeCohort(policy, 0, std::min(groups, perThread), assessmentGrades, courseGrades);   // This thread's share
+        } catch (...) {
+            failures[0] = current_exception();
+        }
+        for (thread& worker : workers) {
+            worker.join();
+        }
+        for (const exception_ptr& failure : failures) {
+            if (failure) rethrow_exception(failure);
+        }
+        return courseGrades;
+    }
+
+    SimulationResult GradeSimulation::run(const CourseGradingPolicy& policy, size_t threads) const {
+        const vector<double> current = gradeAll(nullptr, threads);   // As the courses grade today
+        const vector<double> simulated = gradeAll(&policy, threads);
+
+        const size_t groups = studentCourseCount();
+        vector<uint8_t> currentLetters(groups), simulatedLetters(groups);
+        vector<uint8_t> currentPass(groups), simulatedPass(groups);
+        GradeKernel::classify(current.data(), currentPass.data(), currentLetters.data(), groups);
+        GradeKernel::classify(simulated.data(), simulatedPass.data(), simulatedLetters.data(), groups);
+
+        SimulationResult result;
+        result.studentCoursesEvaluated = groups;
+        double shift = 0.0;
+        for (size_t g = 0; g < groups; ++g) {
+            shift += simulated[g] - current[g];
+            if (currentPass[g] && !simulatedPass[g]) result.passToFail++;
+            if (!currentPass[g] && simulatedPass[g]) result.failToPass++;
+            if (currentLetters[g] != simulatedLetters[g]) result.letterChanges++;
+
+            if (std::abs(simulated[g] - current[g]) > 1e-9) {
+                result.changes.push_back({groupRollNumbers[g], groupCourseKeys[g], current[g], simulated[g],
+                                          currentLetters[g], simulatedLetters[g],
+                                          currentPass[g] != 0, simulatedPass[g] != 0});
+            }
+        }
+        result.meanShift = groups > 0 ? shift / static_cast<double>(groups) : 0.0;
+        return result;
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "common.hpp"
+#include "AssessmentColumns.hpp"
+#include "GradingPolicy.hpp"
+
+USING_STD_SIMULATION
+
+namespace PokenoSouth {
+    // One student's course grade now and under the simulated policy
+    struct GradeChange {
+        int rollNumber;
+        SymbolKey courseKey;
+        double currentGrade;
+        double simulatedGrade;
+        uint8_t currentLetter;      // GradeKernel letter codes
+        uint8_t simulatedLetter;
+        bool currentPass;
+        bool simulatedPass;
+    };
+
+    struct SimulationResult {
+        vector<GradeChange> changes;    // Only (student, course) pairs whose grade moved, by roll then course
+        size_t studentCoursesEvaluated = 0;
+        size_t passToFail = 0;
+        size_t failToPass = 0;
+        size_t letterChanges = 0;
+        double meanShift = 0.0;         // Average simulated - current over all pairs evaluated
+    };
+
+    /**
+     * GradeSimulation for Pokeno South Primary School
+     * "What if" re-grading of every student's course grades under an alternative policy
+     *
+     * Key Features:
+     * - Works on a private snapshot of the assessment columns taken at construction,
+     *   so live data is never touched and may change while a simulation runs
+     * - Snapshot rows are grouped per (student, course) in compressed-row form, which
+     *   CourseGradingPolicy consumes directly (weights via GradeKernel, then selection/combination)
+     * - run() splits the groups into contiguous cohorts, one thread each; threads share only
+     *   read-only inputs and write disjoint output ranges, so no locking is needed.
+     *   A cohort's exception is rethrown on the calling thread after all cohorts finish
+     * - Baseline is each course's assigned policy (GradingPolicyRegistry::forCourse) on the same
+     *   snapshot, matching Student::getCourseGrade(); the simulated policy replaces it everywhere
+     */
+    class GradeSimulation {
+    private:
+        // Snapshot, grouped: group g covers rows [offsets[g], offsets[g + 1])
+        vector<int32_t> groupRollNumbers;
+        vector<SymbolKey> groupCourseKeys;
+        vector<uint32_t> offsets;
+        vector<double> internalMarks;
+        vector<double> finalMarks;
+
+        // A null policy grades each group under its course's assigned policy
+        void gradeCohort(const CourseGradingPolicy* policy, size_t firstGroup, size_t lastGroup,
+                         vector<double>& assessmentGrades, vector<double>& courseGrades) const;
+        vector<double> gradeAll(const CourseGradingPolicy* policy, size_t threads) const;
+
+    public:
+        explicit GradeSimulation(const AssessmentColumns& columns);
+
+        size_t studentCourseCount() const { return groupRollNumbers.size(); }
+        size_t assessmentCount() const { return internalMarks.size(); }
+
+        // threads == 0 picks one per hardware thread (capped by the amount of work)
+        SimulationResult run(const CourseGradingPolicy& policy, size_t threads = 0) const;
+    };
+}
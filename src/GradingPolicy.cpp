@@ -0,0 +1,67 @@
+#include "GradingPolicy.hpp"
+#include "Assessment.hpp"
+
+namespace PokenoSouth {
+
+    static_assert(StandardWeights::INTERNAL == Assessment::INTERNAL_WEIGHT &&
+                  StandardWeights::FINAL == Assessment::FINAL_WEIGHT,
+                  "StandardWeights must match Assessment's built-in weighting");
+
+    // === CONSTRUCTION ===
+    GradingPolicyRegistry::GradingPolicyRegistry() {
+        defaultPolicy = &define<GradingPolicy<StandardWeights>>(DEFAULT_POLICY);
+        define<GradingPolicy<StandardWeights, DropLowest<1>>>("drop-lowest");
+        define<GradingPolicy<StandardWeights, BestN<3>>>("best-3");
+        define<GradingPolicy<StandardWeights, AllScores, WeightedMean, CapAt<100>>>("capped");
+        define<GradingPolicy<MarkWeights<40, 60>>>("split-40-60");
+        define<GradingPolicy<MarkWeights<50, 50>>>("split-50-50");
+    }
+
+    GradingPolicyRegistry& GradingPolicyRegistry::shared() {
+        static GradingPolicyRegistry registry;
+        return registry;
+    }
+
+    // === LOOKUP AND ASSIGNMENT ===
+    const CourseGradingPolicy* GradingPolicyRegistry::find(const string& name) const {
+        auto it = policies.find(name);
+        return it != policies.end() ? it->second.get() : nullptr;
+    }
+
+    vector<string> GradingPolicyRegistry::names() const {
+        vector<string> result;
+        result.reserve(policies.size());
+        for (const auto& entry : policies) {
+            result.push_back(entry.first);
+        }
+        sort(result.begin(), result.end());
+        return result;
+    }
+
+    void GradingPolicyRegistry::assign(SymbolKey courseKey, const string& policyName) {
+        const CourseGradingPolicy* policy = find(policyName);
+        if (!policy) {
+            throw invalid_argument("Unknown grading policy: " + policyName);
+        }
+        if (courseKey == SymbolTable::INVALID_KEY) {
+            throw invalid_argument("Cannot assign a grading policy to an unknown course");
+        }
+        if (courseKey >= policyByCourse.size()) {
+            policyByCourse.resize(courseKey + 1, nullptr);
+        }
+        policyByCourse[courseKey] = policy == defaultPolicy ? nullptr : policy;
+    }
+
+    void GradingPolicyRegistry::unassign(SymbolKey courseKey) {
+        if (courseKey < policyByCourse.size()) {
+            policyByCourse[courseKey] = nullptr;
+        }
+    }
+
+    const CourseGradingPolicy& GradingPolicyRegistry::forCourse(SymbolKey courseKey) const {
+        if (courseKey < policyByCourse.size() && policyByCourse[courseKey]) {
+            return *policyByCourse[courseKey];
+        }
+        return *defaultPolicy;
+    }
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "common.hpp"
+#include "GradeCalculator.hpp"
+#include "GradeKernel.hpp"
+#include "SymbolTable.hpp"
+
+USING_STD_POLICY
+
+namespace PokenoSouth {
+
+    // === POLICY BUILDING BLOCKS ===
+    // Each block is a stateless type with static members; GradingPolicy<> stitches them together
+    // at compile time, so the per-score work inlines into one loop with no virtual calls.
+
+    // Internal/final mark weighting for a course's assessments, in whole percent
+    template <int InternalPercent, int FinalPercent>
+    struct MarkWeights {
+        static_assert(InternalPercent >= 0 && FinalPercent >= 0 && InternalPercent + FinalPercent == 100,
+                      "Mark weights must be non-negative and sum to 100%");
+        static constexpr double INTERNAL = InternalPercent / 100.0;
+        static constexpr double FINAL = FinalPercent / 100.0;
+    };
+    using StandardWeights = MarkWeights<30, 70>;   // Assessment::INTERNAL_WEIGHT / FINAL_WEIGHT
+
+    // Selection: which of a student's (score, weight) pairs count. Works in place on scratch.
+    struct AllScores {
+        static void select(vector<pair<double, double>>&) {}
+    };
+
+    template <size_t Count>
+    struct DropLowest {
+        static void select(vector<pair<double, double>>& scored) {
+            if (scored.size() <= Count) return;   // Never drop a student's only scores
+            nth_element(scored.begin(), scored.begin() + Count, scored.end());
+            scored.erase(scored.begin(), scored.begin() + Count);
+        }
+    };
+
+    template <size_t Count>
+    struct BestN {
+        static_assert(Count > 0, "BestN needs at least one score");
+        static void select(vector<pair<double, double>>& scored) {
+            if (scored.size() <= Count) return;
+            nth_element(scored.begin(), scored.begin() + Count, scored.end(), greater<pair<double, double>>());
+            scored.resize(Count);
+        }
+    };
+
+    // Combination: selected pairs -> one grade
+    struct Mean {
+        static double combine(const vector<pair<double, double>>& scored) {
+            if (scored.empty()) return 0.0;
+            double sum = 0.0;
+            for (const auto& entry : scored) sum += entry.first;
+            return sum / static_cast<double>(scored.size());
+        }
+    };
+
+    struct WeightedMean {
+        static double combine(const vector<pair<double, double>>& scored) {
+            double sum = 0.0, weightSum = 0.0;
+            for (const auto& entry : scored) {
+                sum += entry.first * entry.second;
+                weightSum += entry.second;
+            }
+            return weightSum > 0.0 ? sum / weightSum : 0.0;
+        }
+    };
+
+    // Cap: final clamp on the combined grade
+    struct NoCap {
+        static double apply(double grade) { return grade; }
+    };
+
+    template <int MaxPercent>
+    struct CapAt {
+        static double apply(double grade) { return min(grade, static_cast<double>(MaxPercent)); }
+    };
+
+    /**
+     * CourseGradingPolicy for Pokeno South Primary School
+     * What a course needs from its grading rules, behind one virtual boundary
+     *
+     * Key Features:
+     * - Still a GradeCalculator, so existing callers can use a policy unchanged
+     * - assessmentGrade()/assessmentGrades() apply the course's internal/final weights
+     * - Batch entry points are virtual once per batch; the loops inside are fully inlined
+     * - averagesAllScores() tells Student it may answer from its running course mean
+     */
+    class CourseGradingPolicy : public GradeCalculator {
+    public:
+        using GradeCalculator::calculateGrade;
+
+        virtual double assessmentGrade(double internalMarks, double finalMarks) const = 0;
+        virtual void assessmentGrades(const double* internalMarks, const double* finalMarks,
+                                      double* grades, size_t count) const = 0;
+        virtual double internalWeight() const = 0;
+        virtual double finalWeight() const = 0;
+        virtual bool averagesAllScores() const = 0;   // Course grade = plain mean of every assessment grade
+        virtual const string& getName() const = 0;
+    };
+
+    /**
+     * GradingPolicy for Pokeno South Primary School
+     * One compile-time composition of weights, selection, combination and cap
+     *
+     * Key Features:
+     * - e.g. GradingPolicy<StandardWeights, DropLowest<1>, Mean, CapAt<100>>
+     * - calculateGrades() runs selection and combination for every group in one loop,
+     *   reusing a single scratch buffer across the batch
+     * - Assessment weighting goes through GradeKernel::weightedGrades (SIMD where available)
+     */
+    template <typename Weights, typename Selection = AllScores, typename Combine = Mean, typename Cap = NoCap>
+    class GradingPolicy final : public CourseGradingPolicy {
+    private:
+        string name;
+
+        static double gradeGroup(const ScoreSpan& scores, vector<pair<double, double>>& scratch) {
+            scratch.clear();
+            for (size_t i = 0; i < scores.count; ++i) {
+                scratch.emplace_back(scores.scores[i], scores.weights ? scores.weights[i] : 1.0);
+            }
+            Selection::select(scratch);
+            return Cap::apply(Combine::combine(scratch));
+        }
+
+    public:
+        explicit GradingPolicy(const string& name) : name(name) {}
+
+        double calculateGrade(const vector<AssessmentScore>& scores) const override {
+            vector<pair<double, double>> scratch;
+            scratch.reserve(scores.size());
+            for (const auto& score : scores) scratch.emplace_back(score.score, score.weight);
+            Selection::select(scratch);
+            return Cap::apply(Combine::combine(scratch));
+        }
+
+        double calculateGrade(const ScoreSpan& scores) const override {
+            vector<pair<double, double>> scratch;
+            scratch.reserve(scores.count);
+            return gradeGroup(scores, scratch);
+        }
+
+        void calculateGrades(const ScoreBatch& batch, double* grades) const override {
+            vector<pair<double, double>> scratch;
+            for (size_t g = 0; g < batch.groupCount; ++g) {
+                grades[g] = gradeGroup(batch.group(g), scratch);
+            }
+        }
+
+        double assessmentGrade(double internalMarks, double finalMarks) const override {
+            return internalMarks * Weights::INTERNAL + finalMarks * Weights::FINAL;
+        }
+
+        void assessmentGrades(const double* internalMarks, const double* finalMarks,
+                              double* grades, size_t count) const override {
+            GradeKernel::weightedGrades(internalMarks, finalMarks, grades, count, Weights::INTERNAL, Weights::FINAL);
+        }
+
+        double internalWeight() const override { return Weights::INTERNAL; }
+        double finalWeight() const override { return Weights::FINAL; }
+
+        bool averagesAllScores() const override {
+            return is_same<Selection, AllScores>::value && is_same<Combine, Mean>::value && is_same<Cap, NoCap>::value;
+        }
+
+        const string& getName() const override { return name; }
+    };
+
+    /**
+     * GradingPolicyRegistry for Pokeno South Primary School
+     * Runtime map from courses to compiled grading policies
+     *
+     * Key Features:
+     * - define<Policy>(name) instantiates a policy once; courses share it by name
+     * - Course lookup is a vector index by course SymbolKey, falling back to the "standard" policy
+     * - Built-in policies: "standard", "drop-lowest", "best-3", "capped", "split-40-60", "split-50-50"
+     * - assign() rejects unknown policy names with invalid_argument, like entity setters
+     * - Assessment grades and Student course grades read forCourse(); changing an assignment
+     *   does not re-grade anything by itself (System::applyGradingPolicy does)
+     */
+    class GradingPolicyRegistry {
+    private:
+        unordered_map<string, unique_ptr<CourseGradingPolicy>> policies;
+        vector<const CourseGradingPolicy*> policyByCourse;   // Indexed by course SymbolKey; null = default
+        const CourseGradingPolicy* defaultPolicy = nullptr;
+
+    public:
+        static constexpr const char* DEFAULT_POLICY = "standard";   // Courses with no assignment
+
+        GradingPolicyRegistry();
+        GradingPolicyRegistry(const GradingPolicyRegistry&) = delete;
+        GradingPolicyRegistry& operator=(const GradingPolicyRegistry&) = delete;
+
+        // First definition of a name wins; later calls return the existing policy
+        template <typename Policy>
+        const CourseGradingPolicy& define(const string& name) {
+            auto& slot = policies[name];
+            if (!slot) {
+                slot = make_unique<Policy>(name);
+            }
+            return *slot;
+        }
+
+        const CourseGradingPolicy* find(const string& name) const;   // nullptr if undefined
+        vector<string> names() const;                                 // Every defined policy, sorted
+
+        void assign(SymbolKey courseKey, const string& policyName);
+        void unassign(SymbolKey courseKey);                           // Back to the default policy
+        const CourseGradingPolicy& forCourse(SymbolKey courseKey) const;
+        const CourseGradingPolicy& defaultForCourses() const { return *defaultPolicy; }
+
+        static GradingPolicyRegistry& shared();
+    };
+}
@@ -0,0 +1,132 @@
+#include "MappedFile.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define POKENO_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace PokenoSouth {
+
+    MappedFile::MappedFile(const string& path) : path(path) {
+#ifdef POKENO_MMAP
+        descriptor = ::open(path.c_str(), O_RDWR);
+        if (descriptor < 0) throw runtime_error("cannot open " + path);
+        struct stat status;
+        if (::fstat(descriptor, &status) != 0) {
+            release();
+            throw runtime_error("cannot stat " + path);
+        }
+        length = static_cast<size_t>(status.st_size);
+        map();
+#else
+        ifstream file(path, ios::binary);
+        if (!file) throw runtime_error("cannot open " + path);
+        ostringstream contents;
+        contents << file.rdbuf();
+        buffer = contents.str();
+        length = buffer.size();
+#endif
+    }
+
+    MappedFile MappedFile::create(const string& path, size_t length) {
+        {
+            fstream file(path, ios::out | ios::binary | ios::trunc);
+            if (!file) throw runtime_error("cannot create " + path);
+        }
+        MappedFile created(path);
+        created.resize(length);
+        return created;
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : path(std::move(other.path)), base(other.base), length(other.length), descriptor(other.descriptor),
+          mapped(other.mapped), buffer(std::move(other.buffer)) {
+        other.base = nullptr;
+        other.length = 0;
+        other.descriptor = -1;
+        other.mapped = false;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            path = std::move(other.path);
+            base = other.base;
+            length = other.length;
+            descriptor = other.descriptor;
+            mapped = other.mapped;
+            buffer = std::move(other.buffer);
+            other.base = nullptr;
+            other.length = 0;
+            other.descriptor = -1;
+            other.mapped = false;
+        }
+        return *this;
+    }
+
+    // Maps 'length' bytes of the open descriptor; an empty file is just an empty view
+    void MappedFile::map() {
+#ifdef POKENO_MMAP
+        if (length == 0) return;   // mmap rejects empty mappings
+        void* address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        if (address == MAP_FAILED) {
+            release();
+            throw runtime_error("cannot map " + path);
+        }
+        base = static_cast<char*>(address);
+        mapped = true;
+#endif
+    }
+
+    void MappedFile::release() {
+#ifdef POKENO_MMAP
+        if (mapped) ::munmap(base, length);
+        if (descriptor >= 0) ::close(descriptor);
+#endif
+        base = nullptr;
+        length = 0;
+        descriptor = -1;
+        mapped = false;
+        buffer.clear();
+    }
+
+    void MappedFile::resize(size_t newLength) {
+#ifdef POKENO_MMAP
+        if (mapped) ::munmap(base, length);
+        base = nullptr;
+        mapped = false;
+        if (::ftruncate(descriptor, static_cast<off_t>(newLength)) != 0) {
+            release();
+            throw runtime_error("cannot resize " + path + " to " + to_string(newLength) + " bytes");
+        }
+        length = newLength;
+        map();
+#else
+        std::filesystem::resize_file(path, newLength);
+        buffer.resize(newLength, '\0');
+        length = newLength;
+#endif
+    }
+
+    void MappedFile::flush(size_t offset, size_t count) {
+        if (count == 0 || offset >= length) return;
+        count = std::min(count, length - offset);
+#ifdef POKENO_MMAP
+        // msync takes page-aligned addresses
+        static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t start = offset - offset % pageSize;
+        if (::msync(base + start, offset + count - start, MS_SYNC) != 0) {
+            throw runtime_error("cannot sync " + path);
+        }
+#else
+        fstream file(path, ios::in | ios::out | ios::binary);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(buffer.data() + offset, static_cast<std::streamsize>(count));
+        file.flush();
+        if (!file) throw runtime_error("cannot write " + path);
+#endif
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "common.hpp"
+
+USING_STD_MAPPEDFILE
+
+namespace PokenoSouth {
+    /**
+     * MappedFile for Pokeno South Primary School
+     * Read-write view of a whole file, memory-mapped where the platform allows
+     *
+     * Key Features:
+     * - Opening is one mmap call: nothing is read until a page is touched, and pages come
+     *   straight from the OS page cache, shared with every other user of the file
+     * - Writes through data() land in the file itself (a shared mapping); flush() forces a
+     *   range to the device, so a change is durable once flush() returns
+     * - resize() grows or shrinks the file and maps it again: addresses from data() taken
+     *   before a resize() are invalid after it, so keep offsets, not pointers
+     * - Where mmap is unavailable the file is read into a buffer behind the same data() view,
+     *   and flush() writes the range back
+     * - The mapping stays valid if the file is replaced on disk by a rename; it then refers to
+     *   the replaced file. Move-only; throws runtime_error if the file cannot be opened or mapped
+     */
+    class MappedFile {
+    private:
+        string path;
+        char* base = nullptr;
+        size_t length = 0;
+        int descriptor = -1;   // Kept open for resize()
+        bool mapped = false;
+        string buffer;         // Used instead of a mapping where mmap is unavailable
+
+        void map();
+        void release();
+
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const string& path);   // An existing file
+        ~MappedFile() { release(); }
+
+        // Creates or truncates 'path' to 'length' zero bytes and maps it
+        static MappedFile create(const string& path, size_t length);
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        char* data() { return mapped ? base : buffer.data(); }
+        const char* data() const { return mapped ? base : buffer.data(); }
+        size_t size() const { return length; }
+        bool isMapped() const { return mapped; }
+        const string& getPath() const { return path; }
+
+        void resize(size_t newLength);
+        void flush(size_t offset, size_t count);
+    };
+}
@@ -0,0 +1,227 @@
+#include "MappedHeap.hpp"
+#include "Crc32c.hpp"
+
+namespace PokenoSouth {
+
+    namespace {
+        // "PSHEAP" + format version; bump the version whenever a record layout changes
+        constexpr string_view MAGIC = "PSHEAP02";
+
+        // New files leave this much heap for edits before the file has to grow
+        constexpr uint64_t MIN_HEAP_SLACK = 64 * 1024;
+
+        using StringRef = MappedHeap::StringRef;
+        using SlotKind = MappedHeap::SlotKind;
+
+        // Every string field of a slot except a student's enrollment list, which holds refs itself
+        template <typename Slot, typename Visit>
+        void forEachString(Slot& slot, Visit&& visit) {
+            switch (slot.kind) {
+                case SlotKind::COURSE: {
+                    auto& record = slot.course;
+                    for (auto* field : {&record.courseId, &record.courseName, &record.description,
+                                        &record.teacher, &record.gradingPolicy}) visit(*field);
+                    break;
+                }
+                case SlotKind::STUDENT: {
+                    auto& record = slot.student;
+                    for (auto* field : {&record.firstName, &record.lastName, &record.address,
+                                        &record.contactEmail, &record.emergencyContact}) visit(*field);
+                    break;
+                }
+                case SlotKind::ASSESSMENT: {
+                    auto& record = slot.assessment;
+                    for (auto* field : {&record.assessmentId, &record.courseId, &record.assessmentType,
+                                        &record.remarks}) visit(*field);
+                    break;
+                }
+                case SlotKind::FREE:
+                    break;
+            }
+        }
+
+        vector<StringRef> parseRefs(string_view list) {
+            if (list.size() % sizeof(StringRef) != 0) throw runtime_error("entity heap reference list is malformed");
+            vector<StringRef> refs(list.size() / sizeof(StringRef));
+            if (!refs.empty()) memcpy(refs.data(), list.data(), list.size());
+            return refs;
+        }
+    }
+
+    // Explicit padding only: the file must not depend on what the compiler leaves in the gaps
+    static_assert(sizeof(MappedHeap::StringRef) == 8, "StringRef layout changed");
+    static_assert(sizeof(MappedHeap::CourseRecord) == 64, "CourseRecord layout changed");
+    static_assert(sizeof(MappedHeap::StudentRecord) == 64, "StudentRecord layout changed");
+    static_assert(sizeof(MappedHeap::AssessmentRecord) == 64, "AssessmentRecord layout changed");
+    static_assert(sizeof(MappedHeap::Slot) == 72, "Slot layout changed");
+    static_assert(std::is_trivially_copyable<MappedHeap::Slot>::value, "slots are copied as bytes");
+
+    // === BUILDER ===
+    StringRef MappedHeap::Builder::intern(string_view text) {
+        string key(text);
+        auto it = interned.find(key);
+        if (it != interned.end()) return it->second;
+        if (heap.size() + text.size() > UINT32_MAX) throw runtime_error("entity heap exceeds 4 GiB");
+        const StringRef reference{static_cast<uint32_t>(heap.size()), static_cast<uint32_t>(text.size())};
+        heap.append(text);
+        interned.emplace(std::move(key), reference);
+        return reference;
+    }
+
+    string MappedHeap::Builder::image(uint32_t slotCapacity) const {
+        Header header{};
+        memcpy(header.magic, MAGIC.data(), sizeof(header.magic));
+        header.slotCapacity = std::max({slotCapacity, MIN_SLOT_CAPACITY, static_cast<uint32_t>(slots.size())});
+        header.slotCount = static_cast<uint32_t>(slots.size());
+        header.heapSize = heap.size();
+        header.heapCapacity = heap.size() + std::max<uint64_t>(heap.size() / 2, MIN_HEAP_SLACK);
+        header.checksum = headerChecksum(header);
+
+        const size_t heapStart = sizeof(Header) + static_cast<size_t>(header.slotCapacity) * sizeof(Slot);
+        string image(heapStart + header.heapCapacity, '\0');
+        memcpy(&image[0], &header, sizeof(Header));
+        for (size_t i = 0; i < slots.size(); ++i) {
+            Slot slot = slots[i];
+            slot.checksum = checksum(slot, heap);
+            memcpy(&image[sizeof(Header) + i * sizeof(Slot)], &slot, sizeof(Slot));
+        }
+        if (!heap.empty()) memcpy(&image[heapStart], heap.data(), heap.size());
+        return image;
+    }
+
+    // === OPENING ===
+    MappedHeap::MappedHeap(MappedFile image) : file(std::move(image)) {
+        if (file.size() < sizeof(Header)) throw runtime_error("not an entity heap file");
+        memcpy(&header, file.data(), sizeof(Header));
+        if (string_view(header.magic, sizeof(header.magic)) != MAGIC) {
+            throw runtime_error("not an entity heap file, or one from another format version");
+        }
+        if (headerChecksum(header) != header.checksum) throw runtime_error("entity heap header checksum mismatch");
+        if (header.slotCount > header.slotCapacity || header.heapSize > header.heapCapacity ||
+            file.size() != heapOffset() + header.heapCapacity) {
+            throw runtime_error("entity heap file is truncated or has trailing data");
+        }
+        flushedHeapSize = header.heapSize;
+    }
+
+    uint32_t MappedHeap::headerChecksum(const Header& header) {
+        return Crc32c::compute(string_view(reinterpret_cast<const char*>(&header), offsetof(Header, checksum)));
+    }
+
+    void MappedHeap::writeHeader() {
+        header.checksum = headerChecksum(header);
+        if (memcmp(file.data(), &header, sizeof(Header)) == 0) return;
+        memcpy(file.data(), &header, sizeof(Header));
+        file.flush(0, sizeof(Header));
+    }
+
+    MappedHeap::Slot MappedHeap::emptySlot(SlotKind kind) {
+        Slot slot;
+        memset(&slot, 0, sizeof(Slot));   // Unused union bytes too: they are checksummed
+        slot.kind = kind;
+        return slot;
+    }
+
+    // === READING ===
+    string_view MappedHeap::text(string_view heap, StringRef reference) {
+        if (reference.offset > heap.size() || reference.length > heap.size() - reference.offset) {
+            throw runtime_error("entity heap string out of range");
+        }
+        return heap.substr(reference.offset, reference.length);
+    }
+
+    uint32_t MappedHeap::checksum(const Slot& slot, string_view heap) {
+        Crc32c crc;
+        crc.update(reinterpret_cast<const char*>(&slot) + sizeof(slot.checksum), sizeof(Slot) - sizeof(slot.checksum));
+        forEachString(slot, [&](const StringRef& field) { crc.update(text(heap, field)); });
+        if (slot.kind == SlotKind::STUDENT) {
+            const string_view list = text(heap, slot.student.enrollments);
+            crc.update(list);
+            for (const StringRef& courseId : parseRefs(list)) crc.update(text(heap, courseId));
+        }
+        return crc.value();
+    }
+
+    MappedHeap::SlotKind MappedHeap::kindAt(uint32_t index) const {
+        return slot(index).kind;
+    }
+
+    MappedHeap::Slot MappedHeap::slot(uint32_t index) const {
+        if (index >= header.slotCount) throw runtime_error("entity heap slot " + to_string(index) + " out of range");
+        Slot copy;
+        memcpy(&copy, file.data() + slotOffset(index), sizeof(Slot));
+        return copy;
+    }
+
+    MappedHeap::Slot MappedHeap::verifiedSlot(uint32_t index) const {
+        const Slot copy = slot(index);
+        if (copy.kind == SlotKind::FREE) return copy;
+        if (copy.kind > SlotKind::ASSESSMENT || checksum(copy, heapView()) != copy.checksum) {
+            throw runtime_error("entity heap record in slot " + to_string(index) + " failed its checksum");
+        }
+        return copy;
+    }
+
+    vector<StringRef> MappedHeap::refs(StringRef list) const {
+        return parseRefs(text(list));
+    }
+
+    string MappedHeap::refList(const vector<StringRef>& refs) {
+        string list(refs.size() * sizeof(StringRef), '\0');
+        if (!refs.empty()) memcpy(&list[0], refs.data(), list.size());
+        return list;
+    }
+
+    // === CHANGING IN PLACE ===
+    StringRef MappedHeap::append(string_view text, StringRef previous) {
+        // 'previous' may come from a record that was never checked: compare, never trust it
+        const string_view heap = heapView();
+        if (previous.length == text.size() && previous.offset <= heap.size() &&
+            previous.length <= heap.size() - previous.offset && heap.substr(previous.offset, previous.length) == text) {
+            return previous;
+        }
+        if (header.heapSize + text.size() > UINT32_MAX) throw runtime_error("entity heap exceeds 4 GiB");
+
+        if (header.heapSize + text.size() > header.heapCapacity) {
+            // The header must describe the new length before anything relies on it
+            header.heapCapacity = std::max(header.heapCapacity * 2, header.heapSize + text.size());
+            file.resize(heapOffset() + header.heapCapacity);
+            writeHeader();
+        }
+        const StringRef reference{static_cast<uint32_t>(header.heapSize), static_cast<uint32_t>(text.size())};
+        if (!text.empty()) memcpy(file.data() + heapOffset() + header.heapSize, text.data(), text.size());
+        header.heapSize += text.size();
+        return reference;
+    }
+
+    void MappedHeap::write(uint32_t index, Slot slot) {
+        if (index > header.slotCount || index >= header.slotCapacity) {
+            throw runtime_error("entity heap slot " + to_string(index) + " out of range");
+        }
+        slot.checksum = checksum(slot, heapView());
+
+        // Strings, then the header that covers them, then the slot that refers to them
+        file.flush(heapOffset() + flushedHeapSize, header.heapSize - flushedHeapSize);
+        flushedHeapSize = header.heapSize;
+        if (index == header.slotCount) header.slotCount++;
+        writeHeader();
+        memcpy(file.data() + slotOffset(index), &slot, sizeof(Slot));
+        file.flush(slotOffset(index), sizeof(Slot));
+    }
+
+    void MappedHeap::free(uint32_t index) {
+        if (index >= header.slotCount) throw runtime_error("entity heap slot " + to_string(index) + " out of range");
+        const Slot freed = emptySlot(SlotKind::FREE);
+        memcpy(file.data() + slotOffset(index), &freed, sizeof(Slot));
+        file.flush(slotOffset(index), sizeof(Slot));
+    }
+
+    void MappedHeap::rebase(Slot& slot, Builder& builder) const {
+        forEachString(slot, [&](StringRef& field) { field = builder.intern(text(field)); });
+        if (slot.kind == SlotKind::STUDENT) {
+            vector<StringRef> courseIds = refs(slot.student.enrollments);
+            for (StringRef& courseId : courseIds) courseId = builder.intern(text(courseId));
+            slot.student.enrollments = builder.intern(refList(courseIds));
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "MappedFile.hpp"
+
+USING_STD_MAPPEDFILE
+
+namespace PokenoSouth {
+    /**
+     * MappedHeap for Pokeno South Primary School
+     * Entity records laid out to be used, and changed, where they lie in a mapped file
+     *
+     * Key Features:
+     * - Layout: Header | Slot x slot capacity | string heap. Every slot is one fixed-width
+     *   course, student or assessment record, or free; the heap holds their strings
+     * - Records refer to strings by (offset, length) into the heap, never by address, so the
+     *   file means the same wherever it is mapped and however often the heap grows
+     * - A student's enrollments are a heap string holding the StringRefs of its course IDs
+     * - Opening checks the header only. Each slot carries a CRC32C of its bytes and of every
+     *   string it refers to, checked by verifiedSlot() when that record is read: the cost of
+     *   validation follows the records used, not the size of the file
+     * - write() changes one slot in place: its new strings are appended to the heap, then the
+     *   heap, the header and the slot are flushed in that order, so a crash leaves either the
+     *   old record or the new one, or a slot that fails its checksum. Nothing else moves
+     * - Strings a changed record no longer uses stay in the heap until the file is rebuilt
+     *   through a Builder, which also stores equal strings once
+     */
+    class MappedHeap {
+    public:
+        struct StringRef {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        enum class SlotKind : uint8_t { FREE = 0, COURSE = 1, STUDENT = 2, ASSESSMENT = 3 };
+
+        struct CourseRecord {
+            StringRef courseId, courseName, description, teacher, gradingPolicy;
+            int32_t credits, duration, startDate, endDate, maxEnrollment;
+            uint8_t isActive;
+            uint8_t padding[3];
+        };
+
+        struct StudentRecord {
+            StringRef firstName, lastName, address, contactEmail, emergencyContact;
+            StringRef enrollments;   // StringRef x n: the course IDs
+            int32_t rollNumber, dateOfBirth, enrollmentDate;
+            uint32_t padding;
+        };
+
+        struct AssessmentRecord {
+            double internalMarks, finalMarks;
+            StringRef assessmentId, courseId, assessmentType, remarks;
+            int32_t studentRollNumber, assessmentDate, submissionDate;
+            uint8_t isSubmitted, linked;   // linked: attached to the student with its roll number
+            uint8_t padding[2];
+        };
+
+        struct Slot {
+            uint32_t checksum;   // CRC32C of the rest of the slot and of every string it refers to
+            SlotKind kind;
+            uint8_t padding[3];
+            union {
+                CourseRecord course;
+                StudentRecord student;
+                AssessmentRecord assessment;
+            };
+        };
+
+        // A new image built in memory: slots in order, then a heap of distinct strings
+        class Builder {
+        private:
+            vector<Slot> slots;
+            string heap;
+            unordered_map<string, StringRef> interned;
+
+        public:
+            StringRef intern(string_view text);
+            void add(const Slot& slot) { slots.push_back(slot); }
+            size_t size() const { return slots.size(); }
+
+            // The whole file, with room for at least 'slotCapacity' slots and some heap growth
+            string image(uint32_t slotCapacity) const;
+        };
+
+        static constexpr uint32_t MIN_SLOT_CAPACITY = 64;
+
+    private:
+        struct Header {
+            char magic[8];
+            uint32_t slotCapacity;
+            uint32_t slotCount;      // Slots [0, slotCount) have been used; free ones say so
+            uint64_t heapSize;       // Bytes of the heap in use
+            uint64_t heapCapacity;   // Bytes reserved for it at the end of the file
+            uint32_t checksum;       // CRC32C of the fields above
+            uint32_t padding;
+        };
+
+        MappedFile file;
+        Header header;
+        uint64_t flushedHeapSize;   // Heap bytes up to here are on the device
+
+        size_t slotOffset(uint32_t index) const { return sizeof(Header) + static_cast<size_t>(index) * sizeof(Slot); }
+        size_t heapOffset() const { return slotOffset(header.slotCapacity); }
+        string_view heapView() const { return string_view(file.data() + heapOffset(), header.heapSize); }
+        void writeHeader();
+
+        static uint32_t headerChecksum(const Header& header);
+
+        static string_view text(string_view heap, StringRef reference);
+        static uint32_t checksum(const Slot& slot, string_view heap);
+
+    public:
+        // Takes over an image file; throws runtime_error unless its header is intact
+        explicit MappedHeap(MappedFile image);
+
+        static Slot emptySlot(SlotKind kind);
+
+        uint32_t slotCount() const { return header.slotCount; }
+        uint32_t slotCapacity() const { return header.slotCapacity; }
+        uint64_t heapSize() const { return header.heapSize; }
+        bool isMapped() const { return file.isMapped(); }
+
+        // index < slotCount(). kindAt() and slot() read the bytes as they are; verifiedSlot()
+        // also checks the slot's checksum, throwing runtime_error on a mismatch
+        SlotKind kindAt(uint32_t index) const;
+        Slot slot(uint32_t index) const;
+        Slot verifiedSlot(uint32_t index) const;
+
+        // Points into the mapping until the next append(); throws runtime_error outside the heap
+        string_view text(StringRef reference) const { return text(heapView(), reference); }
+        vector<StringRef> refs(StringRef list) const;   // A StringRef list, e.g. enrollments
+        static string refList(const vector<StringRef>& refs);   // The bytes of one, to store as a string
+
+        // 'previous' if it already holds 'text', else a copy appended to the heap
+        StringRef append(string_view text, StringRef previous = StringRef{0, 0});
+
+        // Persists one slot (index <= slotCount() < slotCapacity()); its strings must be in the heap
+        void write(uint32_t index, Slot slot);
+        void free(uint32_t index);
+
+        // Copies a slot's strings into 'builder' and points the slot at the copies
+        void rebase(Slot& slot, Builder& builder) const;
+    };
+}
@@ -0,0 +1,436 @@
+#include "MappedStorage.hpp"
+
+namespace PokenoSouth {
+
+    namespace {
+        using StringRef = MappedHeap::StringRef;
+        using Slot = MappedHeap::Slot;
+        using SlotKind = MappedHeap::SlotKind;
+
+        // Stores a string for a record field, given the field's value in the record it replaces
+        using Intern = function<StringRef(const string&, StringRef)>;
+
+        Slot encodeCourse(const Course& course, const Slot& previous, const Intern& intern) {
+            Slot slot = MappedHeap::emptySlot(SlotKind::COURSE);
+            MappedHeap::CourseRecord& record = slot.course;
+            const MappedHeap::CourseRecord& before = previous.course;
+            record.courseId = intern(course.getCourseId(), before.courseId);
+            record.courseName = intern(course.getCourseName(), before.courseName);
+            record.description = intern(course.getDescription(), before.description);
+            record.teacher = intern(course.getTeacher(), before.teacher);
+            record.gradingPolicy = intern(course.getGradingPolicyName(), before.gradingPolicy);
+            record.credits = course.getCredits();
+            record.duration = course.getDuration();
+            record.startDate = course.getStartDate().dayNumber();
+            record.endDate = course.getEndDate().dayNumber();
+            record.maxEnrollment = course.getMaxEnrollment();
+            record.isActive = course.getIsActive() ? 1 : 0;
+            return slot;
+        }
+
+        Slot encodeStudent(const Student& student, const Slot& previous, const Intern& intern, const Intern& internCourseId) {
+            Slot slot = MappedHeap::emptySlot(SlotKind::STUDENT);
+            MappedHeap::StudentRecord& record = slot.student;
+            const MappedHeap::StudentRecord& before = previous.student;
+            record.firstName = intern(student.getFirstName(), before.firstName);
+            record.lastName = intern(student.getLastName(), before.lastName);
+            record.address = intern(student.getAddress(), before.address);
+            record.contactEmail = intern(student.getContactEmail(), before.contactEmail);
+            record.emergencyContact = intern(student.getEmergencyContact(), before.emergencyContact);
+            vector<StringRef> courseIds;
+            for (const Course* course : student.getEnrolledCourses()) {
+                courseIds.push_back(internCourseId(course->getCourseId(), StringRef{0, 0}));
+            }
+            record.enrollments = intern(MappedHeap::refList(courseIds), before.enrollments);
+            record.rollNumber = student.getRollNumber();
+            record.dateOfBirth = student.getDateOfBirth().dayNumber();
+            record.enrollmentDate = student.getEnrollmentDate().dayNumber();
+            return slot;
+        }
+
+        Slot encodeAssessment(const Assessment& assessment, const Slot& previous, const Intern& intern,
+                              const Intern& internCourseId) {
+            Slot slot = MappedHeap::emptySlot(SlotKind::ASSESSMENT);
+            MappedHeap::AssessmentRecord& record = slot.assessment;
+            const MappedHeap::AssessmentRecord& before = previous.assessment;
+            record.internalMarks = assessment.getInternalMarks();
+            record.finalMarks = assessment.getFinalMarks();
+            record.assessmentId = intern(assessment.getAssessmentId(), before.assessmentId);
+            record.courseId = internCourseId(assessment.getCourseId(), before.courseId);
+            record.assessmentType = intern(assessment.getAssessmentType(), before.assessmentType);
+            record.remarks = intern(assessment.getRemarks(), before.remarks);
+            record.studentRollNumber = assessment.getStudentRollNumber();
+            record.assessmentDate = assessment.getAssessmentDate().dayNumber();
+            record.submissionDate = assessment.getSubmissionDate().dayNumber();
+            record.isSubmitted = assessment.getIsSubmitted() ? 1 : 0;
+            record.linked = assessment.getOwner() ? 1 : 0;
+            return slot;
+        }
+
+        template <typename Key>
+        void unlist(unordered_map<Key, vector<uint32_t>>& lists, const Key& key, uint32_t slot) {
+            auto it = lists.find(key);
+            if (it == lists.end()) return;
+            vector<uint32_t>& slots = it->second;
+            slots.erase(std::remove(slots.begin(), slots.end(), slot), slots.end());
+            if (slots.empty()) lists.erase(it);
+        }
+    }
+
+    MappedStorage::MappedStorage(string path, string backupDirectory)
+        : path(std::move(path)), backupDirectory(std::move(backupDirectory)) {}
+
+    // === THE MAPPED FILE ===
+    MappedHeap& MappedStorage::open() {
+        if (!heap) {
+            const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+            if (!parent.empty()) std::filesystem::create_directories(parent);
+            if (!std::filesystem::exists(path)) {
+                replace(MappedHeap::Builder().image(0));
+            } else {
+                heap = make_unique<MappedHeap>(MappedFile(path));
+                index();
+            }
+        }
+        return *heap;
+    }
+
+    // Reads where every record is from its key fields; record contents are checked when loaded
+    void MappedStorage::index() {
+        studentSlots.clear();
+        courseSlots.clear();
+        assessmentSlots.clear();
+        assessmentsByStudent.clear();
+        assessmentsByCourse.clear();
+        freeSlots.clear();
+
+        const MappedHeap& records = *heap;
+        for (uint32_t i = 0; i < records.slotCount(); ++i) {
+            const Slot slot = records.slot(i);
+            switch (slot.kind) {
+                case SlotKind::FREE:
+                    freeSlots.push_back(i);
+                    break;
+                case SlotKind::COURSE:
+                    courseSlots[string(records.text(slot.course.courseId))] = i;
+                    break;
+                case SlotKind::STUDENT:
+                    studentSlots[slot.student.rollNumber] = i;
+                    break;
+                case SlotKind::ASSESSMENT:
+                    assessmentSlots[string(records.text(slot.assessment.assessmentId))].push_back(i);
+                    assessmentsByStudent[slot.assessment.studentRollNumber].push_back(i);
+                    assessmentsByCourse[string(records.text(slot.assessment.courseId))].push_back(i);
+                    break;
+                default:
+                    throw runtime_error("entity heap slot " + to_string(i) + " holds no known record kind");
+            }
+        }
+        std::reverse(freeSlots.begin(), freeSlots.end());   // Lowest slot reused first
+    }
+
+    // Writes 'image' next to the file, renames it over the file and maps the result
+    void MappedStorage::replace(const string& image) {
+        heap.reset();
+        const string tempPath = path + ".tmp";
+        try {
+            MappedFile file = MappedFile::create(tempPath, image.size());
+            memcpy(file.data(), image.data(), image.size());
+            file.flush(0, image.size());
+        } catch (...) {
+            std::filesystem::remove(tempPath);
+            throw;
+        }
+        std::filesystem::rename(tempPath, path);
+        heap = make_unique<MappedHeap>(MappedFile(path));
+        index();
+    }
+
+    // Applies one edit; after a failure the record locations are read from the file again
+    bool MappedStorage::change(const string& action, const function<void()>& edit) {
+        clearError();
+        try {
+            open();
+            edit();
+            return true;
+        } catch (const exception& e) {
+            heap.reset();
+            setError("Cannot " + action + " in " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    // A slot for a new record. With none free the file is rebuilt with twice the slots, which
+    // renumbers the records: look slots up again after calling this
+    uint32_t MappedStorage::takeSlot() {
+        if (!freeSlots.empty()) {
+            const uint32_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
+        }
+        if (heap->slotCount() < heap->slotCapacity()) return heap->slotCount();
+
+        MappedHeap::Builder builder;
+        for (uint32_t i = 0; i < heap->slotCount(); ++i) {
+            Slot slot = heap->verifiedSlot(i);
+            if (slot.kind == SlotKind::FREE) continue;
+            heap->rebase(slot, builder);
+            builder.add(slot);
+        }
+        replace(builder.image(heap->slotCapacity() * 2));
+        return heap->slotCount();
+    }
+
+    // A course ID as stored in its course record, so enrollments and assessments share it
+    StringRef MappedStorage::courseIdRef(const string& courseId, StringRef previous) {
+        auto course = courseSlots.find(courseId);
+        if (course != courseSlots.end()) {
+            const Slot slot = heap->slot(course->second);
+            if (slot.kind == SlotKind::COURSE && heap->text(slot.course.courseId) == courseId) return slot.course.courseId;
+        }
+        return heap->append(courseId, previous);
+    }
+
+    // === RECORDS ===
+    void MappedStorage::putStudent(const Student& student) {
+        auto existing = studentSlots.find(student.getRollNumber());
+        const bool found = existing != studentSlots.end();
+        const uint32_t slot = found ? existing->second : takeSlot();
+        MappedHeap& records = *heap;
+        const Slot previous = found ? records.slot(slot) : MappedHeap::emptySlot(SlotKind::STUDENT);
+        const Intern intern = [&records](const string& text, StringRef before) { return records.append(text, before); };
+        const Intern internCourseId = [this](const string& text, StringRef before) { return courseIdRef(text, before); };
+        records.write(slot, encodeStudent(student, previous, intern, internCourseId));
+        studentSlots[student.getRollNumber()] = slot;
+    }
+
+    void MappedStorage::putCourse(const Course& course) {
+        auto existing = courseSlots.find(course.getCourseId());
+        const bool found = existing != courseSlots.end();
+        const uint32_t slot = found ? existing->second : takeSlot();
+        MappedHeap& records = *heap;
+        const Slot previous = found ? records.slot(slot) : MappedHeap::emptySlot(SlotKind::COURSE);
+        const Intern intern = [&records](const string& text, StringRef before) { return records.append(text, before); };
+        records.write(slot, encodeCourse(course, previous, intern));
+        courseSlots[course.getCourseId()] = slot;
+    }
+
+    void MappedStorage::putAssessment(const Assessment& assessment) {
+        auto existing = assessmentSlots.find(assessment.getAssessmentId());
+        const bool found = existing != assessmentSlots.end();
+        const uint32_t slot = found ? existing->second.front() : takeSlot();
+        MappedHeap& records = *heap;
+        Slot previous = MappedHeap::emptySlot(SlotKind::ASSESSMENT);
+        if (found) {
+            // A changed roll number or course moves the record between the lists below
+            previous = records.slot(slot);
+            unlist(assessmentsByStudent, static_cast<int>(previous.assessment.studentRollNumber), slot);
+            unlist(assessmentsByCourse, string(records.text(previous.assessment.courseId)), slot);
+        }
+        const Intern intern = [&records](const string& text, StringRef before) { return records.append(text, before); };
+        const Intern internCourseId = [this](const string& text, StringRef before) { return courseIdRef(text, before); };
+        records.write(slot, encodeAssessment(assessment, previous, intern, internCourseId));
+        if (!found) assessmentSlots[assessment.getAssessmentId()].push_back(slot);
+        assessmentsByStudent[assessment.getStudentRollNumber()].push_back(slot);
+        assessmentsByCourse[assessment.getCourseId()].push_back(slot);
+    }
+
+    void MappedStorage::eraseAssessment(uint32_t slot) {
+        const Slot record = heap->slot(slot);
+        unlist(assessmentSlots, string(heap->text(record.assessment.assessmentId)), slot);
+        unlist(assessmentsByStudent, static_cast<int>(record.assessment.studentRollNumber), slot);
+        unlist(assessmentsByCourse, string(heap->text(record.assessment.courseId)), slot);
+        heap->free(slot);
+        freeSlots.push_back(slot);
+    }
+
+    // === STORAGE OPERATIONS ===
+    bool MappedStorage::initialize() {
+        clearError();
+        try {
+            open();
+            return true;
+        } catch (const exception& e) {
+            heap.reset();
+            setError("Cannot open " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    bool MappedStorage::load(EntityArena<Student>& students,
+                             EntityArena<Course>& courses,
+                             EntityArena<Assessment>& assessments) {
+        clearError();
+        students.clear();
+        courses.clear();
+        assessments.clear();
+        if (!heap && !std::filesystem::exists(path)) return false;   // Nothing saved yet
+
+        try {
+            const MappedHeap& records = open();
+            if (studentSlots.empty() && courseSlots.empty() && assessmentSlots.empty()) return false;
+
+            unordered_map<string, Course*> courseById;
+            for (uint32_t i = 0; i < records.slotCount(); ++i) {
+                if (records.kindAt(i) != SlotKind::COURSE) continue;
+                const MappedHeap::CourseRecord record = records.verifiedSlot(i).course;
+                Course* course = courses.emplace(TRUSTED_INPUT,
+                                                 string(records.text(record.courseId)),
+                                                 string(records.text(record.courseName)),
+                                                 record.credits,
+                                                 string(records.text(record.description)),
+                                                 record.duration,
+                                                 string(records.text(record.teacher)),
+                                                 Date::fromDayNumber(record.startDate),
+                                                 Date::fromDayNumber(record.endDate),
+                                                 record.maxEnrollment,
+                                                 record.isActive != 0);
+                course->setGradingPolicy(string(records.text(record.gradingPolicy)));   // Before any grading below
+                courseById.emplace(course->getCourseId(), course);
+            }
+
+            unordered_map<int, Student*> studentByRoll;
+            for (uint32_t i = 0; i < records.slotCount(); ++i) {
+                if (records.kindAt(i) != SlotKind::STUDENT) continue;
+                const MappedHeap::StudentRecord record = records.verifiedSlot(i).student;
+                Student* student = students.emplace(TRUSTED_INPUT,
+                                                    record.rollNumber,
+                                                    string(records.text(record.firstName)),
+                                                    string(records.text(record.lastName)),
+                                                    Date::fromDayNumber(record.dateOfBirth),
+                                                    string(records.text(record.address)),
+                                                    string(records.text(record.contactEmail)),
+                                                    string(records.text(record.emergencyContact)),
+                                                    Date::fromDayNumber(record.enrollmentDate));
+                studentByRoll.emplace(record.rollNumber, student);
+
+                // Same restore rule as the CSV loader: saved enrollments are linked as-is
+                for (const StringRef courseId : records.refs(record.enrollments)) {
+                    auto course = courseById.find(string(records.text(courseId)));
+                    if (course != courseById.end() && student->attachCourse(course->second)) {
+                        course->second->attachStudent(student);
+                    }
+                }
+            }
+
+            for (uint32_t i = 0; i < records.slotCount(); ++i) {
+                if (records.kindAt(i) != SlotKind::ASSESSMENT) continue;
+                const MappedHeap::AssessmentRecord record = records.verifiedSlot(i).assessment;
+                Assessment* assessment = assessments.emplace(TRUSTED_INPUT,
+                                                             string(records.text(record.assessmentId)),
+                                                             record.studentRollNumber,
+                                                             string(records.text(record.courseId)),
+                                                             record.internalMarks,
+                                                             record.finalMarks,
+                                                             Date::fromDayNumber(record.assessmentDate),
+                                                             string(records.text(record.assessmentType)),
+                                                             record.isSubmitted != 0,
+                                                             Date::fromDayNumber(record.submissionDate),
+                                                             string(records.text(record.remarks)));
+                auto owner = studentByRoll.find(record.studentRollNumber);
+                if (record.linked && owner != studentByRoll.end()) owner->second->addAssessment(assessment);
+            }
+            return true;
+        } catch (const exception& e) {
+            students.clear();
+            courses.clear();
+            assessments.clear();
+            heap.reset();
+            setError("Cannot load " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    bool MappedStorage::save(const EntityArena<Student>& students,
+                             const EntityArena<Course>& courses,
+                             const EntityArena<Assessment>& assessments) {
+        clearError();
+        try {
+            MappedHeap::Builder builder;
+            const Intern intern = [&builder](const string& text, StringRef) { return builder.intern(text); };
+            const Slot none = MappedHeap::emptySlot(SlotKind::FREE);
+            for (const Course* course : courses) builder.add(encodeCourse(*course, none, intern));
+            for (const Student* student : students) builder.add(encodeStudent(*student, none, intern, intern));
+            for (const Assessment* assessment : assessments) {
+                builder.add(encodeAssessment(*assessment, none, intern, intern));
+            }
+            replace(builder.image(static_cast<uint32_t>(builder.size() * 2)));
+            return true;
+        } catch (const exception& e) {
+            heap.reset();
+            setError("Cannot save " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    bool MappedStorage::backup() {
+        clearError();
+        if (!heap && !std::filesystem::exists(path)) return true;   // Nothing to keep yet
+        try {
+            open();   // Every change is flushed as it is made, so the file on disk is complete
+            auto now = time(nullptr);
+            ostringstream timestamp;
+            timestamp << put_time(localtime(&now), "%Y%m%d_%H%M%S");
+            std::filesystem::create_directories(backupDirectory);
+            const string stem = std::filesystem::path(path).stem().string();
+            std::filesystem::copy_file(path, backupDirectory + stem + "_" + timestamp.str() + ".heap",
+                                       std::filesystem::copy_options::overwrite_existing);
+            return true;
+        } catch (const exception& e) {
+            setError("Cannot back up " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    // === RECORD-LEVEL API ===
+    bool MappedStorage::saveStudent(const Student& student) {
+        return change("save student " + to_string(student.getRollNumber()), [&] { putStudent(student); });
+    }
+
+    bool MappedStorage::saveCourse(const Course& course) {
+        return change("save course " + course.getCourseId(), [&] { putCourse(course); });
+    }
+
+    bool MappedStorage::saveAssessment(const Assessment& assessment) {
+        return change("save assessment " + assessment.getAssessmentId(), [&] { putAssessment(assessment); });
+    }
+
+    bool MappedStorage::removeStudent(int rollNumber) {
+        return change("remove student " + to_string(rollNumber), [&] {
+            auto owned = assessmentsByStudent.find(rollNumber);
+            if (owned != assessmentsByStudent.end()) {
+                const vector<uint32_t> slots = owned->second;   // eraseAssessment() edits the list
+                for (uint32_t slot : slots) eraseAssessment(slot);
+            }
+            auto student = studentSlots.find(rollNumber);
+            if (student != studentSlots.end()) {
+                heap->free(student->second);
+                freeSlots.push_back(student->second);
+                studentSlots.erase(student);
+            }
+        });
+    }
+
+    bool MappedStorage::removeCourse(const string& courseId) {
+        return change("remove course " + courseId, [&] {
+            auto owned = assessmentsByCourse.find(courseId);
+            if (owned != assessmentsByCourse.end()) {
+                const vector<uint32_t> slots = owned->second;
+                for (uint32_t slot : slots) eraseAssessment(slot);
+            }
+            auto course = courseSlots.find(courseId);
+            if (course != courseSlots.end()) {
+                heap->free(course->second);
+                freeSlots.push_back(course->second);
+                courseSlots.erase(course);
+            }
+        });
+    }
+
+    bool MappedStorage::removeAssessment(const string& assessmentId) {
+        return change("remove assessment " + assessmentId, [&] {
+            auto slots = assessmentSlots.find(assessmentId);
+            if (slots != assessmentSlots.end()) eraseAssessment(slots->second.front());
+        });
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "StorageBackend.hpp"
+#include "MappedHeap.hpp"
+
+namespace PokenoSouth {
+    /**
+     * MappedStorage for Pokeno South Primary School
+     * Entities as fixed-width records in one memory-mapped file (see MappedHeap)
+     *
+     * Key Features:
+     * - Opening is an mmap call and a header check. load() builds the entities straight from
+     *   the mapped records, checking each record's checksum as it reads it: no read into a
+     *   buffer, no text parsing, and the OS page cache serves repeat starts
+     * - The mapped file is the live store. System routes every single-entity edit through the
+     *   record-level API (saveStudent(), removeCourse(), ...), which rewrites that one record
+     *   in place and flushes it, so save() is left with nothing to write
+     * - Where each record lives is found by one scan of the record keys when the file is
+     *   opened; an edit reads only the record it replaces, to keep the strings that did not change
+     * - Removed records free their slot for the next new record. When no slot is free the
+     *   file is rebuilt with twice the slots, which also drops strings nothing uses any more
+     * - save() and that rebuild write a new file next to the old one and rename it over it
+     * - Assessment IDs may repeat in saved data; the record-level calls address the first
+     *   record with the ID, as BTreeStorage does
+     * - System still works on arena entities, which own their strings, link by pointer and
+     *   carry grade aggregates; the mapped records are what they load from and write to
+     */
+    class MappedStorage : public StorageBackend {
+    private:
+        string path;
+        string backupDirectory;
+        unique_ptr<MappedHeap> heap;   // Opened on first use
+
+        // Record locations, in step with the file
+        unordered_map<int, uint32_t> studentSlots;
+        unordered_map<string, uint32_t> courseSlots;
+        unordered_map<string, vector<uint32_t>> assessmentSlots;       // By assessment ID, first record first
+        unordered_map<int, vector<uint32_t>> assessmentsByStudent;
+        unordered_map<string, vector<uint32_t>> assessmentsByCourse;
+        vector<uint32_t> freeSlots;
+
+        MappedHeap& open();
+        void index();
+        void replace(const string& image);
+        bool change(const string& action, const function<void()>& edit);
+        uint32_t takeSlot();
+
+        void putStudent(const Student& student);
+        void putCourse(const Course& course);
+        void putAssessment(const Assessment& assessment);
+        void eraseAssessment(uint32_t slot);
+        MappedHeap::StringRef courseIdRef(const string& courseId, MappedHeap::StringRef previous);
+
+    public:
+        static constexpr const char* DEFAULT_PATH = "data/entities.heap";
+        static constexpr const char* DEFAULT_BACKUP_DIRECTORY = "data/backups/";
+
+        explicit MappedStorage(string path = DEFAULT_PATH,
+                               string backupDirectory = DEFAULT_BACKUP_DIRECTORY);
+
+        string name() const override { return "memory-mapped records"; }
+        bool initialize() override;
+        bool load(EntityArena<Student>& students,
+                  EntityArena<Course>& courses,
+                  EntityArena<Assessment>& assessments) override;
+        bool save(const EntityArena<Student>& students,
+                  const EntityArena<Course>& courses,
+                  const EntityArena<Assessment>& assessments) override;
+        bool backup() override;
+
+        // === RECORD-LEVEL API (each flushed at once; false with getLastError() on failure) ===
+        bool storesRecords() const override { return true; }
+        bool saveStudent(const Student& student) override;
+        bool saveCourse(const Course& course) override;
+        bool saveAssessment(const Assessment& assessment) override;
+        bool removeStudent(int rollNumber) override;               // With the student's assessments
+        bool removeCourse(const string& courseId) override;        // With the course's assessments
+        bool removeAssessment(const string& assessmentId) override;
+
+        // Slots used so far (free ones included) and slots in the file; 0 before the file is opened
+        uint32_t getSlotCount() const { return heap ? heap->slotCount() : 0; }
+        uint32_t getSlotCapacity() const { return heap ? heap->slotCapacity() : 0; }
+        bool isMapped() const { return heap && heap->isMapped(); }
+        const string& getPath() const { return path; }
+    };
+}
@@ -0,0 +1,38 @@
+#include "MemoryStorage.hpp"
+#include "SnapshotStorage.hpp"
+
+namespace PokenoSouth {
+
+    bool MemoryStorage::load(EntityArena<Student>& students,
+                             EntityArena<Course>& courses,
+                             EntityArena<Assessment>& assessments) {
+        clearError();
+        if (image.empty()) {
+            students.clear();
+            courses.clear();
+            assessments.clear();
+            return false;   // Nothing saved yet
+        }
+        try {
+            SnapshotStorage::decode(image, students, courses, assessments);
+            return true;
+        } catch (const exception& e) {
+            setError(string("Cannot load in-memory data: ") + e.what());
+            return false;
+        }
+    }
+
+    bool MemoryStorage::save(const EntityArena<Student>& students,
+                             const EntityArena<Course>& courses,
+                             const EntityArena<Assessment>& assessments) {
+        clearError();
+        image = SnapshotStorage::encode(students, courses, assessments);
+        return true;
+    }
+
+    bool MemoryStorage::backup() {
+        clearError();
+        if (!image.empty()) backups.push_back(image);
+        return true;
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "StorageBackend.hpp"
+
+namespace PokenoSouth {
+    /**
+     * MemoryStorage for Pokeno South Primary School
+     * A StorageBackend that never touches the disk
+     *
+     * Key Features:
+     * - save() keeps the entities as a snapshot image (SnapshotStorage::encode) in memory;
+     *   load() rebuilds them from it, so a save/load round trip exercises the same
+     *   relinking as the file backends
+     * - Starts empty: the first load() finds nothing stored, like a fresh data directory
+     * - backup() keeps every previous image until the backend is destroyed
+     * - For benchmarks and tests that should measure program logic rather than file I/O
+     */
+    class MemoryStorage : public StorageBackend {
+    private:
+        string image;            // Empty until the first save()
+        vector<string> backups;
+
+    public:
+        string name() const override { return "memory"; }
+        bool initialize() override { return true; }
+        bool load(EntityArena<Student>& students,
+                  EntityArena<Course>& courses,
+                  EntityArena<Assessment>& assessments) override;
+        bool save(const EntityArena<Student>& students,
+                  const EntityArena<Course>& courses,
+                  const EntityArena<Assessment>& assessments) override;
+        bool backup() override;
+
+        size_t getBackupCount() const { return backups.size(); }
+    };
+}
@@ -0,0 +1,78 @@
+#include "PatternMatcher.hpp"
+
+namespace PokenoSouth {
+
+    static unsigned char foldCase(unsigned char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+    }
+
+    // === CONSTRUCTION ===
+    PatternMatcher::PatternMatcher(const vector<string_view>& patterns) {
+        // Alphabet: one column per distinct folded byte; upper- and lower-case letters share a column
+        for (string_view pattern : patterns) {
+            for (char c : pattern) {
+                const unsigned char folded = foldCase(static_cast<unsigned char>(c));
+                if (byteClass[folded] == 0) {
+                    if (alphabetSize == byteClass.size()) {
+                        throw length_error("PatternMatcher alphabet exceeds 255 byte classes");
+                    }
+                    byteClass[folded] = static_cast<uint8_t>(alphabetSize++);
+                }
+            }
+        }
+        for (int c = 'A'; c <= 'Z'; ++c) {
+            byteClass[c] = byteClass[foldCase(static_cast<unsigned char>(c))];
+        }
+
+        // Trie; a zero transition means "absent" until the failure pass fills it in
+        transitions.assign(alphabetSize, START);
+        accepting.assign(1, 0);
+        for (string_view pattern : patterns) {
+            State state = START;
+            for (char c : pattern) {
+                const size_t slot = state * alphabetSize + byteClass[static_cast<unsigned char>(c)];
+                if (transitions[slot] == START) {
+                    transitions[slot] = static_cast<State>(accepting.size());
+                    accepting.push_back(0);
+                    transitions.resize(accepting.size() * alphabetSize, START);
+                }
+                state = transitions[slot];
+            }
+            accepting[state] = 1;
+        }
+
+        // Breadth-first failure links, folded straight into the table so matching never backtracks
+        vector<State> failure(accepting.size(), START);
+        deque<State> pending;
+        for (size_t symbol = 0; symbol < alphabetSize; ++symbol) {
+            const State next = transitions[symbol];
+            if (next != START) pending.push_back(next);
+        }
+        while (!pending.empty()) {
+            const State state = pending.front();
+            pending.pop_front();
+            accepting[state] |= accepting[failure[state]];
+            for (size_t symbol = 0; symbol < alphabetSize; ++symbol) {
+                State& next = transitions[state * alphabetSize + symbol];
+                const State fallback = transitions[failure[state] * alphabetSize + symbol];
+                if (next != START) {
+                    failure[next] = fallback;
+                    pending.push_back(next);
+                } else {
+                    next = fallback;
+                }
+            }
+        }
+    }
+
+    // === MATCHING ===
+    bool PatternMatcher::containsAny(string_view text) const {
+        if (accepting[START]) return true;   // An empty pattern matches everything
+        State state = START;
+        for (char c : text) {
+            state = step(state, c);
+            if (accepting[state]) return true;
+        }
+        return false;
+    }
+}
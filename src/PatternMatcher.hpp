@@ -0,0 +1,43 @@
+#pragma once
+
+#include "common.hpp"
+
+USING_STD_MATCHER
+
+namespace PokenoSouth {
+    /**
+     * PatternMatcher for Pokeno South Primary School
+     * Finds any of a fixed set of substrings in one pass (Aho-Corasick, compiled to a DFA)
+     *
+     * Key Features:
+     * - Built once from the pattern list; matching allocates nothing and reads each input byte once,
+     *   however many patterns there are
+     * - ASCII case-insensitive: letters are folded while building the byte-class table, so the input
+     *   is never lowercased or copied
+     * - Bytes that appear in no pattern share one class, keeping the transition table to
+     *   (states x distinct pattern bytes) entries
+     * - step()/isMatch() expose the automaton for callers that filter or rewrite the input on the fly
+     */
+    class PatternMatcher {
+    public:
+        using State = uint32_t;
+        static constexpr State START = 0;
+
+    private:
+        array<uint8_t, 256> byteClass{};   // Folded byte -> alphabet column; 0 = in no pattern
+        size_t alphabetSize = 1;
+        vector<State> transitions;         // [state * alphabetSize + class] -> next state
+        vector<uint8_t> accepting;         // 1 if some pattern ends at this state (or at a suffix of it)
+
+    public:
+        explicit PatternMatcher(const vector<string_view>& patterns);
+
+        State step(State state, char c) const {
+            return transitions[state * alphabetSize + byteClass[static_cast<unsigned char>(c)]];
+        }
+        bool isMatch(State state) const { return accepting[state] != 0; }
+
+        bool containsAny(string_view text) const;
+        size_t stateCount() const { return accepting.size(); }
+    };
+}
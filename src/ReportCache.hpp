@@ -0,0 +1,56 @@
+#pragma once
+
+#include "common.hpp"
+#include "VersionClock.hpp"
+
+USING_STD_REPORTCACHE
+
+namespace PokenoSouth {
+    /**
+     * ReportCache for Pokeno South Primary School
+     * Materialized report text, tagged with the versions it was built from
+     *
+     * Key Features:
+     * - get() returns the stored text while every dependency version still matches,
+     *   and only calls the builder (then stores the result) when one has moved
+     * - Dependencies are plain Version values: entity getVersion(), VersionClock::latest()
+     *   for whole collections, EntityArena::membershipVersion() for adds and removals
+     * - No explicit invalidation needed on edits; stale entries are simply rebuilt on next use
+     * - Hit/miss counters for the system statistics screen
+     */
+    class ReportCache {
+    private:
+        struct Entry {
+            vector<Version> dependencies;
+            string content;
+        };
+
+        unordered_map<string, Entry> entries;
+        size_t hitCount = 0;
+        size_t missCount = 0;
+
+    public:
+        template <typename Builder>
+        const string& get(const string& key, const vector<Version>& dependencies, Builder&& build) {
+            auto it = entries.find(key);
+            if (it != entries.end() && it->second.dependencies == dependencies) {
+                ++hitCount;
+                return it->second.content;
+            }
+
+            ++missCount;
+            string content = build();   // Build first: a throwing builder leaves the old entry alone
+            Entry& entry = entries[key];
+            entry.dependencies = dependencies;
+            entry.content = std::move(content);
+            return entry.content;
+        }
+
+        void invalidate(const string& key) { entries.erase(key); }
+        void clear() { entries.clear(); }
+
+        size_t size() const { return entries.size(); }
+        size_t hits() const { return hitCount; }
+        size_t misses() const { return missCount; }
+    };
+}
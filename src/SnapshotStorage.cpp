@@ -0,0 +1,275 @@
+#include "SnapshotStorage.hpp"
+#include "Crc32c.hpp"
+#include "ByteCodec.hpp"
+
+namespace PokenoSouth {
+
+    namespace {
+        // "PSSNAP" + format version; bump the version whenever the layout below changes.
+        // Layout (native byte order, which the snapshot is not meant to leave):
+        //   magic | course, student, assessment counts (u32)
+        //   courses:     id, name, credits, description, duration, teacher, start, end, maxEnrollment, active,
+        //                grading policy name
+        //   students:    roll, first, last, dateOfBirth, address, email, emergency, enrolled,
+        //                course count (u32), course index (u32) x count
+        //   assessments: id, roll, courseId, internal, final, date, type, submitted, submission,
+        //                remarks, owning student index (u32, NO_OWNER if unlinked)
+        //   CRC32C (u32) of everything before it
+        // Version 01 is the same without the grading policy; it still loads, with default policies.
+        constexpr string_view MAGIC = "PSSNAP02";
+        constexpr string_view MAGIC_V1 = "PSSNAP01";
+        constexpr uint32_t NO_OWNER = UINT32_MAX;
+    }
+
+    SnapshotStorage::SnapshotStorage(string path, string backupDirectory)
+        : path(std::move(path)), backupDirectory(std::move(backupDirectory)) {}
+
+    // === SNAPSHOT IMAGE ===
+    string SnapshotStorage::encode(const EntityArena<Student>& students,
+                                   const EntityArena<Course>& courses,
+                                   const EntityArena<Assessment>& assessments) {
+        string image;
+        ByteWriter out(image);
+        image.append(MAGIC);
+        out.put<uint32_t>(static_cast<uint32_t>(courses.size()));
+        out.put<uint32_t>(static_cast<uint32_t>(students.size()));
+        out.put<uint32_t>(static_cast<uint32_t>(assessments.size()));
+
+        unordered_map<const Course*, uint32_t> courseIndex;
+        for (const Course* course : courses) {
+            courseIndex.emplace(course, static_cast<uint32_t>(courseIndex.size()));
+            out.putString(course->getCourseId());
+            out.putString(course->getCourseName());
+            out.put<int32_t>(course->getCredits());
+            out.putString(course->getDescription());
+            out.put<int32_t>(course->getDuration());
+            out.putString(course->getTeacher());
+            out.putDate(course->getStartDate());
+            out.putDate(course->getEndDate());
+            out.put<int32_t>(course->getMaxEnrollment());
+            out.put<uint8_t>(course->getIsActive() ? 1 : 0);
+            out.putString(course->getGradingPolicyName());
+        }
+
+        unordered_map<const Student*, uint32_t> studentIndex;
+        vector<uint32_t> enrolled;
+        for (const Student* student : students) {
+            studentIndex.emplace(student, static_cast<uint32_t>(studentIndex.size()));
+            out.put<int32_t>(student->getRollNumber());
+            out.putString(student->getFirstName());
+            out.putString(student->getLastName());
+            out.putDate(student->getDateOfBirth());
+            out.putString(student->getAddress());
+            out.putString(student->getContactEmail());
+            out.putString(student->getEmergencyContact());
+            out.putDate(student->getEnrollmentDate());
+
+            enrolled.clear();
+            for (const Course* course : student->getEnrolledCourses()) {
+                auto it = courseIndex.find(course);
+                if (it != courseIndex.end()) enrolled.push_back(it->second);
+            }
+            out.put<uint32_t>(static_cast<uint32_t>(enrolled.size()));
+            for (uint32_t index : enrolled) out.put<uint32_t>(index);
+        }
+
+        for (const Assessment* assessment : assessments) {
+            out.putString(assessment->getAssessmentId());
+            out.put<int32_t>(assessment->getStudentRollNumber());
+            out.putString(assessment->getCourseId());
+            out.put<double>(assessment->getInternalMarks());
+            out.put<double>(assessment->getFinalMarks());
+            out.putDate(assessment->getAssessmentDate());
+            out.putString(assessment->getAssessmentType());
+            out.put<uint8_t>(assessment->getIsSubmitted() ? 1 : 0);
+            out.putDate(assessment->getSubmissionDate());
+            out.putString(assessment->getRemarks());
+            auto owner = studentIndex.find(assessment->getOwner());
+            out.put<uint32_t>(owner != studentIndex.end() ? owner->second : NO_OWNER);
+        }
+
+        out.put<uint32_t>(Crc32c::compute(image));
+        return image;
+    }
+
+    void SnapshotStorage::decode(string_view image,
+                                 EntityArena<Student>& students,
+                                 EntityArena<Course>& courses,
+                                 EntityArena<Assessment>& assessments) {
+        // Entities link to each other by pointer across arenas, so the old graph goes as a whole
+        students.clear();
+        courses.clear();
+        assessments.clear();
+
+        if (image.size() < MAGIC.size() + sizeof(uint32_t) ||
+            (image.substr(0, MAGIC.size()) != MAGIC && image.substr(0, MAGIC.size()) != MAGIC_V1)) {
+            throw runtime_error("not a snapshot, or a snapshot from another format version");
+        }
+        const bool hasPolicies = image.substr(0, MAGIC.size()) == MAGIC;
+        const string_view body = image.substr(0, image.size() - sizeof(uint32_t));
+        uint32_t checksum;
+        memcpy(&checksum, image.data() + body.size(), sizeof(checksum));
+        if (Crc32c::compute(body) != checksum) {
+            throw runtime_error("snapshot checksum mismatch");
+        }
+
+        try {
+            ByteReader in(body.substr(MAGIC.size()));
+            const uint32_t courseCount = in.get<uint32_t>();
+            const uint32_t studentCount = in.get<uint32_t>();
+            const uint32_t assessmentCount = in.get<uint32_t>();
+
+            vector<Course*> coursesByIndex;
+            coursesByIndex.reserve(courseCount);
+            for (uint32_t i = 0; i < courseCount; ++i) {
+                string courseId = in.getString();
+                string courseName = in.getString();
+                const int credits = in.get<int32_t>();
+                string description = in.getString();
+                const int duration = in.get<int32_t>();
+                string teacher = in.getString();
+                const Date startDate = in.getDate();
+                const Date endDate = in.getDate();
+                const int maxEnrollment = in.get<int32_t>();
+                const bool isActive = in.get<uint8_t>() != 0;
+                const string policyName = hasPolicies ? in.getString() : GradingPolicyRegistry::DEFAULT_POLICY;
+                Course* course = courses.emplace(TRUSTED_INPUT, courseId, courseName, credits, description,
+                                                 duration, teacher, startDate, endDate, maxEnrollment, isActive);
+                course->setGradingPolicy(policyName);   // Before any assessment below is graded
+                coursesByIndex.push_back(course);
+            }
+
+            vector<Student*> studentsByIndex;
+            studentsByIndex.reserve(studentCount);
+            for (uint32_t i = 0; i < studentCount; ++i) {
+                const int rollNumber = in.get<int32_t>();
+                string firstName = in.getString();
+                string lastName = in.getString();
+                const Date dateOfBirth = in.getDate();
+                string address = in.getString();
+                string contactEmail = in.getString();
+                string emergencyContact = in.getString();
+                const Date enrollmentDate = in.getDate();
+                Student* student = students.emplace(TRUSTED_INPUT, rollNumber, firstName, lastName, dateOfBirth,
+                                                    address, contactEmail, emergencyContact, enrollmentDate);
+                studentsByIndex.push_back(student);
+
+                // Same restore rule as the CSV loader: saved enrollments are linked as-is
+                const uint32_t enrolledCount = in.get<uint32_t>();
+                for (uint32_t j = 0; j < enrolledCount; ++j) {
+                    const uint32_t index = in.get<uint32_t>();
+                    if (index >= coursesByIndex.size()) throw runtime_error("snapshot has a bad course index");
+                    if (student->attachCourse(coursesByIndex[index])) {
+                        coursesByIndex[index]->attachStudent(student);
+                    }
+                }
+            }
+
+            for (uint32_t i = 0; i < assessmentCount; ++i) {
+                string assessmentId = in.getString();
+                const int rollNumber = in.get<int32_t>();
+                string courseId = in.getString();
+                const double internalMarks = in.get<double>();
+                const double finalMarks = in.get<double>();
+                const Date assessmentDate = in.getDate();
+                string assessmentType = in.getString();
+                const bool isSubmitted = in.get<uint8_t>() != 0;
+                const Date submissionDate = in.getDate();
+                string remarks = in.getString();
+                const uint32_t owner = in.get<uint32_t>();
+                Assessment* assessment = assessments.emplace(TRUSTED_INPUT, assessmentId, rollNumber, courseId,
+                                                             internalMarks, finalMarks, assessmentDate,
+                                                             assessmentType, isSubmitted, submissionDate, remarks);
+                if (owner != NO_OWNER) {
+                    if (owner >= studentsByIndex.size()) throw runtime_error("snapshot has a bad student index");
+                    studentsByIndex[owner]->addAssessment(assessment);
+                }
+            }
+
+            if (!in.atEnd()) throw runtime_error("snapshot has trailing data");
+        } catch (...) {
+            students.clear();
+            courses.clear();
+            assessments.clear();
+            throw;
+        }
+    }
+
+    // === STORAGE OPERATIONS ===
+    bool SnapshotStorage::initialize() {
+        clearError();
+        try {
+            const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+            if (!parent.empty()) std::filesystem::create_directories(parent);
+            return true;
+        } catch (const exception& e) {
+            setError("Cannot create snapshot directory for " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    bool SnapshotStorage::load(EntityArena<Student>& students,
+                               EntityArena<Course>& courses,
+                               EntityArena<Assessment>& assessments) {
+        clearError();
+        if (!std::filesystem::exists(path)) {
+            students.clear();
+            courses.clear();
+            assessments.clear();
+            return false;   // Nothing saved yet
+        }
+        try {
+            ifstream file(path, ios::binary);
+            ostringstream image;
+            image << file.rdbuf();
+            decode(image.str(), students, courses, assessments);
+            return true;
+        } catch (const exception& e) {
+            setError("Cannot load snapshot " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    bool SnapshotStorage::save(const EntityArena<Student>& students,
+                               const EntityArena<Course>& courses,
+                               const EntityArena<Assessment>& assessments) {
+        clearError();
+        try {
+            const string image = encode(students, courses, assessments);
+            const string tempPath = path + ".tmp";
+            {
+                ofstream file(tempPath, ios::binary | ios::trunc);
+                file.write(image.data(), static_cast<std::streamsize>(image.size()));
+                file.close();
+                if (!file) {
+                    std::filesystem::remove(tempPath);
+                    setError("Cannot write snapshot: " + tempPath);
+                    return false;
+                }
+            }
+            std::filesystem::rename(tempPath, path);
+            return true;
+        } catch (const exception& e) {
+            setError("Cannot save snapshot " + path + ": " + e.what());
+            return false;
+        }
+    }
+
+    bool SnapshotStorage::backup() {
+        clearError();
+        if (!std::filesystem::exists(path)) return true;   // Nothing to keep yet
+        try {
+            auto now = time(nullptr);
+            ostringstream timestamp;
+            timestamp << put_time(localtime(&now), "%Y%m%d_%H%M%S");
+            std::filesystem::create_directories(backupDirectory);
+            const string stem = std::filesystem::path(path).stem().string();
+            std::filesystem::copy_file(path, backupDirectory + stem + "_" + timestamp.str() + ".bin",
+                                       std::filesystem::copy_options::overwrite_existing);
+            return true;
+        } catch (const exception& e) {
+            setError("Cannot back up snapshot " + path + ": " + e.what());
+            return false;
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "StorageBackend.hpp"
+
+namespace PokenoSouth {
+    /**
+     * SnapshotStorage for Pokeno South Primary School
+     * All entities and relationships in one binary file
+     *
+     * Key Features:
+     * - Fixed-width numbers and day-number dates, length-prefixed strings, no text parsing
+     * - Relationships are stored as positions in the file (student -> course indices,
+     *   assessment -> owning student), so loading links them without any lookups
+     * - A CRC32C footer covers the whole image; a snapshot that verifies was written by
+     *   save() from live entities, so it loads through the unchecked TrustedInput constructors.
+     *   One that does not verify is rejected
+     * - save() writes a temporary file and renames it over the old snapshot
+     * - encode()/decode() work on an in-memory image and are shared with MemoryStorage
+     */
+    class SnapshotStorage : public StorageBackend {
+    private:
+        string path;
+        string backupDirectory;
+
+    public:
+        static constexpr const char* DEFAULT_PATH = "data/snapshot.bin";
+        static constexpr const char* DEFAULT_BACKUP_DIRECTORY = "data/backups/";
+
+        explicit SnapshotStorage(string path = DEFAULT_PATH,
+                                 string backupDirectory = DEFAULT_BACKUP_DIRECTORY);
+
+        string name() const override { return "binary snapshot"; }
+        bool initialize() override;
+        bool load(EntityArena<Student>& students,
+                  EntityArena<Course>& courses,
+                  EntityArena<Assessment>& assessments) override;
+        bool save(const EntityArena<Student>& students,
+                  const EntityArena<Course>& courses,
+                  const EntityArena<Assessment>& assessments) override;
+        bool backup() override;
+
+        const string& getPath() const { return path; }
+
+        // === SNAPSHOT IMAGE ===
+        static string encode(const EntityArena<Student>& students,
+                             const EntityArena<Course>& courses,
+                             const EntityArena<Assessment>& assessments);
+        // Replaces the arena contents; throws runtime_error, leaving them empty, if the image is damaged
+        static void decode(string_view image,
+                           EntityArena<Student>& students,
+                           EntityArena<Course>& courses,
+                           EntityArena<Assessment>& assessments);
+    };
+}
@@ -0,0 +1,18 @@
+#include "StorageBackend.hpp"
+#include "CsvStorage.hpp"
+#include "SnapshotStorage.hpp"
+#include "MemoryStorage.hpp"
+#include "BTreeStorage.hpp"
+#include "MappedStorage.hpp"
+
+namespace PokenoSouth {
+
+    unique_ptr<StorageBackend> StorageBackend::create(const string& kind) {
+        if (kind == "csv") return make_unique<CsvStorage>();
+        if (kind == "snapshot") return make_unique<SnapshotStorage>();
+        if (kind == "memory") return make_unique<MemoryStorage>();
+        if (kind == "btree") return make_unique<BTreeStorage>();
+        if (kind == "mapped") return make_unique<MappedStorage>();
+        throw invalid_argument("Unknown storage backend '" + kind + "' (expected csv, snapshot, memory, btree or mapped)");
+    }
+}
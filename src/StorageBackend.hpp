@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Student.hpp"
+#include "Course.hpp"
+#include "Assessment.hpp"
+#include "EntityArena.hpp"
+#include "Usings.hpp"
+
+USING_STD_STORAGE
+
+namespace PokenoSouth {
+    /**
+     * StorageBackend for Pokeno South Primary School
+     * Where System loads its entities from and saves them to
+     *
+     * Key Features:
+     * - load() rebuilds all three arenas with every enrollment and assessment linked;
+     *   save() persists the full set. System rebuilds its own indexes afterwards
+     * - Backends: "csv" (the CSV files under data/, via FileHandler), "snapshot" (one checksummed
+     *   binary file), "btree" (per-record B+tree file; point updates write a few pages),
+     *   "mapped" (fixed-width records in a memory-mapped file, edited in place) and "memory"
+     *   (no disk at all, for benchmarks and tests)
+     * - create() picks one by name, so a site can choose its backend without a rebuild
+     * - Backends that keep one record per entity (storesRecords()) also persist single edits
+     *   through saveStudent()/removeCourse()/...; System then calls those after each change
+     *   instead of leaving everything to the next save()
+     * - Failures return false with getLastError() set; load() returning false with no error
+     *   just means nothing has been stored yet, and System then imports the CSV files in data/ if present
+     */
+    class StorageBackend {
+    private:
+        string lastError;
+
+    protected:
+        void setError(const string& error) { lastError = error; }
+        void clearError() { lastError.clear(); }
+
+    public:
+        virtual ~StorageBackend() = default;
+
+        // Human-readable description, e.g. "CSV files"
+        virtual string name() const = 0;
+
+        // Prepare the storage location (directories, empty files); false if it is unusable
+        virtual bool initialize() = 0;
+
+        // Replace the arena contents with what is stored
+        virtual bool load(EntityArena<Student>& students,
+                          EntityArena<Course>& courses,
+                          EntityArena<Assessment>& assessments) = 0;
+
+        virtual bool save(const EntityArena<Student>& students,
+                          const EntityArena<Course>& courses,
+                          const EntityArena<Assessment>& assessments) = 0;
+
+        // Keep a copy of what is stored now
+        virtual bool backup() = 0;
+
+        // === RECORD-LEVEL CHANGES (only called when storesRecords() is true) ===
+        // Each persists one change at once; removals take the dependent assessments with them
+        virtual bool storesRecords() const { return false; }
+        virtual bool saveStudent(const Student&) { return false; }
+        virtual bool saveCourse(const Course&) { return false; }
+        virtual bool saveAssessment(const Assessment&) { return false; }
+        virtual bool removeStudent(int) { return false; }
+        virtual bool removeCourse(const string&) { return false; }
+        virtual bool removeAssessment(const string&) { return false; }
+
+        const string& getLastError() const { return lastError; }
+
+        // "csv", "snapshot", "memory", "btree" or "mapped"; throws invalid_argument for anything else
+        static unique_ptr<StorageBackend> create(const string& kind);
+    };
+}
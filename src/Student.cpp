@@ -33,13 +33,12 @@ namespace PokenoSouth {
         this->lastName = lastName;
         
         // Validate and set date of birth
-        if (!Common::isValidDateFormat(dateOfBirth)) {
-            throw invalid_argument("Invalid date of birth format: must be YYYY-MM-DD");
+        if (!Date::tryParse(dateOfBirth, this->dateOfBirth)) {
+            throw invalid_argument("Invalid date of birth format: must be a real date in YYYY-MM-DD format");
         }
-        if (!Common::isValidDate(dateOfBirth)) {
+        if (this->dateOfBirth >= Date::today()) {
             throw invalid_argument("Invalid date of birth: must be a valid past date");
         }
-        this->dateOfBirth = dateOfBirth;
         
         // Validate and set address (basic length check; detailed checks are in System prompts)
         if (!Common::isValidLength(address, 1, 100)) {
@@ -60,13 +59,12 @@ namespace PokenoSouth {
         this->emergencyContact = emergencyContact;
         
         // Validate and set enrollment date
-        if (!Common::isValidDateFormat(enrollmentDate)) {
-            throw invalid_argument("Invalid enrollment date format: must be YYYY-MM-DD");
+        if (!Date::tryParse(enrollmentDate, this->enrollmentDate)) {
+            throw invalid_argument("Invalid enrollment date format: must be a real date in YYYY-MM-DD format");
         }
-        if (!Common::isDateNotFuture(enrollmentDate)) {
+        if (this->enrollmentDate > Date::today()) {
             throw invalid_argument("Invalid enrollment date: cannot be in the future");
         }
-        this->enrollmentDate = enrollmentDate;
         
         // Initialize empty collections with optimized capacity
         enrolledCourses.clear();
@@ -76,6 +74,27 @@ namespace PokenoSouth {
         assessments.reserve(20);  // Reserve space for estimated assessments
     }
     
+    Student::Student(TrustedInput,
+                     int rollNumber,
+                     const string& firstName,
+                     const string& lastName,
+                     Date dateOfBirth,
+                     const string& address,
+                     const string& contactEmail,
+                     const string& emergencyContact,
+                     Date enrollmentDate)
+        : rollNumber(rollNumber),
+          firstName(firstName),
+          lastName(lastName),
+          dateOfBirth(dateOfBirth),
+          address(address),
+          contactEmail(contactEmail),
+          emergencyContact(emergencyContact),
+          enrollmentDate(enrollmentDate) {
+        enrolledCourses.reserve(MAX_ENROLLMENTS);
+        assessments.reserve(20);
+    }
+    
     // Copy constructor
     Student::Student(const Student& other)
         : rollNumber(other.rollNumber),
@@ -87,7 +106,10 @@ namespace PokenoSouth {
           emergencyContact(other.emergencyContact),
           enrollmentDate(other.enrollmentDate),
           enrolledCourses(other.enrolledCourses),
-          assessments(other.assessments) {
+          enrolledCourseKeys(other.enrolledCourseKeys),
+          assessments(other.assessments),
+          overallGrades(other.overallGrades),
+          courseGrades(other.courseGrades) {
     }
     
     // Assignment operator
@@ -102,7 +124,11 @@ namespace PokenoSouth {
             emergencyContact = other.emergencyContact;
             enrollmentDate = other.enrollmentDate;
             enrolledCourses = other.enrolledCourses;
+            enrolledCourseKeys = other.enrolledCourseKeys;
             assessments = other.assessments;
+            overallGrades = other.overallGrades;
+            courseGrades = other.courseGrades;
+            markModified();
         }
         return *this;
     }
@@ -113,9 +139,7 @@ namespace PokenoSouth {
     }
     
     int Student::getAge() const {
-        // Simple age calculation - for now return a placeholder
-        // In a real implementation, would parse date and calculate difference
-        return 8; // Primary school age placeholder
+        return dateOfBirth.yearsUntil(Date::today());
     }
     
     // === SETTER METHODS ===
@@ -124,6 +148,7 @@ namespace PokenoSouth {
             throw invalid_argument("Invalid first name: must contain only alphabetic characters and not be empty");
         }
         this->firstName = firstName;
+        markModified();
     }
     
     void Student::setLastName(const string& lastName) {
@@ -131,6 +156,7 @@ namespace PokenoSouth {
             throw invalid_argument("Invalid last name: must contain only alphabetic characters and not be empty");
         }
         this->lastName = lastName;
+        markModified();
     }
     
     void Student::setContactEmail(const string& email) {
@@ -138,6 +164,7 @@ namespace PokenoSouth {
             throw invalid_argument("Invalid contact email format");
         }
         this->contactEmail = email;
+        markModified();
     }
     
     void Student::setEmergencyContact(const string& phoneNumber) {
@@ -145,16 +172,17 @@ namespace PokenoSouth {
             throw invalid_argument("Invalid emergency contact phone number format");
         }
         this->emergencyContact = phoneNumber;
+        markModified();
     }
     
     // === COURSE ENROLLMENT MANAGEMENT ===
-    void Student::enrollInCourse(shared_ptr<Course> course) {
+    void Student::enrollInCourse(Course* course) {
         if (!course) {
             throw invalid_argument("Cannot enroll in null course");
         }
         
         // Check if already enrolled
-        if (isEnrolledInCourse(course->getCourseId())) {
+        if (isEnrolledInCourse(course->getCourseKey())) {
             throw runtime_error("Student is already enrolled in course: " + course->getCourseId());
         }
         
@@ -170,12 +198,15 @@ namespace PokenoSouth {
         }
         
         enrolledCourses.push_back(course);
+        enrolledCourseKeys.insert(course->getCourseKey());
+        markModified();
     }
 
     void Student::withdrawFromCourse(const string& courseId) {
+        const SymbolKey courseKey = SymbolTable::courseIds().find(courseId);
         auto it = find_if(enrolledCourses.begin(), enrolledCourses.end(),
-            [&courseId](const shared_ptr<Course>& course) {
-                return course && course->getCourseId() == courseId;
+            [courseKey](const Course* course) {
+                return course && course->getCourseKey() == courseKey;
             });
             
         if (it == enrolledCourses.end()) {
@@ -184,6 +215,8 @@ namespace PokenoSouth {
         
         // Memory management: Remove and shrink if needed
         enrolledCourses.erase(it);
+        enrolledCourseKeys.erase(courseKey);
+        markModified();
         
         // Optional: Shrink vector if significantly smaller than capacity
         if (enrolledCourses.size() < enrolledCourses.capacity() / 2 && enrolledCourses.capacity() > MAX_ENROLLMENTS) {
@@ -192,14 +225,11 @@ namespace PokenoSouth {
     }
 
     bool Student::isEnrolledInCourse(const string& courseId) const {
-        return any_of(enrolledCourses.begin(), enrolledCourses.end(),
-            [&courseId](const shared_ptr<Course>& course) {
-                return course && course->getCourseId() == courseId;
-            });
+        return isEnrolledInCourse(SymbolTable::courseIds().find(courseId));
     }
 
-    vector<shared_ptr<Course>> Student::getEnrolledCourses() const {
-        return enrolledCourses;
+    bool Student::isEnrolledInCourse(SymbolKey courseKey) const {
+        return enrolledCourseKeys.contains(courseKey);
     }
     
     int Student::getEnrollmentCount() const {
@@ -207,7 +237,7 @@ namespace PokenoSouth {
     }
     
     // === ASSESSMENT MANAGEMENT ===
-    void Student::addAssessment(shared_ptr<Assessment> assessment) {
+    void Student::addAssessment(Assessment* assessment) {
         if (!assessment) {
             throw invalid_argument("Cannot add null assessment");
         }
@@ -219,7 +249,7 @@ namespace PokenoSouth {
         
         // Check if assessment already exists
         auto it = find_if(assessments.begin(), assessments.end(),
-            [&assessment](const shared_ptr<Assessment>& existing) {
+            [assessment](const Assessment* existing) {
                 return existing && existing->getAssessmentId() == assessment->getAssessmentId();
             });
             
@@ -234,11 +264,14 @@ namespace PokenoSouth {
         }
         
         assessments.push_back(assessment);
+        assessment->setOwner(this);
+        recordAssessmentGrade(assessment);
+        markModified();
     }
 
     void Student::removeAssessment(const string& assessmentId) {
         auto it = find_if(assessments.begin(), assessments.end(),
-            [&assessmentId](const shared_ptr<Assessment>& assessment) {
+            [&assessmentId](const Assessment* assessment) {
                 return assessment && assessment->getAssessmentId() == assessmentId;
             });
             
@@ -246,59 +279,186 @@ namespace PokenoSouth {
             throw runtime_error("Assessment not found: " + assessmentId);
         }
         
+        Assessment* removed = *it;
         assessments.erase(it);
+        eraseAssessmentGrade(removed);
+        markModified();
     }
 
-    vector<shared_ptr<Assessment>> Student::getAssessments() const {
-        return assessments;
+    bool Student::attachCourse(Course* course) {
+        if (!course || !enrolledCourseKeys.insert(course->getCourseKey())) {
+            return false;
+        }
+        enrolledCourses.push_back(course);
+        markModified();
+        return true;
     }
 
-    vector<shared_ptr<Assessment>> Student::getAssessmentsForCourse(const string& courseId) const {
-        vector<shared_ptr<Assessment>> courseAssessments;
-        
-        for (const auto& assessment : assessments) {
-            if (assessment && assessment->getCourseId() == courseId) {
-                courseAssessments.push_back(assessment);
-            }
+    void Student::detachAssessment(const Assessment* assessment) {
+        auto it = find(assessments.begin(), assessments.end(), assessment);
+        if (it != assessments.end()) {
+            Assessment* removed = *it;
+            assessments.erase(it);
+            eraseAssessmentGrade(removed);
+            markModified();
         }
-        
-        return courseAssessments;
     }
-    
+
+    void Student::detachCourse(const Course* course) {
+        auto it = find(enrolledCourses.begin(), enrolledCourses.end(), course);
+        if (it != enrolledCourses.end()) {
+            enrolledCourses.erase(it);
+            enrolledCourseKeys.erase(course->getCourseKey());
+            markModified();
+        }
+    }
+
     // === GRADE CALCULATION AND REPORTING ===
     double Student::getOverallGrade() const {
-        if (assessments.empty()) {
+        return overallGrades.mean();
+    }
+    
+    double Student::getCourseGrade(const string& courseId) const {
+        return getCourseGrade(SymbolTable::courseIds().find(courseId));
+    }
+    
+    double Student::getCourseGrade(SymbolKey courseKey) const {
+        const GradeAggregate* grades = findCourseGrades(courseKey);
+        if (!grades) {
             return 0.0;
         }
-        
-        double totalGrade = 0.0;
-        int validAssessments = 0;
-        
-        for (const auto& assessment : assessments) {
-            if (assessment) {
-                totalGrade += assessment->getCalculatedGrade();
-                validAssessments++;
-            }
+        const CourseGradingPolicy& policy = GradingPolicyRegistry::shared().forCourse(courseKey);
+        if (policy.averagesAllScores()) {
+            return grades->mean();   // The running total already is the policy's answer
         }
-        
-        return validAssessments > 0 ? totalGrade / validAssessments : 0.0;
+        return gradeUnderPolicy(policy, courseKey, nullptr, nullptr);
+    }
+
+    GradeAggregate Student::getOverallGradeSummary() const {
+        overallGrades.refreshExtremes([this](auto&& visit) {
+            forEachAssessment([&](const Assessment* assessment) { visit(assessment->getCalculatedGrade()); });
+        });
+        return overallGrades;
+    }
+
+    GradeAggregate Student::getCourseGradeSummary(SymbolKey courseKey) const {
+        GradeAggregate* grades = findCourseGrades(courseKey);
+        if (!grades) {
+            return GradeAggregate();
+        }
+        grades->refreshExtremes([&](auto&& visit) {
+            forEachAssessmentInCourse(courseKey, [&](const Assessment* assessment) {
+                visit(assessment->getCalculatedGrade());
+            });
+        });
+        return *grades;
+    }
+
+    // === VERSIONING ===
+    void Student::markModified() {
+        version = VersionClock::stamp(VersionDomain::Students);
+        for (Course* course : enrolledCourses) {
+            if (course) course->markModified();
+        }
+    }
+
+    // === INCREMENTAL GRADE TOTALS ===
+    GradeAggregate* Student::findCourseGrades(SymbolKey courseKey) const {
+        // A student has assessments in a handful of courses; a flat scan beats hashing here
+        for (auto& entry : courseGrades) {
+            if (entry.first == courseKey) return &entry.second;
+        }
+        return nullptr;
+    }
+
+    double Student::gradeUnderPolicy(const CourseGradingPolicy& policy, SymbolKey courseKey,
+                                     const Assessment* skip, const double* extraGrade) const {
+        // Selection or a cap needs the individual grades; a student has only a few per course
+        vector<double> scores;
+        forEachAssessmentInCourse(courseKey, [&](const Assessment* assessment) {
+            if (assessment != skip) scores.push_back(assessment->getCalculatedGrade());
+        });
+        if (extraGrade) {
+            scores.push_back(*extraGrade);
+        }
+        return policy.calculateGrade(ScoreSpan{scores.data(), nullptr, scores.size()});
     }
     
-    double Student::getCourseGrade(const string& courseId) const {
-        auto courseAssessments = getAssessmentsForCourse(courseId);
-        
-        if (courseAssessments.empty()) {
+    double Student::previousCourseGrade(SymbolKey courseKey, const Assessment* changed,
+                                        const double* previousGrade) const {
+        // Callers ask before touching the running totals, so the mean is still the old one; the
+        // assessment list and cached grades may already show the change, so other policies rebuild it
+        const CourseGradingPolicy& policy = GradingPolicyRegistry::shared().forCourse(courseKey);
+        if (policy.averagesAllScores()) {
+            return getCourseGrade(courseKey);
+        }
+        if (!findCourseGrades(courseKey)) {
             return 0.0;
         }
+        return gradeUnderPolicy(policy, courseKey, changed, previousGrade);
+    }
+    
+    void Student::recordAssessmentGrade(const Assessment* assessment) {
+        const SymbolKey courseKey = assessment->getCourseKey();
+        const double oldCourseGrade = previousCourseGrade(courseKey, assessment, nullptr);
+        const double grade = assessment->getCalculatedGrade();
+        
+        overallGrades.add(grade);
+        GradeAggregate* grades = findCourseGrades(courseKey);
+        if (!grades) {
+            courseGrades.emplace_back(courseKey, GradeAggregate());
+            grades = &courseGrades.back().second;
+        }
+        grades->add(grade);
+        notifyCourseGradeChanged(courseKey, oldCourseGrade);
+    }
+
+    void Student::eraseAssessmentGrade(Assessment* assessment) {
+        const SymbolKey courseKey = assessment->getCourseKey();
+        const double grade = assessment->getCalculatedGrade();
+        const double oldCourseGrade = previousCourseGrade(courseKey, assessment, &grade);
         
-        double totalGrade = 0.0;
-        for (const auto& assessment : courseAssessments) {
-            if (assessment) {
-                totalGrade += assessment->getCalculatedGrade();
+        if (assessment->getOwner() == this) {
+            assessment->setOwner(nullptr);
+        }
+        overallGrades.remove(grade);
+        if (GradeAggregate* grades = findCourseGrades(courseKey)) {
+            grades->remove(grade);
+            if (grades->count == 0) {
+                courseGrades.erase(remove_if(courseGrades.begin(), courseGrades.end(),
+                    [courseKey](const pair<SymbolKey, GradeAggregate>& entry) {
+                        return entry.first == courseKey;
+                    }), courseGrades.end());
             }
         }
+        notifyCourseGradeChanged(courseKey, oldCourseGrade);
+    }
+
+    void Student::onAssessmentGradeChanged(const Assessment* assessment, double oldGrade, double newGrade) {
+        const SymbolKey courseKey = assessment->getCourseKey();
+        const double oldCourseGrade = previousCourseGrade(courseKey, assessment, &oldGrade);
         
-        return totalGrade / courseAssessments.size();
+        overallGrades.replace(oldGrade, newGrade);
+        if (GradeAggregate* grades = findCourseGrades(courseKey)) {
+            grades->replace(oldGrade, newGrade);
+        }
+        notifyCourseGradeChanged(courseKey, oldCourseGrade);
+    }
+
+    void Student::notifyCourseGradeChanged(SymbolKey courseKey, double oldCourseGrade) const {
+        const double newCourseGrade = getCourseGrade(courseKey);
+        if (newCourseGrade == oldCourseGrade || !enrolledCourseKeys.contains(courseKey)) {
+            return;
+        }
+        for (Course* course : enrolledCourses) {
+            if (course && course->getCourseKey() == courseKey) {
+                // Only a two-sided enrollment is counted in the course totals
+                if (course->isStudentEnrolled(rollNumber)) {
+                    course->onStudentGradeChanged(oldCourseGrade, newCourseGrade);
+                }
+                break;
+            }
+        }
     }
 
     string Student::getGradeStatus() const {
@@ -337,10 +497,15 @@ namespace PokenoSouth {
     }
     
     void Student::displayGradeSummary() const {
+        const GradeAggregate summary = getOverallGradeSummary();
         cout << "\n=== Grade Summary ===" << endl;
         cout << "Student: " << getFullName() << " (Roll: " << rollNumber << ")" << endl;
-        cout << "Total Assessments: " << assessments.size() << endl;
-        cout << "Overall Grade: " << fixed << setprecision(1) << getOverallGrade() << "%" << endl;
+        cout << "Total Assessments: " << summary.count << endl;
+        cout << "Overall Grade: " << fixed << setprecision(1) << summary.mean() << "%" << endl;
+        if (summary.count > 0) {
+            cout << "Highest: " << summary.maxGrade << "%   Lowest: " << summary.minGrade << "%" << endl;
+            cout << "Passed: " << summary.passCount << "   Failed: " << summary.failCount << endl;
+        }
         cout << "Status: " << getGradeStatus() << endl;
 
         if (!assessments.empty()) {
@@ -1,6 +1,15 @@
 #pragma once
 
 #include "common.hpp"
+#include "SymbolTable.hpp"
+#include "EntityArena.hpp"
+#include "View.hpp"
+#include "EnrollmentBitmap.hpp"
+#include "GradeAggregate.hpp"
+#include "GradingPolicy.hpp"
+#include "VersionClock.hpp"
+#include "Date.hpp"
+#include "TrustedInput.hpp"
 #include "Course.hpp"
 #include "Assessment.hpp"
 
@@ -18,7 +27,7 @@ namespace PokenoSouth {
      * Key Features:
      * - Immutable roll number (ID pattern)
      * - Comprehensive validation for all fields
-     * - Bidirectional relationships with courses
+     * - Bidirectional relationships with courses (non-owning; entities live in EntityArenas)
      * - Assessment tracking and grade management
      * - CRUD operations with proper encapsulation
      */
@@ -28,15 +37,34 @@ namespace PokenoSouth {
         const int rollNumber;           // Unique identifier, immutable
         string firstName;          // Alphabetic only, required
         string lastName;           // Alphabetic only, required
-        string dateOfBirth;        // YYYY-MM-DD format, past date only
+        Date dateOfBirth;          // Past date only
         string address;            // Non-empty, max length 100
         string contactEmail;       // Valid email format required
         string emergencyContact;   // Valid email format required
-        string enrollmentDate;     // YYYY-MM-DD format, not future
+        Date enrollmentDate;       // Not future
         
-        // Relationship management (composition pattern)
-        vector<shared_ptr<Course>> enrolledCourses;
-        vector<shared_ptr<Assessment>> assessments;
+        // Relationship management: non-owning links into the System arenas
+        vector<Course*> enrolledCourses;
+        EnrollmentBitmap enrolledCourseKeys;    // Same courses as enrolledCourses, by course key
+        vector<Assessment*> assessments;
+        
+        // Running grade totals over 'assessments', updated as they are linked, edited and unlinked
+        mutable GradeAggregate overallGrades;   // Min/max refreshed on demand, like courseGrades
+        mutable vector<pair<SymbolKey, GradeAggregate>> courseGrades;   // One entry per course with assessments
+        
+        EntityHandle handle = INVALID_HANDLE;   // Slot in the owning EntityArena
+        Version version = VersionClock::stamp(VersionDomain::Students);   // See markModified()
+        
+        GradeAggregate* findCourseGrades(SymbolKey courseKey) const;
+        void recordAssessmentGrade(const Assessment* assessment);
+        void eraseAssessmentGrade(Assessment* assessment);
+        void notifyCourseGradeChanged(SymbolKey courseKey, double oldCourseGrade) const;
+        // Course grade from the individual grades, leaving out 'skip' and adding 'extraGrade' if given
+        double gradeUnderPolicy(const CourseGradingPolicy& policy, SymbolKey courseKey,
+                                const Assessment* skip, const double* extraGrade) const;
+        // The course grade before a pending change to 'changed', whose grade was *previousGrade
+        // (null: it was not counted yet)
+        double previousCourseGrade(SymbolKey courseKey, const Assessment* changed, const double* previousGrade) const;
         
     public:
         // Constructor with comprehensive validation
@@ -49,10 +77,21 @@ namespace PokenoSouth {
                 const string& emergencyContact,
                 const string& enrollmentDate);
         
+        // Unchecked constructor for verified saved data (see TrustedInput)
+        Student(TrustedInput,
+                int rollNumber,
+                const string& firstName,
+                const string& lastName,
+                Date dateOfBirth,
+                const string& address,
+                const string& contactEmail,
+                const string& emergencyContact,
+                Date enrollmentDate);
+        
         // Destructor
         ~Student() = default;
         
-        // Copy constructor and assignment (careful with shared_ptr)
+        // Copy constructor and assignment (copies share the non-owning relationship links)
         Student(const Student& other);
         Student& operator=(const Student& other);
         
@@ -64,15 +103,19 @@ namespace PokenoSouth {
         int getRollNumber() const { return rollNumber; }
         const string& getFirstName() const { return firstName; }
         const string& getLastName() const { return lastName; }
-        const string& getDateOfBirth() const { return dateOfBirth; }
+        Date getDateOfBirth() const { return dateOfBirth; }
         const string& getAddress() const { return address; }
         const string& getContactEmail() const { return contactEmail; }
         const string& getEmergencyContact() const { return emergencyContact; }
-        const string& getEnrollmentDate() const { return enrollmentDate; }
+        Date getEnrollmentDate() const { return enrollmentDate; }
+        EntityHandle getHandle() const { return handle; }
+        void setHandle(EntityHandle h) { handle = h; }
+        Version getVersion() const { return version; }
+        void markModified();   // New stamp; also stamps enrolled courses, whose reports list this student
         
         // Derived getters
         string getFullName() const;
-        int getAge() const;  // Calculate from dateOfBirth
+        int getAge() const;  // Whole years from dateOfBirth to today
         
         // === SETTER METHODS (validation enforced) ===
         void setFirstName(const string& firstName);
@@ -82,22 +125,58 @@ namespace PokenoSouth {
         // Note: rollNumber, dateOfBirth, enrollmentDate are immutable
         
         // === COURSE ENROLLMENT MANAGEMENT ===
-        void enrollInCourse(shared_ptr<Course> course);
+        void enrollInCourse(Course* course);
         void withdrawFromCourse(const string& courseId);
         bool isEnrolledInCourse(const string& courseId) const;
-        vector<shared_ptr<Course>> getEnrolledCourses() const;
+        bool isEnrolledInCourse(SymbolKey courseKey) const;
+        View<Course> getEnrolledCourses() const { return enrolledCourses; }
+        const EnrollmentBitmap& getEnrolledCourseKeys() const { return enrolledCourseKeys; }
         int getEnrollmentCount() const;
         
         // === ASSESSMENT MANAGEMENT ===
-        void addAssessment(shared_ptr<Assessment> assessment);
+        void addAssessment(Assessment* assessment);
         void removeAssessment(const string& assessmentId);
-        vector<shared_ptr<Assessment>> getAssessments() const;
-        vector<shared_ptr<Assessment>> getAssessmentsForCourse(const string& courseId) const;
+        View<Assessment> getAssessments() const { return assessments; }
+        
+        // === RESTORING LINKS (persisted state; enrollment rules were checked when it was saved) ===
+        bool attachCourse(Course* course);                     // False if already linked
+        
+        // === UNLINKING (before the related entity leaves its arena) ===
+        void detachAssessment(const Assessment* assessment);   // No-op if not linked
+        void detachCourse(const Course* course);               // No-op if not linked
+        
+        // === VISITORS (no intermediate vectors) ===
+        template <typename Visitor>
+        void forEachCourse(Visitor&& visitor) const {
+            for (Course* course : enrolledCourses) {
+                if (course) visitor(course);
+            }
+        }
+        
+        template <typename Visitor>
+        void forEachAssessment(Visitor&& visitor) const {
+            for (Assessment* assessment : assessments) {
+                if (assessment) visitor(assessment);
+            }
+        }
+        
+        template <typename Visitor>
+        void forEachAssessmentInCourse(SymbolKey courseKey, Visitor&& visitor) const {
+            for (Assessment* assessment : assessments) {
+                if (assessment && assessment->getCourseKey() == courseKey) visitor(assessment);
+            }
+        }
         
         // === GRADE CALCULATION AND REPORTING ===
         double getOverallGrade() const;  // Average across all assessments
-        double getCourseGrade(const string& courseId) const;  // Average for specific course
+        double getCourseGrade(const string& courseId) const;  // Under the course's grading policy (mean by default)
+        double getCourseGrade(SymbolKey courseKey) const;
         string getGradeStatus() const;  // Pass/Fail based on 50% threshold
+        GradeAggregate getOverallGradeSummary() const;
+        GradeAggregate getCourseGradeSummary(SymbolKey courseKey) const;
+        
+        // Called by a linked Assessment after its marks change
+        void onAssessmentGradeChanged(const Assessment* assessment, double oldGrade, double newGrade);
         
         // === DISPLAY AND FORMATTING ===
         void displayStudentInfo() const;
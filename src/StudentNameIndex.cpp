@@ -0,0 +1,483 @@
+#include "StudentNameIndex.hpp"
+
+namespace PokenoSouth {
+
+    StudentNameIndex::StudentNameIndex() {
+        nodes.emplace_back();  // Root node
+    }
+
+    // === NORMALIZATION HELPERS ===
+
+    vector<string> StudentNameIndex::tokenize(const string& name) {
+        vector<string> tokens;
+        string current;
+
+        for (char raw : name) {
+            unsigned char c = static_cast<unsigned char>(raw);
+            if (isalnum(c)) {
+                current += static_cast<char>(tolower(c));
+            } else if (c == '\'' || c == '.') {
+                continue;  // "O'Brien" and "St. John" index as "obrien" and "st john"
+            } else if (!current.empty()) {
+                tokens.push_back(current);
+                current.clear();
+            }
+        }
+        if (!current.empty()) {
+            tokens.push_back(current);
+        }
+
+        return tokens;
+    }
+
+    uint32_t StudentNameIndex::packTrigram(const string& text, size_t pos) {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8) |
+               static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+    }
+
+    int StudentNameIndex::editDistanceLimit(size_t tokenLength, int maxDistance) {
+        // Roughly one edit per three letters, so short words don't match everything
+        int limit = static_cast<int>(tokenLength / 3);
+        return std::max(0, std::min({limit, maxDistance, MAX_EDIT_DISTANCE}));
+    }
+
+    int StudentNameIndex::editDistance(const string& pattern, const string& text, int maxDistance) {
+        const size_t m = pattern.size();
+        const size_t n = text.size();
+        if (m == 0) return static_cast<int>(n);
+        if (n == 0) return static_cast<int>(m);
+
+        if (m > 64) {
+            // Longer than a machine word: plain two-row DP (not expected for real names)
+            vector<int> previous(n + 1), current(n + 1);
+            for (size_t j = 0; j <= n; ++j) previous[j] = static_cast<int>(j);
+            for (size_t i = 1; i <= m; ++i) {
+                current[0] = static_cast<int>(i);
+                for (size_t j = 1; j <= n; ++j) {
+                    int substitution = previous[j - 1] + (pattern[i - 1] != text[j - 1] ? 1 : 0);
+                    current[j] = std::min({previous[j] + 1, current[j - 1] + 1, substitution});
+                }
+                std::swap(previous, current);
+            }
+            return previous[n];
+        }
+
+        // Myers' bit-vector algorithm in Hyyro's formulation for global distance:
+        // one bit per pattern position encodes the vertical deltas of a DP column
+        uint64_t peq[256] = {};
+        for (size_t i = 0; i < m; ++i) {
+            peq[static_cast<unsigned char>(pattern[i])] |= uint64_t(1) << i;
+        }
+
+        const uint64_t lastBit = uint64_t(1) << (m - 1);
+        uint64_t pv = (m == 64) ? ~uint64_t(0) : ((uint64_t(1) << m) - 1);
+        uint64_t mv = 0;
+        int score = static_cast<int>(m);
+
+        for (size_t j = 0; j < n; ++j) {
+            uint64_t eq = peq[static_cast<unsigned char>(text[j])];
+            uint64_t xv = eq | mv;
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+
+            if (ph & lastBit) ++score;
+            else if (mh & lastBit) --score;
+
+            // Each remaining text character can lower the score by at most one
+            if (score - static_cast<int>(n - j - 1) > maxDistance) {
+                return maxDistance + 1;
+            }
+
+            ph = (ph << 1) | 1;  // Row 0 grows by one per text character (global alignment)
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+        }
+        return score;
+    }
+
+    // === INDEX MAINTENANCE (PRIVATE) ===
+
+    int StudentNameIndex::findNode(const string& prefix) const {
+        int nodeId = 0;
+        for (char c : prefix) {
+            const auto& children = nodes[nodeId].children;
+            auto it = lower_bound(children.begin(), children.end(), c,
+                [](const pair<char, int>& child, char value) { return child.first < value; });
+            if (it == children.end() || it->first != c) {
+                return -1;
+            }
+            nodeId = it->second;
+        }
+        return nodeId;
+    }
+
+    int StudentNameIndex::findTerm(const string& text) const {
+        int nodeId = findNode(text);
+        return nodeId >= 0 ? nodes[nodeId].termId : -1;
+    }
+
+    int StudentNameIndex::internTerm(const string& text) {
+        int nodeId = 0;
+        for (char c : text) {
+            auto& children = nodes[nodeId].children;
+            auto it = lower_bound(children.begin(), children.end(), c,
+                [](const pair<char, int>& child, char value) { return child.first < value; });
+            if (it != children.end() && it->first == c) {
+                nodeId = it->second;
+                continue;
+            }
+
+            int childId = static_cast<int>(nodes.size());
+            children.insert(it, {c, childId});
+            nodes.emplace_back();  // May reallocate; 'children' is not used past this point
+            nodeId = childId;
+        }
+
+        if (nodes[nodeId].termId < 0) {
+            int termId = static_cast<int>(terms.size());
+            terms.push_back({text, {}});
+            nodes[nodeId].termId = termId;
+            addTrigrams(text, termId);
+            if (termsByLength.size() <= text.size()) {
+                termsByLength.resize(text.size() + 1);
+            }
+            termsByLength[text.size()].push_back(termId);
+        }
+        return nodes[nodeId].termId;
+    }
+
+    void StudentNameIndex::addTrigrams(const string& text, int termId) {
+        if (text.size() < TRIGRAM_LENGTH) return;
+
+        for (size_t pos = 0; pos + TRIGRAM_LENGTH <= text.size(); ++pos) {
+            auto& postings = trigramTerms[packTrigram(text, pos)];
+            // Term ids are handed out in increasing order, so appending keeps postings sorted
+            if (postings.empty() || postings.back() != termId) {
+                postings.push_back(termId);
+            }
+        }
+    }
+
+    void StudentNameIndex::addPosting(int termId, int slot) {
+        auto& postings = terms[termId].slots;
+        auto it = lower_bound(postings.begin(), postings.end(), slot);
+        if (it == postings.end() || *it != slot) {
+            postings.insert(it, slot);
+        }
+    }
+
+    void StudentNameIndex::removePosting(int termId, int slot) {
+        auto& postings = terms[termId].slots;
+        auto it = lower_bound(postings.begin(), postings.end(), slot);
+        if (it != postings.end() && *it == slot) {
+            postings.erase(it);
+        }
+    }
+
+    void StudentNameIndex::collectPrefixTerms(int nodeId, vector<int>& termIds) const {
+        vector<int> pending = {nodeId};
+        while (!pending.empty()) {
+            int current = pending.back();
+            pending.pop_back();
+
+            if (nodes[current].termId >= 0) {
+                termIds.push_back(nodes[current].termId);
+            }
+            for (const auto& child : nodes[current].children) {
+                pending.push_back(child.second);
+            }
+        }
+    }
+
+    vector<int> StudentNameIndex::collectSubstringTerms(const string& token) const {
+        vector<int> matches;
+        if (token.size() < TRIGRAM_LENGTH) return matches;
+
+        // Verify candidates from the rarest trigram of the token
+        const vector<int>* rarest = nullptr;
+        for (size_t pos = 0; pos + TRIGRAM_LENGTH <= token.size(); ++pos) {
+            auto it = trigramTerms.find(packTrigram(token, pos));
+            if (it == trigramTerms.end()) {
+                return matches;  // A missing trigram rules out every term
+            }
+            if (!rarest || it->second.size() < rarest->size()) {
+                rarest = &it->second;
+            }
+        }
+
+        for (int termId : *rarest) {
+            if (terms[termId].text.find(token) != string::npos) {
+                matches.push_back(termId);
+            }
+        }
+        return matches;
+    }
+
+    // === INDEX MAINTENANCE ===
+
+    void StudentNameIndex::add(const Student& student) {
+        int rollNumber = student.getRollNumber();
+        if (contains(rollNumber)) {
+            remove(rollNumber);
+        }
+
+        int slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<int>(entries.size());
+            entries.emplace_back();
+        }
+
+        IndexedStudent& entry = entries[slot];
+        entry.rollNumber = rollNumber;
+
+        vector<string> tokens = tokenize(student.getFirstName());
+        vector<string> lastTokens = tokenize(student.getLastName());
+        tokens.insert(tokens.end(), lastTokens.begin(), lastTokens.end());
+
+        for (const auto& token : tokens) {
+            int termId = internTerm(token);
+            if (find(entry.termIds.begin(), entry.termIds.end(), termId) == entry.termIds.end()) {
+                entry.termIds.push_back(termId);
+                addPosting(termId, slot);
+            }
+            if (!entry.normalizedFullName.empty()) entry.normalizedFullName += ' ';
+            entry.normalizedFullName += token;
+        }
+
+        entry.sortKey = Common::normalizeText(student.getLastName() + " " + student.getFirstName());
+        slotByRollNumber[rollNumber] = slot;
+    }
+
+    void StudentNameIndex::update(const Student& student) {
+        remove(student.getRollNumber());
+        add(student);
+    }
+
+    void StudentNameIndex::remove(int rollNumber) {
+        auto it = slotByRollNumber.find(rollNumber);
+        if (it == slotByRollNumber.end()) return;
+
+        int slot = it->second;
+        for (int termId : entries[slot].termIds) {
+            removePosting(termId, slot);
+        }
+        entries[slot] = IndexedStudent();
+        freeSlots.push_back(slot);
+        slotByRollNumber.erase(it);
+    }
+
+    void StudentNameIndex::rebuild(const EntityArena<Student>& students) {
+        clear();
+        entries.reserve(students.size());
+        slotByRollNumber.reserve(students.size());
+        for (const auto& student : students) {
+            if (student) {
+                add(*student);
+            }
+        }
+    }
+
+    void StudentNameIndex::clear() {
+        nodes.clear();
+        nodes.emplace_back();
+        terms.clear();
+        trigramTerms.clear();
+        termsByLength.clear();
+        entries.clear();
+        freeSlots.clear();
+        slotByRollNumber.clear();
+    }
+
+    bool StudentNameIndex::contains(int rollNumber) const {
+        return slotByRollNumber.find(rollNumber) != slotByRollNumber.end();
+    }
+
+    // === QUERIES (PRIVATE) ===
+
+    void StudentNameIndex::collectTermScores(const string& token, TermScores& scores) const {
+        // Exact and prefix matches from the trie
+        int nodeId = findNode(token);
+        if (nodeId >= 0) {
+            vector<int> prefixTerms;
+            collectPrefixTerms(nodeId, prefixTerms);
+            for (int termId : prefixTerms) {
+                const string& text = terms[termId].text;
+                if (text.size() == token.size()) {
+                    scores.emplace_back(termId, EXACT_SCORE);
+                } else {
+                    scores.emplace_back(termId, PREFIX_SCORE +
+                                        static_cast<int>(10 * token.size() / text.size()));
+                }
+            }
+        }
+
+        // Substring matches from the trigram index (prefix matches already scored higher)
+        for (int termId : collectSubstringTerms(token)) {
+            const string& text = terms[termId].text;
+            if (text.compare(0, token.size(), token) != 0) {
+                scores.emplace_back(termId, SUBSTRING_SCORE +
+                                    static_cast<int>(10 * token.size() / text.size()));
+            }
+        }
+    }
+
+    void StudentNameIndex::collectFuzzyTerms(const string& token, int maxDistance,
+                                             TermScores& scores) const {
+        const int k = editDistanceLimit(token.size(), maxDistance);
+        const size_t minLength = token.size() > static_cast<size_t>(k) ? token.size() - k : 0;
+        const size_t maxLength = token.size() + k;
+
+        auto verify = [&](int termId) {
+            int distance = editDistance(token, terms[termId].text, k);
+            if (distance <= k) {
+                scores.emplace_back(termId, EXACT_SCORE - FUZZY_PENALTY * distance);
+            }
+        };
+
+        // q-gram lemma: a term within k edits shares at least (|token| - q + 1) - k*q of the
+        // token's trigrams. When that bound is positive, only terms reached through the
+        // trigram index and passing the count need the bit-parallel check.
+        const int trigramCount = token.size() >= TRIGRAM_LENGTH
+            ? static_cast<int>(token.size() - TRIGRAM_LENGTH + 1) : 0;
+        const int threshold = trigramCount - k * static_cast<int>(TRIGRAM_LENGTH);
+
+        if (threshold <= 0) {
+            // Too short or too many edits for the trigram filter: length buckets only
+            for (size_t length = minLength; length <= maxLength && length < termsByLength.size(); ++length) {
+                for (int termId : termsByLength[length]) {
+                    verify(termId);
+                }
+            }
+            return;
+        }
+
+        // Sized by the postings this token reaches, not by the whole vocabulary
+        unordered_map<int, uint16_t> shared;
+        vector<int> candidates;
+        for (size_t pos = 0; pos + TRIGRAM_LENGTH <= token.size(); ++pos) {
+            auto it = trigramTerms.find(packTrigram(token, pos));
+            if (it == trigramTerms.end()) continue;
+            for (int termId : it->second) {
+                size_t length = terms[termId].text.size();
+                if (length < minLength || length > maxLength) continue;
+                if (shared[termId]++ == 0) candidates.push_back(termId);
+            }
+        }
+
+        for (int termId : candidates) {
+            if (shared[termId] >= threshold) {
+                verify(termId);
+            }
+        }
+    }
+
+    vector<NameMatch> StudentNameIndex::rankStudents(const vector<string>& tokens,
+                                                     const vector<TermScores>& tokenTerms,
+                                                     size_t maxResults) const {
+        vector<NameMatch> results;
+
+        // Scratch only for slots the postings reach: the first word's postings create the
+        // candidates, later words can only keep them. Best score for the current word,
+        // running total, words matched
+        struct Candidate {
+            int tokenScore = 0;
+            int total = 0;
+            size_t tokensMatched = 0;
+        };
+        unordered_map<int, Candidate> candidates;
+        vector<int> touched;
+
+        for (size_t tokenIndex = 0; tokenIndex < tokenTerms.size(); ++tokenIndex) {
+            touched.clear();
+            for (const auto& termScore : tokenTerms[tokenIndex]) {
+                for (int slot : terms[termScore.first].slots) {
+                    Candidate* candidate;
+                    if (tokenIndex == 0) {
+                        candidate = &candidates[slot];
+                    } else {
+                        auto it = candidates.find(slot);
+                        if (it == candidates.end() || it->second.tokensMatched != tokenIndex) continue;  // Missed an earlier word
+                        candidate = &it->second;
+                    }
+                    if (candidate->tokenScore == 0) touched.push_back(slot);
+                    candidate->tokenScore = std::max(candidate->tokenScore, termScore.second);
+                }
+            }
+
+            // Every query word must match: only slots touched by all tokens so far survive
+            for (int slot : touched) {
+                Candidate& candidate = candidates[slot];
+                candidate.total += candidate.tokenScore;
+                candidate.tokensMatched++;
+                candidate.tokenScore = 0;
+            }
+            if (touched.empty()) return results;
+        }
+
+        string normalizedQuery;
+        for (const auto& token : tokens) {
+            if (!normalizedQuery.empty()) normalizedQuery += ' ';
+            normalizedQuery += token;
+        }
+
+        vector<pair<int, int>> ranked;  // (slot, score)
+        ranked.reserve(touched.size());
+        for (int slot : touched) {
+            int score = candidates[slot].total;
+            if (entries[slot].normalizedFullName == normalizedQuery) {
+                score += FULL_NAME_BONUS;
+            }
+            ranked.emplace_back(slot, score);
+        }
+
+        auto ranking = [this](const pair<int, int>& a, const pair<int, int>& b) {
+            if (a.second != b.second) return a.second > b.second;
+            const IndexedStudent& entryA = entries[a.first];
+            const IndexedStudent& entryB = entries[b.first];
+            if (entryA.sortKey != entryB.sortKey) return entryA.sortKey < entryB.sortKey;
+            return entryA.rollNumber < entryB.rollNumber;
+        };
+
+        size_t keep = std::min(maxResults, ranked.size());
+        std::partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end(), ranking);
+
+        results.reserve(keep);
+        for (size_t i = 0; i < keep; ++i) {
+            results.push_back({entries[ranked[i].first].rollNumber, ranked[i].second});
+        }
+        return results;
+    }
+
+    // === QUERIES ===
+
+    vector<NameMatch> StudentNameIndex::search(const string& query, size_t maxResults) const {
+        vector<string> tokens = tokenize(query);
+        if (tokens.empty() || maxResults == 0) return {};
+
+        vector<TermScores> tokenTerms(tokens.size());
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            collectTermScores(tokens[i], tokenTerms[i]);
+            if (tokenTerms[i].empty()) return {};
+        }
+        return rankStudents(tokens, tokenTerms, maxResults);
+    }
+
+    vector<NameMatch> StudentNameIndex::fuzzySearch(const string& query, int maxDistance,
+                                                    size_t maxResults) const {
+        vector<string> tokens = tokenize(query);
+        if (tokens.empty() || maxResults == 0 || maxDistance < 0) return {};
+
+        vector<TermScores> tokenTerms(tokens.size());
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            collectFuzzyTerms(tokens[i], maxDistance, tokenTerms[i]);
+            if (tokenTerms[i].empty()) return {};
+        }
+        return rankStudents(tokens, tokenTerms, maxResults);
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "common.hpp"
+#include "Student.hpp"
+
+USING_STD_NAMEINDEX
+
+namespace PokenoSouth {
+    // Forward declaration
+    class Student;
+
+    /**
+     * Ranked result of a name search
+     */
+    struct NameMatch {
+        int rollNumber;     // Student roll number
+        int score;          // Higher is a better match
+    };
+
+    /**
+     * StudentNameIndex for Pokeno South Primary School
+     * In-memory partial-name search over student first and last names
+     *
+     * Key Features:
+     * - Names normalized into lowercase terms (apostrophes and dots dropped, split on spaces and hyphens)
+     * - Prefix trie over distinct terms for "starts with" lookups
+     * - Trigram inverted index over distinct terms for substring lookups
+     * - Incremental add/update/remove kept in step with System CRUD operations
+     * - Ranked results: exact term > term prefix > substring, all query words must match
+     */
+    class StudentNameIndex {
+    private:
+        struct TrieNode {
+            vector<pair<char, int>> children;   // Sorted by character
+            int termId = -1;                    // Term ending at this node, -1 if none
+        };
+
+        struct Term {
+            string text;
+            vector<int> slots;                  // Sorted postings of student slots
+        };
+
+        struct IndexedStudent {
+            int rollNumber = 0;
+            vector<int> termIds;                // Distinct terms of first + last name
+            string sortKey;                     // "last first" for stable ordering of ties
+            string normalizedFullName;          // "first last" terms joined by single spaces
+        };
+
+        vector<TrieNode> nodes;                 // nodes[0] is the root
+        vector<Term> terms;
+        unordered_map<uint32_t, vector<int>> trigramTerms;   // Packed trigram -> sorted term ids
+        vector<vector<int>> termsByLength;      // Term length -> term ids, for fuzzy candidates
+        vector<IndexedStudent> entries;         // Dense student slots referenced by postings
+        vector<int> freeSlots;                  // Slots released by remove(), reused by add()
+        unordered_map<int, int> slotByRollNumber;
+
+        // Index maintenance
+        int internTerm(const string& text);
+        int findTerm(const string& text) const;
+        int findNode(const string& prefix) const;
+        void addTrigrams(const string& text, int termId);
+        void collectPrefixTerms(int nodeId, vector<int>& termIds) const;
+        vector<int> collectSubstringTerms(const string& token) const;
+        void addPosting(int termId, int slot);
+        void removePosting(int termId, int slot);
+
+        // Query helpers: (termId, score) pairs per query word, then ranking by student
+        using TermScores = vector<pair<int, int>>;
+        void collectTermScores(const string& token, TermScores& scores) const;
+        void collectFuzzyTerms(const string& token, int maxDistance, TermScores& scores) const;
+        vector<NameMatch> rankStudents(const vector<string>& tokens,
+                                       const vector<TermScores>& tokenTerms,
+                                       size_t maxResults) const;
+
+        static uint32_t packTrigram(const string& text, size_t pos);
+
+    public:
+        StudentNameIndex();
+
+        // === INDEX MAINTENANCE ===
+        void add(const Student& student);
+        void update(const Student& student);     // Re-index after a name change
+        void remove(int rollNumber);
+        void rebuild(const EntityArena<Student>& students);
+        void clear();
+
+        // === QUERIES ===
+        vector<NameMatch> search(const string& query, size_t maxResults = DEFAULT_MAX_RESULTS) const;
+        vector<NameMatch> fuzzySearch(const string& query,
+                                      int maxDistance = DEFAULT_MAX_EDIT_DISTANCE,
+                                      size_t maxResults = DEFAULT_MAX_RESULTS) const;
+        bool contains(int rollNumber) const;
+        size_t size() const { return slotByRollNumber.size(); }
+        size_t termCount() const { return terms.size(); }
+
+        // === NORMALIZATION HELPERS ===
+        static vector<string> tokenize(const string& name);
+        static int editDistance(const string& pattern, const string& text, int maxDistance);
+        static int editDistanceLimit(size_t tokenLength, int maxDistance);
+
+        // === SCORING RULES ===
+        static constexpr size_t DEFAULT_MAX_RESULTS = 20;
+        static constexpr size_t TRIGRAM_LENGTH = 3;
+        static constexpr int EXACT_SCORE = 100;
+        static constexpr int PREFIX_SCORE = 60;
+        static constexpr int SUBSTRING_SCORE = 30;
+        static constexpr int FULL_NAME_BONUS = 50;
+        static constexpr int DEFAULT_MAX_EDIT_DISTANCE = 2;
+        static constexpr int MAX_EDIT_DISTANCE = 3;
+        static constexpr int FUZZY_PENALTY = 25;       // Per edit, from EXACT_SCORE
+    };
+}
@@ -0,0 +1,47 @@
+#include "SymbolTable.hpp"
+
+namespace PokenoSouth {
+
+    // === INTERNING ===
+
+    SymbolKey SymbolTable::intern(const string& name) {
+        auto it = keys.find(string_view(name));
+        if (it != keys.end()) {
+            return it->second;
+        }
+
+        SymbolKey key = static_cast<SymbolKey>(names.size());
+        names.push_back(name);  // deque::push_back keeps existing elements in place
+        keys.emplace(string_view(names.back()), key);
+        return key;
+    }
+
+    SymbolKey SymbolTable::find(const string& name) const {
+        auto it = keys.find(string_view(name));
+        return it != keys.end() ? it->second : INVALID_KEY;
+    }
+
+    const string& SymbolTable::name(SymbolKey key) const {
+        if (!contains(key)) {
+            throw std::out_of_range("Unknown symbol key: " + std::to_string(key));
+        }
+        return names[key];
+    }
+
+    // === SHARED TABLES ===
+
+    SymbolTable& SymbolTable::courseIds() {
+        static SymbolTable table;
+        return table;
+    }
+
+    SymbolTable& SymbolTable::teachers() {
+        static SymbolTable table;
+        return table;
+    }
+
+    SymbolTable& SymbolTable::assessmentTypes() {
+        static SymbolTable table;
+        return table;
+    }
+}
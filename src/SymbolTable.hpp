@@ -0,0 +1,45 @@
+#pragma once
+
+#include "common.hpp"
+
+USING_STD_SYMBOLTABLE
+
+namespace PokenoSouth {
+    // Dense integer key handed out by a SymbolTable
+    using SymbolKey = uint32_t;
+
+    /**
+     * SymbolTable for Pokeno South Primary School
+     * Interns repeated strings (course IDs, teacher names, assessment types) into dense keys
+     *
+     * Key Features:
+     * - Keys are assigned in first-seen order starting at 0, so they can index vectors directly
+     * - Each distinct string is stored once; name() references stay valid for the table's lifetime
+     * - find() never inserts, so lookups of unknown strings don't grow the table
+     * - Shared tables for course IDs, teachers and assessment types used by the entities
+     */
+    class SymbolTable {
+    private:
+        deque<string> names;                           // Stable storage, indexed by key
+        unordered_map<string_view, SymbolKey> keys;    // Views into 'names'
+
+    public:
+        SymbolTable() = default;
+        SymbolTable(const SymbolTable&) = delete;             // Views would dangle
+        SymbolTable& operator=(const SymbolTable&) = delete;
+
+        // === INTERNING ===
+        SymbolKey intern(const string& name);
+        SymbolKey find(const string& name) const;      // INVALID_KEY if never interned
+        const string& name(SymbolKey key) const;
+        bool contains(SymbolKey key) const { return key < names.size(); }
+        size_t size() const { return names.size(); }
+
+        // === SHARED TABLES ===
+        static SymbolTable& courseIds();
+        static SymbolTable& teachers();
+        static SymbolTable& assessmentTypes();
+
+        static constexpr SymbolKey INVALID_KEY = UINT32_MAX;
+    };
+}
@@ -1,10 +1,18 @@
 #include "System.hpp"
+#include "FileHandler.hpp"
 
 namespace PokenoSouth {
 
-System::System() 
-    : isRunning(false)
+System::System()
+    : System(StorageBackend::create("csv"))
+{
+}
+
+System::System(unique_ptr<StorageBackend> storage)
+    : storage(std::move(storage))
+    , isRunning(false)
     , dataLoaded(false)
+    , unsavedChanges(false)
     , currentSession("")
 {
     auto now = system_clock::now();
@@ -25,8 +33,8 @@ bool System::initialize() {
         displayHeader("Pokeno South Primary School - Student Management System");
         cout << "Initializing system...\n" << endl;
         
-        if (!FileHandler::initializeDataFiles()) {
-            cerr << "Warning: Could not initialize data directories\n";
+        if (!storage->initialize()) {
+            cerr << "Warning: Could not initialize " << storage->name() << " storage\n";
         }
         
         loadAllSystemData();
@@ -79,7 +87,7 @@ int System::run() {
                     cout << "Version: 1.0.0\n";
                     cout << "Developed by Adam Calkin : 270712965, Ben Edwards : 270471269, & Allan Werner : 270697583\n";
                     cout << "Features: Student, Course, and Assessment management\n";
-                    cout << "Data persistence via CSV files\n";
+                    cout << "Data persistence via " << storage->name() << "\n";
                     pauseForUser();
                     break;
                 case 0:
@@ -190,6 +198,9 @@ void System::displayReportsMenu() const {
     cout << "│  1. System Overview                                        │\n";
     cout << "│  2. Enrollment Report                                      │\n";
     cout << "│  3. Grade Report                                           │\n";
+    cout << "│  4. What-If Grade Simulation                               │\n";
+    cout << "│  5. Enrollment Overlap                                     │\n";
+    cout << "│  6. Best-N Standings                                       │\n";
     cout << "│  0. Back to Main Menu                                      │\n";
     cout << "└─────────────────────────────────────────────────────────────┘\n\n";
 }
@@ -528,7 +539,7 @@ void System::handleReportsMenu() {
         clearScreen();
         displayReportsMenu();
         
-        int choice = getMenuChoice(0, 3);
+        int choice = getMenuChoice(0, 6);
         
         switch (choice) {
             case 1:
@@ -540,6 +551,15 @@ void System::handleReportsMenu() {
             case 3:
                 generateGradeReport();
                 break;
+            case 4:
+                runGradeSimulation();
+                break;
+            case 5:
+                compareEnrollments();
+                break;
+            case 6:
+                generateBestNReport();
+                break;
             case 0:
                 return;
             default:
@@ -615,16 +635,67 @@ void System::viewAllStudents() const {
 void System::findStudent() const {
     displayHeader("FIND STUDENT");
     
-    int rollNumber = getIntInput("Enter student roll number: ");
-    auto student = findStudentByRollNumber(rollNumber);
+    string query;
+    try {
+        query = getStringInput("Enter student roll number or name: ");
+    } catch (const exception& e) {
+        cout << e.what() << "\n";
+        pauseForUser();
+        return;
+    }
     
-    if (student) {
-        cout << "\nStudent found:\n";
-        cout << "Roll Number: " << student->getRollNumber() << "\n";
-        cout << "Name: " << student->getFirstName() << " " << student->getLastName() << "\n";
-        cout << "Email: " << student->getContactEmail() << "\n";
+    // All digits: exact roll number lookup, otherwise ranked partial-name search
+    int rollNumber;
+    if (Common::parseAndValidateInt(query, rollNumber, 1, 999999)) {
+        auto student = findStudentByRollNumber(rollNumber);
+        
+        if (student) {
+            cout << "\nStudent found:\n";
+            cout << "Roll Number: " << student->getRollNumber() << "\n";
+            cout << "Name: " << student->getFirstName() << " " << student->getLastName() << "\n";
+            cout << "Email: " << student->getContactEmail() << "\n";
+            
+            // Read from the student's running grade totals; nothing is recomputed here
+            const GradeAggregate overall = student->getOverallGradeSummary();
+            if (overall.count > 0) {
+                cout << fixed << setprecision(1);
+                cout << "Overall Grade: " << overall.mean() << "% over " << overall.count << " assessment(s)"
+                     << " (highest " << overall.maxGrade << "%, lowest " << overall.minGrade << "%)\n";
+                for (const Course* course : student->getEnrolledCourses()) {
+                    const GradeAggregate grades = student->getCourseGradeSummary(course->getCourseKey());
+                    if (grades.count == 0) continue;
+                    cout << "  " << std::left << setw(12) << course->getCourseId() << std::right
+                         << grades.mean() << "% (" << grades.count << " assessment(s), "
+                         << grades.passCount << " passed)\n";
+                }
+            }
+        } else {
+            cout << "Student with roll number " << rollNumber << " not found.\n";
+        }
     } else {
-        cout << "Student with roll number " << rollNumber << " not found.\n";
+        auto matches = findStudentsByName(query);
+        bool similarOnly = false;
+        
+        // Nothing contains the query: retry allowing for typos (e.g. misheard surnames)
+        if (matches.empty()) {
+            matches = findStudentsBySimilarName(query);
+            similarOnly = !matches.empty();
+        }
+        
+        if (matches.empty()) {
+            cout << "No students found matching \"" << query << "\".\n";
+        } else {
+            if (similarOnly) {
+                cout << "\nNo exact matches for \"" << query << "\". Did you mean:\n";
+            } else {
+                cout << "\n" << matches.size() << " student(s) found (best matches first):\n";
+            }
+            for (const auto& student : matches) {
+                cout << "  " << student->getRollNumber() << ": "
+                          << student->getFirstName() << " " << student->getLastName()
+                          << " <" << student->getContactEmail() << ">\n";
+            }
+        }
     }
     
     pauseForUser();
@@ -708,35 +779,385 @@ void System::findAssessment() const {
 
 void System::generateStudentReport() const {
     displayHeader("STUDENT STATISTICS");
-    cout << "Total Students: " << students.size() << "\n";
+    cout << reportCache.get("students",
+                            {students.membershipVersion(), VersionClock::latest(VersionDomain::Students)},
+                            [this]() { return buildStudentReport(); });
     pauseForUser();
 }
 
 void System::generateCourseReport() const {
     displayHeader("COURSE STATISTICS");
-    cout << "Total Courses: " << courses.size() << "\n";
+    cout << reportCache.get("courses",
+                            {courses.membershipVersion(), VersionClock::latest(VersionDomain::Courses)},
+                            [this]() { return buildCourseReport(); });
     pauseForUser();
 }
 
 void System::generateGradeReport() const {
     displayHeader("GRADE STATISTICS");
-    cout << "Total Assessments: " << assessments.size() << "\n";
+    cout << reportCache.get("grades",
+                            {assessments.membershipVersion(), VersionClock::latest(VersionDomain::Assessments)},
+                            [this]() { return buildGradeReport(); });
     pauseForUser();
 }
 
 void System::generateEnrollmentReport() const {
     displayHeader("ENROLLMENT STATISTICS");
-    cout << "Total Students: " << students.size() << "\n";
-    cout << "Total Courses: " << courses.size() << "\n";
+    cout << reportCache.get("enrollments",
+                            {students.membershipVersion(), VersionClock::latest(VersionDomain::Students),
+                             courses.membershipVersion(), VersionClock::latest(VersionDomain::Courses)},
+                            [this]() { return buildEnrollmentReport(); });
     pauseForUser();
 }
 
+// === REPORT BODIES ===
+// Each reads only what its cache key depends on; see the generate*Report() callers.
+
+string System::buildStudentReport() const {
+    stringstream report;
+    report << fixed << setprecision(1);
+    report << "Total Students: " << students.size() << "\n";
+    
+    int enrolledStudents = 0;
+    int gradedStudents = 0;
+    int passingStudents = 0;
+    size_t totalEnrollments = 0;
+    double gradeTotal = 0.0;
+    vector<const Student*> ranked;
+    
+    for (const Student* student : students) {
+        totalEnrollments += student->getEnrollmentCount();
+        if (student->getEnrollmentCount() > 0) enrolledStudents++;
+        if (!student->getAssessments().empty()) {
+            const double grade = student->getOverallGrade();
+            gradedStudents++;
+            gradeTotal += grade;
+            if (grade >= Student::PASS_THRESHOLD) passingStudents++;
+            ranked.push_back(student);
+        }
+    }
+    
+    report << "Enrolled in at least one course: " << enrolledStudents << "\n";
+    report << "Not enrolled in any course: " << (students.size() - enrolledStudents) << "\n";
+    if (!students.empty()) {
+        report << "Average courses per student: "
+               << (static_cast<double>(totalEnrollments) / students.size()) << "\n";
+    }
+    
+    report << "\nStudents with assessments: " << gradedStudents << "\n";
+    if (gradedStudents > 0) {
+        report << "Average overall grade: " << (gradeTotal / gradedStudents) << "%\n";
+        report << "Passing (>= " << Student::PASS_THRESHOLD << "%): " << passingStudents
+               << "   Failing: " << (gradedStudents - passingStudents) << "\n";
+        
+        const size_t shown = std::min<size_t>(ranked.size(), 5);
+        partial_sort(ranked.begin(), ranked.begin() + shown, ranked.end(),
+            [](const Student* a, const Student* b) { return a->getOverallGrade() > b->getOverallGrade(); });
+        report << "\nTop Students:\n";
+        for (size_t i = 0; i < shown; ++i) {
+            report << "  " << (i + 1) << ". " << ranked[i]->getFullName()
+                   << " (Roll " << ranked[i]->getRollNumber() << ") - "
+                   << ranked[i]->getOverallGrade() << "%\n";
+        }
+    }
+    
+    return report.str();
+}
+
+string System::buildCourseReport() const {
+    stringstream report;
+    report << fixed << setprecision(1);
+    report << "Total Courses: " << courses.size() << "\n";
+    if (courses.empty()) {
+        return report.str();
+    }
+    
+    int activeCourses = 0;
+    int fullCourses = 0;
+    for (const Course* course : courses) {
+        if (course->getIsActive()) activeCourses++;
+        if (course->isFull()) fullCourses++;
+    }
+    report << "Active: " << activeCourses << "   Full: " << fullCourses << "\n\n";
+    
+    // Per-course figures come from Course's running grade totals
+    report << std::left << setw(12) << "Course" << setw(32) << "Name" << setw(12) << "Enrolled"
+           << setw(10) << "Average" << setw(12) << "High/Low" << setw(13) << "Policy" << "Pass Rate\n";
+    report << string(101, '-') << "\n";
+    for (const Course* course : courses) {
+        const GradeAggregate summary = course->getGradeSummary();
+        report << setw(12) << course->getCourseId()
+               << setw(32) << course->getCourseName().substr(0, 30)
+               << setw(12) << (to_string(course->getCurrentEnrollment()) + "/" + to_string(course->getMaxEnrollment()))
+               << setw(10) << (to_string(static_cast<int>(course->getCourseAverageGrade() + 0.5)) + "%")
+               << setw(12) << (summary.count > 0 ? to_string(static_cast<int>(summary.maxGrade + 0.5)) + "/" +
+                                                   to_string(static_cast<int>(summary.minGrade + 0.5))
+                                                 : string("-"))
+               << setw(13) << course->getGradingPolicyName()
+               << course->getPassRate() << "%\n";
+    }
+    report << std::right;
+    
+    return report.str();
+}
+
+string System::buildGradeReport() const {
+    stringstream report;
+    report << fixed << setprecision(1);
+    report << "Total Assessments: " << assessments.size() << "\n";
+    if (assessments.empty()) {
+        return report.str();
+    }
+    
+    size_t letterCounts[GradeKernel::LETTER_COUNT];
+    assessmentColumns.countLetterGrades(letterCounts);
+    
+    const GradeAggregate summary = assessmentColumns.summarize();
+    report << "Submitted: " << assessmentColumns.countSubmitted() << "/" << summary.count << "\n";
+    report << "Average Grade: " << summary.mean() << "%\n";
+    report << "Highest Grade: " << summary.maxGrade << "%\n";
+    report << "Lowest Grade: " << summary.minGrade << "%\n";
+    report << "Pass: " << summary.passCount << "   Fail: " << summary.failCount << "\n";
+    report << "\nGrade Distribution:\n";
+    for (uint8_t code = 0; code < GradeKernel::LETTER_COUNT; ++code) {
+        report << "  " << std::left << setw(3) << GradeKernel::letterName(code) << std::right << ": "
+               << letterCounts[code] << "\n";
+    }
+    
+    return report.str();
+}
+
+string System::buildEnrollmentReport() const {
+    stringstream report;
+    report << fixed << setprecision(1);
+    report << "Total Students: " << students.size() << "\n";
+    report << "Total Courses: " << courses.size() << "\n";
+    report << "Total Enrollments: " << getEnrollmentCount() << "\n";
+    
+    int unenrolledStudents = 0;
+    for (const Student* student : students) {
+        if (student->getEnrollmentCount() == 0) unenrolledStudents++;
+    }
+    report << "Students not enrolled: " << unenrolledStudents << "\n";
+    
+    if (!courses.empty()) {
+        report << "\nCourse Fill Rates:\n";
+        for (const Course* course : courses) {
+            report << "  " << std::left << setw(12) << course->getCourseId() << std::right
+                   << course->getCurrentEnrollment() << "/" << course->getMaxEnrollment()
+                   << " (" << (100.0 * course->getCurrentEnrollment() / course->getMaxEnrollment()) << "%)"
+                   << (course->isFull() ? " FULL" : "") << "\n";
+        }
+    }
+    
+    return report.str();
+}
+
 void System::generateSystemStatistics() const {
     displayHeader("SYSTEM OVERVIEW");
     cout << currentSession << "\n\n";
     cout << "Students: " << students.size() << "\n";
     cout << "Courses: " << courses.size() << "\n";
     cout << "Assessments: " << assessments.size() << "\n";
+    cout << "Cached reports: " << reportCache.size() << " (" << reportCache.hits() << " hits, "
+         << reportCache.misses() << " rebuilds)\n";
+    pauseForUser();
+}
+
+void System::runGradeSimulation() const {
+    displayHeader("WHAT-IF GRADE SIMULATION");
+    
+    if (assessments.empty()) {
+        cout << "No assessments found in the system.\n";
+        pauseForUser();
+        return;
+    }
+    
+    static const char* const POLICIES[][2] = {
+        {"split-40-60", "Internal/final split 40/60"},
+        {"split-50-50", "Internal/final split 50/50"},
+        {"drop-lowest", "Drop each student's lowest assessment per course"},
+        {"best-3", "Count only each student's best 3 assessments per course"},
+    };
+    cout << "Compare current grades (each course under its own grading policy) against:\n";
+    for (int i = 0; i < 4; ++i) {
+        cout << "  " << (i + 1) << ". " << POLICIES[i][1] << "\n";
+    }
+    cout << "  0. Cancel\n\n";
+    
+    const int choice = getMenuChoice(0, 4);
+    if (choice == 0) {
+        return;
+    }
+    
+    try {
+        // Runs on a snapshot; nothing below touches live students, courses or assessments
+        const CourseGradingPolicy* policy = GradingPolicyRegistry::shared().find(POLICIES[choice - 1][0]);
+        const GradeSimulation simulation(assessmentColumns);
+        const SimulationResult result = simulation.run(*policy);
+        
+        cout << fixed << setprecision(1);
+        cout << "\nScenario: " << POLICIES[choice - 1][1] << "\n";
+        cout << "Student course grades evaluated: " << result.studentCoursesEvaluated << "\n";
+        cout << "Grades changed: " << result.changes.size() << "\n";
+        cout << "Average change: " << (result.meanShift >= 0 ? "+" : "") << result.meanShift << " points\n";
+        cout << "Pass -> Fail: " << result.passToFail << "   Fail -> Pass: " << result.failToPass << "\n";
+        cout << "Letter grade changes: " << result.letterChanges << "\n";
+        
+        if (!result.changes.empty()) {
+            const size_t shown = std::min<size_t>(result.changes.size(), 20);
+            cout << "\n" << std::left << setw(8) << "Roll" << setw(24) << "Student" << setw(12) << "Course"
+                 << setw(16) << "Current" << "Simulated\n";
+            cout << string(72, '-') << "\n";
+            for (size_t i = 0; i < shown; ++i) {
+                const GradeChange& change = result.changes[i];
+                const Student* student = findStudentByRollNumber(change.rollNumber);
+                cout << setw(8) << change.rollNumber
+                     << setw(24) << (student ? student->getFullName().substr(0, 22) : string("(unknown)"))
+                     << setw(12) << SymbolTable::courseIds().name(change.courseKey)
+                     << setw(16) << (to_string(static_cast<int>(change.currentGrade + 0.5)) + "% " +
+                                    GradeKernel::letterName(change.currentLetter))
+                     << to_string(static_cast<int>(change.simulatedGrade + 0.5)) << "% "
+                     << GradeKernel::letterName(change.simulatedLetter)
+                     << (change.currentPass != change.simulatedPass ? (change.simulatedPass ? "  (now passing)" : "  (now failing)") : "")
+                     << "\n";
+            }
+            cout << std::right;
+            if (shown < result.changes.size()) {
+                cout << "... and " << (result.changes.size() - shown) << " more\n";
+            }
+        }
+    } catch (const exception& e) {
+        cout << "Error running simulation: " << e.what() << "\n";
+    }
+    
+    pauseForUser();
+}
+
+// Set questions over the enrollment matrix, answered from the bitmaps without walking rosters
+void System::compareEnrollments() const {
+    displayHeader("ENROLLMENT OVERLAP");
+    
+    cout << "  1. Students in both of two courses\n";
+    cout << "  2. Students in either of two courses\n";
+    cout << "  3. Courses shared by two students\n";
+    cout << "  0. Cancel\n\n";
+    
+    const int choice = getMenuChoice(0, 3);
+    if (choice == 0) {
+        return;
+    }
+    
+    try {
+        if (choice == 1 || choice == 2) {
+            const string firstCourseId = getStringInput("Enter first Course ID: ");
+            const string secondCourseId = getStringInput("Enter second Course ID: ");
+            if (!findCourseById(firstCourseId) || !findCourseById(secondCourseId)) {
+                cout << "Error: Both courses must exist.\n";
+                pauseForUser();
+                return;
+            }
+            
+            const vector<int> rollNumbers = choice == 1
+                ? getStudentsInBothCourses(firstCourseId, secondCourseId)
+                : getStudentsInEitherCourse(firstCourseId, secondCourseId);
+            cout << "\n" << rollNumbers.size() << " student(s) in " << (choice == 1 ? "both " : "either ")
+                 << firstCourseId << (choice == 1 ? " and " : " or ") << secondCourseId << ":\n";
+            for (int rollNumber : rollNumbers) {
+                const Student* student = findStudentByRollNumber(rollNumber);
+                cout << "  " << std::left << setw(8) << rollNumber << std::right
+                     << (student ? student->getFullName() : string("(unknown)")) << "\n";
+            }
+        } else {
+            const int firstRollNumber = getIntInput("Enter first student roll number: ");
+            const int secondRollNumber = getIntInput("Enter second student roll number: ");
+            if (!findStudentByRollNumber(firstRollNumber) || !findStudentByRollNumber(secondRollNumber)) {
+                cout << "Error: Both students must exist.\n";
+                pauseForUser();
+                return;
+            }
+            
+            const vector<string> courseIds = getSharedCourses(firstRollNumber, secondRollNumber);
+            cout << "\n" << countSharedCourses(firstRollNumber, secondRollNumber) << " shared course(s):\n";
+            for (const string& courseId : courseIds) {
+                const Course* course = findCourseById(courseId);
+                cout << "  " << std::left << setw(12) << courseId << std::right
+                     << (course ? course->getCourseName() : string("")) << "\n";
+            }
+        }
+    } catch (const exception& e) {
+        cout << "Error comparing enrollments: " << e.what() << "\n";
+    }
+    
+    pauseForUser();
+}
+
+// Best-N averages straight from the assessment columns: per (student, course) through the batch
+// calculator, and per course by streaming every row through a bounded heap
+void System::generateBestNReport() const {
+    displayHeader("BEST-N STANDINGS");
+    
+    if (assessments.empty()) {
+        cout << "No assessments found in the system.\n";
+        pauseForUser();
+        return;
+    }
+    
+    const int bestN = getValidatedIntInput("Count the best how many assessments (1-10)? ", 1, 10);
+    
+    // Course benchmarks: one pass over the course-key and grade columns
+    vector<BestNAccumulator> courseBest(SymbolTable::courseIds().size(), BestNAccumulator(bestN));
+    const vector<SymbolKey>& courseKeys = assessmentColumns.courseKeys();
+    const vector<double>& grades = assessmentColumns.grades();
+    assessmentColumns.forEachRowWhere(
+        [&](size_t row) { return courseKeys[row] < courseBest.size(); },
+        [&](size_t row) { courseBest[courseKeys[row]].add(grades[row]); });
+    
+    cout << fixed << setprecision(1);
+    cout << "\nCourse benchmarks (mean of the " << bestN << " best assessment grades):\n";
+    cout << std::left << setw(12) << "Course" << setw(30) << "Name" << setw(12) << "Counted"
+         << setw(12) << "Best-N" << "Lowest Counted\n";
+    cout << string(80, '-') << "\n";
+    for (const Course* course : courses) {
+        const BestNAccumulator& best = courseBest[course->getCourseKey()];
+        if (best.size() == 0) continue;
+        cout << setw(12) << course->getCourseId() << setw(30) << course->getCourseName().substr(0, 28)
+             << setw(12) << best.size() << setw(12) << best.grade() << best.lowestKept() << "\n";
+    }
+    
+    // Student standings: every (student, course) group graded in one batch call
+    const StudentScoreGroups groups = assessmentColumns.groupGradesByStudent();
+    vector<double> bestGrades(groups.size());
+    BestNOutOfMCalculator(bestN).calculateGrades(groups.batch(), bestGrades.data());
+    
+    vector<size_t> ranked(groups.size());
+    for (size_t g = 0; g < ranked.size(); ++g) ranked[g] = g;
+    std::stable_sort(ranked.begin(), ranked.end(), [&bestGrades](size_t a, size_t b) {
+        return bestGrades[a] > bestGrades[b];
+    });
+    
+    const size_t shown = std::min<size_t>(ranked.size(), 20);
+    cout << "\nTop student standings (best " << bestN << " per course, against the course grade):\n";
+    cout << setw(8) << "Roll" << setw(24) << "Student" << setw(12) << "Course"
+         << setw(12) << "Best-N" << "Course Grade\n";
+    cout << string(68, '-') << "\n";
+    for (size_t i = 0; i < shown; ++i) {
+        const size_t g = ranked[i];
+        const Student* student = findStudentByRollNumber(groups.rollNumbers[g]);
+        cout << setw(8) << groups.rollNumbers[g]
+             << setw(24) << (student ? student->getFullName().substr(0, 22) : string("(unknown)"))
+             << setw(12) << SymbolTable::courseIds().name(groups.courseKeys[g])
+             << setw(12) << bestGrades[g];
+        if (student) {
+            cout << student->getCourseGrade(groups.courseKeys[g]);
+        }
+        cout << "\n";
+    }
+    cout << std::right;
+    if (shown < ranked.size()) {
+        cout << "... and " << (ranked.size() - shown) << " more\n";
+    }
+    
     pauseForUser();
 }
 
@@ -744,30 +1165,93 @@ void System::loadAllSystemData() {
     try {
         cout << "Loading system data...\n";
         
-        // Clear existing data first
+        // Clear existing data first; the columns go first so the assessments needn't untrack one by one.
+        // Policy assignments are keyed by interned course id and would outlive a course that doesn't reload
+        assessmentColumns.clear();
+        for (const Course* course : courses) {
+            GradingPolicyRegistry::shared().unassign(course->getCourseKey());
+        }
         students.clear();
         courses.clear();
         assessments.clear();
+        studentNameIndex.clear();
+        studentsByRollNumber.clear();
+        reportCache.clear();
+        unsavedChanges = false;   // importCsvData() may set it again
         
-        // Try to load data from CSV files
+        // Try to load data from the storage backend
         try {
-            bool loadSuccess = FileHandler::loadAllData(students, courses, assessments);
+            bool loadSuccess = storage->load(students, courses, assessments);
             if (loadSuccess) {
-                cout << "✓ Data loaded successfully from CSV files.\n";
-            } else {
+                cout << "✓ Data loaded successfully from " << storage->name() << ".\n";
+            } else if (!storage->getLastError().empty()) {
+                cout << "✗ " << storage->getLastError() << "\n";
+                cout << "Starting with empty system.\n";
+            } else if (!importCsvData()) {
                 cout << "Note: No existing data found. Starting with empty system.\n";
             }
-            dataLoaded = true;
             
         } catch (const exception& e) {
             cout << "Error loading data: " << e.what() << "\n";
             cout << "Starting with empty system.\n";
-            dataLoaded = true;
         }
         
     } catch (const exception& e) {
         cout << "Error in loadAllSystemData: " << e.what() << "\n";
-        dataLoaded = true;
+    }
+    
+    // Whatever a failed or partial load left in the arenas, the indexes must describe it
+    rebuildIndexes();
+    dataLoaded = true;
+}
+
+void System::rebuildIndexes() {
+    studentNameIndex.rebuild(students);
+    studentsByRollNumber = FileHandler::indexStudentsByRollNumber(students);
+    assessmentColumns.rebuild(assessments);
+    reportCache.clear();
+}
+
+// A backend other than CSV with nothing stored yet takes over the CSV files under data/ once,
+// so switching POKENO_STORAGE keeps the school's records. False if there was nothing to import
+bool System::importCsvData() {
+    if (dynamic_cast<CsvStorage*>(storage.get()) || !CsvStorage::hasFiles()) {
+        return false;
+    }
+    
+    cout << "No " << storage->name() << " data yet. Importing the CSV files under data/...\n";
+    CsvStorage csv;
+    if (!csv.load(students, courses, assessments)) {
+        cout << "✗ CSV import failed: " << csv.getLastError() << "\n";
+        students.clear();
+        courses.clear();
+        assessments.clear();
+        return false;
+    }
+    
+    if (storage->save(students, courses, assessments)) {
+        cout << "✓ Imported " << students.size() << " students, " << courses.size() << " courses and "
+             << assessments.size() << " assessments into " << storage->name() << ".\n";
+    } else {
+        // The data is still in memory; the next successful save persists it
+        cout << "✗ CSV data imported but not saved to " << storage->name() << ": "
+             << storage->getLastError() << "\n";
+        unsavedChanges = true;
+    }
+    return true;
+}
+
+// Persists one edit at once when the backend stores records individually. Otherwise, or if
+// that fails, the edit waits for the next full save
+void System::recordChange(const function<bool(StorageBackend&)>& change) {
+    if (!storage->storesRecords()) {
+        unsavedChanges = true;
+        return;
+    }
+    if (!change(*storage)) {
+        cout << "✗ Could not save the change to " << storage->name() << ": " << storage->getLastError()
+             << " (it will be saved with the next full save)\n";
+        unsavedChanges = true;
     }
 }
 
@@ -775,7 +1259,14 @@ bool System::saveAllSystemData() {
     try {
         cout << "Saving system data...\n";
         
-        if (FileHandler::saveAllData(students, courses, assessments)) {
+        // Record-level backends already hold every edit; a full save would only re-check them
+        if (storage->storesRecords() && !unsavedChanges) {
+            cout << "✓ All changes were saved as they were made.\n";
+            return true;
+        }
+        
+        if (storage->save(students, courses, assessments)) {
+            unsavedChanges = false;
             cout << "✓ All data saved successfully.\n";
             return true;
         } else {
@@ -791,46 +1282,71 @@ bool System::saveAllSystemData() {
 
 // === PUBLIC INTERFACE IMPLEMENTATIONS ===
 
-bool System::addStudent(shared_ptr<Student> student) {
-    if (!student) return false;
-    if (findStudentByRollNumber(student->getRollNumber())) return false;
-    students.push_back(student);
+bool System::addStudent(const Student& student) {
+    if (findStudentByRollNumber(student.getRollNumber())) return false;
+    Student* stored = students.emplace(student);
+    studentNameIndex.add(*stored);
+    studentsByRollNumber.emplace(stored->getRollNumber(), stored);
+    recordChange([stored](StorageBackend& backend) { return backend.saveStudent(*stored); });
     return true;
 }
 
-bool System::addCourse(shared_ptr<Course> course) {
-    if (!course) return false;
-    if (findCourseById(course->getCourseId())) return false;
-    courses.push_back(course);
+bool System::addCourse(const Course& course) {
+    if (findCourseById(course.getCourseId())) return false;
+    Course* stored = courses.emplace(course);
+    recordChange([stored](StorageBackend& backend) { return backend.saveCourse(*stored); });
     return true;
 }
 
-bool System::addAssessment(shared_ptr<Assessment> assessment) {
-    if (!assessment) return false;
-    if (findAssessmentById(assessment->getAssessmentId())) return false;
-    assessments.push_back(assessment);
+bool System::addAssessment(const Assessment& assessment) {
+    if (findAssessmentById(assessment.getAssessmentId())) return false;
+    Assessment* stored = assessments.emplace(assessment);
+    assessmentColumns.track(stored);
+    
+    // Link to the owning student so Student grade queries see it
+    if (Student* student = findStudentByRollNumber(stored->getStudentRollNumber())) {
+        student->addAssessment(stored);
+    }
+    recordChange([stored](StorageBackend& backend) { return backend.saveAssessment(*stored); });
     return true;
 }
 
-shared_ptr<Student> System::findStudentByRollNumber(int rollNumber) const {
-    auto it = find_if(students.begin(), students.end(),
-        [rollNumber](const shared_ptr<Student>& student) {
-            return student && student->getRollNumber() == rollNumber;
-        });
-    return (it != students.end()) ? *it : nullptr;
+Student* System::findStudentByRollNumber(int rollNumber) const {
+    auto it = studentsByRollNumber.find(rollNumber);
+    return (it != studentsByRollNumber.end()) ? it->second : nullptr;
 }
 
-shared_ptr<Course> System::findCourseById(const string& courseId) const {
+vector<Student*> System::findStudentsByName(const string& query) const {
+    return resolveNameMatches(studentNameIndex.search(query));
+}
+
+vector<Student*> System::findStudentsBySimilarName(const string& query) const {
+    return resolveNameMatches(studentNameIndex.fuzzySearch(query));
+}
+
+vector<Student*> System::resolveNameMatches(const vector<NameMatch>& matches) const {
+    vector<Student*> result;
+    for (const auto& match : matches) {
+        if (auto student = findStudentByRollNumber(match.rollNumber)) {
+            result.push_back(student);
+        }
+    }
+    return result;
+}
+
+Course* System::findCourseById(const string& courseId) const {
+    const SymbolKey courseKey = SymbolTable::courseIds().find(courseId);
+    if (courseKey == SymbolTable::INVALID_KEY) return nullptr;  // Never interned: no such course
     auto it = find_if(courses.begin(), courses.end(),
-        [&courseId](const shared_ptr<Course>& course) {
-            return course && course->getCourseId() == courseId;
+        [courseKey](const Course* course) {
+            return course && course->getCourseKey() == courseKey;
         });
     return (it != courses.end()) ? *it : nullptr;
 }
 
-shared_ptr<Assessment> System::findAssessmentById(const string& assessmentId) const {
+Assessment* System::findAssessmentById(const string& assessmentId) const {
     auto it = find_if(assessments.begin(), assessments.end(),
-        [&assessmentId](const shared_ptr<Assessment>& assessment) {
+        [&assessmentId](const Assessment* assessment) {
             return assessment && assessment->getAssessmentId() == assessmentId;
         });
     return (it != assessments.end()) ? *it : nullptr;
@@ -852,7 +1368,7 @@ size_t System::getEnrollmentCount() const {
     size_t count = 0;
     for (const auto& student : students) {
         if (student) {
-            count += student->getEnrolledCourses().size();
+            count += static_cast<size_t>(student->getEnrollmentCount());
         }
     }
     return count;
@@ -901,7 +1417,10 @@ void System::addNewStudent() {
         
         string dateOfBirth = getValidatedStringInput(
             "Enter Date of Birth (YYYY-MM-DD): ",
-            [](const string& input) { return Common::isValidDateFormat(input) && Common::isValidDate(input); },
+            [](const string& input) {
+                Date parsed;
+                return Date::tryParse(input, parsed) && parsed < Date::today();   // Student's own rule
+            },
             "Error: Date must be in YYYY-MM-DD format and be a valid past date."
         );
         
@@ -932,10 +1451,10 @@ void System::addNewStudent() {
         
         // Create and add the student
         try {
-            auto student = make_shared<Student>(rollNumber, firstName, lastName,
-                                                    dateOfBirth, address,
-                                                    contactEmail, emergencyContact,
-                                                    enrollmentDate);
+            Student student(rollNumber, firstName, lastName,
+                            dateOfBirth, address,
+                            contactEmail, emergencyContact,
+                            enrollmentDate);
             
             if (addStudent(student)) {
                 cout << "\n✓ Student added successfully!\n";
@@ -1050,6 +1569,9 @@ void System::editStudent() {
             }
         }
         
+        studentNameIndex.update(*student);
+        recordChange([student](StorageBackend& backend) { return backend.saveStudent(*student); });
+        
         cout << "\n✓ Student updated successfully!\n";
         cout << "Updated details:\n";
         cout << "  Roll Number: " << student->getRollNumber() << "\n";
@@ -1093,9 +1615,10 @@ void System::deleteStudent() {
         cout << "  Email: " << student->getContactEmail() << "\n";
         
         // Check for enrollments
-        auto enrolledCourses = student->getEnrolledCourses();
-        if (!enrolledCourses.empty()) {
-            cout << "\nWarning: Student is enrolled in " << enrolledCourses.size() << " course(s):\n";
+        auto enrolledCourses = student->getEnrolledCourses();   // View: invalid once the student is erased
+        const size_t enrolledCourseCount = enrolledCourses.size();
+        if (enrolledCourseCount > 0) {
+            cout << "\nWarning: Student is enrolled in " << enrolledCourseCount << " course(s):\n";
             for (const auto& course : enrolledCourses) {
                 if (course) {
                     cout << "  - " << course->getCourseId() << ": " << course->getCourseName() << "\n";
@@ -1104,20 +1627,15 @@ void System::deleteStudent() {
         }
         
         // Check for assessments
-        int assessmentCount = 0;
-        for (const auto& assessment : assessments) {
-            if (assessment && assessment->getStudentRollNumber() == rollNumber) {
-                assessmentCount++;
-            }
-        }
+        const int assessmentCount = static_cast<int>(assessmentColumns.countForStudent(rollNumber));
         if (assessmentCount > 0) {
             cout << "\nWarning: Student has " << assessmentCount << " assessment record(s).\n";
         }
         
         // T046: Enhanced confirmation dialog for destructive operations
         vector<string> warnings;
-        if (!enrolledCourses.empty()) {
-            warnings.push_back("Student is enrolled in " + to_string(enrolledCourses.size()) + " course(s)");
+        if (enrolledCourseCount > 0) {
+            warnings.push_back("Student is enrolled in " + to_string(enrolledCourseCount) + " course(s)");
         }
         if (assessmentCount > 0) {
             warnings.push_back("Student has " + to_string(assessmentCount) + " assessment record(s) that will be deleted");
@@ -1128,30 +1646,19 @@ void System::deleteStudent() {
                               " (Roll #" + to_string(rollNumber) + ")";
         
         if (confirmDestructiveOperation("delete this student", itemDesc, warnings)) {
-            // Note: In this implementation, we'll remove the student but leave enrollment relationships
-            // to be cleaned up by course management separately
+            string studentName = student->getFirstName() + " " + student->getLastName();
             
-            // Remove assessments for this student
-            assessments.erase(remove_if(assessments.begin(), assessments.end(),
-                [rollNumber](const shared_ptr<Assessment>& assessment) {
-                    return assessment && assessment->getStudentRollNumber() == rollNumber;
-                }), assessments.end());
-            
-            // Remove student from the system
-            students.erase(remove_if(students.begin(), students.end(),
-                [rollNumber](const shared_ptr<Student>& s) {
-                    return s && s->getRollNumber() == rollNumber;
-                }), students.end());
+            // Withdraws from courses and removes the student's assessments before freeing the slot
+            eraseStudent(student);
             
             displaySuccessMessage("Student Deletion", 
-                "Student " + student->getFirstName() + " " + student->getLastName() + " has been removed from the system");
+                "Student " + studentName + " has been removed from the system");
             
             if (assessmentCount > 0) {
                 displayInfoMessage(to_string(assessmentCount) + " assessment record(s) were also removed");
             }
-            if (!enrolledCourses.empty()) {
-                displayWarningMessage("Student was removed from " + to_string(enrolledCourses.size()) +
-                    " course(s). Course enrollments should be reviewed separately");
+            if (enrolledCourseCount > 0) {
+                displayInfoMessage("Student was withdrawn from " + to_string(enrolledCourseCount) + " course(s)");
             }
         } else {
             displayInfoMessage("Student deletion was cancelled - no changes made");
@@ -1238,8 +1745,8 @@ void System::addNewCourse() {
         
         // Create and add the course
         try {
-            auto course = make_shared<Course>(courseId, courseName, credits, description,
-                                                 duration, startDate, endDate, maxEnrollment);
+            Course course(courseId, courseName, credits, description,
+                          duration, startDate, endDate, maxEnrollment);
             
             if (addCourse(course)) {
                 cout << "\n✓ Course added successfully!\n";
@@ -1295,6 +1802,7 @@ void System::editCourse() {
         cout << "  Credits: " << course->getCredits() << "\n";
         cout << "  Description: " << course->getDescription() << "\n";
         cout << "  Duration: " << course->getDuration() << " weeks\n";
+        cout << "  Grading Policy: " << course->getGradingPolicyName() << "\n";
         cout << "\nEnter new details (or press Enter to keep current value):\n";
         
         // Edit course name with validation
@@ -1363,6 +1871,25 @@ void System::editCourse() {
             }
         }
         
+        // Edit grading policy; the course's grades are recalculated under the new one
+        cout << "Grading Policy [" << course->getGradingPolicyName() << "] (";
+        const vector<string> policyNames = GradingPolicyRegistry::shared().names();
+        for (size_t i = 0; i < policyNames.size(); ++i) {
+            cout << (i > 0 ? ", " : "") << policyNames[i];
+        }
+        cout << "; Enter to skip): ";
+        input = getStringInput("");
+        if (!input.empty() && input != course->getGradingPolicyName()) {
+            try {
+                applyGradingPolicy(course, input);
+                cout << "✓ Grading policy updated; course grades recalculated.\n";
+            } catch (const exception& e) {
+                cout << "✗ Error updating grading policy: " << e.what() << "\n";
+            }
+        }
+        
+        recordChange([course](StorageBackend& backend) { return backend.saveCourse(*course); });
+        
         cout << "\n✓ Course updated successfully!\n";
         cout << "Updated details:\n";
         cout << "  Course ID: " << course->getCourseId() << "\n";
@@ -1370,6 +1897,7 @@ void System::editCourse() {
         cout << "  Credits: " << course->getCredits() << "\n";
         cout << "  Description: " << course->getDescription() << "\n";
         cout << "  Duration: " << course->getDuration() << " weeks\n";
+        cout << "  Grading Policy: " << course->getGradingPolicyName() << "\n";
         
     } catch (const exception& e) {
         cout << "Error in editCourse: " << e.what() << "\n";
@@ -1400,6 +1928,7 @@ void System::deleteCourse() {
             pauseForUser();
             return;
         }
+        const SymbolKey courseKey = course->getCourseKey();
         
         // Show course details before deletion
         cout << "Course to be deleted:\n";
@@ -1408,9 +1937,10 @@ void System::deleteCourse() {
         cout << "  Credits: " << course->getCredits() << "\n";
         
         // Check for enrolled students
-        auto enrolledStudents = course->getEnrolledStudents();
-        if (!enrolledStudents.empty()) {
-            cout << "\nWarning: Course has " << enrolledStudents.size() << " enrolled student(s):\n";
+        auto enrolledStudents = course->getEnrolledStudents();   // View: invalid once the course is erased
+        const size_t enrolledStudentCount = enrolledStudents.size();
+        if (enrolledStudentCount > 0) {
+            cout << "\nWarning: Course has " << enrolledStudentCount << " enrolled student(s):\n";
             for (const auto& student : enrolledStudents) {
                 if (student) {
                     cout << "  - " << student->getRollNumber() << ": "
@@ -1420,12 +1950,7 @@ void System::deleteCourse() {
         }
         
         // Check for assessments
-        int assessmentCount = 0;
-        for (const auto& assessment : assessments) {
-            if (assessment && assessment->getCourseId() == courseId) {
-                assessmentCount++;
-            }
-        }
+        const int assessmentCount = static_cast<int>(assessmentColumns.countForCourse(courseKey));
         if (assessmentCount > 0) {
             cout << "\nWarning: Course has " << assessmentCount << " assessment record(s).\n";
         }
@@ -1436,27 +1961,15 @@ void System::deleteCourse() {
         getline(cin, confirmation);
         
         if (confirmation == "y" || confirmation == "Y" || confirmation == "yes" || confirmation == "YES") {
-            // Note: In this implementation, we'll remove the course but leave enrollment relationships
-            // to be cleaned up by student management separately
-            
-            // Remove assessments for this course
-            assessments.erase(remove_if(assessments.begin(), assessments.end(),
-                [&courseId](const shared_ptr<Assessment>& assessment) {
-                    return assessment && assessment->getCourseId() == courseId;
-                }), assessments.end());
-            
-            // Remove course from the system
-            courses.erase(remove_if(courses.begin(), courses.end(),
-                [&courseId](const shared_ptr<Course>& c) {
-                    return c && c->getCourseId() == courseId;
-                }), courses.end());
+            // Withdraws enrolled students and removes the course's assessments before freeing the slot
+            eraseCourse(course);
             
             cout << "\n✓ Course deleted successfully!\n";
             if (assessmentCount > 0) {
                 cout << "✓ " << assessmentCount << " assessment record(s) removed.\n";
             }
-            if (!enrolledStudents.empty()) {
-                cout << "Note: Course removed from system. Student enrollments should be updated separately.\n";
+            if (enrolledStudentCount > 0) {
+                cout << "✓ " << enrolledStudentCount << " student(s) withdrawn from the course.\n";
             }
         } else {
             cout << "Deletion cancelled.\n";
@@ -1570,9 +2083,9 @@ void System::addNewAssessment() {
         
         // Create and add the assessment
         try {
-            auto assessment = make_shared<Assessment>(assessmentId, studentRollNumber, courseId,
-                                                         internalMarks, finalMarks, assessmentDate,
-                                                         assessmentType, remarks);
+            Assessment assessment(assessmentId, studentRollNumber, courseId,
+                                  internalMarks, finalMarks, assessmentDate,
+                                  assessmentType, remarks);
             
             if (addAssessment(assessment)) {
                 cout << "\n✓ Assessment added successfully!\n";
@@ -1704,6 +2217,8 @@ void System::editAssessment() {
             }
         }
         
+        recordChange([assessment](StorageBackend& backend) { return backend.saveAssessment(*assessment); });
+        
         cout << "\n✓ Assessment updated successfully!\n";
         cout << "Updated details:\n";
         cout << "  Assessment ID: " << assessment->getAssessmentId() << "\n";
@@ -1774,11 +2289,8 @@ void System::deleteAssessment() {
         
         string normalizedConfirmation = Common::normalizeText(confirmation);
         if (normalizedConfirmation == "yes" || normalizedConfirmation == "y") {
-            // Remove assessment from the system
-            assessments.erase(remove_if(assessments.begin(), assessments.end(),
-                [&assessmentId](const shared_ptr<Assessment>& a) {
-                    return a && a->getAssessmentId() == assessmentId;
-                }), assessments.end());
+            // Remove assessment from the system (and from its student's list)
+            eraseAssessment(assessment);
             
             cout << "\n✓ Assessment deleted successfully!\n";
         } else {
@@ -1837,18 +2349,10 @@ void System::enrollStudentInCourse() {
             pauseForUser();
             return;
         }
+        const SymbolKey courseKey = course->getCourseKey();
         
         // Check if student is already enrolled in the course
-        auto enrolledCourses = student->getEnrolledCourses();
-        bool alreadyEnrolled = false;
-        for (const auto& enrolledCourse : enrolledCourses) {
-            if (enrolledCourse && enrolledCourse->getCourseId() == courseId) {
-                alreadyEnrolled = true;
-                break;
-            }
-        }
-        
-        if (alreadyEnrolled) {
+        if (student->isEnrolledInCourse(courseKey)) {
             cout << "Error: Student " << student->getFirstName() << " " << student->getLastName()
                       << " is already enrolled in course " << course->getCourseName() << ".\n";
             pauseForUser();
@@ -1856,8 +2360,8 @@ void System::enrollStudentInCourse() {
         }
         
         // Check course enrollment limit
-        auto enrolledStudents = course->getEnrolledStudents();
-        if (enrolledStudents.size() >= static_cast<size_t>(course->getMaxEnrollment())) {
+        const size_t currentEnrollment = course->getEnrolledStudents().size();
+        if (currentEnrollment >= static_cast<size_t>(course->getMaxEnrollment())) {
             cout << "Error: Course " << course->getCourseName() << " has reached its enrollment limit of "
                       << course->getMaxEnrollment() << " students.\n";
             pauseForUser();
@@ -1870,7 +2374,7 @@ void System::enrollStudentInCourse() {
                   << " (Roll: " << studentRollNumber << ")\n";
         cout << "  Course: " << course->getCourseName() << " (ID: " << courseId << ")\n";
         cout << "  Credits: " << course->getCredits() << "\n";
-        cout << "  Current Enrollment: " << enrolledStudents.size() << "/" << course->getMaxEnrollment() << "\n";
+        cout << "  Current Enrollment: " << currentEnrollment << "/" << course->getMaxEnrollment() << "\n";
         
         // Confirm enrollment with validation
         string confirmation = getValidatedStringInput(
@@ -1890,15 +2394,21 @@ void System::enrollStudentInCourse() {
             try {
                 // Add course to student's enrolled courses
                 student->enrollInCourse(course);
-                // Add student to course's enrolled students
-                course->enrollStudent(student);
+                // Add student to course's enrolled students (undo the first half if refused)
+                try {
+                    course->enrollStudent(student);
+                } catch (const exception&) {
+                    student->detachCourse(course);
+                    throw;
+                }
+                recordChange([student](StorageBackend& backend) { return backend.saveStudent(*student); });
                 
                 enrollmentSuccess = true;
                 
                 cout << "\n✓ Enrollment successful!\n";
                 cout << "Student " << student->getFirstName() << " " << student->getLastName()
                           << " has been enrolled in " << course->getCourseName() << ".\n";
-                cout << "New enrollment count: " << (enrolledStudents.size() + 1) << "/"
+                cout << "New enrollment count: " << (currentEnrollment + 1) << "/"
                           << course->getMaxEnrollment() << "\n";
                 
             } catch (const exception& e) {
@@ -1979,11 +2489,12 @@ void System::withdrawStudentFromCourse() {
             pauseForUser();
             return;
         }
+        const SymbolKey courseKey = course->getCourseKey();
         
         // Check if student is enrolled in the course
         bool isEnrolled = false;
         for (const auto& enrolledCourse : enrolledCourses) {
-            if (enrolledCourse && enrolledCourse->getCourseId() == courseId) {
+            if (enrolledCourse && enrolledCourse->getCourseKey() == courseKey) {
                 isEnrolled = true;
                 break;
             }
@@ -1997,13 +2508,7 @@ void System::withdrawStudentFromCourse() {
         }
         
         // Check for existing assessments
-        int assessmentCount = 0;
-        for (const auto& assessment : assessments) {
-            if (assessment && assessment->getStudentRollNumber() == studentRollNumber && 
-                assessment->getCourseId() == courseId) {
-                assessmentCount++;
-            }
-        }
+        const int assessmentCount = static_cast<int>(assessmentColumns.countFor(studentRollNumber, courseKey));
         
         // Show withdrawal details for confirmation
         cout << "\nWithdrawal Details:\n";
@@ -2034,6 +2539,7 @@ void System::withdrawStudentFromCourse() {
                 student->withdrawFromCourse(courseId);
                 // Remove student from course's enrolled students
                 course->withdrawStudent(studentRollNumber);
+                recordChange([student](StorageBackend& backend) { return backend.saveStudent(*student); });
                 
                 cout << "\n✓ Withdrawal successful!\n";
                 cout << "Student " << student->getFirstName() << " " << student->getLastName()
@@ -2110,7 +2616,7 @@ void System::viewStudentEnrollments() const {
                     double totalMarks = 0.0;
                     for (const auto& assessment : assessments) {
                         if (assessment && assessment->getStudentRollNumber() == studentRollNumber && 
-                            assessment->getCourseId() == course->getCourseId()) {
+                            assessment->getCourseKey() == course->getCourseKey()) {
                             assessmentCount++;
                             totalMarks += (assessment->getInternalMarks() + assessment->getFinalMarks()) / 2.0;
                         }
@@ -2186,105 +2692,9 @@ void System::viewCourseEnrollments() const {
             pauseForUser();
             return;
         }
-        
-        cout << "\nCourse Information:\n";
-        cout << "  Course ID: " << course->getCourseId() << "\n";
-        cout << "  Name: " << course->getCourseName() << "\n";
-        cout << "  Credits: " << course->getCredits() << "\n";
-        cout << "  Description: " << course->getDescription() << "\n";
-        cout << "  Duration: " << course->getDuration() << " weeks\n";
-        
-        auto enrolledStudents = course->getEnrolledStudents();
-        
-        cout << "\nEnrollment Status: " << enrolledStudents.size() << "/"
-                  << course->getMaxEnrollment() << " students\n";
-        
-        if (enrolledStudents.empty()) {
-            cout << "\nNo students are currently enrolled in this course.\n";
-        } else {
-            cout << "\nEnrolled Students (" << enrolledStudents.size() << "):\n";
-            cout << string(80, '-') << "\n";
-            
-            for (size_t i = 0; i < enrolledStudents.size(); ++i) {
-                if (enrolledStudents[i]) {
-                    auto student = enrolledStudents[i];
-                    cout << (i + 1) << ". Roll Number: " << student->getRollNumber() << "\n";
-                    cout << "   Name: " << student->getFirstName() << " " << student->getLastName() << "\n";
-                    cout << "   Email: " << student->getContactEmail() << "\n";
-                    
-                    // Check for assessments for this student in this course
-                    int assessmentCount = 0;
-                    double totalMarks = 0.0;
-                    string latestAssessment = "None";
-                    
-                    for (const auto& assessment : assessments) {
-                        if (assessment && assessment->getStudentRollNumber() == student->getRollNumber() && 
-                            assessment->getCourseId() == courseId) {
-                            assessmentCount++;
-                            totalMarks += (assessment->getInternalMarks() + assessment->getFinalMarks()) / 2.0;
-                            latestAssessment = assessment->getAssessmentDate();
-                        }
-                    }
-                    
-                    if (assessmentCount > 0) {
-                        cout << "   Assessments: " << assessmentCount
-                                  << " (Avg: " << fixed << setprecision(1)
-                                  << (totalMarks / assessmentCount) << "%)\n";
-                        cout << "   Latest Assessment: " << latestAssessment << "\n";
-                    } else {
-                        cout << "   Assessments: None\n";
-                    }
-                    
-                    cout << string(80, '-') << "\n";
-                }
-            }
-            
-            // Calculate course statistics
-            int totalAssessments = 0;
-            double courseAverage = 0.0;
-            double highestAverage = 0.0;
-            double lowestAverage = 100.0;
-            
-            for (const auto& student : enrolledStudents) {
-                if (student) {
-                    int studentAssessments = 0;
-                    double studentTotal = 0.0;
-                    
-                    for (const auto& assessment : assessments) {
-                        if (assessment && assessment->getStudentRollNumber() == student->getRollNumber() && 
-                            assessment->getCourseId() == courseId) {
-                            studentAssessments++;
-                            studentTotal += (assessment->getInternalMarks() + assessment->getFinalMarks()) / 2.0;
-                        }
-                    }
-                    
-                    if (studentAssessments > 0) {
-                        double studentAverage = studentTotal / studentAssessments;
-                        courseAverage += studentAverage;
-                        totalAssessments++;
-                        
-                        if (studentAverage > highestAverage) {
-                            highestAverage = studentAverage;
-                        }
-                        if (studentAverage < lowestAverage) {
-                            lowestAverage = studentAverage;
-                        }
-                    }
-                }
-            }
-            
-            cout << "\nCourse Statistics:\n";
-            cout << "  Enrollment Rate: " << fixed << setprecision(1)
-                      << (static_cast<double>(enrolledStudents.size()) / course->getMaxEnrollment() * 100) << "%\n";
-            
-            if (totalAssessments > 0) {
-                cout << "  Students with Assessments: " << totalAssessments << "/" << enrolledStudents.size() << "\n";
-                cout << "  Course Average: " << fixed << setprecision(1)
-                          << (courseAverage / totalAssessments) << "%\n";
-                cout << "  Highest Average: " << fixed << setprecision(1) << highestAverage << "%\n";
-                cout << "  Lowest Average: " << fixed << setprecision(1) << lowestAverage << "%\n";
-            }
-        }
+        // Rebuilt only when the course, its roster, or an enrolled student's details or marks change
+        cout << reportCache.get("course-enrollments:" + course->getCourseId(), {course->getVersion()},
+                                [this, course]() { return buildCourseEnrollmentView(course); });
         
     } catch (const exception& e) {
         cout << "Error in viewCourseEnrollments: " << e.what() << "\n";
@@ -2293,6 +2703,77 @@ void System::viewCourseEnrollments() const {
     pauseForUser();
 }
 
+string System::buildCourseEnrollmentView(const Course* course) const {
+    stringstream view;
+    const SymbolKey courseKey = course->getCourseKey();
+    
+    view << "\nCourse Information:\n";
+    view << "  Course ID: " << course->getCourseId() << "\n";
+    view << "  Name: " << course->getCourseName() << "\n";
+    view << "  Credits: " << course->getCredits() << "\n";
+    view << "  Description: " << course->getDescription() << "\n";
+    view << "  Duration: " << course->getDuration() << " weeks\n";
+    view << "  Grading Policy: " << course->getGradingPolicyName() << "\n";
+    
+    auto enrolledStudents = course->getEnrolledStudents();
+    
+    view << "\nEnrollment Status: " << enrolledStudents.size() << "/"
+         << course->getMaxEnrollment() << " students\n";
+    
+    if (enrolledStudents.empty()) {
+        view << "\nNo students are currently enrolled in this course.\n";
+        return view.str();
+    }
+    
+    view << "\nEnrolled Students (" << enrolledStudents.size() << "):\n";
+    view << string(80, '-') << "\n";
+    
+    // Grades come from the students' and the course's running totals
+    int studentsWithAssessments = 0;
+    
+    for (size_t i = 0; i < enrolledStudents.size(); ++i) {
+        const Student* student = enrolledStudents[i];
+        if (!student) continue;
+        
+        view << (i + 1) << ". Roll Number: " << student->getRollNumber() << "\n";
+        view << "   Name: " << student->getFirstName() << " " << student->getLastName() << "\n";
+        view << "   Email: " << student->getContactEmail() << "\n";
+        
+        const GradeAggregate grades = student->getCourseGradeSummary(courseKey);
+        if (grades.count > 0) {
+            Date latestAssessment;
+            student->forEachAssessmentInCourse(courseKey, [&](const Assessment* assessment) {
+                latestAssessment = std::max(latestAssessment, assessment->getAssessmentDate());
+            });
+            view << "   Assessments: " << grades.count
+                 << " (Avg: " << fixed << setprecision(1) << grades.mean() << "%, range "
+                 << grades.minGrade << "-" << grades.maxGrade << "%)\n";
+            view << "   Latest Assessment: " << latestAssessment << "\n";
+            studentsWithAssessments++;
+        } else {
+            view << "   Assessments: None\n";
+        }
+        
+        view << string(80, '-') << "\n";
+    }
+    
+    view << "\nCourse Statistics:\n";
+    view << "  Enrollment Rate: " << fixed << setprecision(1)
+         << (static_cast<double>(enrolledStudents.size()) / course->getMaxEnrollment() * 100) << "%\n";
+    
+    if (studentsWithAssessments > 0) {
+        // Over every enrolled student's course grade; a student without marks counts as 0
+        const GradeAggregate summary = course->getGradeSummary();
+        view << "  Students with Assessments: " << studentsWithAssessments << "/" << enrolledStudents.size() << "\n";
+        view << "  Course Average: " << fixed << setprecision(1) << course->getCourseAverageGrade() << "%\n";
+        view << "  Highest Course Grade: " << fixed << setprecision(1) << summary.maxGrade << "%\n";
+        view << "  Lowest Course Grade: " << fixed << setprecision(1) << summary.minGrade << "%\n";
+        view << "  Passing: " << summary.passCount << "   Failing: " << summary.failCount << "\n";
+    }
+    
+    return view.str();
+}
+
 void System::backupSystemData() {
     cout << "Backup functionality will be implemented in full version.\n";
     pauseForUser();
@@ -2332,70 +2813,161 @@ bool System::isValidCourseId(const string& courseId) const {
     return !courseId.empty() && courseId.length() <= 10;
 }
 
-vector<shared_ptr<Student>> System::getStudentsInCourse(const string& courseId) const {
+View<Student> System::getStudentsInCourse(const string& courseId) const {
     auto course = findCourseById(courseId);
-    return course ? course->getEnrolledStudents() : vector<shared_ptr<Student>>();
+    return course ? course->getEnrolledStudents() : View<Student>();
 }
 
-vector<shared_ptr<Course>> System::getCoursesForStudent(int rollNumber) const {
+View<Course> System::getCoursesForStudent(int rollNumber) const {
     auto student = findStudentByRollNumber(rollNumber);
-    return student ? student->getEnrolledCourses() : vector<shared_ptr<Course>>();
+    return student ? student->getEnrolledCourses() : View<Course>();
 }
 
-vector<shared_ptr<Assessment>> System::getAssessmentsForStudent(int rollNumber) const {
-    vector<shared_ptr<Assessment>> result;
-    for (const auto& assessment : assessments) {
-        if (assessment && assessment->getStudentRollNumber() == rollNumber) {
-            result.push_back(assessment);
-        }
+// Roll numbers in ascending order
+static vector<int> toRollNumbers(const EnrollmentBitmap& rollNumberSet) {
+    vector<int> rollNumbers;
+    rollNumbers.reserve(rollNumberSet.size());
+    rollNumberSet.forEach([&rollNumbers](uint32_t rollNumber) {
+        rollNumbers.push_back(static_cast<int>(rollNumber));
+    });
+    return rollNumbers;
+}
+
+vector<int> System::getStudentsInBothCourses(const string& firstCourseId, const string& secondCourseId) const {
+    auto first = findCourseById(firstCourseId);
+    auto second = findCourseById(secondCourseId);
+    if (!first || !second) {
+        return {};
     }
-    return result;
+    return toRollNumbers(EnrollmentBitmap::intersect(first->getEnrolledRollNumberSet(),
+                                                     second->getEnrolledRollNumberSet()));
 }
 
-vector<shared_ptr<Assessment>> System::getAssessmentsForCourse(const string& courseId) const {
-    vector<shared_ptr<Assessment>> result;
-    for (const auto& assessment : assessments) {
-        if (assessment && assessment->getCourseId() == courseId) {
-            result.push_back(assessment);
-        }
+vector<int> System::getStudentsInEitherCourse(const string& firstCourseId, const string& secondCourseId) const {
+    auto first = findCourseById(firstCourseId);
+    auto second = findCourseById(secondCourseId);
+    if (!first && !second) {
+        return {};
     }
-    return result;
+    if (!first || !second) {
+        return toRollNumbers((first ? first : second)->getEnrolledRollNumberSet());
+    }
+    return toRollNumbers(EnrollmentBitmap::unite(first->getEnrolledRollNumberSet(),
+                                                 second->getEnrolledRollNumberSet()));
 }
 
-bool System::removeStudent(int rollNumber) {
-    auto it = find_if(students.begin(), students.end(),
-        [rollNumber](const shared_ptr<Student>& student) {
-            return student && student->getRollNumber() == rollNumber;
+vector<string> System::getSharedCourses(int firstRollNumber, int secondRollNumber) const {
+    vector<string> courseIds;
+    auto first = findStudentByRollNumber(firstRollNumber);
+    auto second = findStudentByRollNumber(secondRollNumber);
+    if (!first || !second) {
+        return courseIds;
+    }
+    EnrollmentBitmap::intersect(first->getEnrolledCourseKeys(), second->getEnrolledCourseKeys())
+        .forEach([&courseIds](uint32_t courseKey) {
+            courseIds.push_back(SymbolTable::courseIds().name(courseKey));
         });
-    if (it != students.end()) {
-        students.erase(it);
-        return true;
+    return courseIds;
+}
+
+size_t System::countSharedCourses(int firstRollNumber, int secondRollNumber) const {
+    auto first = findStudentByRollNumber(firstRollNumber);
+    auto second = findStudentByRollNumber(secondRollNumber);
+    if (!first || !second) {
+        return 0;
     }
-    return false;
+    return EnrollmentBitmap::intersectionCount(first->getEnrolledCourseKeys(), second->getEnrolledCourseKeys());
+}
+
+vector<Assessment*> System::getAssessmentsForStudent(int rollNumber) const {
+    return assessmentColumns.selectForStudent(rollNumber);
+}
+
+vector<Assessment*> System::getAssessmentsForCourse(const string& courseId) const {
+    return assessmentColumns.selectForCourse(SymbolTable::courseIds().find(courseId));
+}
+
+bool System::removeStudent(int rollNumber) {
+    Student* student = findStudentByRollNumber(rollNumber);
+    if (!student) return false;
+    eraseStudent(student);
+    return true;
 }
 
 bool System::removeCourse(const string& courseId) {
-    auto it = find_if(courses.begin(), courses.end(),
-        [&courseId](const shared_ptr<Course>& course) {
-            return course && course->getCourseId() == courseId;
-        });
-    if (it != courses.end()) {
-        courses.erase(it);
-        return true;
-    }
-    return false;
+    Course* course = findCourseById(courseId);
+    if (!course) return false;
+    eraseCourse(course);
+    return true;
 }
 
 bool System::removeAssessment(const string& assessmentId) {
-    auto it = find_if(assessments.begin(), assessments.end(),
-        [&assessmentId](const shared_ptr<Assessment>& assessment) {
-            return assessment && assessment->getAssessmentId() == assessmentId;
-        });
-    if (it != assessments.end()) {
-        assessments.erase(it);
-        return true;
+    Assessment* assessment = findAssessmentById(assessmentId);
+    if (!assessment) return false;
+    eraseAssessment(assessment);
+    return true;
+}
+
+// Arena slots are reused, so every link to an entity is removed before its slot is freed
+
+void System::eraseStudent(Student* student) {
+    const int rollNumber = student->getRollNumber();
+    // Scan every course rather than trusting the back-links: a one-sided link must not dangle
+    for (Course* course : courses) {
+        course->detachStudent(student);
+    }
+    assessments.eraseIf([rollNumber](const Assessment* assessment) {
+        return assessment->getStudentRollNumber() == rollNumber;
+    });
+    studentNameIndex.remove(rollNumber);
+    studentsByRollNumber.erase(rollNumber);
+    students.erase(student);
+    recordChange([rollNumber](StorageBackend& backend) { return backend.removeStudent(rollNumber); });
+}
+
+void System::eraseCourse(Course* course) {
+    const SymbolKey courseKey = course->getCourseKey();
+    const string courseId = course->getCourseId();
+    vector<Student*> withdrawn;   // Their stored enrollments still name the course
+    for (Student* student : students) {
+        if (student->isEnrolledInCourse(courseKey)) withdrawn.push_back(student);
+        student->detachCourse(course);
+    }
+    for (Assessment* assessment : assessments) {
+        if (assessment->getCourseKey() == courseKey) {
+            unlinkAssessment(assessment);  // Safe mid-iteration: erase only empties the slot
+        }
+    }
+    courses.erase(course);
+    GradingPolicyRegistry::shared().unassign(courseKey);   // A new course with this ID starts on the default
+    recordChange([&courseId](StorageBackend& backend) { return backend.removeCourse(courseId); });
+    for (Student* student : withdrawn) {
+        recordChange([student](StorageBackend& backend) { return backend.saveStudent(*student); });
+    }
+}
+
+void System::eraseAssessment(Assessment* assessment) {
+    const string assessmentId = assessment->getAssessmentId();
+    unlinkAssessment(assessment);
+    recordChange([&assessmentId](StorageBackend& backend) { return backend.removeAssessment(assessmentId); });
+}
+
+// Assigns the policy, then re-grades every assessment in the course under it and refreshes the
+// course totals. Throws invalid_argument for an unknown policy before anything changes
+void System::applyGradingPolicy(Course* course, const string& policyName) {
+    course->setGradingPolicy(policyName);
+    const CourseGradingPolicy& policy = course->getGradingPolicy();
+    assessmentColumns.regrade(course->getCourseKey(), policy.internalWeight(), policy.finalWeight());
+    // Selection rules (drop-lowest, best-N) move course grades even where no assessment grade moved
+    course->recalculateGradeTotals();
+}
+
+// Drops the assessment from memory only; callers persist the removal
+void System::unlinkAssessment(Assessment* assessment) {
+    if (Student* student = findStudentByRollNumber(assessment->getStudentRollNumber())) {
+        student->detachAssessment(assessment);
     }
-    return false;
+    assessments.erase(assessment);
 }
 
 bool System::loadData() {
@@ -2408,7 +2980,7 @@ bool System::saveData() {
 }
 
 bool System::createBackup() {
-    return FileHandler::backupDataFiles();
+    return storage->backup();
 }
 
 bool System::enrollStudent(int rollNumber, const string& courseId) {
@@ -2419,9 +2991,15 @@ bool System::enrollStudent(int rollNumber, const string& courseId) {
     
     try {
         student->enrollInCourse(course);
+    } catch (const exception&) {
+        return false;
+    }
+    try {
         course->enrollStudent(student);
+        recordChange([student](StorageBackend& backend) { return backend.saveStudent(*student); });
         return true;
     } catch (const exception&) {
+        student->detachCourse(course);  // Keep the link two-sided or absent
         return false;
     }
 }
@@ -2435,6 +3013,7 @@ bool System::withdrawStudent(int rollNumber, const string& courseId) {
     try {
         student->withdrawFromCourse(courseId);
         course->withdrawStudent(rollNumber);
+        recordChange([student](StorageBackend& backend) { return backend.saveStudent(*student); });
         return true;
     } catch (const exception&) {
         return false;
@@ -5,7 +5,12 @@
 #include "Student.hpp"
 #include "Course.hpp"
 #include "Assessment.hpp"
-#include "FileHandler.hpp"
+#include "AssessmentColumns.hpp"
+#include "StorageBackend.hpp"
+#include "CsvStorage.hpp"
+#include "StudentNameIndex.hpp"
+#include "ReportCache.hpp"
+#include "GradeSimulation.hpp"
 
 USING_STD_SYSTEM
 
@@ -26,13 +31,25 @@ namespace PokenoSouth {
 class System {
 private:
     // === ENTITY MANAGEMENT ===
-    vector<shared_ptr<Student>> students;
-    vector<shared_ptr<Course>> courses;
-    vector<shared_ptr<Assessment>> assessments;
+    AssessmentColumns assessmentColumns;   // Columnar mirror of 'assessments'; declared first so it outlives them
+    EntityArena<Student> students;
+    EntityArena<Course> courses;
+    EntityArena<Assessment> assessments;
+    
+    // === SEARCH INDEXES ===
+    StudentNameIndex studentNameIndex;   // Partial-name search, kept in step with student CRUD
+    unordered_map<int, Student*> studentsByRollNumber;   // O(1) roll number lookups, same lifecycle
+    
+    // === MATERIALIZED REPORTS ===
+    mutable ReportCache reportCache;     // Rebuilt per report only when its dependency versions move
+    
+    // === PERSISTENCE ===
+    unique_ptr<StorageBackend> storage;  // Where load/save/backup go; CSV files unless chosen otherwise
     
     // === SYSTEM STATE ===
     bool isRunning;
     bool dataLoaded;
+    bool unsavedChanges;                 // Edits not yet persisted; only the next save() writes them
     string currentSession;
     
     // === MENU DISPLAY METHODS ===
@@ -83,6 +100,7 @@ private:
     void editCourse();
     void deleteCourse();
     void findCourse() const;
+    void applyGradingPolicy(Course* course, const string& policyName);   // Assign, then re-grade the course
     
     void addNewAssessment();
     void viewAllAssessments() const;
@@ -102,9 +120,22 @@ private:
     void generateGradeReport() const;
     void generateEnrollmentReport() const;
     void generateSystemStatistics() const;
+    void runGradeSimulation() const;
+    void compareEnrollments() const;
+    void generateBestNReport() const;
+    
+    // Report bodies, rendered to text for the report cache
+    string buildStudentReport() const;
+    string buildCourseReport() const;
+    string buildGradeReport() const;
+    string buildEnrollmentReport() const;
+    string buildCourseEnrollmentView(const Course* course) const;
     
     // === DATA MANAGEMENT ===
     void loadAllSystemData();
+    bool importCsvData();
+    void rebuildIndexes();
+    void recordChange(const function<bool(StorageBackend&)>& change);
     bool saveAllSystemData();
     void backupSystemData();
     void validateDataIntegrity();
@@ -118,17 +149,33 @@ private:
     void showOperationResult(bool success, const string& operation) const;
     
     // === SEARCH OPERATIONS ===
-    shared_ptr<Student> findStudentByRollNumber(int rollNumber) const;
-    shared_ptr<Course> findCourseById(const string& courseId) const;
-    shared_ptr<Assessment> findAssessmentById(const string& assessmentId) const;
-    vector<shared_ptr<Student>> getStudentsInCourse(const string& courseId) const;
-    vector<shared_ptr<Course>> getCoursesForStudent(int rollNumber) const;
-    vector<shared_ptr<Assessment>> getAssessmentsForStudent(int rollNumber) const;
-    vector<shared_ptr<Assessment>> getAssessmentsForCourse(const string& courseId) const;
+    Student* findStudentByRollNumber(int rollNumber) const;
+    vector<Student*> findStudentsByName(const string& query) const;
+    vector<Student*> findStudentsBySimilarName(const string& query) const;
+    vector<Student*> resolveNameMatches(const vector<NameMatch>& matches) const;
+    Course* findCourseById(const string& courseId) const;
+    Assessment* findAssessmentById(const string& assessmentId) const;
+    View<Student> getStudentsInCourse(const string& courseId) const;
+    View<Course> getCoursesForStudent(int rollNumber) const;
+    
+    // === ENROLLMENT SET QUERIES (bitmap intersections/unions; sorted results) ===
+    vector<int> getStudentsInBothCourses(const string& firstCourseId, const string& secondCourseId) const;
+    vector<int> getStudentsInEitherCourse(const string& firstCourseId, const string& secondCourseId) const;
+    vector<string> getSharedCourses(int firstRollNumber, int secondRollNumber) const;
+    size_t countSharedCourses(int firstRollNumber, int secondRollNumber) const;
+    vector<Assessment*> getAssessmentsForStudent(int rollNumber) const;
+    vector<Assessment*> getAssessmentsForCourse(const string& courseId) const;
+    
+    // === ENTITY REMOVAL (unlinks relationships, then frees the arena slot) ===
+    void eraseStudent(Student* student);
+    void eraseCourse(Course* course);
+    void eraseAssessment(Assessment* assessment);
+    void unlinkAssessment(Assessment* assessment);
 
 public:
     // === CONSTRUCTOR AND DESTRUCTOR ===
-    System();
+    System();                                            // CSV storage
+    explicit System(unique_ptr<StorageBackend> storage);
     ~System();
     
     // === CORE SYSTEM OPERATIONS ===
@@ -137,9 +184,9 @@ public:
     bool shutdown();
     
     // === ENTITY MANAGEMENT ===
-    bool addStudent(shared_ptr<Student> student);
-    bool addCourse(shared_ptr<Course> course);
-    bool addAssessment(shared_ptr<Assessment> assessment);
+    bool addStudent(const Student& student);      // Copied into the arena
+    bool addCourse(const Course& course);
+    bool addAssessment(const Assessment& assessment);
     bool removeStudent(int rollNumber);
     bool removeCourse(const string& courseId);
     bool removeAssessment(const string& assessmentId);
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace PokenoSouth {
+    /**
+     * TrustedInput for Pokeno South Primary School
+     * Tag that selects an entity's unchecked constructor
+     *
+     * Key Features:
+     * - Only for data this program wrote itself and has since verified unchanged
+     *   (FileHandler's checksummed CSV files); everything else uses the validating constructors
+     * - The unchecked constructors still parse what they must (dates) but skip every
+     *   format, range and business-rule check
+     */
+    struct TrustedInput {
+        explicit TrustedInput() = default;
+    };
+
+    inline constexpr TrustedInput TRUSTED_INPUT{};
+}
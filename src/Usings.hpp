@@ -2,7 +2,7 @@
 #define USINGS_HPP
 
 // #define INCLUDE_COMMON
-#include <regex>
+#include <array>
 #include <cctype>
 #include <iostream>
 #include <chrono>
@@ -24,6 +24,18 @@
 #include <exception>
 #include <algorithm>
 #include <numeric>
+#include <unordered_map>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <unordered_set>
+#include <string_view>
+#include <optional>
+#include <iterator>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+#include <type_traits>
 
 #define USING_STD_ASSESSMENT \
     using std::string; \
@@ -34,7 +46,13 @@
     using std::setprecision; \
     using std::cout; \
     using std::endl; \
-    using std::abs;
+    using std::abs; \
+    using std::vector; \
+    using std::invalid_argument; \
+    using std::runtime_error; \
+    using std::atomic; \
+    using std::memory_order_relaxed; \
+    using std::memcpy;
 
 #define USING_STD_COURSE \
     using std::string; \
@@ -48,11 +66,14 @@
     using std::vector; \
     using std::string; \
     using std::min; \
-    using std::nth_element; \
     using std::greater; \
+    using std::push_heap; \
+    using std::pop_heap; \
+    using std::accumulate;
 
 #define USING_STD_FILEHANDLER \
     using std::string; \
+    using std::unordered_map; \
     using std::stoi; \
     using std::vector; \
     using std::shared_ptr; \
@@ -76,6 +97,9 @@
     using std::to_string; \
     using std::ios; \
     using std::getline; \
+    using std::istringstream; \
+    using std::string_view; \
+    using std::runtime_error; \
     using std::chrono::system_clock; \
     using std::this_thread::sleep_for; \
     using std::chrono::milliseconds; \
@@ -85,6 +109,7 @@
     using std::ostream; \
     using std::string; \
     using std::vector; \
+    using std::pair; \
     using std::shared_ptr; \
     using std::invalid_argument;
 
@@ -106,23 +131,180 @@
     using std::localtime; \
     using std::streamsize; \
     using std::numeric_limits; \
-    using std::transform;
+    using std::transform; \
+    using std::partial_sort; \
+    using std::setw; \
+    using std::find_if; \
+    using std::unique_ptr; \
+    using std::unordered_map;
+
+#define USING_STD_NAMEINDEX \
+    using std::string; \
+    using std::vector; \
+    using std::pair; \
+    using std::shared_ptr; \
+    using std::unordered_map; \
+    using std::lower_bound; \
+    using std::sort;
+
+#define USING_STD_SYMBOLTABLE \
+    using std::string; \
+    using std::string_view; \
+    using std::deque; \
+    using std::unordered_map;
+
+#define USING_STD_ARENA \
+    using std::vector; \
+    using std::deque; \
+    using std::optional;
+
+#define USING_STD_POLICY \
+    using std::vector; \
+    using std::string; \
+    using std::pair; \
+    using std::unordered_map; \
+    using std::unique_ptr; \
+    using std::make_unique; \
+    using std::nth_element; \
+    using std::greater; \
+    using std::min; \
+    using std::sort; \
+    using std::is_same; \
+    using std::invalid_argument;
+
+#define USING_STD_SIMULATION \
+    using std::vector; \
+    using std::thread; \
+    using std::sort; \
+    using std::exception_ptr; \
+    using std::current_exception; \
+    using std::rethrow_exception;
+
+#define USING_STD_COLUMNS \
+    using std::vector; \
+    using std::string;
+
+#define USING_STD_VERSION \
+    using std::atomic; \
+    using std::memory_order_relaxed;
+
+#define USING_STD_REPORTCACHE \
+    using std::string; \
+    using std::vector; \
+    using std::unordered_map;
+
+#define USING_STD_BITMAP \
+    using std::vector; \
+    using std::lower_bound; \
+    using std::min; \
+    using std::set_intersection; \
+    using std::set_union; \
+    using std::back_inserter;
+
+#define USING_STD_DATE \
+    using std::string; \
+    using std::string_view; \
+    using std::ostream; \
+    using std::invalid_argument;
+
+#define USING_STD_CLOCK \
+    using std::atomic; \
+    using std::memory_order_relaxed; \
+    using std::memory_order_acquire; \
+    using std::memory_order_release; \
+    using std::chrono::system_clock; \
+    using std::localtime; \
+    using std::mktime;
+
+#define USING_STD_CHARCLASS \
+    using std::array; \
+    using std::string_view;
+
+#define USING_STD_CRC32C \
+    using std::array; \
+    using std::string_view; \
+    using std::memcpy;
+
+#define USING_STD_BYTECODEC \
+    using std::string; \
+    using std::string_view; \
+    using std::runtime_error; \
+    using std::memcpy;
+
+#define USING_STD_MAPPEDFILE \
+    using std::string; \
+    using std::string_view; \
+    using std::vector; \
+    using std::unordered_map; \
+    using std::runtime_error; \
+    using std::to_string; \
+    using std::fstream; \
+    using std::ifstream; \
+    using std::ostringstream; \
+    using std::ios; \
+    using std::memcpy; \
+    using std::memset;
+
+#define USING_STD_BPLUSTREE \
+    using std::string; \
+    using std::string_view; \
+    using std::to_string; \
+    using std::vector; \
+    using std::list; \
+    using std::pair; \
+    using std::unordered_map; \
+    using std::shared_ptr; \
+    using std::make_shared; \
+    using std::function; \
+    using std::fstream; \
+    using std::ofstream; \
+    using std::ios; \
+    using std::runtime_error; \
+    using std::length_error; \
+    using std::memcpy; \
+    using std::memset; \
+    using std::sort; \
+    using std::lower_bound; \
+    using std::upper_bound;
+
+#define USING_STD_STORAGE \
+    using std::string; \
+    using std::string_view; \
+    using std::vector; \
+    using std::unique_ptr; \
+    using std::make_unique; \
+    using std::unordered_map; \
+    using std::unordered_set; \
+    using std::function; \
+    using std::to_string; \
+    using std::exception; \
+    using std::runtime_error; \
+    using std::invalid_argument; \
+    using std::ifstream; \
+    using std::ofstream; \
+    using std::ostringstream; \
+    using std::ios; \
+    using std::memcpy; \
+    using std::time; \
+    using std::localtime; \
+    using std::put_time;
+
+#define USING_STD_MATCHER \
+    using std::array; \
+    using std::vector; \
+    using std::deque; \
+    using std::string_view; \
+    using std::length_error;
 
 #define USING_STD_COMMON \
     using std::string; \
+    using std::string_view; \
     using std::vector; \
-    using std::regex; \
-    using std::regex_match; \
-    using std::remove; \
-    using std::replace; \
-    using std::all_of; \
-    using std::isalnum; \
+    using std::array; \
     using std::isdigit; \
     using std::stoi; \
     using std::stod; \
-    using std::transform; \
     using std::tolower; \
-    using std::unique; \
     using std::isspace; \
     using std::cout; \
     using std::endl; \
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "common.hpp"
+
+USING_STD_VERSION
+
+namespace PokenoSouth {
+    // Modification stamp; larger means later
+    using Version = uint64_t;
+
+    enum class VersionDomain { Students, Courses, Assessments, Count };
+
+    /**
+     * VersionClock for Pokeno South Primary School
+     * Hands out modification stamps for entities and remembers the latest stamp per entity type
+     *
+     * Key Features:
+     * - One clock shared by all entities, so a recreated entity never repeats a stamp that
+     *   a cache may still hold for its predecessor
+     * - latest(domain) changes whenever any entity of that type changes, giving whole-collection
+     *   reports an O(1) dependency check
+     * - Atomic, so stamping stays well-defined if entities are touched off the main thread
+     */
+    class VersionClock {
+    private:
+        static inline atomic<Version> clock{0};
+        static inline atomic<Version> latestByDomain[static_cast<size_t>(VersionDomain::Count)] = {};
+
+    public:
+        static Version stamp(VersionDomain domain) {
+            const Version version = ++clock;
+            latestByDomain[static_cast<size_t>(domain)].store(version, memory_order_relaxed);
+            return version;
+        }
+
+        static Version latest(VersionDomain domain) {
+            return latestByDomain[static_cast<size_t>(domain)].load(memory_order_relaxed);
+        }
+    };
+}
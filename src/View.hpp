@@ -0,0 +1,36 @@
+#pragma once
+
+#include "common.hpp"
+
+USING_STD_ARENA
+
+namespace PokenoSouth {
+    /**
+     * View for Pokeno South Primary School
+     * Read-only, non-owning window over a relationship list (a contiguous run of T*)
+     *
+     * Key Features:
+     * - Two words (pointer + count); copying a View never copies the list
+     * - Range-for, size(), empty() and indexing, like a std::span<T* const>
+     * - Elements are non-owning entity pointers, as stored by Student and Course
+     *
+     * A View is invalidated by any change to the list it was taken from (enroll, withdraw,
+     * add/remove assessment). Take the size up front when a loop body may modify the list.
+     */
+    template <typename T>
+    class View {
+    private:
+        T* const* first = nullptr;
+        size_t count = 0;
+
+    public:
+        View() = default;
+        View(const vector<T*>& items) : first(items.data()), count(items.size()) {}
+
+        T* const* begin() const { return first; }
+        T* const* end() const { return first + count; }
+        T* operator[](size_t index) const { return first[index]; }
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+    };
+}
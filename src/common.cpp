@@ -1,32 +1,75 @@
 #include "common.hpp"
+#include "Date.hpp"
+#include "PatternMatcher.hpp"
+#include "CharClass.hpp"
+
+using PokenoSouth::Date;
+using PokenoSouth::PatternMatcher;
+using PokenoSouth::CharClass;
 
 namespace Common {
     
+    // Character classes for the hand-written validators, one bit per class, indexed by byte
+    enum : uint8_t {
+        CHAR_DIGIT = 1 << 0,
+        CHAR_ALPHA = 1 << 1,          // ASCII letters only
+        CHAR_EMAIL_LOCAL = 1 << 2,    // [a-zA-Z0-9._%+-]
+        CHAR_EMAIL_DOMAIN = 1 << 3    // [a-zA-Z0-9.-]
+    };
+    
+    static constexpr array<uint8_t, 256> makeCharClasses() {
+        array<uint8_t, 256> classes{};
+        for (int c = '0'; c <= '9'; ++c) classes[c] |= CHAR_DIGIT | CHAR_EMAIL_LOCAL | CHAR_EMAIL_DOMAIN;
+        for (int c = 'a'; c <= 'z'; ++c) classes[c] |= CHAR_ALPHA | CHAR_EMAIL_LOCAL | CHAR_EMAIL_DOMAIN;
+        for (int c = 'A'; c <= 'Z'; ++c) classes[c] |= CHAR_ALPHA | CHAR_EMAIL_LOCAL | CHAR_EMAIL_DOMAIN;
+        for (char c : {'.', '_', '%', '+', '-'}) classes[static_cast<unsigned char>(c)] |= CHAR_EMAIL_LOCAL;
+        for (char c : {'.', '-'}) classes[static_cast<unsigned char>(c)] |= CHAR_EMAIL_DOMAIN;
+        return classes;
+    }
+    static constexpr array<uint8_t, 256> CHAR_CLASSES = makeCharClasses();
+    
+    static bool hasClass(char c, uint8_t charClass) {
+        return (CHAR_CLASSES[static_cast<unsigned char>(c)] & charClass) != 0;
+    }
+    
     /**
-     * Validates email format using regex pattern
+     * Validates email format: ^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}$
+     * Single pass, no backtracking. The top-level domain holds no '.', so it is whatever follows
+     * the domain's last '.'; the match succeeds iff that '.' is not the domain's first character
+     * and at least two letters (and nothing else) follow it.
      */
-    bool isValidEmail(const string& email) {
-        if (email.empty()) return false;
-        
-        const regex emailPattern(
-            R"(^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}$)"
-        );
+    bool isValidEmail(string_view email) {
+        const size_t length = email.size();
+        size_t i = 0;
+        while (i < length && hasClass(email[i], CHAR_EMAIL_LOCAL)) ++i;
+        if (i == 0 || i == length || email[i] != '@') return false;
         
-        return regex_match(email, emailPattern);
+        const size_t domainStart = ++i;
+        size_t lastDot = string::npos;
+        size_t tldLetters = 0;
+        bool tldAlphaOnly = false;
+        for (; i < length; ++i) {
+            const char c = email[i];
+            if (!hasClass(c, CHAR_EMAIL_DOMAIN)) return false;
+            if (c == '.') {
+                lastDot = i;
+                tldLetters = 0;
+                tldAlphaOnly = true;
+            } else if (hasClass(c, CHAR_ALPHA)) {
+                tldLetters++;
+            } else {
+                tldAlphaOnly = false;
+            }
+        }
+        return lastDot != string::npos && lastDot > domainStart && tldAlphaOnly && tldLetters >= 2;
     }
     
     /**
      * Validates date is not in the future
      */
-    bool isDateNotFuture(const string& date) {
-        if (date.empty()) return false;
-        
-        const regex datePattern(R"(^\d{4}-\d{2}-\d{2}$)");
-        if (!regex_match(date, datePattern)) {
-            return false;
-        }
-        
-        return true; // Simplified validation
+    bool isDateNotFuture(string_view date) {
+        Date parsed;
+        return Date::tryParse(date, parsed) && parsed <= Date::today();
     }
     
     /**
@@ -36,18 +79,24 @@ namespace Common {
         return rollNumber > 0 && rollNumber <= 999999; // 6-digit max
     }
     
-    bool isValidName(const string& name) {
+    bool isValidName(string_view name) {
+        static constexpr CharClass NAME_CHARS = CharClass::alnum() | CharClass::of(" '-.");
         if (name.empty() || name.length() > 50) return false;
-        return isValidAlphanumeric(name, " '-.");
+        return NAME_CHARS.containsAll(name);
     }
     
-    bool isValidDateFormat(const string& date) {
-        const regex datePattern(R"(^\d{4}-\d{2}-\d{2}$)");
-        return regex_match(date, datePattern);
+    bool isValidDateFormat(string_view date) {
+        // ^\d{4}-\d{2}-\d{2}$
+        if (date.size() != 10 || date[4] != '-' || date[7] != '-') return false;
+        for (size_t i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+            if (!hasClass(date[i], CHAR_DIGIT)) return false;
+        }
+        return true;
     }
     
-    bool isValidDate(const string& date) {
-        return isValidDateFormat(date); // Simplified
+    bool isValidDate(string_view date) {
+        Date parsed;
+        return Date::tryParse(date, parsed);   // Format plus a real calendar day
     }
     
     // === T036: INPUT SANITIZATION AND VALIDATION HELPERS ===
@@ -55,50 +104,67 @@ namespace Common {
     /**
      * Sanitizes input string by removing/escaping dangerous characters
      */
+    void sanitizeInPlace(string& text) {
+        // Drop NULs and neutralise markup characters in one pass, then trim
+        size_t kept = 0;
+        for (char c : text) {
+            switch (c) {
+                case '\0': continue;
+                case '<': case '>': case '&': c = ' '; break;
+                case '"': c = '\''; break;
+                default: break;
+            }
+            text[kept++] = c;
+        }
+        text.resize(kept);
+        trimInPlace(text);
+    }
+    
     string sanitizeInput(const string& input) {
         string sanitized = input;
-        
-        // Remove null characters
-        sanitized.erase(remove(sanitized.begin(), sanitized.end(), '\0'), sanitized.end());
-        
-        // Replace dangerous characters
-        replace(sanitized.begin(), sanitized.end(), '<', ' ');
-        replace(sanitized.begin(), sanitized.end(), '>', ' ');
-        replace(sanitized.begin(), sanitized.end(), '&', ' ');
-        replace(sanitized.begin(), sanitized.end(), '"', '\'');
-        
-        return trimString(sanitized);
+        sanitizeInPlace(sanitized);
+        return sanitized;
     }
     
     /**
      * Removes leading and trailing whitespace from string
      */
+    static constexpr string_view WHITESPACE = " \t\n\r\f\v";   // What isspace() accepts in the C locale
+    
+    string_view trimView(string_view text) {
+        const size_t start = text.find_first_not_of(WHITESPACE);
+        if (start == string_view::npos) return string_view();
+        const size_t end = text.find_last_not_of(WHITESPACE);
+        return text.substr(start, end - start + 1);
+    }
+    
+    void trimInPlace(string& text) {
+        const size_t end = text.find_last_not_of(WHITESPACE);
+        if (end == string::npos) {
+            text.clear();
+            return;
+        }
+        text.erase(end + 1);
+        text.erase(0, text.find_first_not_of(WHITESPACE));
+    }
+    
     string trimString(const string& str) {
-        if (str.empty()) return str;
-        
-        size_t start = str.find_first_not_of(" \t\n\r\f\v");
-        if (start == string::npos) return "";
-        
-        size_t end = str.find_last_not_of(" \t\n\r\f\v");
-        return str.substr(start, end - start + 1);
+        return string(trimView(str));
     }
     
     /**
      * Validates string contains only alphanumeric characters and specified special chars
      */
-    bool isValidAlphanumeric(const string& input, const string& allowedSpecialChars) {
-        return all_of(input.begin(), input.end(),
-            [&allowedSpecialChars](char c) {
-                return isalnum(c) || allowedSpecialChars.find(c) != string::npos;
-            });
+    bool isValidAlphanumeric(string_view input, string_view allowedSpecialChars) {
+        return (CharClass::alnum() | CharClass::of(allowedSpecialChars)).containsAll(input);
     }
     
     /**
      * Validates and sanitizes numeric input from string
      */
-    bool parseAndValidateInt(const string& input, int& value, int minValue, int maxValue) {
+    bool parseAndValidateInt(string_view input, int& value, int minValue, int maxValue) {
         try {
-            string trimmed = trimString(input);
+            const string_view trimmed = trimView(input);
             if (trimmed.empty()) return false;
             
             // Check if all characters are digits (with optional leading minus)
@@ -111,7 +177,7 @@ namespace Common {
                 if (!isdigit(trimmed[i])) return false;
             }
             
-            value = stoi(trimmed);
+            value = stoi(string(trimmed));
             return value >= minValue && value <= maxValue;
         } catch (...) {
             return false;
@@ -121,12 +187,12 @@ namespace Common {
     /**
      * Validates and sanitizes double input from string
      */
-    bool parseAndValidateDouble(const string& input, double& value, double minValue, double maxValue) {
+    bool parseAndValidateDouble(string_view input, double& value, double minValue, double maxValue) {
         try {
-            string trimmed = trimString(input);
+            const string_view trimmed = trimView(input);
             if (trimmed.empty()) return false;
             
-            value = stod(trimmed);
+            value = stod(string(trimmed));
             return value >= minValue && value <= maxValue;
         } catch (...) {
             return false;
@@ -136,31 +202,38 @@ namespace Common {
     /**
      * Checks if string contains potentially dangerous characters or patterns
      */
-    bool isSafeInput(const string& input) {
+    // Runs 'matcher' over normalizeText(input) without building it: the view is trimmed, and each
+    // whitespace run is fed as its first character. The matcher folds case itself.
+    static bool matchesNormalized(const PatternMatcher& matcher, string_view input) {
+        PatternMatcher::State state = PatternMatcher::START;
+        bool previousSpace = false;
+        for (char c : trimView(input)) {
+            const bool space = isspace(static_cast<unsigned char>(c)) != 0;
+            if (space && previousSpace) continue;
+            previousSpace = space;
+            state = matcher.step(state, c);
+            if (matcher.isMatch(state)) return true;
+        }
+        return false;
+    }
+    
+    bool isSafeInput(string_view input) {
         // Check for null characters
-        if (input.find('\0') != string::npos) return false;
+        if (input.find('\0') != string_view::npos) return false;
         
-        // Check for potentially dangerous patterns
-        const vector<string> dangerousPatterns = {
-            "../", "..\\", "<script", "</script", "javascript:", 
+        // Check for potentially dangerous patterns (case-insensitive)
+        static const PatternMatcher dangerousPatterns({
+            "../", "..\\", "<script", "</script", "javascript:",
             "vbscript:", "onload=", "onerror=", "onclick=",
             "DROP TABLE", "DELETE FROM", "INSERT INTO", "UPDATE SET"
-        };
-        
-        string lowerInput = normalizeText(input);
-        for (const auto& pattern : dangerousPatterns) {
-            if (lowerInput.find(pattern) != string::npos) {
-                return false;
-            }
-        }
-        
-        return true;
+        });
+        return !matchesNormalized(dangerousPatterns, input);
     }
     
     /**
      * Validates string length is within acceptable bounds
      */
-    bool isValidLength(const string& input, size_t minLength, size_t maxLength) {
+    bool isValidLength(string_view input, size_t minLength, size_t maxLength) {
         size_t length = input.length();
         return length >= minLength && length <= maxLength;
     }
@@ -168,117 +241,98 @@ namespace Common {
     /**
      * Escapes special characters in string for safe CSV output
      */
-    string escapeCSVField(const string& input) {
-        if (input.empty()) return input;
-        
-        bool needsEscaping = input.find(',') != string::npos ||
-                           input.find('"') != string::npos ||
-                           input.find('\n') != string::npos ||
-                           input.find('\r') != string::npos;
-        
-        if (!needsEscaping) return input;
-        
-        string escaped = "\"";
+    bool needsCSVEscaping(string_view input) {
+        return input.find_first_of(",\"\n\r") != string_view::npos;
+    }
+    
+    void appendCSVField(string_view input, string& out) {
+        if (!needsCSVEscaping(input)) {
+            out.append(input);
+            return;
+        }
+        out.push_back('"');
         for (char c : input) {
-            if (c == '"') {
-                escaped += "\"\""; // Escape quotes by doubling them
-            } else {
-                escaped += c;
-            }
+            if (c == '"') out.push_back('"');   // Escape quotes by doubling them
+            out.push_back(c);
         }
-        escaped += "\"";
-        
+        out.push_back('"');
+    }
+    
+    string escapeCSVField(const string& input) {
+        if (!needsCSVEscaping(input)) return input;
+        string escaped;
+        escaped.reserve(input.size() + 8);
+        appendCSVField(input, escaped);
         return escaped;
     }
     
     /**
      * Validates phone number format (basic international patterns)
      */
-    bool isValidPhoneNumber(const string& phoneNumber) {
-        if (phoneNumber.empty()) return false;
-
-        // Normalize by removing common separators
-        string normalized;
-        normalized.reserve(phoneNumber.size());
+    bool isValidPhoneNumber(string_view phoneNumber) {
+        // Separators are ignored; what remains must be an optional leading '+' then 7-15 digits
+        size_t digitCount = 0;
+        bool leadingPlus = false;
         for (char c : phoneNumber) {
-            if (isdigit(static_cast<unsigned char>(c)) || c == '+') {
-                normalized.push_back(c);
+            if (isdigit(static_cast<unsigned char>(c))) {
+                digitCount++;
+            } else if (c == '+') {
+                if (leadingPlus || digitCount > 0) return false;   // '+' only at the start
+                leadingPlus = true;
             }
         }
 
-        // Optional leading '+' followed by digits, or just digits
-        size_t start = 0;
-        if (!normalized.empty() && normalized[0] == '+') {
-            start = 1;
-        }
-
-        if (start >= normalized.size()) return false; // '+' only is invalid
-
-        // Ensure remaining are all digits
-        for (size_t i = start; i < normalized.size(); ++i) {
-            if (!isdigit(static_cast<unsigned char>(normalized[i]))) return false;
-        }
-
-        // Count digits (exclude '+') and enforce reasonable length (7-15 digits)
-        size_t digitCount = normalized.size() - start;
-        if (digitCount < 7 || digitCount > 15) return false;
-
         // Allow leading zero for local numbers (NZ etc.)
         // No further country-specific checks
-        return true;
+        return digitCount >= 7 && digitCount <= 15;
     }
     
     /**
      * Normalizes text by converting to lowercase and removing extra whitespace
      */
+    void normalizeTextInto(string_view input, string& out) {
+        out.clear();
+        bool previousSpace = false;
+        for (char c : trimView(input)) {
+            // Collapse each whitespace run to its first character
+            const bool space = isspace(static_cast<unsigned char>(c)) != 0;
+            if (space && previousSpace) continue;
+            previousSpace = space;
+            out.push_back(static_cast<char>(tolower(static_cast<unsigned char>(c))));
+        }
+    }
+    
     string normalizeText(const string& input) {
-        string normalized = trimString(input);
-        transform(normalized.begin(), normalized.end(), normalized.begin(),
-                      [](char c) { return tolower(c); });
-        
-        // Replace multiple whitespace with single space
-        auto end = unique(normalized.begin(), normalized.end(),
-                              [](char a, char b) { return isspace(a) && isspace(b); });
-        normalized.erase(end, normalized.end());
-        
+        string normalized;
+        normalizeTextInto(input, normalized);
         return normalized;
     }
     
     /**
      * Validates text contains only printable ASCII characters
      */
-    bool isPrintableASCII(const string& input) {
-        return all_of(input.begin(), input.end(),
-            [](char c) { return c >= 32 && c <= 126; });
+    bool isPrintableASCII(string_view input) {
+        static constexpr CharClass PRINTABLE = CharClass::printableASCII();
+        return PRINTABLE.containsAll(input);
     }
     
     /**
      * Checks if input matches common SQL injection patterns
      */
-    bool isSafeSQLInput(const string& input) {
-        string lowerInput = normalizeText(input);
-        
-        const vector<string> sqlKeywords = {
+    bool isSafeSQLInput(string_view input) {
+        static const PatternMatcher sqlKeywords({
             "select ", "insert ", "update ", "delete ", "drop ", "create ",
             "alter ", "truncate ", "exec ", "execute ", "union ", "or 1=1",
             "and 1=1", "' or ", "\" or ", "; --", "/*", "*/"
-        };
-        
-        for (const auto& keyword : sqlKeywords) {
-            if (lowerInput.find(keyword) != string::npos) {
-                return false;
-            }
-        }
-        
-        return true;
+        });
+        return !matchesNormalized(sqlKeywords, input);
     }
     
     /**
      * Validates input against a whitelist of allowed characters
      */
-    bool matchesWhitelist(const string& input, const string& whitelist) {
-        return all_of(input.begin(), input.end(),
-            [&whitelist](char c) { return whitelist.find(c) != string::npos; });
+    bool matchesWhitelist(string_view input, string_view whitelist) {
+        return CharClass::of(whitelist).containsAll(input);
     }
     
     // === UTILITY FUNCTIONS ===
@@ -324,11 +378,7 @@ namespace Common {
      * Get current date in YYYY-MM-DD format
      */
     string getCurrentDate() {
-        auto now = system_clock::now();
-        auto time_t = system_clock::to_time_t(now);
-        ostringstream oss;
-        oss << put_time(localtime(&time_t), "%Y-%m-%d");
-        return oss.str();
+        return Date::today().toString();
     }
     
     /**
@@ -8,89 +8,98 @@ USING_STD_COMMON
 namespace Common {
     
     /**
-     * Validates email format using regex pattern
+     * Validates email format (local@domain.tld, hand-written single-pass matcher)
      */
-    bool isValidEmail(const string& email);
+    bool isValidEmail(string_view email);
 
     /**
      * Validates phone number format (basic international patterns)
      */
-    bool isValidPhoneNumber(const string& phoneNumber);
+    bool isValidPhoneNumber(string_view phoneNumber);
 
     /**
      * Validates date is not in the future
      */
-    bool isDateNotFuture(const string& date);
+    bool isDateNotFuture(string_view date);
     
     /**
      * Additional validation functions for Student class compatibility
      */
     bool isValidRollNumber(int rollNumber);
-    bool isValidName(const string& name);
-    bool isValidDateFormat(const string& date);
-    bool isValidDate(const string& date);
+    bool isValidName(string_view name);
+    bool isValidDateFormat(string_view date);
+    bool isValidDate(string_view date);
     
     // === T036: INPUT SANITIZATION AND VALIDATION HELPERS ===
+    // Validators take string_view and never allocate. Transformations come as a view (trimView),
+    // in-place (sanitizeInPlace, trimInPlace) or output-buffer (normalizeTextInto, appendCSVField)
+    // form; the string-returning originals are thin wrappers over them.
     
     /**
      * Sanitizes input string by removing/escaping dangerous characters
      */
+    void sanitizeInPlace(string& text);
     string sanitizeInput(const string& input);
     
     /**
      * Removes leading and trailing whitespace from string
      */
+    string_view trimView(string_view text);   // Views into 'text'
+    void trimInPlace(string& text);
     string trimString(const string& str);
     
     /**
      * Validates string contains only alphanumeric characters and specified special chars
      */
-    bool isValidAlphanumeric(const string& input, const string& allowedSpecialChars = " '-");
+    bool isValidAlphanumeric(string_view input, string_view allowedSpecialChars = " '-");
     
     /**
      * Validates and sanitizes numeric input from string
      */
-    bool parseAndValidateInt(const string& input, int& value, int minValue, int maxValue);
+    bool parseAndValidateInt(string_view input, int& value, int minValue, int maxValue);
     
     /**
      * Validates and sanitizes double input from string
      */
-    bool parseAndValidateDouble(const string& input, double& value, double minValue, double maxValue);
+    bool parseAndValidateDouble(string_view input, double& value, double minValue, double maxValue);
     
     /**
-     * Checks if string contains potentially dangerous characters or patterns
+     * Checks if string contains potentially dangerous characters or patterns (case-insensitive)
      */
-    bool isSafeInput(const string& input);
+    bool isSafeInput(string_view input);
     
     /**
      * Validates string length is within acceptable bounds
      */
-    bool isValidLength(const string& input, size_t minLength, size_t maxLength);
+    bool isValidLength(string_view input, size_t minLength, size_t maxLength);
     
     /**
      * Escapes special characters in string for safe CSV output
      */
+    bool needsCSVEscaping(string_view input);
+    void appendCSVField(string_view input, string& out);   // Appends the escaped field to 'out'
     string escapeCSVField(const string& input);
     
     /**
      * Normalizes text by converting to lowercase and removing extra whitespace
      */
+    void normalizeTextInto(string_view input, string& out);   // Replaces 'out'; reuses its capacity
     string normalizeText(const string& input);
     
     /**
      * Validates text contains only printable ASCII characters
      */
-    bool isPrintableASCII(const string& input);
+    bool isPrintableASCII(string_view input);
     
     /**
      * Checks if input matches common SQL injection patterns
      */
-    bool isSafeSQLInput(const string& input);
+    bool isSafeSQLInput(string_view input);
     
     /**
      * Validates input against a whitelist of allowed characters
      */
-    bool matchesWhitelist(const string& input, const string& whitelist);
+    bool matchesWhitelist(string_view input, string_view whitelist);
     
     // === UTILITY FUNCTIONS ===
     
@@ -7,8 +7,9 @@
 
 int main() {
     try {
-        // Create system controller
-        PokenoSouth::System system;
+        // Create system controller; POKENO_STORAGE picks the backend (csv, snapshot, memory, btree or mapped)
+        const char* storageKind = std::getenv("POKENO_STORAGE");
+        PokenoSouth::System system(PokenoSouth::StorageBackend::create(storageKind ? storageKind : "csv"));
         
         // Run the application
         return system.run();
@@ -0,0 +1,255 @@
+// Randomized model test for BPlusTree: put/erase/get/scan checked against a std::map across
+// commit, rollback, reopen, overflow values and compaction, plus damaged-file handling
+
+#include "TestSupport.hpp"
+#include "BPlusTree.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+
+using PokenoSouth::BPlusTree;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    using Model = std::map<std::string, std::string>;
+
+    const std::string PREFIXES = "abcz";
+
+    std::string randomKey(TestRandom& random) {
+        std::string key(1, random.pick(PREFIXES));
+        for (size_t i = random.below(24); i > 0; --i) key += static_cast<char>('0' + random.below(10));
+        if (random.chance(2)) key.append(400, 'k');   // Long keys split pages sooner
+        return key;
+    }
+
+    std::string randomValue(TestRandom& random) {
+        // One in twenty goes to overflow pages (MAX_INLINE_VALUE is 1 KiB); some span several
+        const size_t length = random.chance(5) ? BPlusTree::MAX_INLINE_VALUE + random.below(10000) : random.below(120);
+        std::string value(length, '\0');
+        for (char& c : value) c = static_cast<char>(random.below(256));
+        return value;
+    }
+
+    void checkMatches(const BPlusTree& tree, const Model& model, const char* when) {
+        const std::string context = std::string(" (") + when + ")";
+        CHECK_MSG(tree.size() == model.size(), "size" + context);
+
+        auto expected = model.begin();
+        bool ordered = true;
+        tree.scan("", [&](std::string_view key, std::string_view value) {
+            if (expected == model.end() || expected->first != key || expected->second != value) {
+                ordered = false;
+                return false;
+            }
+            ++expected;
+            return true;
+        });
+        CHECK_MSG(ordered && expected == model.end(), "full scan" + context);
+
+        std::string value;
+        for (const auto& [key, stored] : model) {
+            if (!tree.get(key, value) || value != stored) {
+                CHECK_MSG(false, "get" + context);
+                break;
+            }
+        }
+
+        for (char prefix : PREFIXES) {
+            const std::string start(1, prefix);
+            std::vector<std::string> want;
+            for (auto it = model.lower_bound(start); it != model.end() && it->first[0] == prefix; ++it) {
+                want.push_back(it->first);
+            }
+            std::vector<std::string> got;
+            tree.scan(start, [&](std::string_view key, std::string_view) {
+                got.emplace_back(key);
+                return true;
+            });
+            CHECK_MSG(got == want, "prefix scan " + start + context);
+        }
+    }
+
+    void randomOperations(BPlusTree& tree, Model& model, TestRandom& random, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const size_t choice = random.below(10);
+            if (choice < 3 && !model.empty()) {
+                auto victim = model.begin();
+                std::advance(victim, static_cast<std::ptrdiff_t>(random.below(model.size())));
+                const std::string key = victim->first;
+                CHECK(tree.erase(key));
+                model.erase(key);
+            } else if (choice < 4) {
+                const std::string key = randomKey(random);
+                CHECK(tree.erase(key) == (model.erase(key) == 1));
+            } else {
+                const std::string key = randomKey(random);
+                const std::string value = randomValue(random);
+                tree.put(key, value);
+                model[key] = value;
+            }
+        }
+    }
+
+    void testModel(const std::string& path) {
+        TestRandom random;
+        Model model;
+        Model committed;
+        auto tree = std::make_unique<BPlusTree>(path, 32);   // Small cache, so pages are re-read
+
+        for (int round = 0; round < 80; ++round) {
+            randomOperations(*tree, model, random, random.below(500));
+            checkMatches(*tree, model, "before commit");
+
+            switch (random.below(10)) {
+            case 0:
+                tree->rollback();
+                model = committed;
+                checkMatches(*tree, model, "after rollback");
+                break;
+            case 1:
+                tree->commit();
+                committed = model;
+                tree.reset();
+                tree = std::make_unique<BPlusTree>(path, 32);
+                checkMatches(*tree, model, "after reopen");
+                break;
+            case 2:
+                tree->compact();
+                committed = model;
+                checkMatches(*tree, model, "after compaction");
+                break;
+            default:
+                tree->commit();
+                committed = model;
+                break;
+            }
+            CHECK(!tree->hasUncommittedChanges());
+
+            if (round == 50) {
+                // Erase nearly everything: leaves empty out and automatic compaction kicks in
+                while (model.size() > 3) {
+                    CHECK(tree->erase(model.begin()->first));
+                    model.erase(model.begin());
+                }
+                tree->commit();
+                committed = model;
+                checkMatches(*tree, model, "after mass erase");
+            }
+        }
+
+        tree->compact();
+        const BPlusTree::Stats stats = tree->getStats();
+        CHECK(stats.filePages - 2 == stats.livePages);   // A compacted file holds only live pages
+        CHECK(stats.entries == model.size());
+        tree.reset();
+
+        BPlusTree reopened(path);
+        checkMatches(reopened, model, "final reopen");
+        CHECK(reopened.getStats().lastCommit == stats.lastCommit);
+    }
+
+    // Newest meta page slot: the one with the higher transaction number (at byte 8 + 8 + 4 of each)
+    std::streamoff newestMetaOffset(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        uint64_t txn[2] = {};
+        for (int slot = 0; slot < 2; ++slot) {
+            file.seekg(slot * static_cast<std::streamoff>(BPlusTree::PAGE_SIZE) + 20);
+            file.read(reinterpret_cast<char*>(&txn[slot]), sizeof(txn[slot]));
+        }
+        return txn[0] > txn[1] ? 0 : static_cast<std::streamoff>(BPlusTree::PAGE_SIZE);
+    }
+
+    void flipByte(const std::string& path, std::streamoff offset) {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(offset);
+        const char original = static_cast<char>(file.get());
+        file.seekp(offset);
+        file.put(static_cast<char>(original ^ 0x5A));
+    }
+
+    void testDamage(const std::string& path) {
+        std::filesystem::remove(path);
+        {
+            BPlusTree tree(path);
+            for (int i = 0; i < 200; ++i) tree.put("key" + std::to_string(i), std::string(50, 'v'));
+            tree.commit();
+            tree.put("torn", "x");
+            tree.commit();
+        }
+
+        // A torn meta page write: the previous commit is what opens
+        flipByte(path, newestMetaOffset(path) + 100);
+        {
+            BPlusTree tree(path);
+            std::string value;
+            CHECK(!tree.get("torn", value));
+            CHECK(tree.get("key7", value) && value == std::string(50, 'v'));
+            CHECK(tree.size() == 200);
+        }
+
+        // Any one damaged page: reads through it throw, and never return wrong data
+        Model expected;
+        for (int i = 0; i < 200; ++i) expected["key" + std::to_string(i)] = std::string(50, 'v');
+        const std::string damagedPath = path + ".damaged";
+        const auto pages = static_cast<std::streamoff>(std::filesystem::file_size(path) / BPlusTree::PAGE_SIZE);
+        size_t detected = 0;
+        for (std::streamoff page = 2; page < pages; ++page) {
+            std::filesystem::copy_file(path, damagedPath, std::filesystem::copy_options::overwrite_existing);
+            flipByte(damagedPath, page * static_cast<std::streamoff>(BPlusTree::PAGE_SIZE) + 50);
+            try {
+                BPlusTree tree(damagedPath);
+                checkMatches(tree, expected, "superseded page damaged");
+            } catch (const std::runtime_error&) {
+                detected++;
+            }
+        }
+        CHECK(detected > 0);
+        std::filesystem::remove(damagedPath);
+
+        // Both meta pages damaged with data behind them: refuses to open
+        flipByte(path, newestMetaOffset(path) == 0 ? static_cast<std::streamoff>(BPlusTree::PAGE_SIZE) + 100 : 100);
+        bool threw = false;
+        try {
+            BPlusTree tree(path);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    void testNeverCommitted(const std::string& path) {
+        // Created, then stopped before the first commit: just the two blank meta pages
+        std::filesystem::remove(path);
+        {
+            std::ofstream file(path, std::ios::binary);
+            const std::string blank(2 * BPlusTree::PAGE_SIZE, '\0');
+            file.write(blank.data(), static_cast<std::streamsize>(blank.size()));
+        }
+        try {
+            BPlusTree tree(path);
+            CHECK(tree.size() == 0);
+            tree.put("first", "commit");
+            tree.commit();
+        } catch (const std::runtime_error& e) {
+            CHECK_MSG(false, std::string("blank file did not open: ") + e.what());
+        }
+        BPlusTree reopened(path);
+        std::string value;
+        CHECK(reopened.get("first", value) && value == "commit");
+    }
+}
+
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "pokeno_bplustree_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    testModel((directory / "model.btree").string());
+    testDamage((directory / "damage.btree").string());
+    testNeverCommitted((directory / "blank.btree").string());
+
+    std::filesystem::remove_all(directory);
+    return finish("BPlusTreeTest");
+}
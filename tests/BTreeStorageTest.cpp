@@ -0,0 +1,167 @@
+// System on the B+tree backend: the CSV files are imported on first start, and every
+// single-entity edit is committed as it happens, without a full save
+
+#include "TestSupport.hpp"
+#include "System.hpp"
+#include "BTreeStorage.hpp"
+#include "CsvStorage.hpp"
+#include "Clock.hpp"
+
+#include <filesystem>
+#include <memory>
+
+using namespace PokenoSouth;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    const char* const RECORDS = "data/records.btree";
+
+    struct Snapshot {
+        EntityArena<Student> students;
+        EntityArena<Course> courses;
+        EntityArena<Assessment> assessments;
+
+        Student* student(int rollNumber) {
+            for (Student* student : students) {
+                if (student->getRollNumber() == rollNumber) return student;
+            }
+            return nullptr;
+        }
+        Course* course(const std::string& courseId) {
+            for (Course* course : courses) {
+                if (course->getCourseId() == courseId) return course;
+            }
+            return nullptr;
+        }
+        size_t assessmentsWith(const std::string& assessmentId) {
+            size_t count = 0;
+            for (Assessment* assessment : assessments) count += assessment->getAssessmentId() == assessmentId;
+            return count;
+        }
+        size_t assessmentsFor(const std::string& courseId) {
+            size_t count = 0;
+            for (Assessment* assessment : assessments) count += assessment->getCourseId() == courseId;
+            return count;
+        }
+    };
+
+    // What a fresh start would load, read straight from the records file
+    std::unique_ptr<Snapshot> stored() {
+        auto snapshot = std::make_unique<Snapshot>();
+        BTreeStorage storage(RECORDS);
+        CHECK_MSG(storage.load(snapshot->students, snapshot->courses, snapshot->assessments), storage.getLastError());
+        return snapshot;
+    }
+
+    uint64_t lastCommit() {
+        BTreeStorage storage(RECORDS);
+        return storage.getStats().lastCommit;
+    }
+}
+
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "pokeno_btree_storage_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::filesystem::copy(POKENO_TEST_DATA_DIR, directory / "data", std::filesystem::copy_options::recursive);
+    std::filesystem::remove(directory / "data" / "records.btree");
+    std::filesystem::current_path(directory);   // CsvStorage reads the fixed data/ paths
+
+    // Pick the entities to edit from the sample data
+    Snapshot csv;
+    CsvStorage csvStorage;
+    CHECK(csvStorage.load(csv.students, csv.courses, csv.assessments));
+    Course* removedCourse = nullptr;   // Has enrolled students and assessments
+    for (Course* course : csv.courses) {
+        if (!course->getEnrolledRollNumbers().empty() && csv.assessmentsFor(course->getCourseId()) > 0) {
+            removedCourse = course;
+            break;
+        }
+    }
+    Student* student = *csv.students.begin();   // The one with the most room for another course
+    for (Student* candidate : csv.students) {
+        if (candidate->getEnrollmentCount() < student->getEnrollmentCount()) student = candidate;
+    }
+    Course* joinedCourse = nullptr;    // One the student is not in yet
+    for (Course* course : csv.courses) {
+        if (course != removedCourse && course->getIsActive() && !student->isEnrolledInCourse(course->getCourseId()) &&
+            static_cast<int>(course->getEnrolledRollNumbers().size()) < course->getMaxEnrollment()) {
+            joinedCourse = course;
+            break;
+        }
+    }
+    std::string removedAssessment;     // A unique ID outside the removed course
+    for (Assessment* assessment : csv.assessments) {
+        if (assessment->getCourseId() != removedCourse->getCourseId() &&
+            csv.assessmentsWith(assessment->getAssessmentId()) == 1) {
+            removedAssessment = assessment->getAssessmentId();
+            break;
+        }
+    }
+    if (!removedCourse || !joinedCourse || removedAssessment.empty()) {
+        CHECK_MSG(false, "sample data lacks the entities this test edits");
+        return finish("BTreeStorageTest");
+    }
+    const std::string removedCourseId = removedCourse->getCourseId();
+    const std::string joinedCourseId = joinedCourse->getCourseId();
+    const int rollNumber = student->getRollNumber();
+
+    // Enrollment windows are checked against today: pin it inside the joined course's window
+    FakeClock clock(joinedCourse->getStartDate());
+    ScopedClock pinned(clock);
+
+    {
+        System system(std::make_unique<BTreeStorage>(RECORDS));
+        CHECK(system.loadData());
+        CHECK(system.getStudentCount() == csv.students.size());   // Imported from the CSV files
+        CHECK(std::filesystem::exists(RECORDS));
+        CHECK(stored()->students.size() == csv.students.size());
+
+        // Each edit is committed on its own
+        uint64_t commits = lastCommit();
+        CHECK(system.enrollStudent(rollNumber, joinedCourseId));
+        CHECK(lastCommit() == commits + 1);
+        CHECK(stored()->student(rollNumber)->isEnrolledInCourse(joinedCourseId));
+
+        CHECK(system.removeAssessment(removedAssessment));
+        CHECK(stored()->assessmentsWith(removedAssessment) == 0);
+
+        CHECK(system.addStudent(Student(990001, "Aroha", "Test", "2014-05-06", "1 Test Rd",
+                                        "aroha.test@pokenosouth.ac.nz", "0211112222", "2024-02-03")));
+        CHECK(stored()->student(990001) != nullptr);
+
+        CHECK(system.removeCourse(removedCourseId));
+        const auto afterRemoval = stored();
+        CHECK(afterRemoval->course(removedCourseId) == nullptr);
+        CHECK(afterRemoval->assessmentsFor(removedCourseId) == 0);
+
+        CHECK(system.withdrawStudent(rollNumber, joinedCourseId));
+        CHECK(!stored()->student(rollNumber)->isEnrolledInCourse(joinedCourseId));
+
+        // Nothing is left for the full save to write
+        commits = lastCommit();
+        CHECK(system.saveData());
+        CHECK(lastCommit() == commits);
+    }
+
+    // The removed course's students were re-saved: re-creating the course brings none of them back
+    {
+        System system(std::make_unique<BTreeStorage>(RECORDS));
+        CHECK(system.loadData());
+        CHECK(system.getStudentCount() == csv.students.size() + 1);   // One added, none removed
+        CHECK(system.getStudentCount() == stored()->students.size());
+        CHECK(system.addCourse(Course(removedCourseId, removedCourse->getCourseName(), removedCourse->getCredits(),
+                                      removedCourse->getDescription(), removedCourse->getDuration())));
+    }
+    const auto reopened = stored();   // The loop below must not range over a temporary's member
+    CHECK(reopened->course(removedCourseId) != nullptr);
+    CHECK(reopened->course(removedCourseId)->getEnrolledRollNumbers().empty());
+    for (Student* reloaded : reopened->students) {
+        CHECK_MSG(!reloaded->isEnrolledInCourse(removedCourseId),
+                  "student " + std::to_string(reloaded->getRollNumber()) + " kept a stale enrollment");
+    }
+
+    std::filesystem::current_path(std::filesystem::temp_directory_path());
+    std::filesystem::remove_all(directory);
+    return finish("BTreeStorageTest");
+}
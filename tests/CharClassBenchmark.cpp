@@ -0,0 +1,60 @@
+// Benchmark: CharClass::findFirstNotIn on each path against the isalnum + find() scan it
+// replaced, over a name-like buffer in which every byte is a member
+
+#include "TestSupport.hpp"
+#include "CharClass.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+using PokenoSouth::CharClass;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    volatile size_t sink = 0;   // Keeps the timed calls from being optimized away
+
+    double gigabytesPerSecond(size_t bytes, double nanoseconds) { return static_cast<double>(bytes) / nanoseconds; }
+}
+
+int main(int argc, char** argv) {
+    // Optional scale factor: CharClassBenchmark 10 runs ten times as many scans
+    const size_t scale = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1;
+    const size_t scans = 20000 * scale;
+
+    const std::string_view allowed = " '-.";
+    const CharClass nameClass = CharClass::alnum() | CharClass::of(allowed);
+    TestRandom random;
+    std::string buffer;
+    const std::string nameBytes = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 '-.";
+    for (int i = 0; i < 5000; ++i) buffer += random.pick(nameBytes);
+
+    const double referenceNs = nanosecondsPerCall(scans, [&](size_t) {
+        const auto it = std::find_if(buffer.begin(), buffer.end(), [allowed](char c) {
+            return !std::isalnum(static_cast<unsigned char>(c)) && allowed.find(c) == std::string_view::npos;
+        });
+        sink = sink + static_cast<size_t>(it - buffer.begin());
+    });
+    std::printf("%-8s %7.2f GB/s\n", "isalnum", gigabytesPerSecond(buffer.size(), referenceNs));
+
+    for (const char* path : {"avx2", "ssse3", "scalar"}) {
+        size_t position = 0;
+        if (!nameClass.findFirstNotInOn(path, buffer, position)) {
+            std::printf("%-8s not supported here\n", path);
+            continue;
+        }
+        CHECK_MSG(position == std::string_view::npos, std::string(path) + " found a non-member in an all-member buffer");
+        const double pathNs = nanosecondsPerCall(scans, [&](size_t) {
+            size_t found = 0;
+            nameClass.findFirstNotInOn(path, buffer, found);
+            sink = sink + found;
+        });
+        std::printf("%-8s %7.2f GB/s | %5.1fx\n", path, gigabytesPerSecond(buffer.size(), pathNs), referenceNs / pathNs);
+        if (std::string_view(path) != "scalar") {
+            CHECK_MSG(pathNs < referenceNs, std::string(path) + " is not faster than isalnum + find");
+        }
+    }
+    std::printf("findFirstNotIn() uses %s here\n", CharClass::simdPath());
+
+    return finish("CharClassBenchmark");
+}
@@ -0,0 +1,133 @@
+// Differential test: CharClass on each of its AVX2, SSSE3 and scalar paths, and the Common
+// validators built on it, against the isalnum + find() checks they replaced
+
+#include "TestSupport.hpp"
+#include "CharClass.hpp"
+#include "common.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+using PokenoSouth::CharClass;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    const char* const PATHS[] = {"avx2", "ssse3", "scalar"};
+
+    // The pre-CharClass checks, one per validator
+    bool referenceIsValidAlphanumeric(std::string_view input, std::string_view allowed) {
+        return std::all_of(input.begin(), input.end(), [allowed](char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || allowed.find(c) != std::string_view::npos;
+        });
+    }
+
+    bool referenceIsPrintableASCII(std::string_view input) {
+        return std::all_of(input.begin(), input.end(), [](char c) { return c >= 32 && c <= 126; });
+    }
+
+    bool referenceMatchesWhitelist(std::string_view input, std::string_view whitelist) {
+        return std::all_of(input.begin(), input.end(),
+                           [whitelist](char c) { return whitelist.find(c) != std::string_view::npos; });
+    }
+
+    // A class as plain membership flags, built alongside the CharClass under test
+    struct Members {
+        bool member[256] = {};
+
+        size_t findFirstNotIn(std::string_view text) const {
+            for (size_t i = 0; i < text.size(); ++i) {
+                if (!member[static_cast<unsigned char>(text[i])]) return i;
+            }
+            return std::string_view::npos;
+        }
+    };
+
+    // Mostly members, so scans run long enough to reach the vector loops and their overlapping tail
+    std::string makeText(TestRandom& random, const std::string& memberBytes) {
+        std::string text;
+        const size_t length = random.below(4) == 0 ? random.below(16) : random.below(200);
+        for (size_t i = 0; i < length; ++i) {
+            text += (memberBytes.empty() || random.chance(2)) ? static_cast<char>(random.below(256))
+                                                              : random.pick(memberBytes);
+        }
+        return text;
+    }
+
+    void checkPaths(const CharClass& charClass, const Members& members, std::string_view text) {
+        const size_t expected = members.findFirstNotIn(text);
+        CHECK(charClass.findFirstNotIn(text) == expected);
+        for (const char* path : PATHS) {
+            size_t position = 0;
+            if (charClass.findFirstNotInOn(path, text, position)) {
+                CHECK_MSG(position == expected, std::string(path) + " path, length " + std::to_string(text.size()));
+            }
+        }
+    }
+
+    void checkRandomClasses(TestRandom& random) {
+        for (int round = 0; round < 2000; ++round) {
+            CharClass charClass;
+            Members members;
+            std::string memberBytes;
+            for (size_t n = random.below(120); n > 0; --n) {
+                const unsigned char c = static_cast<unsigned char>(random.below(256));
+                charClass.add(c);
+                members.member[c] = true;
+                memberBytes += static_cast<char>(c);
+            }
+            for (int t = 0; t < 50; ++t) checkPaths(charClass, members, makeText(random, memberBytes));
+
+            // Every byte value once, at every position of a long run of members
+            if (!memberBytes.empty()) {
+                std::string run(70, memberBytes[0]);
+                for (int value = 0; value < 256; ++value) {
+                    run[static_cast<size_t>(value) % run.size()] = static_cast<char>(value);
+                    checkPaths(charClass, members, run);
+                    run[static_cast<size_t>(value) % run.size()] = memberBytes[0];
+                }
+            }
+        }
+    }
+
+    void checkValidators(TestRandom& random) {
+        const std::string specials = " '-._@,";
+        for (int round = 0; round < 100000; ++round) {
+            std::string allowed;
+            for (size_t n = random.below(4); n > 0; --n) allowed += random.pick(specials);
+            const std::string text = makeText(random, "abcXYZ0189 '-.");
+
+            CHECK(Common::isValidAlphanumeric(text, allowed) == referenceIsValidAlphanumeric(text, allowed));
+            CHECK(Common::matchesWhitelist(text, allowed + "abcXYZ") ==
+                  referenceMatchesWhitelist(text, allowed + "abcXYZ"));
+            CHECK(Common::isPrintableASCII(text) == referenceIsPrintableASCII(text));
+            CHECK(Common::isValidName(text) ==
+                  (!text.empty() && text.size() <= 50 && referenceIsValidAlphanumeric(text, " '-.")));
+        }
+    }
+}
+
+int main() {
+    std::printf("CharClassTest: default path %s; paths run here:", CharClass::simdPath());
+    for (const char* path : PATHS) {
+        size_t position = 0;
+        if (CharClass().findFirstNotInOn(path, "", position)) std::printf(" %s", path);
+    }
+    std::printf("\n");
+
+    // The built-in classes are the C-locale isalnum()/isdigit()/isalpha() sets
+    for (int value = 0; value < 256; ++value) {
+        const char c = static_cast<char>(value);
+        CHECK(CharClass::alnum().contains(c) == (std::isalnum(value) != 0));
+        CHECK(CharClass::digits().contains(c) == (std::isdigit(value) != 0));
+        CHECK(CharClass::letters().contains(c) == (std::isalpha(value) != 0));
+        CHECK(CharClass::printableASCII().contains(c) == (value >= 32 && value <= 126));
+    }
+    size_t position = 0;
+    CHECK(!CharClass().findFirstNotInOn("neon", "abc", position));
+
+    TestRandom random;
+    checkRandomClasses(random);
+    checkValidators(random);
+
+    return finish("CharClassTest");
+}
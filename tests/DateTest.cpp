@@ -0,0 +1,184 @@
+// Date: the day-number conversion against a day-by-day calendar walk, the strict parser, leap
+// years and century boundaries, FakeClock/ScopedClock, and which dates of birth Student accepts
+
+#include "TestSupport.hpp"
+#include "Date.hpp"
+#include "Clock.hpp"
+#include "Student.hpp"
+#include "common.hpp"
+
+#include <stdexcept>
+#include <string>
+
+using namespace PokenoSouth;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    int daysInMonth(int year, int month) {
+        static const int DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return DAYS[month - 1] + (month == 2 && Date::isLeapYear(year) ? 1 : 0);
+    }
+
+    std::string civilText(int year, int month, int day) {
+        char text[16];
+        std::snprintf(text, sizeof text, "%04d-%02d-%02d", year, month, day);
+        return text;
+    }
+
+    void checkCalendarWalk() {
+        // Count days forward from 1970-01-01 and backward to 1600: every date's day number is its
+        // position in the walk, and converts, formats and parses back to itself
+        struct Civil { int year, month, day; };
+        auto checkDay = [](Civil civil, int32_t expected) {
+            const Date date = Date::fromCivil(civil.year, civil.month, civil.day);
+            const std::string text = civilText(civil.year, civil.month, civil.day);
+            CHECK_MSG(date.dayNumber() == expected, text + ": day number " + std::to_string(date.dayNumber()));
+            CHECK_MSG(date.year() == civil.year && date.month() == civil.month && date.day() == civil.day,
+                      text + ": civil fields differ");
+            CHECK_MSG(date.toString() == text && Date::parse(text) == date, text + ": text round trip");
+        };
+
+        Civil civil{1970, 1, 1};
+        for (int32_t dayNumber = 0; civil.year <= 2400; ++dayNumber) {
+            checkDay(civil, dayNumber);
+            if (++civil.day > daysInMonth(civil.year, civil.month)) {
+                civil.day = 1;
+                if (++civil.month > 12) { civil.month = 1; civil.year++; }
+            }
+        }
+        civil = {1969, 12, 31};
+        for (int32_t dayNumber = -1; civil.year >= 1600; --dayNumber) {
+            checkDay(civil, dayNumber);
+            if (--civil.day < 1) {
+                if (--civil.month < 1) { civil.month = 12; civil.year--; }
+                civil.day = daysInMonth(civil.year, civil.month);
+            }
+        }
+
+        // The ends of the four-digit range
+        CHECK(Date::parse("0000-01-01").toString() == "0000-01-01");
+        CHECK(Date::parse("9999-12-31").toString() == "9999-12-31");
+        CHECK(Date::parse("9999-12-31").daysSince(Date::parse("0000-01-01")) == 3652424);
+    }
+
+    void checkLeapYears() {
+        CHECK(Date::isLeapYear(2024) && !Date::isLeapYear(2023));
+        CHECK(!Date::isLeapYear(1900) && !Date::isLeapYear(2100));   // Centuries are not...
+        CHECK(Date::isLeapYear(2000) && Date::isLeapYear(1600));     // ...unless divisible by 400
+
+        Date date;
+        CHECK(!Date::tryParse("1900-02-29", date) && !Date::tryParse("2100-02-29", date));
+        CHECK(Date::tryParse("2000-02-29", date) && date.addDays(1) == Date::parse("2000-03-01"));
+        CHECK(Date::parse("1900-02-28").addDays(1) == Date::parse("1900-03-01"));
+        CHECK(Date::parse("2000-02-28").addDays(1) == Date::parse("2000-02-29"));
+        CHECK(Date::parse("2001-01-01").daysSince(Date::parse("2000-01-01")) == 366);
+        CHECK(Date::parse("1901-01-01").daysSince(Date::parse("1900-01-01")) == 365);
+        CHECK(Date::parse("2000-01-01").dayNumber() == 10957);
+        CHECK(Date::parse("1900-01-01").dayNumber() == -25567);
+        CHECK(Date::parse("1999-12-31").addDays(1) == Date::parse("2000-01-01"));
+
+        // Ages count a year only once the birthday is reached; a 29 February birthday is reached
+        // on 1 March in other years
+        const Date born = Date::parse("2016-02-29");
+        CHECK(born.yearsUntil(Date::parse("2024-02-28")) == 7);
+        CHECK(born.yearsUntil(Date::parse("2024-02-29")) == 8);
+        CHECK(born.yearsUntil(Date::parse("2025-02-28")) == 8);
+        CHECK(born.yearsUntil(Date::parse("2025-03-01")) == 9);
+        CHECK(Date().yearsUntil(born) == 0);
+    }
+
+    void checkParser() {
+        const Date sentinel = Date::parse("2001-02-03");
+        for (const char* text : {"", "2024-02-30", "2023-02-29", "2024-13-01", "2024-00-10", "2024-01-00",
+                                 "2024-04-31", "2024-1-01", "2024-01-1", "2024/01/01", "01-01-2024",
+                                 "15/03/2015", "2024-01-01 ", " 2024-01-01", "2024-01-0a", "+024-01-01",
+                                 "2024-01-010"}) {
+            Date date = sentinel;
+            CHECK_MSG(!Date::tryParse(text, date) && date == sentinel, std::string("accepted \"") + text + "\"");
+            bool threw = false;
+            try { Date::parse(text); } catch (const std::invalid_argument&) { threw = true; }
+            CHECK(threw);
+        }
+        bool threw = false;
+        try { Date::fromCivil(2023, 2, 29); } catch (const std::invalid_argument&) { threw = true; }
+        CHECK(threw);
+
+        // Empty dates: formatted as nothing, before every real date, unmoved by arithmetic
+        const Date empty;
+        CHECK(empty.empty() && empty.toString().empty());
+        CHECK(empty < Date::parse("0000-01-01") && empty.addDays(30).empty());
+    }
+
+    void checkClocks() {
+        const Date wallClock = SystemClock::shared().currentDate();
+        CHECK(Date::today() == wallClock);
+
+        FakeClock term(Date::parse("2025-06-15"));
+        {
+            ScopedClock scoped(term);
+            CHECK(Date::today() == Date::parse("2025-06-15"));
+            term.advanceDays(17);
+            CHECK(Clock::today() == Date::parse("2025-07-02"));
+
+            FakeClock nested(Date::parse("1999-12-31"));
+            {
+                ScopedClock inner(nested);
+                CHECK(Date::today() == Date::parse("1999-12-31"));
+                nested.advanceDays(1);
+                CHECK(Date::today() == Date::parse("2000-01-01"));
+            }
+            CHECK(Date::today() == Date::parse("2025-07-02"));   // The outer clock is back
+            term.set(Date::parse("2024-02-29"));
+            CHECK(Date::today().yearsUntil(Date::parse("2028-02-29")) == 4);
+        }
+        CHECK(Date::today() == SystemClock::shared().currentDate());   // And the system clock after that
+    }
+
+    bool acceptsStudent(const std::string& dateOfBirth, const std::string& enrollmentDate) {
+        try {
+            Student(1, "Test", "Student", dateOfBirth, "1 Main Rd", "family@example.nz", "0210000000", enrollmentDate);
+            return true;
+        } catch (const std::invalid_argument&) {
+            return false;
+        }
+    }
+
+    void checkDateOfBirthRules() {
+        // Student validation now parses the date: it must be a real calendar day strictly before
+        // today, and the enrollment date may not be after today. Before, any "dddd-dd-dd" passed
+        FakeClock clock(Date::parse("2025-06-15"));
+        ScopedClock scoped(clock);
+
+        CHECK(acceptsStudent("2015-06-14", "2025-06-15"));   // Enrolled today
+        CHECK(acceptsStudent("2016-02-29", "2024-02-01"));   // A real leap day
+        CHECK(acceptsStudent("2025-06-14", "2025-06-15"));   // Born yesterday: past is all it asks
+        CHECK(!acceptsStudent("2025-06-15", "2025-06-15"));  // Born today is not in the past
+        CHECK(!acceptsStudent("2025-06-16", "2025-06-15"));
+        CHECK(!acceptsStudent("2015-02-29", "2024-02-01"));  // These four matched the old pattern
+        CHECK(!acceptsStudent("2015-13-01", "2024-02-01"));
+        CHECK(!acceptsStudent("2015-04-31", "2024-02-01"));
+        CHECK(!acceptsStudent("2015-00-00", "2024-02-01"));
+        CHECK(!acceptsStudent("15/03/2015", "2024-02-01"));
+        CHECK(!acceptsStudent("2015-03-15", "2025-06-16"));  // Enrolled tomorrow
+
+        // The shared validators follow the same calendar
+        CHECK(Common::isValidDate("2016-02-29") && !Common::isValidDate("2015-02-29"));
+        CHECK(Common::isDateNotFuture("2025-06-15") && !Common::isDateNotFuture("2025-06-16"));
+        CHECK(Common::isValidDateFormat("2015-02-29"));   // Format only, as documented
+
+        // The same record is accepted or not depending on the clock, never on when it was typed
+        clock.set(Date::parse("2015-06-14"));
+        CHECK(!acceptsStudent("2015-06-14", "2015-06-14"));
+        clock.advanceDays(1);
+        CHECK(acceptsStudent("2015-06-14", "2015-06-15"));
+    }
+}
+
+int main() {
+    checkCalendarWalk();
+    checkLeapYears();
+    checkParser();
+    checkClocks();
+    checkDateOfBirthRules();
+    return finish("DateTest");
+}
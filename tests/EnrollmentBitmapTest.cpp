@@ -0,0 +1,107 @@
+// EnrollmentBitmap against std::set: membership through array <-> bitmap conversions, and
+// intersect/unite/intersectionCount for every pairing of array and bitmap containers
+
+#include "TestSupport.hpp"
+#include "EnrollmentBitmap.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <vector>
+
+using namespace PokenoSouth;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    struct ModelledSet {
+        EnrollmentBitmap bitmap;
+        std::set<uint32_t> model;
+
+        void insert(uint32_t key) { CHECK(bitmap.insert(key) == model.insert(key).second); }
+        void erase(uint32_t key) { CHECK(bitmap.erase(key) == (model.erase(key) == 1)); }
+    };
+
+    std::vector<uint32_t> keysOf(const std::set<uint32_t>& model) {
+        return std::vector<uint32_t>(model.begin(), model.end());
+    }
+
+    void checkMatches(const EnrollmentBitmap& bitmap, const std::set<uint32_t>& model, const std::string& what) {
+        CHECK_MSG(bitmap.size() == model.size(), what + ": size " + std::to_string(bitmap.size()) +
+                                                 ", expected " + std::to_string(model.size()));
+        CHECK_MSG(bitmap.toVector() == keysOf(model), what + ": keys differ");
+        std::vector<uint32_t> visited;
+        bitmap.forEach([&visited](uint32_t key) { visited.push_back(key); });
+        CHECK_MSG(visited == keysOf(model), what + ": forEach order differs");
+    }
+
+    // Dense sets pack many keys into a short range; sparse ones have few keys or a wide range
+    ModelledSet randomSet(TestRandom& random, bool dense) {
+        ModelledSet set;
+        const size_t count = dense ? 64 + random.below(400) : random.below(30);
+        const uint32_t range = dense ? static_cast<uint32_t>(count + count / 2) : 1 + static_cast<uint32_t>(random.below(100000));
+        for (size_t i = 0; i < count; ++i) set.insert(static_cast<uint32_t>(random.below(range)));
+        return set;
+    }
+
+    void checkMembership() {
+        TestRandom random;
+        ModelledSet set;
+        bool sawDense = false, sawSparseAgain = false;
+        for (int step = 0; step < 20000; ++step) {
+            // Grow for a while, then shrink, so the container converts both ways
+            const bool growing = (step / 2500) % 2 == 0;
+            const uint32_t key = static_cast<uint32_t>(random.below(600));
+            if (growing && random.chance(80)) set.insert(key);
+            else set.erase(key);
+            CHECK(set.bitmap.contains(key) == (set.model.count(key) == 1));
+            if (set.bitmap.isDense()) sawDense = true;
+            else if (sawDense) sawSparseAgain = true;
+        }
+        checkMatches(set.bitmap, set.model, "after random inserts and erases");
+        CHECK_MSG(sawDense && sawSparseAgain, "the walk never converted to a bitmap and back");
+
+        for (uint32_t key = 0; key < 700; ++key) {
+            CHECK(set.bitmap.contains(key) == (set.model.count(key) == 1));
+        }
+        set.bitmap.clear();
+        CHECK(set.bitmap.empty() && !set.bitmap.contains(0));
+    }
+
+    void checkSetQueries() {
+        TestRandom random(11);
+        for (int round = 0; round < 400; ++round) {
+            const bool firstDense = round % 2 == 0;
+            const bool secondDense = (round / 2) % 2 == 0;
+            const ModelledSet first = randomSet(random, firstDense);
+            const ModelledSet second = randomSet(random, secondDense);
+            const std::string pairing = std::string(first.bitmap.isDense() ? "bitmap" : "array") + " x " +
+                                        (second.bitmap.isDense() ? "bitmap" : "array");
+            CHECK_MSG(first.bitmap.isDense() == firstDense && second.bitmap.isDense() == secondDense,
+                      "set generator missed the container it aimed for: " + pairing);
+
+            std::set<uint32_t> both, either;
+            std::set_intersection(first.model.begin(), first.model.end(), second.model.begin(), second.model.end(),
+                                  std::inserter(both, both.end()));
+            std::set_union(first.model.begin(), first.model.end(), second.model.begin(), second.model.end(),
+                           std::inserter(either, either.end()));
+
+            checkMatches(EnrollmentBitmap::intersect(first.bitmap, second.bitmap), both, "intersect " + pairing);
+            checkMatches(EnrollmentBitmap::unite(first.bitmap, second.bitmap), either, "unite " + pairing);
+            CHECK_MSG(EnrollmentBitmap::intersectionCount(first.bitmap, second.bitmap) == both.size(),
+                      "intersectionCount " + pairing);
+        }
+
+        // Empty operands, in either position
+        const EnrollmentBitmap empty;
+        const ModelledSet dense = randomSet(random, true);
+        checkMatches(EnrollmentBitmap::intersect(empty, dense.bitmap), {}, "intersect with empty");
+        checkMatches(EnrollmentBitmap::unite(dense.bitmap, empty), dense.model, "unite with empty");
+        CHECK(EnrollmentBitmap::intersectionCount(dense.bitmap, empty) == 0);
+    }
+}
+
+int main() {
+    checkMembership();
+    checkSetQueries();
+    return finish("EnrollmentBitmapTest");
+}
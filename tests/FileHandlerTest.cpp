@@ -0,0 +1,110 @@
+// FileHandler's enrollments file: saved with a checksum sidecar, read back through it, and
+// rejected when a byte has changed since the save
+
+#include "TestSupport.hpp"
+#include "FileHandler.hpp"
+#include "Student.hpp"
+#include "Course.hpp"
+#include "EntityArena.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace PokenoSouth;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    struct School {
+        EntityArena<Course> courses;
+        EntityArena<Student> students;
+
+        // Three courses, four students; student n takes the first n % 3 + 1 courses
+        School() {
+            const Date start = Date::parse("2024-02-01");
+            for (const char* courseId : {"ENR101", "ENR102", "ENR103"}) {
+                courses.emplace(TRUSTED_INPUT, courseId, "Enrollments", 3, "Checksums", 12, "Teacher",
+                                start, start.addDays(84), 30, true);
+            }
+            for (int rollNumber = 1; rollNumber <= 4; ++rollNumber) {
+                students.emplace(TRUSTED_INPUT, rollNumber, "Test", "Student" + std::to_string(rollNumber),
+                                 Date::parse("2015-01-01"), "1 Main Rd", "family@example.nz", "0210000000", start);
+            }
+        }
+
+        void enrollAll() {
+            for (Student* student : students) {
+                int taken = 0;
+                for (Course* course : courses) {
+                    if (taken++ > student->getRollNumber() % 3) break;
+                    if (student->attachCourse(course)) course->attachStudent(student);
+                }
+            }
+        }
+
+        size_t enrollmentCount() const {
+            size_t count = 0;
+            for (const Student* student : students) count += student->getEnrolledCourses().size();
+            return count;
+        }
+    };
+
+    std::string readAll(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    void writeAll(const std::string& path, const std::string& content) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+    }
+
+    void checkEnrollmentChecksum() {
+        School saved;
+        saved.enrollAll();
+        CHECK(FileHandler::saveEnrollments(saved.students, saved.courses));
+        const std::string path = FileHandler::ENROLLMENTS_FILE;
+        CHECK(std::filesystem::exists(path + FileHandler::CHECKSUM_EXTENSION));
+
+        // Intact: every enrollment comes back
+        School intact;
+        CHECK(FileHandler::loadEnrollments(intact.students, intact.courses));
+        CHECK(intact.enrollmentCount() == saved.enrollmentCount() && intact.enrollmentCount() > 0);
+
+        // One byte flipped anywhere in a row: the load is refused and nothing is linked
+        const std::string original = readAll(path);
+        const size_t firstRow = original.find('\n') + 1;
+        for (size_t offset : {firstRow, firstRow + 2, original.size() / 2, original.size() - 2}) {
+            std::string corrupt = original;
+            corrupt[offset] = corrupt[offset] == '1' ? '2' : '1';
+            writeAll(path, corrupt);
+            School rejected;
+            CHECK_MSG(!FileHandler::loadEnrollments(rejected.students, rejected.courses),
+                      "byte " + std::to_string(offset) + " flipped, but the load succeeded");
+            CHECK(rejected.enrollmentCount() == 0);
+            CHECK(FileHandler::getLastError().find("checksum") != std::string::npos);
+        }
+
+        // A file without a sidecar (hand-made, or from before checksums) still loads
+        writeAll(path, original);
+        std::filesystem::remove(path + FileHandler::CHECKSUM_EXTENSION);
+        School unverified;
+        CHECK(FileHandler::loadEnrollments(unverified.students, unverified.courses));
+        CHECK(unverified.enrollmentCount() == saved.enrollmentCount());
+    }
+}
+
+int main() {
+    // ENROLLMENTS_FILE is relative to the working directory; keep it away from the real data
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "pokeno_file_handler_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory / "data");
+    const std::filesystem::path previous = std::filesystem::current_path();
+    std::filesystem::current_path(directory);
+
+    checkEnrollmentChecksum();
+
+    std::filesystem::current_path(previous);
+    std::filesystem::remove_all(directory);
+    return finish("FileHandlerTest");
+}
@@ -0,0 +1,179 @@
+// GradeAggregate: min/max after removing an extreme, and the integer micro-percent sum,
+// on its own and as Student and Course keep it while assessments change
+
+#include "TestSupport.hpp"
+#include "GradeAggregate.hpp"
+#include "Student.hpp"
+#include "Course.hpp"
+#include "Assessment.hpp"
+#include "EntityArena.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace PokenoSouth;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    // Min/max the way a stale aggregate's owner recomputes them
+    void refreshFrom(GradeAggregate& aggregate, const std::vector<double>& grades) {
+        aggregate.refreshExtremes([&grades](auto&& visit) {
+            for (double grade : grades) visit(grade);
+        });
+    }
+
+    void checkExtremes() {
+        GradeAggregate aggregate;
+        std::vector<double> grades = {72.5, 40.0, 95.0, 61.25, 40.0};
+        for (double grade : grades) aggregate.add(grade);
+        CHECK(aggregate.minGrade == 40.0 && aggregate.maxGrade == 95.0 && !aggregate.extremesStale);
+
+        // Removing the maximum leaves max stale until the owner rescans
+        aggregate.remove(95.0);
+        grades.erase(std::find(grades.begin(), grades.end(), 95.0));
+        CHECK(aggregate.extremesStale);
+        refreshFrom(aggregate, grades);
+        CHECK(!aggregate.extremesStale && aggregate.maxGrade == 72.5 && aggregate.minGrade == 40.0);
+
+        // One of two equal minimums goes: the rescan still finds the other
+        aggregate.remove(40.0);
+        grades.erase(std::find(grades.begin(), grades.end(), 40.0));
+        refreshFrom(aggregate, grades);
+        CHECK(aggregate.minGrade == 40.0);
+        aggregate.remove(40.0);
+        grades.erase(std::find(grades.begin(), grades.end(), 40.0));
+        refreshFrom(aggregate, grades);
+        CHECK(aggregate.minGrade == 61.25 && aggregate.maxGrade == 72.5);
+
+        // An add while stale must not be mistaken for an exact extreme; the rescan settles it
+        aggregate.remove(72.5);
+        grades.erase(std::find(grades.begin(), grades.end(), 72.5));
+        aggregate.add(10.0);
+        grades.push_back(10.0);
+        refreshFrom(aggregate, grades);
+        CHECK(aggregate.minGrade == 10.0 && aggregate.maxGrade == 61.25);
+
+        // Emptying resets everything; the next add is exact again
+        aggregate.remove(10.0);
+        aggregate.remove(61.25);
+        CHECK(aggregate.count == 0 && aggregate.sumMicros == 0 && !aggregate.extremesStale);
+        aggregate.add(55.0);
+        CHECK(aggregate.minGrade == 55.0 && aggregate.maxGrade == 55.0 && aggregate.passCount == 1);
+    }
+
+    void checkSumDoesNotDrift() {
+        // A double running sum picks up rounding on every edit and keeps it; the micro-percent
+        // sum is always exactly the sum of the grades currently held
+        TestRandom random;
+        GradeAggregate aggregate;
+        std::vector<double> current(40);
+        double doubleSum = 0.0;
+        for (double& grade : current) {
+            grade = static_cast<double>(random.below(100001)) / 1000.0;
+            aggregate.add(grade);
+            doubleSum += grade;
+        }
+        for (int edit = 0; edit < 100000; ++edit) {
+            double& grade = current[random.below(current.size())];
+            const double replacement = static_cast<double>(random.below(100001)) / 1000.0;
+            aggregate.replace(grade, replacement);
+            doubleSum += replacement - grade;
+            grade = replacement;
+        }
+        int64_t expectedMicros = 0;
+        double directSum = 0.0;
+        for (double grade : current) {
+            expectedMicros += GradeAggregate::toMicros(grade);
+            directSum += grade;
+        }
+        CHECK_MSG(doubleSum != directSum, "a double sum no longer drifts here; the check below proves nothing");
+        CHECK(aggregate.sumMicros == expectedMicros && aggregate.count == 40);
+
+        // Back and forth across the pass mark: the aggregate returns to exactly 50 and a pass
+        GradeAggregate edge;
+        edge.add(50.0);
+        for (int i = 0; i < 100000; ++i) {
+            edge.replace(50.0, 49.7);
+            edge.replace(49.7, 50.0);
+        }
+        CHECK(edge.sumMicros == 50000000 && edge.mean() == 50.0);
+        CHECK(edge.passCount == 1 && edge.failCount == 0);
+
+        // The sum depends only on the set of grades, not on the order they arrived or left in
+        std::vector<double> grades;
+        for (int i = 0; i < 500; ++i) grades.push_back(static_cast<double>(random.below(100001)) / 1000.0);
+        GradeAggregate forward, backward, churned;
+        for (double grade : grades) forward.add(grade);
+        for (auto it = grades.rbegin(); it != grades.rend(); ++it) backward.add(*it);
+        for (double grade : grades) {
+            churned.add(grade);
+            churned.add(0.1);
+            churned.remove(0.1);
+        }
+        CHECK(forward.sumMicros == backward.sumMicros && forward.sumMicros == churned.sumMicros);
+        for (double grade : grades) forward.remove(grade);
+        CHECK(forward.sumMicros == 0 && forward.count == 0);
+
+        // Grades straddling the pass mark average to exactly 50
+        GradeAggregate straddle;
+        straddle.add(49.9);
+        straddle.add(50.1);
+        CHECK(straddle.mean() == 50.0 && straddle.mean() >= GradeAggregate::PASS_THRESHOLD);
+    }
+
+    void checkStudentAndCourseTotals() {
+        EntityArena<Course> courses;
+        EntityArena<Student> students;
+        EntityArena<Assessment> assessments;
+        const Date start = Date::parse("2024-02-01");
+        Course* course = courses.emplace(TRUSTED_INPUT, "AGG101", "Aggregates", 3, "Running totals", 12,
+                                         "Teacher", start, start.addDays(84), 30, true);
+
+        std::vector<Student*> enrolled;
+        for (int rollNumber = 1; rollNumber <= 3; ++rollNumber) {
+            Student* student = students.emplace(TRUSTED_INPUT, rollNumber, "Test", "Student" + std::to_string(rollNumber),
+                                                Date::parse("2015-01-01"), "1 Main Rd", "family@example.nz",
+                                                "0210000000", start);
+            if (student->attachCourse(course)) course->attachStudent(student);
+            enrolled.push_back(student);
+        }
+
+        // Student 1: three assessments, the best of which is removed again
+        std::vector<Assessment*> marks;
+        for (double internal : {60.0, 90.0, 30.0}) {
+            Assessment* assessment = assessments.emplace(TRUSTED_INPUT, "AGG-" + std::to_string(marks.size()), 1,
+                                                         "AGG101", internal, internal, start.addDays(7), "Quiz",
+                                                         true, start.addDays(7), "");
+            enrolled[0]->addAssessment(assessment);
+            marks.push_back(assessment);
+        }
+        GradeAggregate studentSummary = enrolled[0]->getCourseGradeSummary(course->getCourseKey());
+        CHECK(studentSummary.count == 3 && studentSummary.maxGrade == 90.0 && studentSummary.minGrade == 30.0);
+        CHECK(course->getGradeSummary().maxGrade == 60.0);   // Student 1's course grade; the others have none
+
+        enrolled[0]->removeAssessment(marks[1]->getAssessmentId());
+        studentSummary = enrolled[0]->getCourseGradeSummary(course->getCourseKey());
+        CHECK(studentSummary.count == 2 && studentSummary.maxGrade == 60.0 && studentSummary.minGrade == 30.0);
+        const GradeAggregate overall = enrolled[0]->getOverallGradeSummary();
+        CHECK(overall.count == 2 && overall.maxGrade == 60.0 && overall.mean() == 45.0);
+
+        // Editing marks moves the course totals through the student's change notification
+        marks[2]->updateMarks(80.0, 80.0);
+        CHECK(enrolled[0]->getCourseGradeSummary(course->getCourseKey()).maxGrade == 80.0);
+        CHECK(course->getGradeSummary().maxGrade == 70.0);
+
+        // The top student leaves: the course rescans its remaining students
+        course->detachStudent(enrolled[0]);
+        enrolled[0]->detachCourse(course);
+        const GradeAggregate courseSummary = course->getGradeSummary();
+        CHECK(courseSummary.count == 2 && courseSummary.maxGrade == 0.0 && courseSummary.minGrade == 0.0);
+        CHECK(courseSummary.sumMicros == 0);
+    }
+}
+
+int main() {
+    checkExtremes();
+    checkSumDoesNotDrift();
+    checkStudentAndCourseTotals();
+    return finish("GradeAggregateTest");
+}
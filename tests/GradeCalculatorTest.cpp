@@ -0,0 +1,129 @@
+// Best-N grading: BestNAccumulator over streamed scores and BestNOutOfMCalculator's batch path
+// over AssessmentColumns::groupGradesByStudent(), both against sorting every score
+
+#include "TestSupport.hpp"
+#include "GradeCalculator.hpp"
+#include "AssessmentColumns.hpp"
+#include "Assessment.hpp"
+#include "EntityArena.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace PokenoSouth;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    // Mean of the bestN largest scores, the obvious way
+    double referenceBestN(std::vector<double> scores, size_t bestN) {
+        const size_t take = std::min(bestN, scores.size());
+        if (take == 0) return 0.0;
+        std::sort(scores.begin(), scores.end(), std::greater<double>());
+        double sum = 0.0;
+        for (size_t i = 0; i < take; ++i) sum += scores[i];
+        return sum / static_cast<double>(take);
+    }
+
+    bool near(double a, double b) { return a > b - 1e-9 && a < b + 1e-9; }
+
+    double randomGrade(TestRandom& random) {
+        return static_cast<double>(random.below(100001)) / 1000.0;
+    }
+
+    void checkAccumulator() {
+        TestRandom random;
+        for (size_t bestN : {0, 1, 3, 7, 40}) {
+            BestNAccumulator best(bestN);
+            std::vector<double> seen;
+            for (int step = 0; step < 2000; ++step) {
+                // Many repeats, so ties at the eviction boundary are common
+                const double score = random.chance(30) ? static_cast<double>(random.below(5)) * 25.0 : randomGrade(random);
+                best.add(score);
+                seen.push_back(score);
+                CHECK(best.size() == std::min(bestN, seen.size()));
+                CHECK_MSG(near(best.grade(), referenceBestN(seen, bestN)),
+                          "best " + std::to_string(bestN) + " after " + std::to_string(seen.size()) + " scores");
+                if (bestN > 0) {
+                    std::vector<double> sorted = seen;
+                    std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+                    CHECK(best.lowestKept() == sorted[best.size() - 1]);
+                }
+            }
+            best.clear();
+            CHECK(best.size() == 0 && best.grade() == 0.0 && best.lowestKept() == 0.0);
+        }
+
+        // Evictions adjust an integer sum: long churn lands exactly on the kept scores' mean
+        BestNAccumulator best(2);
+        for (int step = 0; step < 100000; ++step) best.add(49.0 + static_cast<double>(step % 1000) / 1000.0 * 0.001);
+        best.add(80.1);
+        best.add(80.2);
+        CHECK(best.grade() == (GradeAggregate::toMicros(80.1) + GradeAggregate::toMicros(80.2)) /
+                              GradeAggregate::MICROS_PER_PERCENT / 2.0);
+    }
+
+    void checkGroupedBatch() {
+        TestRandom random(9);
+        AssessmentColumns columns;   // Outlives the assessments, which untrack themselves
+        EntityArena<Assessment> assessments;
+        const Date date = Date::parse("2024-03-01");
+        const std::vector<std::string> courseIds = {"BST101", "BST102", "BST103"};
+
+        // Rows arrive in random order; the model groups them by (roll number, course key)
+        std::map<std::pair<int, SymbolKey>, std::vector<double>> expected;
+        for (int i = 0; i < 1500; ++i) {
+            const int rollNumber = 1 + static_cast<int>(random.below(60));
+            const std::string& courseId = courseIds[random.below(courseIds.size())];
+            Assessment* assessment = assessments.emplace(TRUSTED_INPUT, "BST-" + std::to_string(i), rollNumber, courseId,
+                                                         randomGrade(random), randomGrade(random), date, "Test",
+                                                         true, date, "");
+            columns.track(assessment);
+            expected[{rollNumber, assessment->getCourseKey()}].push_back(assessment->getCalculatedGrade());
+        }
+        // Removing rows moves others into the holes; the grouping must not care
+        for (int i = 0; i < 200; ++i) {
+            const Assessment* removed = columns.source(random.below(columns.size()));
+            auto& group = expected[{removed->getStudentRollNumber(), removed->getCourseKey()}];
+            group.erase(std::find(group.begin(), group.end(), removed->getCalculatedGrade()));
+            if (group.empty()) expected.erase({removed->getStudentRollNumber(), removed->getCourseKey()});
+            columns.untrack(removed);
+        }
+
+        const StudentScoreGroups groups = columns.groupGradesByStudent();
+        CHECK(groups.size() == expected.size() && groups.offsets.size() == groups.size() + 1);
+        CHECK(groups.grades.size() == columns.size() && groups.offsets.back() == columns.size());
+
+        for (size_t bestN : {1, 3, 1000}) {
+            std::vector<double> grades(groups.size(), -1.0);
+            BestNOutOfMCalculator(bestN).calculateGrades(groups.batch(), grades.data());
+            size_t g = 0;
+            for (const auto& [key, scores] : expected) {
+                if (g >= groups.size()) break;
+                CHECK_MSG(groups.rollNumbers[g] == key.first && groups.courseKeys[g] == key.second,
+                          "group " + std::to_string(g) + " out of order");
+                std::vector<double> grouped(groups.grades.begin() + groups.offsets[g],
+                                            groups.grades.begin() + groups.offsets[g + 1]);
+                std::vector<double> sortedExpected = scores;
+                std::sort(grouped.begin(), grouped.end());
+                std::sort(sortedExpected.begin(), sortedExpected.end());
+                CHECK(grouped == sortedExpected);
+                CHECK_MSG(near(grades[g], referenceBestN(scores, bestN)), "best " + std::to_string(bestN) +
+                          " for roll " + std::to_string(key.first));
+                ++g;
+            }
+        }
+
+        columns.clear();
+        const StudentScoreGroups none = columns.groupGradesByStudent();
+        CHECK(none.size() == 0 && none.offsets.size() == 1 && none.grades.empty());
+    }
+}
+
+int main() {
+    checkAccumulator();
+    checkGroupedBatch();
+    return finish("GradeCalculatorTest");
+}
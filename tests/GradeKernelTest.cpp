@@ -0,0 +1,195 @@
+// GradeKernel: the batch weighting and classification against their scalar forms at every
+// tail length and alignment, and AssessmentColumns::regrade against per-assessment grading
+
+#include "TestSupport.hpp"
+#include "GradeKernel.hpp"
+#include "GradingPolicy.hpp"
+#include "AssessmentColumns.hpp"
+#include "Assessment.hpp"
+#include "Student.hpp"
+#include "Course.hpp"
+#include "EntityArena.hpp"
+
+#include <cstring>
+#include <vector>
+
+using namespace PokenoSouth;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    bool sameBits(double a, double b) { return std::memcmp(&a, &b, sizeof a) == 0; }
+
+    // Marks as entered: whole numbers, halves, and arbitrary three-decimal values
+    double randomMarks(TestRandom& random) {
+        switch (random.below(3)) {
+            case 0: return static_cast<double>(random.below(101));
+            case 1: return static_cast<double>(random.below(201)) / 2.0;
+            default: return static_cast<double>(random.below(100001)) / 1000.0;
+        }
+    }
+
+    void checkWeightedGrades() {
+        // Every count up to a few vector widths past 64, so each tail length is covered, read
+        // from both an aligned and an odd offset
+        TestRandom random;
+        const Date date = Date::parse("2024-03-01");
+        for (const char* name : {"standard", "split-40-60", "split-50-50"}) {
+            const CourseGradingPolicy* policy = GradingPolicyRegistry::shared().find(name);
+            CHECK_MSG(policy != nullptr, std::string("no policy ") + name);
+            if (!policy) continue;
+            for (size_t count = 0; count <= 67; ++count) {
+                for (size_t offset : {0, 1}) {
+                    std::vector<double> internal(count + offset), final(count + offset), out(count + offset + 1, -1.0);
+                    for (size_t i = offset; i < count + offset; ++i) {
+                        internal[i] = randomMarks(random);
+                        final[i] = randomMarks(random);
+                    }
+                    GradeKernel::weightedGrades(internal.data() + offset, final.data() + offset, out.data() + offset,
+                                                count, policy->internalWeight(), policy->finalWeight());
+                    for (size_t i = offset; i < count + offset; ++i) {
+                        CHECK_MSG(sameBits(out[i], policy->assessmentGrade(internal[i], final[i])),
+                                  std::string(name) + ": count " + std::to_string(count) + ", row " +
+                                  std::to_string(i - offset));
+                    }
+                    CHECK_MSG(out[count + offset] == -1.0, "wrote past the end at count " + std::to_string(count));
+                }
+            }
+        }
+
+        // The standard weights against Assessment's own scalar calculation
+        for (size_t count = 0; count <= 19; ++count) {
+            std::vector<double> internal(count), final(count), out(count);
+            for (size_t i = 0; i < count; ++i) {
+                internal[i] = randomMarks(random);
+                final[i] = randomMarks(random);
+            }
+            GradeKernel::weightedGrades(internal.data(), final.data(), out.data(), count,
+                                        Assessment::INTERNAL_WEIGHT, Assessment::FINAL_WEIGHT);
+            for (size_t i = 0; i < count; ++i) {
+                const Assessment assessment(TRUSTED_INPUT, "KRN-" + std::to_string(i), 1, "KRN100", internal[i],
+                                            final[i], date, "Test", true, date, "");
+                CHECK(sameBits(out[i], assessment.calculateWeightedGrade()));
+            }
+        }
+    }
+
+    void checkClassify() {
+        TestRandom random(3);
+        // The band edges and their neighbours, where a lane could disagree with the scalar test
+        std::vector<double> edges;
+        for (double bound : {Assessment::A_PLUS_THRESHOLD, Assessment::A_THRESHOLD, Assessment::B_PLUS_THRESHOLD,
+                             Assessment::B_THRESHOLD, Assessment::C_PLUS_THRESHOLD, Assessment::C_THRESHOLD,
+                             Assessment::D_THRESHOLD, Assessment::PASS_THRESHOLD}) {
+            edges.insert(edges.end(), {bound, bound - 1e-9, bound + 1e-9});
+        }
+        edges.insert(edges.end(), {0.0, 100.0});
+
+        for (size_t count = 0; count <= 41; ++count) {
+            std::vector<double> grades(count);
+            for (double& grade : grades) {
+                grade = random.chance(40) ? edges[random.below(edges.size())] : randomMarks(random);
+            }
+            std::vector<uint8_t> passFlags(count, 0xEE), letterCodes(count, 0xEE);
+            GradeKernel::classify(grades.data(), passFlags.data(), letterCodes.data(), count);
+            for (size_t i = 0; i < count; ++i) {
+                CHECK(letterCodes[i] == GradeKernel::letterCode(grades[i]));
+                CHECK(passFlags[i] == (grades[i] >= Assessment::PASS_THRESHOLD ? 1 : 0));
+            }
+
+            // Either output may be left out
+            std::vector<uint8_t> codesOnly(count, 0xEE);
+            GradeKernel::classify(grades.data(), nullptr, codesOnly.data(), count);
+            CHECK(codesOnly == letterCodes);
+        }
+
+        // Letter codes name the same letter Assessment reports
+        const Date date = Date::parse("2024-03-01");
+        for (double edge : edges) {
+            const Assessment assessment(TRUSTED_INPUT, "KRN-EDGE", 1, "KRN100", edge, edge, date, "Test", true, date, "");
+            CHECK_MSG(assessment.getLetterGrade() == GradeKernel::letterName(GradeKernel::letterCode(assessment.getCalculatedGrade())),
+                      "letter at " + std::to_string(edge));
+        }
+    }
+
+    void checkColumnRegrade() {
+        // Two courses' rows interleaved across more than one kernel block, with a ragged end
+        EntityArena<Course> courses;
+        EntityArena<Student> students;
+        EntityArena<Assessment> assessments;
+        AssessmentColumns columns;
+        const Date start = Date::parse("2024-02-01");
+        Course* regraded = courses.emplace(TRUSTED_INPUT, "KRN101", "Kernels", 3, "Re-graded", 12, "Teacher",
+                                           start, start.addDays(84), 30, true);
+        Course* untouched = courses.emplace(TRUSTED_INPUT, "KRN102", "Kernels II", 3, "Left alone", 12, "Teacher",
+                                            start, start.addDays(84), 30, true);
+        std::vector<Student*> enrolled;
+        for (int rollNumber = 1; rollNumber <= 7; ++rollNumber) {
+            Student* student = students.emplace(TRUSTED_INPUT, rollNumber, "Test", "Student" + std::to_string(rollNumber),
+                                                Date::parse("2015-01-01"), "1 Main Rd", "family@example.nz",
+                                                "0210000000", start);
+            for (Course* course : {regraded, untouched}) {
+                if (student->attachCourse(course)) course->attachStudent(student);
+            }
+            enrolled.push_back(student);
+        }
+
+        TestRandom random(5);
+        for (size_t i = 0; i < 3 * 256 + 37; ++i) {
+            Student* student = enrolled[random.below(enrolled.size())];
+            Course* course = random.chance(50) ? regraded : untouched;
+            Assessment* assessment = assessments.emplace(TRUSTED_INPUT, "KRN-" + std::to_string(i), student->getRollNumber(),
+                                                         course->getCourseId(), randomMarks(random), randomMarks(random),
+                                                         start.addDays(7), "Test", true, start.addDays(7), "");
+            student->addAssessment(assessment);
+            columns.track(assessment);
+        }
+        const std::vector<double> before = columns.grades();
+
+        regraded->setGradingPolicy("split-50-50");
+        const CourseGradingPolicy& policy = regraded->getGradingPolicy();
+        const size_t moved = columns.regrade(regraded->getCourseKey(), policy.internalWeight(), policy.finalWeight());
+        regraded->recalculateGradeTotals();
+
+        size_t expectedMoved = 0;
+        for (size_t row = 0; row < columns.size(); ++row) {
+            const Assessment* assessment = columns.source(row);
+            const bool inCourse = columns.courseKeys()[row] == regraded->getCourseKey();
+            const double expected = inCourse ? policy.assessmentGrade(assessment->getInternalMarks(), assessment->getFinalMarks())
+                                             : before[row];
+            expectedMoved += inCourse && expected != before[row];
+            CHECK_MSG(sameBits(columns.grades()[row], expected), "row " + std::to_string(row) + " grade column");
+            CHECK_MSG(sameBits(assessment->getCalculatedGrade(), expected), "row " + std::to_string(row) + " cached grade");
+            CHECK(sameBits(assessment->calculateWeightedGrade(), expected));
+        }
+        CHECK(moved == expectedMoved && moved > 0);
+
+        // The owners' running totals moved with the grades
+        for (const Student* student : enrolled) {
+            for (const Course* course : {regraded, untouched}) {
+                double sum = 0.0;
+                size_t count = 0;
+                for (const Assessment* assessment : columns.selectForStudent(student->getRollNumber())) {
+                    if (assessment->getCourseKey() != course->getCourseKey()) continue;
+                    sum += assessment->calculateWeightedGrade();
+                    count++;
+                }
+                const double expected = count ? sum / static_cast<double>(count) : 0.0;
+                const double actual = student->getCourseGrade(course->getCourseKey());
+                CHECK_MSG(actual > expected - 1e-6 && actual < expected + 1e-6,
+                          "student " + std::to_string(student->getRollNumber()) + " in " + course->getCourseId());
+            }
+        }
+
+        // Re-applying the same weights moves nothing
+        CHECK(columns.regrade(regraded->getCourseKey(), policy.internalWeight(), policy.finalWeight()) == 0);
+        GradingPolicyRegistry::shared().unassign(regraded->getCourseKey());
+    }
+}
+
+int main() {
+    std::printf("GradeKernelTest: %s path\n", GradeKernel::usesSimd() ? "SSE2" : "scalar");
+    checkWeightedGrades();
+    checkClassify();
+    checkColumnRegrade();
+    return finish("GradeKernelTest");
+}
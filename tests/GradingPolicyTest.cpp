@@ -0,0 +1,251 @@
+// Per-course grading policies: assessment and course grades follow the policy assigned in
+// GradingPolicyRegistry, the running totals stay exact across a change, and every storage format keeps it
+
+#include "TestSupport.hpp"
+#include "GradingPolicy.hpp"
+#include "Student.hpp"
+#include "Course.hpp"
+#include "Assessment.hpp"
+#include "EntityArena.hpp"
+#include "AssessmentColumns.hpp"
+#include "FileHandler.hpp"
+#include "MemoryStorage.hpp"
+#include "BTreeStorage.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <vector>
+
+using namespace PokenoSouth;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    bool near(double a, double b) { return std::abs(a - b) < 1e-9; }
+
+    struct School {
+        AssessmentColumns columns;   // Outlives the assessments, which untrack themselves
+        EntityArena<Course> courses;
+        EntityArena<Student> students;
+        EntityArena<Assessment> assessments;
+        Course* course = nullptr;
+        std::vector<Student*> enrolled;
+
+        // One course, two enrolled students
+        School() {
+            const Date start = Date::parse("2024-02-01");
+            course = courses.emplace(TRUSTED_INPUT, "POL101", "Policies", 3, "Grading rules", 12, "Teacher",
+                                     start, start.addDays(84), 30, true);
+            for (int rollNumber = 1; rollNumber <= 2; ++rollNumber) {
+                Student* student = students.emplace(TRUSTED_INPUT, rollNumber, "Test", "Student" + std::to_string(rollNumber),
+                                                    Date::parse("2015-01-01"), "1 Main Rd", "family@example.nz",
+                                                    "0210000000", start);
+                if (student->attachCourse(course)) course->attachStudent(student);
+                enrolled.push_back(student);
+            }
+        }
+
+        Assessment* mark(Student* student, double internal, double final) {
+            const std::string id = "POL-" + std::to_string(assessments.size());
+            Assessment* assessment = assessments.emplace(TRUSTED_INPUT, id, student->getRollNumber(), "POL101",
+                                                         internal, final, Date::parse("2024-03-01"), "Test",
+                                                         true, Date::parse("2024-03-01"), "");
+            student->addAssessment(assessment);
+            columns.track(assessment);
+            return assessment;
+        }
+
+        // What System::applyGradingPolicy does for a course
+        void apply(const std::string& policyName) {
+            course->setGradingPolicy(policyName);
+            const CourseGradingPolicy& policy = course->getGradingPolicy();
+            columns.regrade(course->getCourseKey(), policy.internalWeight(), policy.finalWeight());
+            course->recalculateGradeTotals();
+        }
+    };
+
+    // The policy's grade for one student, from scratch
+    double expectedCourseGrade(const Student* student, const Course* course) {
+        const CourseGradingPolicy& policy = GradingPolicyRegistry::shared().forCourse(course->getCourseKey());
+        std::vector<double> grades;
+        student->forEachAssessmentInCourse(course->getCourseKey(), [&](const Assessment* assessment) {
+            grades.push_back(policy.assessmentGrade(assessment->getInternalMarks(), assessment->getFinalMarks()));
+        });
+        return policy.calculateGrade(ScoreSpan{grades.data(), nullptr, grades.size()});
+    }
+
+    // Every cached grade, student total and course total agrees with a recomputation
+    void checkConsistent(School& school, const std::string& when) {
+        const CourseGradingPolicy& policy = school.course->getGradingPolicy();
+        for (const Assessment* assessment : school.assessments) {
+            CHECK_MSG(near(assessment->getCalculatedGrade(),
+                           policy.assessmentGrade(assessment->getInternalMarks(), assessment->getFinalMarks())),
+                      when + ": stale assessment grade " + assessment->getAssessmentId());
+        }
+        GradeAggregate courseTotals;
+        for (const Student* student : school.enrolled) {
+            const double grade = student->getCourseGrade(school.course->getCourseKey());
+            CHECK_MSG(near(grade, expectedCourseGrade(student, school.course)),
+                      when + ": course grade of student " + std::to_string(student->getRollNumber()));
+            courseTotals.add(grade);
+        }
+        const GradeAggregate summary = school.course->getGradeSummary();
+        CHECK_MSG(summary.sumMicros == courseTotals.sumMicros && summary.passCount == courseTotals.passCount &&
+                  summary.maxGrade == courseTotals.maxGrade, when + ": course totals drifted");
+    }
+
+    void checkRegistry() {
+        GradingPolicyRegistry& registry = GradingPolicyRegistry::shared();
+        const std::vector<std::string> names = registry.names();
+        CHECK(std::is_sorted(names.begin(), names.end()));
+        for (const char* name : {"standard", "drop-lowest", "best-3", "capped", "split-40-60", "split-50-50"}) {
+            CHECK_MSG(std::find(names.begin(), names.end(), name) != names.end(), std::string("missing ") + name);
+        }
+
+        const SymbolKey courseKey = SymbolTable::courseIds().intern("REG101");
+        CHECK(registry.forCourse(courseKey).getName() == GradingPolicyRegistry::DEFAULT_POLICY);
+        registry.assign(courseKey, "best-3");
+        CHECK(registry.forCourse(courseKey).getName() == "best-3");
+        bool threw = false;
+        try { registry.assign(courseKey, "no-such-policy"); } catch (const std::invalid_argument&) { threw = true; }
+        CHECK_MSG(threw && registry.forCourse(courseKey).getName() == "best-3", "unknown policy must be rejected");
+        threw = false;
+        try { registry.assign(SymbolTable::INVALID_KEY, "best-3"); } catch (const std::invalid_argument&) { threw = true; }
+        CHECK(threw);
+        registry.unassign(courseKey);
+        CHECK(registry.forCourse(courseKey).getName() == GradingPolicyRegistry::DEFAULT_POLICY);
+
+        CHECK(registry.find("standard")->averagesAllScores() && !registry.find("best-3")->averagesAllScores());
+        CHECK(near(registry.find("split-40-60")->internalWeight(), 0.4));
+    }
+
+    void checkGrades() {
+        School school;
+        Student* first = school.enrolled[0];
+        Student* second = school.enrolled[1];
+        std::vector<Assessment*> marks;
+        const std::vector<std::pair<double, double>> internalAndFinal = {{80.0, 40.0}, {60.0, 60.0}, {20.0, 100.0}, {90.0, 90.0}};
+        for (auto [internal, final] : internalAndFinal) {
+            marks.push_back(school.mark(first, internal, final));
+        }
+        school.mark(second, 50.0, 50.0);
+        const SymbolKey courseKey = school.course->getCourseKey();
+
+        // Standard: 52, 60, 76, 90
+        CHECK(near(marks[0]->getCalculatedGrade(), 52.0) && near(first->getCourseGrade(courseKey), 69.5));
+        checkConsistent(school, "standard");
+
+        // A different split re-grades every assessment: 60, 60, 60, 90
+        school.apply("split-50-50");
+        CHECK(near(marks[2]->getCalculatedGrade(), 60.0) && near(first->getCourseGrade(courseKey), 67.5));
+        CHECK(near(first->getOverallGradeSummary().mean(), 67.5));
+        CHECK(near(marks[0]->getInternalContribution(), 40.0));
+        checkConsistent(school, "split-50-50");
+
+        // Selection moves course grades with no assessment grade changing: 52 is dropped
+        school.apply("drop-lowest");
+        CHECK(near(marks[0]->getCalculatedGrade(), 52.0));
+        CHECK(near(first->getCourseGrade(courseKey), (60.0 + 76.0 + 90.0) / 3));
+        CHECK(near(second->getCourseGrade(courseKey), 50.0));   // A lone score is never dropped
+        checkConsistent(school, "drop-lowest");
+
+        // Edits under a selection policy keep the course totals in step incrementally
+        marks[0]->updateMarks(100.0, 100.0);
+        CHECK(near(first->getCourseGrade(courseKey), (100.0 + 76.0 + 90.0) / 3));
+        checkConsistent(school, "edit under drop-lowest");
+        first->removeAssessment(marks[3]->getAssessmentId());
+        checkConsistent(school, "removal under drop-lowest");
+
+        school.apply("best-3");
+        school.mark(first, 10.0, 10.0);
+        checkConsistent(school, "add under best-3");
+
+        // Back to the default: a plain mean of everything again
+        school.apply(GradingPolicyRegistry::DEFAULT_POLICY);
+        CHECK(near(first->getCourseGrade(courseKey), (100.0 + 60.0 + 76.0 + 10.0) / 4));
+        checkConsistent(school, "standard again");
+    }
+
+    // Saves 'school' with its course on 'policyName', resets the assignment, loads it back
+    void checkStorageKeepsPolicy(const std::string& what, const std::string& policyName,
+                                 const std::function<bool(School&)>& save,
+                                 const std::function<bool(EntityArena<Student>&, EntityArena<Course>&,
+                                                          EntityArena<Assessment>&)>& load) {
+        School saved;
+        saved.mark(saved.enrolled[0], 30.0, 90.0);
+        saved.mark(saved.enrolled[0], 70.0, 20.0);
+        saved.apply(policyName);
+        CHECK_MSG(save(saved), what + ": save failed");
+        saved.apply(GradingPolicyRegistry::DEFAULT_POLICY);   // Only the stored copy remembers it now
+
+        EntityArena<Student> students;
+        EntityArena<Course> courses;
+        EntityArena<Assessment> assessments;
+        CHECK_MSG(load(students, courses, assessments), what + ": load failed");
+        CHECK_MSG(courses.size() == 1 && (*courses.begin())->getGradingPolicyName() == policyName,
+                  what + ": grading policy not restored");
+        for (const Student* student : students) {
+            if (student->getRollNumber() != 1) continue;
+            CHECK_MSG(near(student->getCourseGrade((*courses.begin())->getCourseKey()),
+                           expectedCourseGrade(student, *courses.begin())),
+                      what + ": loaded grades ignore the restored policy");
+        }
+        GradingPolicyRegistry::shared().unassign(SymbolTable::courseIds().find("POL101"));
+    }
+
+    void checkPersistence() {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "pokeno_grading_policy_test";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        MemoryStorage memory;
+        checkStorageKeepsPolicy("memory/snapshot", "split-40-60",
+            [&](School& school) { return memory.save(school.students, school.courses, school.assessments); },
+            [&](auto& students, auto& courses, auto& assessments) { return memory.load(students, courses, assessments); });
+
+        BTreeStorage btree((directory / "records.btree").string(), (directory / "backups").string());
+        checkStorageKeepsPolicy("btree", "drop-lowest",
+            [&](School& school) { return btree.save(school.students, school.courses, school.assessments); },
+            [&](auto& students, auto& courses, auto& assessments) { return btree.load(students, courses, assessments); });
+
+        // The CSV courses file: written with the GradingPolicy column, read back through its checksum
+        const std::string coursesFile = (directory / "courses.csv").string();
+        School csv;
+        csv.course->setGradingPolicy("best-3");
+        CHECK(FileHandler::saveCoursesToFile(csv.courses, coursesFile));
+        csv.course->setGradingPolicy(GradingPolicyRegistry::DEFAULT_POLICY);
+        EntityArena<Course> loaded;
+        CHECK(FileHandler::loadCoursesFromFile(loaded, coursesFile));
+        CHECK_MSG(loaded.size() == 1 && (*loaded.begin())->getGradingPolicyName() == "best-3",
+                  "csv: grading policy not restored");
+
+        // Files from before the column load with the default policy; an unknown name falls back to it
+        {
+            std::ofstream legacy(directory / "legacy.csv");
+            legacy << "CourseId,CourseName,Credits,Description,Teacher,Duration,StartDate,EndDate,MaxEnrollment,IsActive\n"
+                   << "POL101,Policies,3,Grading rules,Teacher,12,2024-02-01,2024-04-25,30,Yes\n";
+            std::ofstream unknown(directory / "unknown.csv");
+            unknown << "CourseId,CourseName,Credits,Description,Teacher,Duration,StartDate,EndDate,MaxEnrollment,IsActive,GradingPolicy\n"
+                    << "POL101,Policies,3,Grading rules,Teacher,12,2024-02-01,2024-04-25,30,Yes,no-such-policy\n";
+        }
+        for (const char* file : {"legacy.csv", "unknown.csv"}) {
+            csv.course->setGradingPolicy("best-3");
+            EntityArena<Course> restored;
+            CHECK_MSG(FileHandler::loadCoursesFromFile(restored, (directory / file).string()), file);
+            CHECK_MSG(restored.size() == 1 &&
+                      (*restored.begin())->getGradingPolicyName() == GradingPolicyRegistry::DEFAULT_POLICY,
+                      std::string(file) + ": expected the default policy");
+        }
+
+        std::filesystem::remove_all(directory);
+    }
+}
+
+int main() {
+    checkRegistry();
+    checkGrades();
+    checkPersistence();
+    return finish("GradingPolicyTest");
+}
@@ -0,0 +1,217 @@
+// System on the memory-mapped backend: the CSV files are imported on first start, every
+// single-entity edit changes its record in place in the mapped file, the file grows its slot
+// table when full, and a damaged record is caught when it is read, not when the file is opened
+
+#include "TestSupport.hpp"
+#include "System.hpp"
+#include "MappedStorage.hpp"
+#include "CsvStorage.hpp"
+#include "Clock.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+using namespace PokenoSouth;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    const char* const HEAP = "data/entities.heap";
+
+    struct Snapshot {
+        EntityArena<Student> students;
+        EntityArena<Course> courses;
+        EntityArena<Assessment> assessments;
+
+        Student* student(int rollNumber) {
+            for (Student* student : students) {
+                if (student->getRollNumber() == rollNumber) return student;
+            }
+            return nullptr;
+        }
+        Course* course(const std::string& courseId) {
+            for (Course* course : courses) {
+                if (course->getCourseId() == courseId) return course;
+            }
+            return nullptr;
+        }
+        size_t assessmentsWith(const std::string& assessmentId) {
+            size_t count = 0;
+            for (Assessment* assessment : assessments) count += assessment->getAssessmentId() == assessmentId;
+            return count;
+        }
+        size_t assessmentsFor(const std::string& courseId) {
+            size_t count = 0;
+            for (Assessment* assessment : assessments) count += assessment->getCourseId() == courseId;
+            return count;
+        }
+    };
+
+    // What a fresh start would load, read straight from the mapped file
+    std::unique_ptr<Snapshot> stored() {
+        auto snapshot = std::make_unique<Snapshot>();
+        MappedStorage storage(HEAP);
+        CHECK_MSG(storage.load(snapshot->students, snapshot->courses, snapshot->assessments), storage.getLastError());
+        return snapshot;
+    }
+
+    std::string fileBytes() {
+        std::ifstream file(HEAP, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    size_t bytesChanged(const std::string& before, const std::string& after) {
+        size_t changed = before.size() > after.size() ? before.size() - after.size() : after.size() - before.size();
+        for (size_t i = 0; i < std::min(before.size(), after.size()); ++i) changed += before[i] != after[i];
+        return changed;
+    }
+
+    Student testStudent(int rollNumber, const std::string& address) {
+        return Student(rollNumber, "Aroha", "Test", "2014-05-06", address, "aroha.test@pokenosouth.ac.nz",
+                       "0211112222", "2024-02-03");
+    }
+}
+
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "pokeno_mapped_storage_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::filesystem::copy(POKENO_TEST_DATA_DIR, directory / "data", std::filesystem::copy_options::recursive);
+    std::filesystem::remove(directory / "data" / "entities.heap");
+    std::filesystem::current_path(directory);   // CsvStorage reads the fixed data/ paths
+
+    // Pick the entities to edit from the sample data
+    Snapshot csv;
+    CsvStorage csvStorage;
+    CHECK(csvStorage.load(csv.students, csv.courses, csv.assessments));
+    Course* removedCourse = nullptr;   // Has enrolled students and assessments
+    for (Course* course : csv.courses) {
+        if (!course->getEnrolledRollNumbers().empty() && csv.assessmentsFor(course->getCourseId()) > 0) {
+            removedCourse = course;
+            break;
+        }
+    }
+    Student* student = *csv.students.begin();   // The one with the most room for another course
+    for (Student* candidate : csv.students) {
+        if (candidate->getEnrollmentCount() < student->getEnrollmentCount()) student = candidate;
+    }
+    Course* joinedCourse = nullptr;    // One the student is not in yet
+    for (Course* course : csv.courses) {
+        if (course != removedCourse && course->getIsActive() && !student->isEnrolledInCourse(course->getCourseId()) &&
+            static_cast<int>(course->getEnrolledRollNumbers().size()) < course->getMaxEnrollment()) {
+            joinedCourse = course;
+            break;
+        }
+    }
+    std::string removedAssessment;     // A unique ID outside the removed course
+    for (Assessment* assessment : csv.assessments) {
+        if (assessment->getCourseId() != removedCourse->getCourseId() &&
+            csv.assessmentsWith(assessment->getAssessmentId()) == 1) {
+            removedAssessment = assessment->getAssessmentId();
+            break;
+        }
+    }
+    if (!removedCourse || !joinedCourse || removedAssessment.empty()) {
+        CHECK_MSG(false, "sample data lacks the entities this test edits");
+        return finish("MappedStorageTest");
+    }
+    const std::string removedCourseId = removedCourse->getCourseId();
+    const std::string joinedCourseId = joinedCourse->getCourseId();
+    const int rollNumber = student->getRollNumber();
+
+    // Enrollment windows are checked against today: pin it inside the joined course's window
+    FakeClock clock(joinedCourse->getStartDate());
+    ScopedClock pinned(clock);
+
+    {
+        System system(std::make_unique<MappedStorage>(HEAP));
+        CHECK(system.loadData());
+        CHECK(system.getStudentCount() == csv.students.size());   // Imported from the CSV files
+        CHECK(stored()->students.size() == csv.students.size());
+
+        // An edit rewrites its own record where it lies: same file, a few bytes changed
+        const std::string before = fileBytes();
+        CHECK(system.enrollStudent(rollNumber, joinedCourseId));
+        const std::string after = fileBytes();
+        CHECK(after.size() == before.size());
+        CHECK_MSG(bytesChanged(before, after) < 200,
+                  std::to_string(bytesChanged(before, after)) + " bytes changed for one enrollment");
+        CHECK(stored()->student(rollNumber)->isEnrolledInCourse(joinedCourseId));
+
+        CHECK(system.removeAssessment(removedAssessment));
+        CHECK(stored()->assessmentsWith(removedAssessment) == 0);
+
+        CHECK(system.addStudent(testStudent(990001, "1 Test Rd")));   // Reuses the freed slot
+        CHECK(stored()->student(990001) != nullptr);
+
+        CHECK(system.removeCourse(removedCourseId));
+        const auto afterRemoval = stored();
+        CHECK(afterRemoval->course(removedCourseId) == nullptr);
+        CHECK(afterRemoval->assessmentsFor(removedCourseId) == 0);
+
+        CHECK(system.withdrawStudent(rollNumber, joinedCourseId));
+        CHECK(!stored()->student(rollNumber)->isEnrolledInCourse(joinedCourseId));
+
+        // Nothing is left for the full save to write
+        const std::string beforeSave = fileBytes();
+        CHECK(system.saveData());
+        CHECK(fileBytes() == beforeSave);
+    }
+
+    // A full slot table is rebuilt with twice the slots; every record survives the move
+    uint32_t capacity = 0;
+    {
+        MappedStorage probe(HEAP);
+        CHECK(probe.initialize() && probe.isMapped());
+        capacity = probe.getSlotCapacity();
+    }
+    {
+        System system(std::make_unique<MappedStorage>(HEAP));
+        CHECK(system.loadData());
+        for (int i = 0; i < static_cast<int>(capacity); ++i) {
+            CHECK(system.addStudent(testStudent(991000 + i, std::to_string(i) + " Mapped Lane")));
+        }
+        CHECK(system.getStudentCount() == csv.students.size() + 1 + capacity);
+    }
+    {
+        MappedStorage grown(HEAP);
+        CHECK(grown.initialize());
+        CHECK(grown.getSlotCapacity() >= 2 * capacity && grown.getSlotCount() > capacity);
+        const auto reopened = stored();
+        CHECK(reopened->students.size() == csv.students.size() + 1 + capacity);
+        CHECK(reopened->student(991000) != nullptr && reopened->student(991000)->getAddress() == "0 Mapped Lane");
+        CHECK(reopened->course(removedCourseId) == nullptr);
+    }
+
+    // Damage one student's address in the string heap. Opening still works and edits to other
+    // records still land: only reading that record notices
+    {
+        std::string bytes = fileBytes();
+        const size_t address = bytes.find("17 Mapped Lane");
+        CHECK(address != std::string::npos);
+        bytes[address] = '9';
+        std::ofstream(HEAP, std::ios::binary | std::ios::trunc) << bytes;
+
+        MappedStorage storage(HEAP);
+        CHECK(storage.initialize());
+        CHECK_MSG(storage.saveStudent(testStudent(990002, "2 Test Rd")), storage.getLastError());
+        CHECK(storage.removeStudent(991003));
+
+        Snapshot rejected;
+        CHECK(!storage.load(rejected.students, rejected.courses, rejected.assessments));
+        CHECK_MSG(storage.getLastError().find("checksum") != std::string::npos, storage.getLastError());
+        CHECK(rejected.students.empty());
+
+        // Rewriting the record from the entity repairs it
+        CHECK(storage.saveStudent(testStudent(991017, "17 Mapped Lane")));
+        const auto repaired = stored();
+        CHECK(repaired->student(991017) != nullptr && repaired->student(991017)->getAddress() == "17 Mapped Lane");
+        CHECK(repaired->student(990002) != nullptr && repaired->student(991003) == nullptr);
+    }
+
+    std::filesystem::current_path(std::filesystem::temp_directory_path());
+    std::filesystem::remove_all(directory);
+    return finish("MappedStorageTest");
+}
@@ -0,0 +1,148 @@
+// StudentNameIndex: the bit-parallel edit distance against a plain DP, and fuzzy search
+// (q-gram filter plus verification) against checking every indexed name term
+
+#include "TestSupport.hpp"
+#include "StudentNameIndex.hpp"
+#include "Student.hpp"
+#include "EntityArena.hpp"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+using namespace PokenoSouth;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    // Textbook Levenshtein distance, full table
+    int referenceDistance(const std::string& pattern, const std::string& text) {
+        std::vector<std::vector<int>> table(pattern.size() + 1, std::vector<int>(text.size() + 1));
+        for (size_t i = 0; i <= pattern.size(); ++i) table[i][0] = static_cast<int>(i);
+        for (size_t j = 0; j <= text.size(); ++j) table[0][j] = static_cast<int>(j);
+        for (size_t i = 1; i <= pattern.size(); ++i) {
+            for (size_t j = 1; j <= text.size(); ++j) {
+                table[i][j] = std::min({table[i - 1][j] + 1, table[i][j - 1] + 1,
+                                        table[i - 1][j - 1] + (pattern[i - 1] != text[j - 1] ? 1 : 0)});
+            }
+        }
+        return table[pattern.size()][text.size()];
+    }
+
+    std::string randomText(TestRandom& random, const std::string& alphabet, size_t length) {
+        std::string text;
+        for (size_t i = 0; i < length; ++i) text += random.pick(alphabet);
+        return text;
+    }
+
+    // A few random edits of 'text', so related pairs (small distances) are common
+    std::string mutate(TestRandom& random, std::string text, const std::string& alphabet, size_t edits) {
+        for (size_t e = 0; e < edits; ++e) {
+            const size_t position = text.empty() ? 0 : random.below(text.size() + 1);
+            switch (random.below(3)) {
+                case 0: text.insert(text.begin() + position, random.pick(alphabet)); break;
+                case 1: if (position < text.size()) text.erase(position, 1); break;
+                default: if (position < text.size()) text[position] = random.pick(alphabet); break;
+            }
+        }
+        return text;
+    }
+
+    // editDistance() is exact up to maxDistance and only promises "more" beyond it
+    void checkDistance(const std::string& pattern, const std::string& text, int maxDistance) {
+        const int expected = referenceDistance(pattern, text);
+        const int actual = StudentNameIndex::editDistance(pattern, text, maxDistance);
+        const bool agrees = expected <= maxDistance ? actual == expected : actual > maxDistance;
+        CHECK_MSG(agrees, "\"" + pattern + "\" vs \"" + text + "\" (max " + std::to_string(maxDistance) +
+                          "): expected " + std::to_string(expected) + ", got " + std::to_string(actual));
+    }
+
+    void checkEditDistance() {
+        // Fixed cases: empty strings, identical, and the word-size boundary
+        checkDistance("", "", 0);
+        checkDistance("", "abc", 5);
+        checkDistance("abc", "", 5);
+        checkDistance("abc", "", 1);
+        checkDistance("kitten", "sitting", 3);
+        checkDistance("kitten", "sitting", 2);
+        checkDistance("flaw", "lawn", 2);
+        checkDistance("same", "same", 0);
+        const std::string word63(63, 'a'), word64(64, 'a'), word65(65, 'a');
+        for (const std::string* pattern : {&word63, &word64, &word65}) {
+            checkDistance(*pattern, *pattern, 0);
+            checkDistance(*pattern, *pattern + "b", 1);
+            checkDistance(*pattern, "b" + pattern->substr(1), 1);
+            checkDistance(*pattern, std::string(pattern->size(), 'b'), 200);
+            checkDistance(*pattern, "", 100);
+        }
+
+        TestRandom random;
+        const std::string lowercase = "abcdefghijklmnopqrstuvwxyz";
+        const std::string printable = " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+        const std::string highBytes = "ab\x80\xc3\xa9\xff";
+        for (const std::string* alphabet : {&lowercase, &printable, &highBytes}) {
+            for (int round = 0; round < 3000; ++round) {
+                // Mostly name-sized, with enough long patterns to cover the DP fallback above 64
+                const size_t length = random.chance(15) ? 60 + random.below(30) : random.below(16);
+                const std::string pattern = randomText(random, *alphabet, length);
+                const std::string text = random.chance(70)
+                    ? mutate(random, pattern, *alphabet, random.below(6))
+                    : randomText(random, *alphabet, random.below(length + 8));
+                checkDistance(pattern, text, static_cast<int>(random.below(6)));
+                checkDistance(pattern, text, static_cast<int>(pattern.size() + text.size()));
+            }
+        }
+    }
+
+    void checkFuzzySearch() {
+        // Names from a few syllables, so many terms lie within an edit or two of each other
+        TestRandom random(7);
+        const std::vector<std::string> syllables = {"ka", "ri", "to", "ma", "ne", "hu", "ana", "ti", "wa", "ro"};
+        auto name = [&]() {
+            std::string text;
+            const size_t count = 1 + random.below(4);
+            for (size_t i = 0; i < count; ++i) text += syllables[random.below(syllables.size())];
+            return text;
+        };
+
+        EntityArena<Student> students;
+        const Date born = Date::parse("2015-03-04");
+        const Date enrolled = Date::parse("2024-02-01");
+        for (int rollNumber = 1; rollNumber <= 400; ++rollNumber) {
+            students.emplace(TRUSTED_INPUT, rollNumber, name(), name(), born, "1 Main Rd",
+                             "family@example.nz", "0210000000", enrolled);
+        }
+        StudentNameIndex index;
+        index.rebuild(students);
+
+        const std::string letters = "aehikmnortuw";
+        for (int round = 0; round < 300; ++round) {
+            const std::string token = random.chance(80) ? mutate(random, name(), letters, random.below(3))
+                                                        : randomText(random, letters, 1 + random.below(8));
+            if (token.empty()) continue;
+            const int maxDistance = static_cast<int>(random.below(StudentNameIndex::MAX_EDIT_DISTANCE + 1));
+            const int limit = StudentNameIndex::editDistanceLimit(token.size(), maxDistance);
+
+            std::set<int> expected;
+            for (const Student* student : students) {
+                for (const std::string& field : {student->getFirstName(), student->getLastName()}) {
+                    for (const std::string& term : StudentNameIndex::tokenize(field)) {
+                        if (referenceDistance(token, term) <= limit) expected.insert(student->getRollNumber());
+                    }
+                }
+            }
+            std::set<int> actual;
+            for (const NameMatch& match : index.fuzzySearch(token, maxDistance, students.size())) {
+                actual.insert(match.rollNumber);
+            }
+            CHECK_MSG(actual == expected, "fuzzy \"" + token + "\" (max " + std::to_string(maxDistance) + "): " +
+                                          std::to_string(actual.size()) + " matches, expected " +
+                                          std::to_string(expected.size()));
+        }
+    }
+}
+
+int main() {
+    checkEditDistance();
+    checkFuzzySearch();
+    return finish("NameIndexTest");
+}
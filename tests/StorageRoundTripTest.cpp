@@ -0,0 +1,232 @@
+// Every storage backend: save a school, load it into empty arenas and compare every field,
+// enrollment and assessment; and System's first-start import of data/*.csv into an empty
+// non-CSV backend
+
+#include "TestSupport.hpp"
+#include "System.hpp"
+#include "StorageBackend.hpp"
+#include "CsvStorage.hpp"
+#include "GradingPolicy.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace PokenoSouth;
+using namespace PokenoSouth::Testing;
+
+namespace {
+    struct School {
+        EntityArena<Student> students;
+        EntityArena<Course> courses;
+        EntityArena<Assessment> assessments;
+    };
+
+    std::string number(double value) {
+        char text[32];
+        std::snprintf(text, sizeof text, "%.6f", value);
+        return text;
+    }
+
+    template <typename T>
+    std::string joined(std::vector<T> values) {
+        std::sort(values.begin(), values.end());
+        std::string text;
+        for (const T& value : values) {
+            if constexpr (std::is_same_v<T, std::string>) text += value + ";";
+            else text += std::to_string(value) + ";";
+        }
+        return text;
+    }
+
+    // Every stored field and link of every entity, one line each, in a fixed order
+    std::vector<std::string> describe(const School& school) {
+        std::vector<std::string> lines;
+        for (const Student* student : school.students) {
+            std::vector<std::string> courseIds, assessmentIds;
+            for (const Course* course : student->getEnrolledCourses()) courseIds.push_back(course->getCourseId());
+            for (const Assessment* assessment : student->getAssessments()) assessmentIds.push_back(assessment->getAssessmentId());
+            lines.push_back("student " + std::to_string(student->getRollNumber()) + "|" + student->getFirstName() + "|" +
+                            student->getLastName() + "|" + student->getDateOfBirth().toString() + "|" +
+                            student->getAddress() + "|" + student->getContactEmail() + "|" +
+                            student->getEmergencyContact() + "|" + student->getEnrollmentDate().toString() +
+                            "|courses " + joined(courseIds) + "|assessments " + joined(assessmentIds) +
+                            "|overall " + number(student->getOverallGrade()));
+        }
+        for (const Course* course : school.courses) {
+            lines.push_back("course " + course->getCourseId() + "|" + course->getCourseName() + "|" +
+                            std::to_string(course->getCredits()) + "|" + course->getDescription() + "|" +
+                            std::to_string(course->getDuration()) + "|" + course->getTeacher() + "|" +
+                            course->getStartDate().toString() + "|" + course->getEndDate().toString() + "|" +
+                            std::to_string(course->getMaxEnrollment()) + "|" + (course->getIsActive() ? "active" : "inactive") +
+                            "|" + course->getGradingPolicyName() + "|students " + joined(course->getEnrolledRollNumbers()) +
+                            "|average " + number(course->getCourseAverageGrade()));
+        }
+        for (const Assessment* assessment : school.assessments) {
+            lines.push_back("assessment " + assessment->getAssessmentId() + "|" +
+                            std::to_string(assessment->getStudentRollNumber()) + "|" + assessment->getCourseId() + "|" +
+                            number(assessment->getInternalMarks()) + "|" + number(assessment->getFinalMarks()) + "|" +
+                            assessment->getAssessmentDate().toString() + "|" + assessment->getAssessmentType() + "|" +
+                            (assessment->getIsSubmitted() ? "submitted" : "pending") + "|" +
+                            assessment->getSubmissionDate().toString() + "|" + assessment->getRemarks() + "|" +
+                            number(assessment->getCalculatedGrade()) + "|owner " +
+                            (assessment->getOwner() ? std::to_string(assessment->getOwner()->getRollNumber()) : "none"));
+        }
+        std::sort(lines.begin(), lines.end());
+        return lines;
+    }
+
+    // Values every backend must keep exactly: separators and quotes in text, empty optional
+    // dates, an inactive course, a non-default grading policy, and marks at the CSV's precision
+    void buildSchool(School& school) {
+        const Date start = Date::parse("2024-02-05");
+        Course* maths = school.courses.emplace(TRUSTED_INPUT, "RT101", "Round Trips", 3, "Numbers, \"exactly\" as saved",
+                                               12, "Ms. Parata", start, start.addDays(84), 25, true);
+        Course* art = school.courses.emplace(TRUSTED_INPUT, "RT102", "Art, Craft", 2, "Paint; clay", 10, "Mr. Ngata",
+                                             Date(), Date(), 15, true);
+        school.courses.emplace(TRUSTED_INPUT, "RT103", "Retired", 1, "No longer offered", 8, "Staff",
+                               start, start.addDays(56), 10, false);
+        art->setGradingPolicy("drop-lowest");
+
+        std::vector<Student*> roll;
+        for (int i = 0; i < 5; ++i) {
+            roll.push_back(school.students.emplace(TRUSTED_INPUT, 7001 + i, "Kiri" + std::string(1, static_cast<char>('a' + i)),
+                                                   i % 2 ? "O'Neill" : "Smith-Jones", Date::parse("2015-03-04").addDays(40 * i),
+                                                   std::to_string(10 + i) + " Main Rd, Pokeno", "whanau" + std::to_string(i) + "@example.nz",
+                                                   "021555000" + std::to_string(i), start.addDays(-i)));
+        }
+        for (size_t i = 0; i < roll.size(); ++i) {
+            for (Course* course : {maths, art}) {
+                if (course == art && i % 2 == 1) continue;
+                if (roll[i]->attachCourse(course)) course->attachStudent(roll[i]);
+            }
+        }
+
+        const double marks[][2] = {{72.5, 64.0}, {88.0, 91.5}, {40.5, 55.0}, {100.0, 0.0}, {63.0, 47.5}};
+        int next = 0;
+        for (size_t i = 0; i < roll.size(); ++i) {
+            for (Course* course : {maths, art}) {
+                if (!roll[i]->isEnrolledInCourse(course->getCourseId())) continue;
+                for (int sitting = 0; sitting < 2; ++sitting, ++next) {
+                    const bool submitted = next % 4 != 3;
+                    const Date date = start.addDays(14 * (sitting + 1));
+                    Assessment* assessment = school.assessments.emplace(
+                        TRUSTED_INPUT, "RT-" + std::to_string(next), roll[i]->getRollNumber(), course->getCourseId(),
+                        marks[next % 5][0], marks[next % 5][1], date, sitting ? "Final Exam" : "Quiz", submitted,
+                        submitted ? date.addDays(next % 3) : Date(), next % 2 ? "Good work, \"keep going\"" : "");
+                    roll[i]->addAssessment(assessment);
+                }
+            }
+        }
+    }
+
+    void forgetPolicies(const School& school) {
+        for (const Course* course : school.courses) GradingPolicyRegistry::shared().unassign(course->getCourseKey());
+    }
+
+    void checkRoundTrips() {
+        School original;
+        buildSchool(original);
+        const std::vector<std::string> expected = describe(original);
+
+        for (const char* kind : {"csv", "snapshot", "memory", "btree", "mapped"}) {
+            std::unique_ptr<StorageBackend> storage = StorageBackend::create(kind);
+            CHECK_MSG(storage->initialize(), std::string(kind) + ": initialize failed");
+
+            // Nothing stored yet: load says so without an error, which is what triggers an import
+            School empty;
+            if (std::string(kind) != "csv") {
+                CHECK_MSG(!storage->load(empty.students, empty.courses, empty.assessments) && storage->getLastError().empty(),
+                          std::string(kind) + ": an empty store should load nothing, without an error");
+            }
+
+            CHECK_MSG(storage->save(original.students, original.courses, original.assessments),
+                      std::string(kind) + ": save failed: " + storage->getLastError());
+            forgetPolicies(original);   // Only the stored copy knows RT102's policy now
+
+            School loaded;
+            CHECK_MSG(storage->load(loaded.students, loaded.courses, loaded.assessments),
+                      std::string(kind) + ": load failed: " + storage->getLastError());
+            const std::vector<std::string> actual = describe(loaded);
+            CHECK_MSG(actual.size() == expected.size(), std::string(kind) + ": " + std::to_string(actual.size()) +
+                                                        " records, expected " + std::to_string(expected.size()));
+            for (size_t i = 0; i < std::min(actual.size(), expected.size()); ++i) {
+                CHECK_MSG(actual[i] == expected[i], std::string(kind) + ":\n  saved  " + expected[i] + "\n  loaded " + actual[i]);
+            }
+
+            // Saving what was loaded changes nothing
+            CHECK(storage->save(loaded.students, loaded.courses, loaded.assessments));
+            School reloaded;
+            CHECK(storage->load(reloaded.students, reloaded.courses, reloaded.assessments));
+            CHECK_MSG(describe(reloaded) == expected, std::string(kind) + ": second round trip differs");
+
+            GradingPolicyRegistry::shared().assign(SymbolTable::courseIds().find("RT102"), "drop-lowest");
+        }
+        forgetPolicies(original);
+    }
+
+    void checkCsvImport(const std::filesystem::path& directory) {
+        // The sample data, as the CSV backend reads it
+        std::filesystem::remove_all(directory / "data");
+        std::filesystem::copy(POKENO_TEST_DATA_DIR, directory / "data", std::filesystem::copy_options::recursive);
+        School csv;
+        CsvStorage csvStorage;
+        CHECK(csvStorage.load(csv.students, csv.courses, csv.assessments));
+        const std::vector<std::string> expected = describe(csv);
+        CHECK(!csv.students.empty() && !csv.assessments.empty());
+
+        for (const char* kind : {"snapshot", "btree", "mapped", "memory"}) {
+            std::filesystem::remove(directory / "data" / "snapshot.bin");
+            std::filesystem::remove(directory / "data" / "records.btree");
+            std::filesystem::remove(directory / "data" / "entities.heap");
+
+            // First start on an empty backend: System imports the CSV files and saves them into it
+            {
+                System system(StorageBackend::create(kind));
+                CHECK_MSG(system.loadData(), std::string(kind) + ": load failed");
+                CHECK_MSG(system.getStudentCount() == csv.students.size() && system.getCourseCount() == csv.courses.size() &&
+                          system.getAssessmentCount() == csv.assessments.size(),
+                          std::string(kind) + ": import counts differ from the CSV files");
+                CHECK(system.getEnrollmentCount() > 0);
+            }
+            if (std::string(kind) == "memory") continue;   // Gone with its System
+
+            // The backend now holds the same school on its own
+            std::unique_ptr<StorageBackend> storage = StorageBackend::create(kind);
+            School imported;
+            CHECK_MSG(storage->load(imported.students, imported.courses, imported.assessments),
+                      std::string(kind) + ": imported data did not load: " + storage->getLastError());
+            CHECK_MSG(describe(imported) == expected, std::string(kind) + ": imported data differs from the CSV files");
+        }
+
+        // A backend that already has data is never overwritten by the CSV files
+        {
+            System system(StorageBackend::create("snapshot"));
+            CHECK(system.loadData());
+            CHECK(system.removeStudent((*csv.students.begin())->getRollNumber()));
+            CHECK(system.saveData());
+        }
+        System restarted(StorageBackend::create("snapshot"));
+        CHECK(restarted.loadData());
+        CHECK(restarted.getStudentCount() == csv.students.size() - 1);
+    }
+}
+
+int main() {
+    // Every backend uses fixed paths under data/ in the working directory
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "pokeno_storage_round_trip_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory / "data");
+    const std::filesystem::path previous = std::filesystem::current_path();
+    std::filesystem::current_path(directory);
+
+    checkRoundTrips();
+    checkCsvImport(directory);
+
+    std::filesystem::current_path(previous);
+    std::filesystem::remove_all(directory);
+    return finish("StorageRoundTripTest");
+}
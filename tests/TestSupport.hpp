@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace PokenoSouth {
+    /**
+     * TestSupport for Pokeno South Primary School
+     * Just enough harness for the ctest programs under tests/
+     *
+     * Key Features:
+     * - CHECK(condition) and CHECK_MSG(condition, detail) report the first few failures with
+     *   file, line and detail, and keep counting after that
+     * - finish() prints a one-line summary and returns the process exit code
+     * - TestRandom is a fixed-seed generator, so a failing corpus reproduces exactly
+     * - nanosecondsPerCall() times a callable for benchmarks
+     */
+    namespace Testing {
+        inline int& failures() {
+            static int count = 0;
+            return count;
+        }
+
+        inline void report(bool passed, const char* expression, const char* file, int line,
+                           const std::string& detail = "") {
+            if (passed) return;
+            if (++failures() <= 20) {
+                std::fprintf(stderr, "%s:%d: CHECK(%s) failed%s%s\n", file, line, expression,
+                             detail.empty() ? "" : ": ", detail.c_str());
+            }
+        }
+
+        inline int finish(const char* testName) {
+            if (failures() == 0) {
+                std::printf("%s: all checks passed\n", testName);
+                return 0;
+            }
+            std::printf("%s: %d check(s) failed\n", testName, failures());
+            return 1;
+        }
+
+        struct TestRandom {
+            std::mt19937_64 engine;
+
+            explicit TestRandom(uint64_t seed = 20261018) : engine(seed) {}
+
+            size_t below(size_t bound) { return static_cast<size_t>(engine() % bound); }
+            bool chance(size_t percent) { return below(100) < percent; }
+            char pick(const std::string& alphabet) { return alphabet[below(alphabet.size())]; }
+        };
+
+        // Average wall time of 'call' over 'iterations' runs, in nanoseconds
+        template <typename Call>
+        double nanosecondsPerCall(size_t iterations, Call&& call) {
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i) call(i);
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            return elapsed.count() / static_cast<double>(iterations);
+        }
+    }
+}
+
+#define CHECK(condition) ::PokenoSouth::Testing::report((condition), #condition, __FILE__, __LINE__)
+#define CHECK_MSG(condition, detail) ::PokenoSouth::Testing::report((condition), #condition, __FILE__, __LINE__, (detail))
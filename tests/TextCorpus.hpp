@@ -0,0 +1,118 @@
+#pragma once
+
+#include "TestSupport.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+namespace PokenoSouth {
+    /**
+     * TextCorpus for Pokeno South Primary School
+     * Reference versions and generated inputs for Common's text utilities
+     *
+     * Key Features:
+     * - The references are the implementations from before the string_view/PatternMatcher rewrite:
+     *   trim, lower-case and collapse whitespace into a new string, then find() each pattern
+     * - One intended difference: isSafeInput's upper-case patterns ("DROP TABLE" ...) could never
+     *   match the lower-cased text, so the reference lists them in lower case, as now matched
+     * - Inputs are remark-like text spliced with pattern fragments in random case, whitespace runs
+     *   of mixed kinds (including inside a pattern), NUL and non-ASCII bytes
+     */
+    namespace Testing {
+        inline bool isSpaceByte(char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; }
+
+        inline std::string referenceNormalizeText(const std::string& input) {
+            const size_t start = input.find_first_not_of(" \t\n\r\f\v");
+            if (start == std::string::npos) return "";
+            const size_t end = input.find_last_not_of(" \t\n\r\f\v");
+            std::string normalized = input.substr(start, end - start + 1);
+            std::transform(normalized.begin(), normalized.end(), normalized.begin(),
+                           [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+            auto last = std::unique(normalized.begin(), normalized.end(),
+                                    [](char a, char b) { return isSpaceByte(a) && isSpaceByte(b); });
+            normalized.erase(last, normalized.end());
+            return normalized;
+        }
+
+        inline const std::vector<std::string>& dangerousPatterns() {
+            static const std::vector<std::string> patterns = {
+                "../", "..\\", "<script", "</script", "javascript:",
+                "vbscript:", "onload=", "onerror=", "onclick=",
+                "drop table", "delete from", "insert into", "update set"
+            };
+            return patterns;
+        }
+
+        inline const std::vector<std::string>& sqlKeywords() {
+            static const std::vector<std::string> keywords = {
+                "select ", "insert ", "update ", "delete ", "drop ", "create ",
+                "alter ", "truncate ", "exec ", "execute ", "union ", "or 1=1",
+                "and 1=1", "' or ", "\" or ", "; --", "/*", "*/"
+            };
+            return keywords;
+        }
+
+        inline bool referenceIsSafeInput(const std::string& input) {
+            if (input.find('\0') != std::string::npos) return false;
+            const std::string lowerInput = referenceNormalizeText(input);
+            for (const std::string& pattern : dangerousPatterns()) {
+                if (lowerInput.find(pattern) != std::string::npos) return false;
+            }
+            return true;
+        }
+
+        inline bool referenceIsSafeSQLInput(const std::string& input) {
+            const std::string lowerInput = referenceNormalizeText(input);
+            for (const std::string& keyword : sqlKeywords()) {
+                if (lowerInput.find(keyword) != std::string::npos) return false;
+            }
+            return true;
+        }
+
+        inline std::vector<std::string> makeTextCorpus(size_t count, TestRandom& random) {
+            static const std::vector<std::string> words = {
+                "Good", "progress", "in", "reading", "needs", "support", "with", "fractions", "Term 2",
+                "O'Brien", "Te Reo", "excellent", "homework", "1=1", "or", "and", "--", ";", "'", "\""
+            };
+            const std::string spaces = " \t\n\r\f\v";
+            const std::string noise = std::string("aZ.:/\\<=*-") + '\0' + "\xC3\xA9\xFF";
+
+            std::vector<std::string> corpus;
+            corpus.reserve(count);
+            for (size_t n = 0; n < count; ++n) {
+                std::string text;
+                auto addSpaces = [&](size_t maxRun) {
+                    for (size_t i = random.below(maxRun + 1); i > 0; --i) text += random.pick(spaces);
+                };
+                addSpaces(2);
+                for (size_t piece = 1 + random.below(8); piece > 0; --piece) {
+                    const size_t kind = random.below(10);
+                    std::string part;
+                    if (kind < 5) {
+                        part = words[random.below(words.size())];
+                    } else if (kind < 7) {
+                        part = dangerousPatterns()[random.below(dangerousPatterns().size())];
+                    } else if (kind < 9) {
+                        part = sqlKeywords()[random.below(sqlKeywords().size())];
+                    } else {
+                        for (size_t i = 1 + random.below(3); i > 0; --i) part += random.pick(noise);
+                    }
+                    for (char& c : part) {
+                        if (isSpaceByte(c) && random.chance(50)) {
+                            c = random.pick(spaces);   // Same run after collapsing, different bytes
+                        } else if (random.chance(30)) {
+                            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+                        }
+                    }
+                    if (random.chance(10) && part.size() > 1) part.erase(random.below(part.size()), 1);
+                    text += part;
+                    addSpaces(3);
+                }
+                corpus.push_back(std::move(text));
+            }
+            return corpus;
+        }
+    }
+}
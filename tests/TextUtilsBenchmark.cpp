@@ -0,0 +1,43 @@
+// Benchmark: Common::isSafeInput / isSafeSQLInput / normalizeTextInto against the
+// normalize-then-find implementations they replaced (see TextCorpus.hpp)
+
+#include "TextCorpus.hpp"
+#include "common.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace PokenoSouth::Testing;
+
+namespace {
+    volatile size_t sink = 0;   // Keeps the timed calls from being optimized away
+
+    template <typename Current, typename Reference>
+    void compare(const char* what, const std::vector<std::string>& corpus, Current current, Reference reference) {
+        const size_t calls = corpus.size();
+        const double currentNs = nanosecondsPerCall(calls, [&](size_t i) { sink = sink + current(corpus[i]); });
+        const double referenceNs = nanosecondsPerCall(calls, [&](size_t i) { sink = sink + reference(corpus[i]); });
+        std::printf("%-18s current %8.1f ns | previous %8.1f ns | %5.1fx\n",
+                    what, currentNs, referenceNs, referenceNs / currentNs);
+        CHECK_MSG(currentNs < referenceNs, std::string(what) + " is not faster than before");
+    }
+}
+
+int main(int argc, char** argv) {
+    // Optional scale factor: TextUtilsBenchmark 10 runs ten times the default corpus
+    const size_t scale = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1;
+
+    TestRandom random;
+    const std::vector<std::string> corpus = makeTextCorpus(100000 * scale, random);
+
+    compare("isSafeInput", corpus,
+            [](const std::string& s) { return Common::isSafeInput(s); }, referenceIsSafeInput);
+    compare("isSafeSQLInput", corpus,
+            [](const std::string& s) { return Common::isSafeSQLInput(s); }, referenceIsSafeSQLInput);
+    std::string buffer;
+    compare("normalizeText", corpus,
+            [&buffer](const std::string& s) { Common::normalizeTextInto(s, buffer); return buffer.size(); },
+            [](const std::string& s) { return referenceNormalizeText(s).size(); });
+
+    return finish("TextUtilsBenchmark");
+}
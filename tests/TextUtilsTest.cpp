@@ -0,0 +1,67 @@
+// Differential test: Common::isSafeInput / isSafeSQLInput / normalizeText against the
+// implementations they replaced (see TextCorpus.hpp)
+
+#include "TextCorpus.hpp"
+#include "common.hpp"
+
+using namespace PokenoSouth::Testing;
+
+namespace {
+    std::string printable(const std::string& text) {
+        std::string shown;
+        for (char c : text) {
+            const unsigned char byte = static_cast<unsigned char>(c);
+            if (byte >= 32 && byte < 127) {
+                shown += c;
+            } else {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\x%02X", byte);
+                shown += escaped;
+            }
+        }
+        return shown;
+    }
+
+    void checkKnownCases() {
+        CHECK(Common::normalizeText("  Hello \t\n World  ") == "hello world");
+        CHECK(Common::normalizeText("A\t \nB") == "a\tb");   // A run keeps its first character
+        CHECK(Common::normalizeText(" \t ").empty());
+        CHECK(Common::isSafeInput("Great work on fractions"));
+        CHECK(!Common::isSafeInput("see ../etc/passwd"));
+        CHECK(!Common::isSafeInput("Drop \t Table students"));
+        CHECK(!Common::isSafeInput(std::string("ok\0ok", 5)));
+        CHECK(Common::isSafeSQLInput("Selected for the team"));
+        CHECK(!Common::isSafeSQLInput("x' OR 1=1; --"));
+        CHECK(!Common::isSafeSQLInput("UNION\n\nselect *"));
+    }
+}
+
+int main() {
+    checkKnownCases();
+
+    TestRandom random;
+    const std::vector<std::string> corpus = makeTextCorpus(200000, random);
+    size_t unsafe = 0, unsafeSql = 0;
+    std::string buffer;
+    for (const std::string& input : corpus) {
+        const std::string expected = referenceNormalizeText(input);
+        CHECK_MSG(Common::normalizeText(input) == expected, "normalizeText on \"" + printable(input) + "\"");
+        Common::normalizeTextInto(input, buffer);   // Reused buffer must not leak earlier contents
+        CHECK_MSG(buffer == expected, "normalizeTextInto on \"" + printable(input) + "\"");
+
+        const bool safe = referenceIsSafeInput(input);
+        unsafe += safe ? 0 : 1;
+        CHECK_MSG(Common::isSafeInput(input) == safe, "isSafeInput on \"" + printable(input) + "\"");
+
+        const bool safeSql = referenceIsSafeSQLInput(input);
+        unsafeSql += safeSql ? 0 : 1;
+        CHECK_MSG(Common::isSafeSQLInput(input) == safeSql, "isSafeSQLInput on \"" + printable(input) + "\"");
+    }
+    // Both verdicts must be common for the comparison to mean anything
+    CHECK_MSG(unsafe > corpus.size() / 10 && unsafe < corpus.size() * 9 / 10,
+              "isSafeInput rejected " + std::to_string(unsafe) + " of " + std::to_string(corpus.size()));
+    CHECK_MSG(unsafeSql > corpus.size() / 10 && unsafeSql < corpus.size() * 9 / 10,
+              "isSafeSQLInput rejected " + std::to_string(unsafeSql) + " of " + std::to_string(corpus.size()));
+
+    return finish("TextUtilsTest");
+}
@@ -0,0 +1,47 @@
+// Benchmark: Common::isValidEmail / isValidDateFormat against the regex versions they replaced.
+// The old validators compiled their regex on every call, so the "regex (per call)" column is the
+// former cost; "regex (precompiled)" separates the matching from the compiling.
+
+#include "ValidatorCorpus.hpp"
+#include "common.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace PokenoSouth::Testing;
+
+namespace {
+    volatile size_t sink = 0;   // Keeps the timed calls from being optimized away
+
+    template <typename Matcher, typename Reference>
+    void compare(const char* what, const std::vector<std::string>& corpus, const char* pattern,
+                 Matcher matcher, Reference reference, size_t regexCalls) {
+        const size_t calls = corpus.size();
+        const double matcherNs = nanosecondsPerCall(calls, [&](size_t i) { sink = sink + matcher(corpus[i]); });
+        const double precompiledNs = nanosecondsPerCall(calls, [&](size_t i) { sink = sink + reference(corpus[i]); });
+        const double perCallNs = nanosecondsPerCall(regexCalls, [&](size_t i) {
+            const std::regex compiled(pattern);
+            sink = sink + std::regex_match(corpus[i % calls], compiled);
+        });
+
+        std::printf("%-18s matcher %8.1f ns | regex (precompiled) %9.1f ns | regex (per call) %10.1f ns | %6.0fx\n",
+                    what, matcherNs, precompiledNs, perCallNs, perCallNs / matcherNs);
+        CHECK_MSG(matcherNs < perCallNs, std::string(what) + " matcher is not faster than the old regex");
+    }
+}
+
+int main(int argc, char** argv) {
+    // Optional scale factor: ValidatorBenchmark 10 runs ten times the default corpus
+    const size_t scale = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1;
+
+    TestRandom random;
+    const std::vector<std::string> emails = makeEmailCorpus(100000 * scale, random);
+    const std::vector<std::string> dates = makeDateCorpus(100000 * scale, random);
+
+    compare("isValidEmail", emails, R"(^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}$)",
+            [](const std::string& s) { return Common::isValidEmail(s); }, referenceIsValidEmail, 2000 * scale);
+    compare("isValidDateFormat", dates, R"(^\d{4}-\d{2}-\d{2}$)",
+            [](const std::string& s) { return Common::isValidDateFormat(s); }, referenceIsValidDateFormat, 2000 * scale);
+
+    return finish("ValidatorBenchmark");
+}
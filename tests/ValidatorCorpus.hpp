@@ -0,0 +1,87 @@
+#pragma once
+
+#include "TestSupport.hpp"
+
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace PokenoSouth {
+    /**
+     * ValidatorCorpus for Pokeno South Primary School
+     * Reference regexes and generated inputs for the Common:: email and date validators
+     *
+     * Key Features:
+     * - The references are the exact patterns the validators used before the hand-written
+     *   matchers replaced them, compiled once here
+     * - Corpora mix random strings over a validator-heavy alphabet (plus newlines, spaces and
+     *   non-ASCII bytes) with valid inputs put through a few random edits, so both accepted and
+     *   near-miss rejected inputs are common
+     */
+    namespace Testing {
+        inline bool referenceIsValidEmail(const std::string& email) {
+            if (email.empty()) return false;
+            static const std::regex emailPattern(R"(^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}$)");
+            return std::regex_match(email, emailPattern);
+        }
+
+        inline bool referenceIsValidDateFormat(const std::string& date) {
+            static const std::regex datePattern(R"(^\d{4}-\d{2}-\d{2}$)");
+            return std::regex_match(date, datePattern);
+        }
+
+        // Up to 'maxEdits' random insertions, deletions and replacements drawn from 'alphabet'
+        inline void mutate(std::string& text, TestRandom& random, const std::string& alphabet, size_t maxEdits) {
+            const size_t edits = random.below(maxEdits + 1);
+            for (size_t e = 0; e < edits; ++e) {
+                const size_t at = text.empty() ? 0 : random.below(text.size());
+                switch (random.below(3)) {
+                case 0: text.insert(text.begin() + static_cast<std::ptrdiff_t>(at), random.pick(alphabet)); break;
+                case 1: if (!text.empty()) text.erase(at, 1); break;
+                default: if (!text.empty()) text[at] = random.pick(alphabet); break;
+                }
+            }
+        }
+
+        inline std::vector<std::string> makeEmailCorpus(size_t count, TestRandom& random) {
+            const std::string alphabet = std::string("aZk09._%+-@@..-") + "\n \xC3\xA9!";
+            const std::string letters = "abcxyzABCXYZ";
+            const std::string localChars = "abcXYZ019._%+-";
+            const std::string domainChars = "abcXYZ019.-";
+
+            std::vector<std::string> corpus;
+            corpus.reserve(count);
+            for (size_t n = 0; n < count; ++n) {
+                std::string email;
+                if (random.chance(30)) {
+                    const size_t length = random.below(24);
+                    for (size_t i = 0; i < length; ++i) email += random.pick(alphabet);
+                } else {
+                    for (size_t i = 1 + random.below(8); i > 0; --i) email += random.pick(localChars);
+                    email += '@';
+                    for (size_t i = 1 + random.below(8); i > 0; --i) email += random.pick(domainChars);
+                    email += '.';
+                    for (size_t i = random.below(5); i > 0; --i) email += random.pick(letters);
+                    mutate(email, random, alphabet, 2);
+                }
+                corpus.push_back(std::move(email));
+            }
+            return corpus;
+        }
+
+        inline std::vector<std::string> makeDateCorpus(size_t count, TestRandom& random) {
+            const std::string alphabet = std::string("0123456789--/ x") + "\n\xD9\xA3";
+            std::vector<std::string> corpus;
+            corpus.reserve(count);
+            for (size_t n = 0; n < count; ++n) {
+                std::string date = "dddd-dd-dd";
+                for (char& c : date) {
+                    if (c == 'd') c = static_cast<char>('0' + random.below(10));
+                }
+                mutate(date, random, alphabet, 2);
+                corpus.push_back(std::move(date));
+            }
+            return corpus;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+// Differential test: Common::isValidEmail / isValidDateFormat against the regexes they replaced
+
+#include "ValidatorCorpus.hpp"
+#include "common.hpp"
+
+using namespace PokenoSouth::Testing;
+
+namespace {
+    void checkKnownCases() {
+        CHECK(Common::isValidEmail("parent@pokeno.school.nz"));
+        CHECK(Common::isValidEmail("a.b+c_d%e-f@x-y.co"));
+        CHECK(!Common::isValidEmail(""));
+        CHECK(!Common::isValidEmail("@pokeno.nz"));
+        CHECK(!Common::isValidEmail("parent@.nz"));
+        CHECK(!Common::isValidEmail("parent@pokeno.n"));
+        CHECK(!Common::isValidEmail("parent@pokeno.nz\n"));
+        CHECK(!Common::isValidEmail("parent@pokeno.n2"));
+
+        CHECK(Common::isValidDateFormat("2024-02-29"));
+        CHECK(Common::isValidDateFormat("9999-99-99"));   // Format only; isValidDate checks the calendar
+        CHECK(!Common::isValidDateFormat("2024-2-29"));
+        CHECK(!Common::isValidDateFormat("2024/02/29"));
+        CHECK(!Common::isValidDateFormat("2024-02-29 "));
+    }
+
+    template <typename Validator, typename Reference>
+    void checkAgreement(const char* what, const std::vector<std::string>& corpus,
+                        Validator validator, Reference reference) {
+        size_t accepted = 0;
+        for (const std::string& input : corpus) {
+            const bool expected = reference(input);
+            accepted += expected ? 1 : 0;
+            CHECK_MSG(validator(input) == expected, std::string(what) + " disagrees on \"" + input + "\"");
+        }
+        // A corpus that is all accepts or all rejects would not test much
+        CHECK_MSG(accepted > corpus.size() / 50 && accepted < corpus.size() - corpus.size() / 50,
+                  std::string(what) + " corpus accepted " + std::to_string(accepted) + " of " +
+                      std::to_string(corpus.size()));
+    }
+}
+
+int main() {
+    checkKnownCases();
+
+    TestRandom random;
+    checkAgreement("isValidEmail", makeEmailCorpus(200000, random),
+                   [](const std::string& s) { return Common::isValidEmail(s); }, referenceIsValidEmail);
+    checkAgreement("isValidDateFormat", makeDateCorpus(200000, random),
+                   [](const std::string& s) { return Common::isValidDateFormat(s); }, referenceIsValidDateFormat);
+
+    return finish("ValidatorTest");
+}